@@ -106,7 +106,18 @@ bool pqInputDataTypeDecorator::processState() const
     std::vector<std::string> parts = vtksys::SystemTools::SplitString(dataname, ' ');
     if (cur_input && !parts.empty())
     {
-      vtkPVDataInformation* dataInfo = cur_input->getDataInformation();
+      // don't gather the data information here: decide on the last known one
+      // and update the widget once the fresh one is available.
+      auto self = const_cast<pqInputDataTypeDecorator*>(this);
+      vtkPVDataInformation* dataInfo =
+        cur_input->requestDataInformation(self, [self](vtkPVDataInformation*) {
+          Q_EMIT self->enableStateChanged();
+          Q_EMIT self->visibilityChanged();
+        });
+      if (!dataInfo)
+      {
+        return false;
+      }
       for (std::size_t i = 0; i < parts.size(); ++i)
       {
         const bool match = (parts[i] == "Structured") ? dataInfo->IsDataStructured()
@@ -100,6 +100,18 @@ void pqInteractivePropertyWidgetAbstract::setupConnections(
   pqCoreUtilities::connect(widget, vtkCommand::EndInteractionEvent, this, SIGNAL(endInteraction()));
   pqCoreUtilities::connect(widget, vtkCommand::EndInteractionEvent, this, SIGNAL(changeFinished()));
 
+  // Filters can expose an "Interacting" function in the group to produce a
+  // cheaper result while the widget is being dragged, e.g. Plot Over Line. It is
+  // set before the changes are applied since startInteraction() and
+  // endInteraction() are fired before changeAvailable() and changeFinished().
+  if (smgroup->GetProperty("Interacting"))
+  {
+    QObject::connect(this, &pqInteractivePropertyWidgetAbstract::startInteraction, this,
+      [this]() { vtkSMPropertyHelper(this->propertyGroup()->GetProperty("Interacting")).Set(1); });
+    QObject::connect(this, &pqInteractivePropertyWidgetAbstract::endInteraction, this,
+      [this]() { vtkSMPropertyHelper(this->propertyGroup()->GetProperty("Interacting")).Set(0); });
+  }
+
   if (vtkSMProperty* input = smgroup->GetProperty("Input"))
   {
     this->setDataSource(vtkSMPropertyHelper(input).GetAsProxy());
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <QApplication>
+#include <QList>
+#include <QtDebug>
+
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPipelineModel.h>
+#include <pqPipelineSource.h>
+#include <pqServer.h>
+#include <pqServerManagerModel.h>
+#include <vtkSMSessionProxyManager.h>
+
+namespace
+{
+// Counts the notifications a view of a pqPipelineModel would receive.
+struct ModelSignalCounts
+{
+  int RowsInserted = 0;
+  int RowsRemoved = 0;
+  int Resets = 0;
+  int FirstChildAdded = 0;
+
+  void connect(pqPipelineModel* model)
+  {
+    QObject::connect(
+      model, &QAbstractItemModel::rowsInserted, [this]() { ++this->RowsInserted; });
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved, [this]() { ++this->RowsRemoved; });
+    QObject::connect(model, &QAbstractItemModel::modelReset, [this]() { ++this->Resets; });
+    QObject::connect(
+      model, &pqPipelineModel::firstChildAdded, [this]() { ++this->FirstChildAdded; });
+  }
+
+  void clear() { *this = ModelSignalCounts(); }
+};
+
+// Connects the model the way pqPipelineBrowserWidget does.
+void connectModel(pqServerManagerModel* smModel, pqPipelineModel* model)
+{
+  QObject::connect(smModel, SIGNAL(preServerAdded(pqServer*)), model, SLOT(addServer(pqServer*)));
+  QObject::connect(
+    smModel, SIGNAL(serverRemoved(pqServer*)), model, SLOT(removeServer(pqServer*)));
+  QObject::connect(smModel, SIGNAL(sourceAdded(pqPipelineSource*)), model,
+    SLOT(addSource(pqPipelineSource*)));
+  QObject::connect(smModel, SIGNAL(sourceRemoved(pqPipelineSource*)), model,
+    SLOT(removeSource(pqPipelineSource*)));
+  QObject::connect(smModel, SIGNAL(connectionAdded(pqPipelineSource*, pqPipelineSource*, int)),
+    model, SLOT(addConnection(pqPipelineSource*, pqPipelineSource*, int)));
+  QObject::connect(smModel, SIGNAL(connectionRemoved(pqPipelineSource*, pqPipelineSource*, int)),
+    model, SLOT(removeConnection(pqPipelineSource*, pqPipelineSource*, int)));
+  QObject::connect(smModel, SIGNAL(bulkRegistrationStarted()), model, SLOT(beginBulkUpdate()));
+  QObject::connect(smModel, SIGNAL(bulkRegistrationFinished()), model, SLOT(endBulkUpdate()));
+}
+
+// Checks that every source is found at the expected place in the tree: the
+// spheres under the server, each with its shrink filter as only child.
+bool validate(pqPipelineModel* model, const QList<pqPipelineSource*>& spheres,
+  const QList<pqPipelineSource*>& shrinks)
+{
+  const QModelIndex serverIndex = model->index(0, 0);
+  if (model->rowCount() != 1 || model->rowCount(serverIndex) != spheres.size())
+  {
+    qCritical() << "ERROR! Expected" << spheres.size() << "sources, got"
+                << model->rowCount(serverIndex);
+    return false;
+  }
+  for (int cc = 0; cc < spheres.size(); ++cc)
+  {
+    const QModelIndex sphereIndex = model->getIndexFor(spheres[cc]);
+    if (sphereIndex.parent() != serverIndex || model->getItemFor(sphereIndex) != spheres[cc] ||
+      model->rowCount(sphereIndex) != 1)
+    {
+      qCritical() << "ERROR! Unexpected index for source" << cc;
+      return false;
+    }
+    const QModelIndex shrinkIndex = model->getIndexFor(shrinks[cc]);
+    if (shrinkIndex != model->index(0, 0, sphereIndex) ||
+      model->getItemFor(shrinkIndex) != shrinks[cc])
+    {
+      qCritical() << "ERROR! Unexpected index for filter" << cc;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int PipelineModelBulkUpdate(int argc, char* argv[])
+{
+  QApplication app(argc, argv);
+  pqApplicationCore appCore(argc, argv);
+  pqObjectBuilder* builder = appCore.getObjectBuilder();
+  pqServerManagerModel* smModel = appCore.getServerManagerModel();
+
+  pqPipelineModel model;
+  connectModel(smModel, &model);
+  ModelSignalCounts counts;
+  counts.connect(&model);
+
+  pqServer* server = builder->createServer(pqServerResource("builtin:"));
+  vtkSMSessionProxyManager* pxm = server->proxyManager();
+
+  // Outside of a bulk update, rows are notified as they are inserted. The filter
+  // may be moved under its input once connected, hence at least 2 insertions.
+  counts.clear();
+  QList<pqPipelineSource*> spheres;
+  QList<pqPipelineSource*> shrinks;
+  spheres.push_back(builder->createSource("sources", "SphereSource", server));
+  shrinks.push_back(builder->createFilter("filters", "ShrinkFilter", spheres.back()));
+  if (counts.RowsInserted < 2 || counts.Resets != 0 || !validate(&model, spheres, shrinks))
+  {
+    qCritical() << "ERROR! Unexpected notifications outside of a bulk update.";
+    return EXIT_FAILURE;
+  }
+
+  // A bulk update that does not change the tree does not reset the model.
+  counts.clear();
+  pxm->BeginBulkRegistration();
+  pxm->EndBulkRegistration();
+  if (counts.Resets != 0)
+  {
+    qCritical() << "ERROR! An empty bulk update reset the model.";
+    return EXIT_FAILURE;
+  }
+
+  // Sources added in nested bulk updates are notified by a single reset, at the
+  // end of the outermost one, followed by firstChildAdded for the server and
+  // every sphere so that views expand the tree again.
+  counts.clear();
+  pxm->BeginBulkRegistration();
+  pxm->BeginBulkRegistration();
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    spheres.push_back(builder->createSource("sources", "SphereSource", server));
+    shrinks.push_back(builder->createFilter("filters", "ShrinkFilter", spheres.back()));
+  }
+  pxm->EndBulkRegistration();
+  if (counts.Resets != 0)
+  {
+    qCritical() << "ERROR! The model was reset before the outermost bulk update ended.";
+    return EXIT_FAILURE;
+  }
+  pxm->EndBulkRegistration();
+  if (counts.RowsInserted != 0 || counts.Resets != 1 ||
+    counts.FirstChildAdded != spheres.size() + 1 || !validate(&model, spheres, shrinks))
+  {
+    qCritical() << "ERROR! Unexpected notifications for a bulk addition:" << counts.RowsInserted
+                << "rows inserted," << counts.Resets << "resets," << counts.FirstChildAdded
+                << "firstChildAdded.";
+    return EXIT_FAILURE;
+  }
+
+  // Removing sources in a bulk update also resets the model once.
+  counts.clear();
+  pxm->BeginBulkRegistration();
+  for (int cc = spheres.size() - 1; cc > 0; --cc)
+  {
+    builder->destroy(shrinks.takeLast());
+    builder->destroy(spheres.takeLast());
+  }
+  pxm->EndBulkRegistration();
+  if (counts.RowsRemoved != 0 || counts.Resets != 1 || !validate(&model, spheres, shrinks))
+  {
+    qCritical() << "ERROR! Unexpected notifications for a bulk removal:" << counts.RowsRemoved
+                << "rows removed," << counts.Resets << "resets.";
+    return EXIT_FAILURE;
+  }
+
+  builder->destroySources(server);
+  builder->removeServer(server);
+  return EXIT_SUCCESS;
+}
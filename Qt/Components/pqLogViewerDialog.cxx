@@ -5,11 +5,14 @@
 #include "pqLogViewerDialog.h"
 
 #include "pqActiveObjects.h"
+#include "pqFileDialog.h"
 #include "pqServer.h"
 
 #include <QMouseEvent>
 
+#include "vtkLogRecorder.h"
 #include "vtkPVLogInformation.h"
+#include "vtkPVLogTimelineWriter.h"
 #include "vtkPVLogger.h"
 #include "vtkPVServerInformation.h"
 #include "vtkSMPropertyHelper.h"
@@ -18,6 +21,8 @@
 
 #include "ui_pqLogViewerDialog.h"
 
+#include <limits>
+
 namespace
 {
 std::map<int, vtkLogger::Verbosity> indexToVerbosity;
@@ -35,6 +40,32 @@ constexpr int APPLICATION_CATEGORY = 2;
 constexpr int PIPELINE_CATEGORY = 3;
 constexpr int PLUGINS_CATEGORY = 4;
 constexpr int EXECUTION_CATEGORY = 5;
+
+// Number of round trips used to estimate the clock offset of each process.
+constexpr int CLOCK_OFFSET_ROUNDS = 4;
+
+// Estimates the offset between the clock of the process of `logRecorderProxy`
+// and the clock of `clientRecorder`. Only the time of rank 0 is gathered, the
+// shortest of a few round trips giving the best estimate.
+double estimateClockOffset(vtkSMProxy* logRecorderProxy, vtkLogRecorder* clientRecorder)
+{
+  double offset = 0.0;
+  double bestRoundTrip = std::numeric_limits<double>::max();
+  for (int round = 0; round < CLOCK_OFFSET_ROUNDS; ++round)
+  {
+    vtkNew<vtkPVLogInformation> timeInfo;
+    const double requestTime = clientRecorder->GetTraceTime();
+    logRecorderProxy->GatherInformation(timeInfo);
+    const double replyTime = clientRecorder->GetTraceTime();
+    if (replyTime - requestTime < bestRoundTrip)
+    {
+      bestRoundTrip = replyTime - requestTime;
+      offset = vtkPVLogTimelineWriter::EstimateClockOffset(
+        requestTime, replyTime, timeInfo->GetTraceTime());
+    }
+  }
+  return offset;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -155,6 +186,10 @@ pqLogViewerDialog::pqLogViewerDialog(QWidget* parent)
     this->Ui->refreshButton, &QPushButton::pressed, this, &pqLogViewerDialog::refresh);
   QObject::connect(
     this->Ui->clearLogsButton, &QPushButton::pressed, this, &pqLogViewerDialog::clear);
+  QObject::connect(this->Ui->recordTimelineCheckBox, &QCheckBox::toggled, this,
+    &pqLogViewerDialog::setTimelineRecording);
+  QObject::connect(
+    this->Ui->saveTimelineButton, &QPushButton::pressed, this, &pqLogViewerDialog::saveTimeline);
   QObject::connect(this->Ui->logTabWidget, &QTabWidget::tabCloseRequested, this->Ui->logTabWidget,
     &QTabWidget::removeTab);
 
@@ -212,6 +247,7 @@ pqLogViewerDialog::pqLogViewerDialog(QWidget* parent)
 //----------------------------------------------------------------------------
 pqLogViewerDialog::~pqLogViewerDialog()
 {
+  this->setTimelineRecording(false);
   for (const auto& logRecorderProxy : this->LogRecorderProxies)
   {
     logRecorderProxy->Delete();
@@ -235,6 +271,7 @@ void pqLogViewerDialog::clear()
   for (const auto& logRecorderProxy : this->LogRecorderProxies)
   {
     logRecorderProxy->InvokeCommand("ClearLogs");
+    logRecorderProxy->InvokeCommand("ClearTraceEvents");
   }
 
   for (auto* logView : this->LogViews)
@@ -268,6 +305,51 @@ void pqLogViewerDialog::addLogView()
   }
 }
 
+//----------------------------------------------------------------------------
+void pqLogViewerDialog::setTimelineRecording(bool record)
+{
+  for (const auto& logRecorderProxy : this->LogRecorderProxies)
+  {
+    vtkSMPropertyHelper(logRecorderProxy, "TraceEnabled").Set(record ? 1 : 0);
+    logRecorderProxy->UpdateVTKObjects();
+    if (record)
+    {
+      logRecorderProxy->InvokeCommand("SynchronizeClocks");
+    }
+  }
+  this->Ui->saveTimelineButton->setEnabled(record);
+}
+
+//----------------------------------------------------------------------------
+void pqLogViewerDialog::saveTimeline()
+{
+  pqFileDialog fileDialog(nullptr, this, tr("Save Timeline"), QString(),
+    tr("Trace Event Files") + " (*.json);;" + tr("All Files") + " (*)", false);
+  fileDialog.setFileMode(pqFileDialog::AnyFile);
+  if (fileDialog.exec() != pqFileDialog::Accepted)
+  {
+    return;
+  }
+
+  auto clientRecorder =
+    vtkLogRecorder::SafeDownCast(this->LogRecorderProxies[CLIENT_PROCESS]->GetClientSideObject());
+  vtkNew<vtkPVLogTimelineWriter> writer;
+  for (int i = 0; i < this->LogRecorderProxies.size(); ++i)
+  {
+    // the trace events can take long to transfer, so the clock offset is
+    // estimated from separate lightweight round trips.
+    const double offset = i == CLIENT_PROCESS
+      ? 0.0
+      : ::estimateClockOffset(this->LogRecorderProxies[i], clientRecorder);
+    vtkNew<vtkPVLogInformation> traceInfo;
+    traceInfo->SetCollectTrace(true);
+    this->LogRecorderProxies[i]->GatherInformation(traceInfo);
+    writer->AddProcess(this->Ui->processComboBox->itemText(i).toStdString(), traceInfo, offset);
+  }
+  writer->SetFileName(fileDialog.getSelectedFiles().first().toUtf8().data());
+  writer->Write();
+}
+
 //----------------------------------------------------------------------------
 void pqLogViewerDialog::recordRefTimes()
 {
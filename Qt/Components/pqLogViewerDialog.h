@@ -56,6 +56,16 @@ public:
    */
   void addLogView();
 
+  /**
+   * Start or stop recording a timeline of trace events on all processes.
+   */
+  void setTimelineRecording(bool record);
+
+  /**
+   * Save the timeline recorded on all processes to a trace event file.
+   */
+  void saveTimeline();
+
 protected:
   // Override to handle custom close button icon in tab widget
   bool eventFilter(QObject* obj, QEvent* event) override;
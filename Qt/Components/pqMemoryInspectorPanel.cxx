@@ -12,26 +12,33 @@
 #include "pqActiveObjects.h"
 #include "pqApplicationCore.h"
 #include "pqCoreUtilities.h"
+#include "pqDataRepresentation.h"
+#include "pqPipelineSource.h"
 #include "pqRenderView.h"
 #include "pqServerManagerModel.h"
 #include "pqView.h"
 #include "vtkSMRenderViewProxy.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkNew.h"
 #include "vtkPVDisableStackTraceSignalHandler.h"
 #include "vtkPVEnableStackTraceSignalHandler.h"
 #include "vtkPVInformation.h"
 #include "vtkPVMemoryUseInformation.h"
+#include "vtkPVProxyMemoryInformation.h"
 #include "vtkPVSystemConfigInformation.h"
 #include "vtkProcessModule.h"
+#include "vtkSMProxy.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionClient.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QFont>
 #include <QFontMetrics>
 #include <QFormLayout>
 #include <QFrame>
+#include <QHeaderView>
 #include <QLabel>
 #include <QMenu>
 #include <QMessageBox>
@@ -44,6 +51,7 @@
 #include <QString>
 #include <QStringList>
 #include <QStyleFactory>
+#include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include <QTreeWidgetItemIterator>
 
@@ -208,6 +216,79 @@ void unescapeWhitespace(string& s, char escChar)
     }
   }
 }
+
+// ****************************************************************************
+// Tree item of the proxy memory breakdown, sorted on the memory size rather
+// than on the formatted text in the memory column.
+class ProxyMemoryItem : public QTreeWidgetItem
+{
+public:
+  using QTreeWidgetItem::QTreeWidgetItem;
+
+  bool operator<(const QTreeWidgetItem& other) const override
+  {
+    const int column = this->treeWidget() ? this->treeWidget()->sortColumn() : 0;
+    if (column == 2)
+    {
+      return this->data(2, Qt::UserRole).toLongLong() < other.data(2, Qt::UserRole).toLongLong();
+    }
+    return this->QTreeWidgetItem::operator<(other);
+  }
+
+  void AddMemorySize(long long size)
+  {
+    const long long total = this->data(2, Qt::UserRole).toLongLong() + size;
+    this->setData(2, Qt::UserRole, total);
+    this->setText(2, pqCoreUtilities::formatMemoryFromKiBValue(total));
+  }
+};
+
+// ****************************************************************************
+// Name of the pipeline object, or of the representation, owning the proxy
+// with the given global id.
+QString getProxyLabel(vtkSMSession* session, vtkTypeUInt32 globalId)
+{
+  vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(session->GetRemoteObject(globalId));
+  if (!proxy)
+  {
+    return QCoreApplication::translate("pqMemoryInspectorPanel", "Internal object %1")
+      .arg(globalId);
+  }
+  proxy = proxy->GetTrueParentProxy();
+
+  pqServerManagerModel* smm = pqApplicationCore::instance()->getServerManagerModel();
+  if (auto repr = smm->findItem<pqDataRepresentation*>(proxy))
+  {
+    pqPipelineSource* input = repr->getInput();
+    pqView* view = repr->getView();
+    return QCoreApplication::translate("pqMemoryInspectorPanel", "%1 in %2")
+      .arg(input ? input->getSMName() : QString(proxy->GetXMLLabel()))
+      .arg(view ? view->getSMName() : QString());
+  }
+  if (auto item = smm->findItem<pqProxy*>(proxy))
+  {
+    return item->getSMName();
+  }
+  return QString(proxy->GetXMLLabel());
+}
+
+// ****************************************************************************
+QString getProcessLabel(int processType, int rank)
+{
+  switch (processType)
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return QCoreApplication::translate("pqMemoryInspectorPanel", "client");
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      return QCoreApplication::translate("pqMemoryInspectorPanel", "data server rank %1")
+        .arg(rank);
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return QCoreApplication::translate("pqMemoryInspectorPanel", "render server rank %1")
+        .arg(rank);
+    default:
+      return QCoreApplication::translate("pqMemoryInspectorPanel", "server rank %1").arg(rank);
+  }
+}
 };
 
 /// data associated with an mpi rank
@@ -686,6 +767,10 @@ pqMemoryInspectorPanel::pqMemoryInspectorPanel(QWidget* pWidget, Qt::WindowFlags
         SLOT(EnableUpdate()));
   */
 
+  // largest memory users first.
+  this->Ui->proxyView->sortByColumn(2, Qt::DescendingOrder);
+  this->Ui->proxyView->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+
   QPalette pal = this->Ui->configView->palette();
   pal.setColor(QPalette::Highlight, Qt::lightGray);
   this->Ui->configView->setPalette(pal);
@@ -958,6 +1043,7 @@ void pqMemoryInspectorPanel::Clear()
   this->StackTraceOnRenderServer = 0;
 
   this->Ui->configView->clear();
+  this->Ui->proxyView->clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -1188,6 +1274,7 @@ void pqMemoryInspectorPanel::Update()
 
   this->UpdateRanks();
   this->UpdateHosts();
+  this->UpdateProxies();
 
   this->PendingUpdate = false;
   this->UpdateEnabled = false;
@@ -1300,6 +1387,65 @@ void pqMemoryInspectorPanel::UpdateRanks()
   infos->Delete();
 }
 
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::UpdateProxies()
+{
+#if defined pqMemoryInspectorPanelDEBUG
+  cerr << ":::::pqMemoryInspectorPanel::UpdateProxies" << endl;
+#endif
+
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  if (!server)
+  {
+    pqErrorMacro("failed to get active server");
+    return;
+  }
+
+  // fetch the memory used by the data of each proxy, on all processes.
+  vtkSMSession* session = server->session();
+  vtkNew<vtkPVProxyMemoryInformation> infos;
+  session->GatherInformation(vtkPVSession::CLIENT, infos, 0);
+  if (!this->ClientOnly)
+  {
+    vtkNew<vtkPVProxyMemoryInformation> dsinfos;
+    session->GatherInformation(vtkPVSession::DATA_SERVER, dsinfos, 0);
+    infos->AddInformation(dsinfos);
+
+    // see UpdateRanks.
+    if (session->GetRenderClientMode() == vtkSMSession::RENDERING_SPLIT)
+    {
+      vtkNew<vtkPVProxyMemoryInformation> rsinfos;
+      session->GatherInformation(vtkPVSession::RENDER_SERVER, rsinfos, 0);
+      infos->AddInformation(rsinfos);
+    }
+  }
+
+  // one top level item per pipeline object or representation, with one child
+  // per kind of data and process.
+  QTreeWidget* view = this->Ui->proxyView;
+  const bool sorting = view->isSortingEnabled();
+  view->setSortingEnabled(false);
+  view->clear();
+  map<QString, ProxyMemoryItem*> proxyItems;
+  for (size_t i = 0; i < infos->GetNumberOfEntries(); ++i)
+  {
+    const QString label = ::getProxyLabel(session, infos->GetGlobalID(i));
+    ProxyMemoryItem*& proxyItem = proxyItems[label];
+    if (!proxyItem)
+    {
+      proxyItem = new ProxyMemoryItem(view);
+      proxyItem->setText(0, label);
+    }
+    proxyItem->AddMemorySize(infos->GetMemorySize(i));
+
+    ProxyMemoryItem* item = new ProxyMemoryItem(proxyItem);
+    item->setText(0, vtkPVProxyMemoryInformation::GetMemoryKindAsString(infos->GetKind(i)));
+    item->setText(1, ::getProcessLabel(infos->GetProcessType(i), infos->GetRank(i)));
+    item->AddMemorySize(infos->GetMemorySize(i));
+  }
+  view->setSortingEnabled(sorting);
+}
+
 //-----------------------------------------------------------------------------
 void pqMemoryInspectorPanel::UpdateHosts()
 {
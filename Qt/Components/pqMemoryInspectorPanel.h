@@ -104,6 +104,7 @@ private:
   void UpdateRanks();
   void UpdateHosts();
   void UpdateHosts(map<string, HostData*>& hosts);
+  void UpdateProxies();
 
   void InitializeServerGroup(long long clientPid, vtkPVSystemConfigInformation* configs,
     int validProcessType, QTreeWidgetItem* group, string groupName, map<string, HostData*>& hosts,
@@ -102,6 +102,13 @@ void pqPipelineBrowserWidget::configureModel()
   QObject::connect(smModel, SIGNAL(connectionRemoved(pqServerManagerModelItem*, pqExtractor*)),
     this->PipelineModel, SLOT(removeConnection(pqServerManagerModelItem*, pqExtractor*)));
 
+  // Batch the updates when many proxies are registered at once, e.g. when
+  // loading a state file.
+  QObject::connect(
+    smModel, SIGNAL(bulkRegistrationStarted()), this->PipelineModel, SLOT(beginBulkUpdate()));
+  QObject::connect(
+    smModel, SIGNAL(bulkRegistrationFinished()), this->PipelineModel, SLOT(endBulkUpdate()));
+
   // Use the tree view's font as the base for the model's modified
   // font.
   QFont modifiedFont = this->font();
@@ -25,6 +25,7 @@
 #include "vtkNew.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMLiveInsituLinkProxy.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMSourceProxy.h"
@@ -32,10 +33,15 @@
 
 #include <QApplication>
 #include <QFont>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
 #include <QString>
 #include <QStyle>
+#include <QVector>
 #include <QtDebug>
 
+#include <algorithm>
 #include <cassert>
 
 class ModifiedLiveInsituLink : public vtkCommand
@@ -87,8 +93,6 @@ static const QString LAST = "LAST";
 //-----------------------------------------------------------------------------
 class pqPipelineModelDataItem : public QObject
 {
-  bool InConstructor;
-
 public:
   static vtkNew<vtkSMParaViewPipelineControllerWithRendering> Controller;
 
@@ -98,8 +102,12 @@ public:
   pqServerManagerModelItem* Object;
   pqPipelineModel::ItemType Type;
   QString VisibilityIcon;
+  bool VisibilityIconValid;
   bool Selectable;
 
+  // Row of this item in Parent->Children, if still valid. See getIndexInParent().
+  int Row;
+
   // This is a terrible iVar, agreed. But it makes my life easier.
   // This is valid only for elements of Type==Proxy. These refer to the link
   // items present for this item, if any. This list is automatically kept
@@ -107,84 +115,92 @@ public:
   QList<pqPipelineModelDataItem*> Links;
 
   pqPipelineModelDataItem(QObject* p, pqServerManagerModelItem* object,
-    pqPipelineModel::ItemType itemType, pqPipelineModel* model)
-    : QObject(p)
-  {
-    this->InConstructor = true;
-    this->Selectable = true;
-    this->Model = model;
-    this->Parent = nullptr;
-    this->Object = object;
-    this->Type = itemType;
-    this->VisibilityIcon = PipelineModelIconType::LAST;
-    if (itemType == pqPipelineModel::Link)
+    pqPipelineModel::ItemType itemType, pqPipelineModel* model);
+  ~pqPipelineModelDataItem() override;
+
+  pqPipelineModelDataItem& operator=(const pqPipelineModelDataItem& other);
+
+  // no need to call this generally. Only needed when operator = is used.
+  void updateLinks()
+  {
+    if (this->Type == pqPipelineModel::Link)
     {
       pqPipelineModelDataItem* proxyItem =
-        model->getDataItem(object, nullptr, pqPipelineModel::Proxy);
+        this->Model->getDataItem(this->Object, nullptr, pqPipelineModel::Proxy);
       assert(proxyItem != 0);
       proxyItem->Links.push_back(this);
     }
-    if (this->Object)
+    Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
     {
-      this->updateVisibilityIcon(this->Model->view(), false);
+      child->updateLinks();
     }
-    this->InConstructor = false;
   }
-  ~pqPipelineModelDataItem() override
+
+  pqPipelineModel::ItemType getType() { return this->Type; }
+  int getIndexInParent()
   {
-    if (this->Type == pqPipelineModel::Link && this->Model->Internal)
+    if (!this->Parent)
     {
-      pqPipelineModelDataItem* proxyItem =
-        this->Model->getDataItem(this->Object, nullptr, pqPipelineModel::Proxy);
-      if (proxyItem)
-      {
-        proxyItem->Links.removeAll(this);
-      }
+      return 0;
+    }
+    if (this->Parent->Children.value(this->Row) != this)
+    {
+      this->Row = this->Parent->Children.indexOf(this);
     }
+    return this->Row;
   }
 
-  pqPipelineModelDataItem& operator=(const pqPipelineModelDataItem& other)
+  // Returns true if this item comes before `other` in a depth-first traversal
+  // of the tree.
+  bool precedes(pqPipelineModelDataItem* other)
   {
-    this->Object = other.Object;
-    this->Type = other.Type;
-    this->VisibilityIcon = other.VisibilityIcon;
-    Q_FOREACH (pqPipelineModelDataItem* otherChild, other.Children)
-    {
-      pqPipelineModelDataItem* child =
-        new pqPipelineModelDataItem(this, nullptr, pqPipelineModel::Invalid, this->Model);
-      this->addChild(child);
-      *child = *otherChild;
-    }
-    return *this;
+    QVector<int> path = this->getPath();
+    QVector<int> otherPath = other->getPath();
+    return std::lexicographical_compare(
+      path.begin(), path.end(), otherPath.begin(), otherPath.end());
   }
 
-  // no need to call this generally. Only needed when operator = is used.
-  void updateLinks()
+  // Returns true if this item is `root` or one of its descendants.
+  bool isInSubtree(const pqPipelineModelDataItem* root) const
   {
-    if (this->Type == pqPipelineModel::Link)
+    const pqPipelineModelDataItem* item = this;
+    while (item && item != root)
     {
-      pqPipelineModelDataItem* proxyItem =
-        this->Model->getDataItem(this->Object, nullptr, pqPipelineModel::Proxy);
-      assert(proxyItem != 0);
-      proxyItem->Links.push_back(this);
+      item = item->Parent;
     }
-    Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
+    return item != nullptr;
+  }
+
+  // The icon type is cached since it may be costly to determine, e.g. for
+  // sources relying on the preferred view type.
+  const QString& getIconType() const
+  {
+    if (this->IconType.isEmpty())
     {
-      child->updateLinks();
+      this->IconType = this->computeIconType();
     }
+    return this->IconType;
   }
 
-  pqPipelineModel::ItemType getType() { return this->Type; }
-  int getIndexInParent()
+  bool hasIconType() const { return !this->IconType.isEmpty(); }
+
+  // returns true when the (already requested) icon type has changed.
+  bool updateIconType()
   {
-    if (!this->Parent)
+    if (this->IconType.isEmpty())
     {
-      return 0;
+      return false;
+    }
+    QString newIconType = this->computeIconType();
+    if (newIconType == this->IconType)
+    {
+      return false;
     }
-    return this->Parent->Children.indexOf(this);
+    this->IconType = newIconType;
+    return true;
   }
 
-  QString getIconType() const
+  QString computeIconType() const
   {
     switch (this->Type)
     {
@@ -247,6 +263,7 @@ public:
     }
     child->setParent(this);
     child->Parent = this;
+    child->Row = this->Children.size();
     this->Children.push_back(child);
   }
 
@@ -257,13 +274,88 @@ public:
       qCritical() << "Cannot remove a non-child.";
       return;
     }
+    int row = child->getIndexInParent();
     child->setParent(nullptr);
     child->Parent = nullptr;
-    this->Children.removeAll(child);
+    this->Children.removeAt(row);
+    for (int cc = row; cc < this->Children.size(); ++cc)
+    {
+      this->Children[cc]->Row = cc;
+    }
   }
 
-  // returns true when the icon has changed.
+  // Returns the visibility icon in the view, computing it if needed.
+  const QString& getVisibilityIcon(pqView* view)
+  {
+    if (!this->VisibilityIconValid)
+    {
+      this->VisibilityIcon = this->computeVisibilityIcon(view);
+      this->VisibilityIconValid = true;
+    }
+    return this->VisibilityIcon;
+  }
+
+  // Discards the visibility icon(s), to be computed again when requested.
+  void invalidateVisibilityIcon(bool traverse_subtree)
+  {
+    this->VisibilityIconValid = false;
+    if (traverse_subtree)
+    {
+      Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
+      {
+        child->invalidateVisibilityIcon(traverse_subtree);
+      }
+    }
+  }
+
+  // returns true when the icon has changed. Icons that have not been requested
+  // yet are left alone, they are computed when needed.
   bool updateVisibilityIcon(pqView* view, bool traverse_subtree)
+  {
+    bool ret_val = false;
+    if (this->VisibilityIconValid)
+    {
+      QString newIcon = this->computeVisibilityIcon(view);
+      if (this->VisibilityIcon != newIcon)
+      {
+        this->VisibilityIcon = newIcon;
+        if (this->Model)
+        {
+          this->Model->itemDataChanged(this);
+        }
+        ret_val = true;
+      }
+    }
+    if (traverse_subtree)
+    {
+      Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
+      {
+        child->updateVisibilityIcon(view, traverse_subtree);
+      }
+    }
+    return ret_val;
+  }
+
+  bool isModified() const
+  {
+    pqProxy* proxy = qobject_cast<pqProxy*>(this->Object);
+    return (proxy && (proxy->modifiedState() != pqProxy::UNMODIFIED));
+  }
+
+private:
+  mutable QString IconType;
+
+  QVector<int> getPath()
+  {
+    QVector<int> path;
+    for (pqPipelineModelDataItem* item = this; item->Parent; item = item->Parent)
+    {
+      path.push_front(item->getIndexInParent());
+    }
+    return path;
+  }
+
+  QString computeVisibilityIcon(pqView* view) const
   {
     QString newIcon = PipelineModelIconType::LAST;
     switch (this->Type)
@@ -304,34 +396,9 @@ public:
       default:
         break;
     }
-
-    bool ret_val = false;
-    if (this->VisibilityIcon != newIcon)
-    {
-      this->VisibilityIcon = newIcon;
-      if (!this->InConstructor && this->Model)
-      {
-        this->Model->itemDataChanged(this);
-      }
-      ret_val = true;
-    }
-    if (traverse_subtree)
-    {
-      Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
-      {
-        child->updateVisibilityIcon(view, traverse_subtree);
-      }
-    }
-    return ret_val;
-  }
-
-  bool isModified() const
-  {
-    pqProxy* proxy = qobject_cast<pqProxy*>(this->Object);
-    return (proxy && (proxy->modifiedState() != pqProxy::UNMODIFIED));
+    return newIcon;
   }
 
-private:
   QString getBreakpointVisibilityIcon() const
   {
     pqLiveInsituManager* server = pqLiveInsituManager::instance();
@@ -442,8 +509,115 @@ public:
   pqPipelineModelDataItem Root;
   pqTimer DelayedUpdateVisibilityTimer;
   QList<QPointer<pqPipelineSource>> DelayedUpdateVisibilityItems;
+  QSet<pqPipelineSource*> DelayedUpdateVisibilitySources;
+
+  // Data items for each pqServerManagerModelItem, so that items are looked up
+  // without traversing the tree. There may be several data items for the same
+  // object, e.g. a fan-in filter and its links.
+  QHash<pqServerManagerModelItem*, QList<pqPipelineModelDataItem*>> DataItems;
+
+  // Nesting level of pqPipelineModel::beginBulkUpdate() calls and whether the
+  // model reset has started, i.e. whether the tree changed since then.
+  int BulkUpdateDepth = 0;
+  bool InBulkReset = false;
+
+  void addDataItem(pqPipelineModelDataItem* item) { this->DataItems[item->Object].push_back(item); }
+
+  void removeDataItem(pqPipelineModelDataItem* item)
+  {
+    auto iter = this->DataItems.find(item->Object);
+    if (iter != this->DataItems.end())
+    {
+      iter.value().removeOne(item);
+      if (iter.value().empty())
+      {
+        this->DataItems.erase(iter);
+      }
+    }
+  }
 };
 
+//-----------------------------------------------------------------------------
+pqPipelineModelDataItem::pqPipelineModelDataItem(QObject* p, pqServerManagerModelItem* object,
+  pqPipelineModel::ItemType itemType, pqPipelineModel* model)
+  : QObject(p)
+{
+  this->Selectable = true;
+  this->Model = model;
+  this->Parent = nullptr;
+  this->Row = -1;
+  this->Object = object;
+  this->Type = itemType;
+  // the visibility icon is computed when first requested, see
+  // pqPipelineModel::data().
+  this->VisibilityIcon = PipelineModelIconType::LAST;
+  this->VisibilityIconValid = false;
+  if (this->Object)
+  {
+    this->Model->Internal->addDataItem(this);
+  }
+  if (itemType == pqPipelineModel::Link)
+  {
+    pqPipelineModelDataItem* proxyItem =
+      model->getDataItem(object, nullptr, pqPipelineModel::Proxy);
+    assert(proxyItem != 0);
+    proxyItem->Links.push_back(this);
+  }
+}
+
+//-----------------------------------------------------------------------------
+pqPipelineModelDataItem::~pqPipelineModelDataItem()
+{
+  // children are deleted after this item, don't let them walk up to it.
+  Q_FOREACH (pqPipelineModelDataItem* child, this->Children)
+  {
+    child->Parent = nullptr;
+  }
+
+  if (this->Object && this->Model->Internal)
+  {
+    this->Model->Internal->removeDataItem(this);
+    if (this->Type == pqPipelineModel::Link)
+    {
+      pqPipelineModelDataItem* proxyItem =
+        this->Model->getDataItem(this->Object, nullptr, pqPipelineModel::Proxy);
+      if (proxyItem)
+      {
+        proxyItem->Links.removeAll(this);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+pqPipelineModelDataItem& pqPipelineModelDataItem::operator=(const pqPipelineModelDataItem& other)
+{
+  if (this->Object != other.Object)
+  {
+    if (this->Object)
+    {
+      this->Model->Internal->removeDataItem(this);
+    }
+    this->Object = other.Object;
+    if (this->Object)
+    {
+      this->Model->Internal->addDataItem(this);
+    }
+  }
+  this->Type = other.Type;
+  this->VisibilityIcon = other.VisibilityIcon;
+  this->VisibilityIconValid = other.VisibilityIconValid;
+  this->IconType = other.IconType;
+  Q_FOREACH (pqPipelineModelDataItem* otherChild, other.Children)
+  {
+    pqPipelineModelDataItem* child =
+      new pqPipelineModelDataItem(this, nullptr, pqPipelineModel::Invalid, this->Model);
+    this->addChild(child);
+    *child = *otherChild;
+  }
+  return *this;
+}
+
 //-----------------------------------------------------------------------------
 void pqPipelineModel::constructor()
 {
@@ -790,7 +964,7 @@ QVariant pqPipelineModel::data(const QModelIndex& idx, int role) const
     case Qt::DisplayRole:
       if (idx.column() == 1)
       {
-        return QIcon(this->PixmapMap[item->VisibilityIcon]);
+        return QIcon(this->PixmapMap.value(item->getVisibilityIcon(this->View)));
       }
       VTK_FALLTHROUGH;
     // *** don't break.
@@ -840,7 +1014,13 @@ QVariant pqPipelineModel::data(const QModelIndex& idx, int role) const
       {
         if (item && item->getType() != pqPipelineModel::Invalid)
         {
-          return QVariant(this->PixmapMap[item->getIconType()]);
+          // Make sure a pipeline icon exists for this item
+          const QString& iconType = item->getIconType();
+          if (!this->checkAndLoadPipelinePixmap(iconType))
+          {
+            qWarning() << "Could not find icon pixmap for" << iconType;
+          }
+          return QVariant(this->PixmapMap.value(iconType));
         }
       }
       break;
@@ -959,25 +1139,24 @@ pqPipelineModelDataItem* pqPipelineModel::getDataItem(
     _parent = &this->Internal->Root;
   }
 
-  if (!item)
+  auto iter = this->Internal->DataItems.constFind(item);
+  if (!item || iter == this->Internal->DataItems.constEnd())
   {
     return nullptr;
   }
 
-  if (_parent->Object == item && (type == pqPipelineModel::Invalid || type == _parent->Type))
-  {
-    return _parent;
-  }
-
-  Q_FOREACH (pqPipelineModelDataItem* child, _parent->Children)
+  // Among the data items for `item` under `_parent`, return the first one in
+  // depth-first order.
+  pqPipelineModelDataItem* retVal = nullptr;
+  Q_FOREACH (pqPipelineModelDataItem* candidate, iter.value())
   {
-    pqPipelineModelDataItem* retVal = this->getDataItem(item, child, type);
-    if (retVal && (type == pqPipelineModel::Invalid || type == retVal->Type))
+    if ((type == pqPipelineModel::Invalid || type == candidate->Type) &&
+      candidate->isInSubtree(_parent) && (!retVal || candidate->precedes(retVal)))
     {
-      return retVal;
+      retVal = candidate;
     }
   }
-  return nullptr;
+  return retVal;
 }
 
 //-----------------------------------------------------------------------------
@@ -1005,6 +1184,13 @@ void pqPipelineModel::addChild(pqPipelineModelDataItem* _parent, pqPipelineModel
     return;
   }
 
+  if (this->beginBulkReset())
+  {
+    // views are notified in endBulkUpdate().
+    _parent->addChild(child);
+    return;
+  }
+
   QModelIndex parentIndex = this->getIndex(_parent);
   int row = _parent->Children.size();
 
@@ -1012,12 +1198,6 @@ void pqPipelineModel::addChild(pqPipelineModelDataItem* _parent, pqPipelineModel
   _parent->addChild(child);
   this->endInsertRows();
 
-  // Make sure a pipeline icon exists for this item
-  if (!this->checkAndLoadPipelinePixmap(child->getIconType()))
-  {
-    qWarning() << "Could not find icon pixmap for" << child->getIconType();
-  }
-
   if (row == 0)
   {
     Q_EMIT this->firstChildAdded(parentIndex);
@@ -1046,6 +1226,12 @@ void pqPipelineModel::removeChildFromParent(pqPipelineModelDataItem* child)
     return;
   }
 
+  if (this->beginBulkReset())
+  {
+    _parent->removeChild(child);
+    return;
+  }
+
   QModelIndex parentIndex = this->getIndex(_parent);
   int row = child->getIndexInParent();
 
@@ -1061,7 +1247,7 @@ void pqPipelineModel::serverDataChanged()
   // and invalidate only that one. FOr now, just invalidate all.
 
   int max = this->Internal->Root.Children.size() - 1;
-  if (max >= 0)
+  if (max >= 0 && !this->Internal->InBulkReset)
   {
     QModelIndex minIndex = this->getIndex(this->Internal->Root.Children[0]);
     QModelIndex maxIndex = this->getIndex(this->Internal->Root.Children[max]);
@@ -1072,6 +1258,10 @@ void pqPipelineModel::serverDataChanged()
 //-----------------------------------------------------------------------------
 void pqPipelineModel::itemDataChanged(pqPipelineModelDataItem* item)
 {
+  if (this->Internal->InBulkReset)
+  {
+    return;
+  }
   QModelIndex idx = this->getIndex(item);
   Q_EMIT this->dataChanged(idx, idx);
 }
@@ -1143,6 +1333,8 @@ void pqPipelineModel::addSource(pqPipelineSource* source)
 
   QObject::connect(source, SIGNAL(visibilityChanged(pqPipelineSource*, pqDataRepresentation*)),
     this, SLOT(delayedUpdateVisibility(pqPipelineSource*)));
+  QObject::connect(
+    source, SIGNAL(dataUpdated(pqPipelineSource*)), this, SLOT(updateIconType(pqPipelineSource*)));
 
   QObject::connect(source, SIGNAL(nameChanged(pqServerManagerModelItem*)), this,
     SLOT(updateData(pqServerManagerModelItem*)));
@@ -1153,6 +1345,13 @@ void pqPipelineModel::addSource(pqPipelineSource* source)
 //-----------------------------------------------------------------------------
 void pqPipelineModel::removeSource(pqPipelineSource* source)
 {
+  // the address of a removed source can be reused by a new one, that must not
+  // be mistaken for an already pending update.
+  if (this->Internal->DelayedUpdateVisibilitySources.remove(source))
+  {
+    this->Internal->DelayedUpdateVisibilityItems.removeAll(source);
+  }
+
   pqPipelineModelDataItem* item =
     this->getDataItem(source, &this->Internal->Root, pqPipelineModel::Proxy);
 
@@ -1474,15 +1673,85 @@ void pqPipelineModel::setView(pqView* newview)
     return;
   }
   this->View = newview;
-  // update all VisibilityIcons.
-  this->Internal->Root.updateVisibilityIcon(newview, true);
+  // all VisibilityIcons are computed again when requested.
+  this->Internal->Root.invalidateVisibilityIcon(true);
+  this->visibilityColumnChanged(&this->Internal->Root);
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::visibilityColumnChanged(pqPipelineModelDataItem* item)
+{
+  if (this->Internal->InBulkReset || item->Children.empty())
+  {
+    return;
+  }
+  QModelIndex parentIndex = this->getIndex(item);
+  Q_EMIT this->dataChanged(this->index(0, 1, parentIndex),
+    this->index(item->Children.size() - 1, 1, parentIndex));
+  Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+  {
+    this->visibilityColumnChanged(child);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::beginBulkUpdate()
+{
+  ++this->Internal->BulkUpdateDepth;
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::endBulkUpdate()
+{
+  if (this->Internal->BulkUpdateDepth == 0 || --this->Internal->BulkUpdateDepth > 0)
+  {
+    return;
+  }
+
+  if (this->Internal->InBulkReset)
+  {
+    this->Internal->InBulkReset = false;
+    this->endResetModel();
+    this->notifyChildrenAdded(&this->Internal->Root);
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool pqPipelineModel::beginBulkReset()
+{
+  if (this->Internal->BulkUpdateDepth == 0)
+  {
+    return false;
+  }
+  if (!this->Internal->InBulkReset)
+  {
+    this->beginResetModel();
+    this->Internal->InBulkReset = true;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::notifyChildrenAdded(pqPipelineModelDataItem* item)
+{
+  Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+  {
+    if (!child->Children.empty())
+    {
+      Q_EMIT this->firstChildAdded(this->getIndex(child));
+      this->notifyChildrenAdded(child);
+    }
+  }
 }
 
 //-----------------------------------------------------------------------------
 void pqPipelineModel::delayedUpdateVisibility(pqPipelineSource* source)
 {
-  this->Internal->DelayedUpdateVisibilityItems.removeAll(source);
-  this->Internal->DelayedUpdateVisibilityItems.push_front(source);
+  if (!this->Internal->DelayedUpdateVisibilitySources.contains(source))
+  {
+    this->Internal->DelayedUpdateVisibilitySources.insert(source);
+    this->Internal->DelayedUpdateVisibilityItems.push_back(source);
+  }
   this->Internal->DelayedUpdateVisibilityTimer.start(0);
 }
 
@@ -1497,6 +1766,7 @@ void pqPipelineModel::delayedUpdateVisibilityTimeout()
     }
   }
   this->Internal->DelayedUpdateVisibilityItems.clear();
+  this->Internal->DelayedUpdateVisibilitySources.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -1527,6 +1797,7 @@ void pqPipelineModel::updateData(pqServerManagerModelItem* source, ItemType type
   pqPipelineModelDataItem* item = this->getDataItem(source, &this->Internal->Root, type);
   if (item)
   {
+    item->updateIconType();
     item->updateVisibilityIcon(this->View, false);
     this->itemDataChanged(item);
     Q_FOREACH (pqPipelineModelDataItem* link, item->Links)
@@ -1544,6 +1815,60 @@ void pqPipelineModel::updateData(pqServerManagerModelItem* source, ItemType type
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqPipelineModel::updateIconType(pqPipelineSource* source)
+{
+  pqPipelineModelDataItem* item =
+    this->getDataItem(source, &this->Internal->Root, pqPipelineModel::Proxy);
+  if (!item)
+  {
+    return;
+  }
+
+  // icons not shown yet are computed when they are, nothing to update.
+  bool shown = item->hasIconType();
+  Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+  {
+    shown = shown || (child->Type == pqPipelineModel::Port && child->hasIconType());
+  }
+  if (!shown)
+  {
+    return;
+  }
+
+  // port icons depend on the data information. Rather than gathering it here,
+  // update the icons once it is available.
+  QPointer<pqPipelineSource> guard(source);
+  bool pending = false;
+  Q_FOREACH (pqOutputPort* port, source->getOutputPorts())
+  {
+    port->requestDataInformation(this, [this, guard](vtkPVDataInformation*) {
+      if (guard)
+      {
+        this->updateIconType(guard);
+      }
+    });
+    vtkSMOutputPort* smport = port->getOutputPortProxy();
+    pending = pending || (smport && !smport->IsDataInformationValid());
+  }
+  if (pending)
+  {
+    return;
+  }
+
+  if (item->updateIconType())
+  {
+    this->itemDataChanged(item);
+  }
+  Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+  {
+    if (child->Type == pqPipelineModel::Port && child->updateIconType())
+    {
+      this->itemDataChanged(child);
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqPipelineModel::updateDataServer(pqServer* server)
 {
@@ -1587,7 +1912,7 @@ void pqPipelineModel::disableFilterSession()
 }
 
 //-----------------------------------------------------------------------------
-bool pqPipelineModel::checkAndLoadPipelinePixmap(const QString& iconType)
+bool pqPipelineModel::checkAndLoadPipelinePixmap(const QString& iconType) const
 {
   auto it = this->PixmapMap.find(iconType);
   if (it != this->PixmapMap.end())
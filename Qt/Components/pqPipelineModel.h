@@ -357,6 +357,18 @@ public Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
    */
   void setView(pqView* module);
 
+  ///@{
+  /**
+   * Brackets a large number of changes, e.g. sources added while loading a
+   * state file. Calls may be nested. If the tree changes in between, a single
+   * model reset is reported instead of notifying views of every row inserted
+   * or removed, and `firstChildAdded` is fired for every item with children
+   * when done, so that views expand the tree again.
+   */
+  void beginBulkUpdate();
+  void endBulkUpdate();
+  ///@}
+
 Q_SIGNALS:
   void firstChildAdded(const QModelIndex& index);
   void childWithChildrenAdded(const QModelIndex& index);
@@ -384,6 +396,12 @@ private Q_SLOTS:
   void updateData(pqServerManagerModelItem*, ItemType type = Proxy);
   void updateDataServer(pqServer* server);
 
+  /**
+   * called when the data produced by the source has been updated, which may
+   * change its pipeline icon.
+   */
+  void updateIconType(pqPipelineSource*);
+
 private: // NOLINT(readability-redundant-access-specifiers)
   friend class pqPipelineModelDataItem;
 
@@ -413,6 +431,23 @@ private: // NOLINT(readability-redundant-access-specifiers)
 
   QModelIndex getIndex(pqPipelineModelDataItem* item) const;
 
+  /**
+   * Notifies views that the visibility column changed for the descendants of
+   * the item.
+   */
+  void visibilityColumnChanged(pqPipelineModelDataItem* item);
+
+  /**
+   * Within beginBulkUpdate()/endBulkUpdate(), starts the model reset if not
+   * already done and returns true. Returns false otherwise.
+   */
+  bool beginBulkReset();
+
+  /**
+   * Fires firstChildAdded() for the descendants of the item that have children.
+   */
+  void notifyChildrenAdded(pqPipelineModelDataItem* item);
+
   /**
    * Check the PixmapMap contains a pixmap associated to the provided iconType.
    * Return true if yes.
@@ -420,10 +455,10 @@ private: // NOLINT(readability-redundant-access-specifiers)
    * and add it to the map.
    * Return true if sucessful, false otherwise.
    */
-  bool checkAndLoadPipelinePixmap(const QString& iconType);
+  bool checkAndLoadPipelinePixmap(const QString& iconType) const;
 
-  pqPipelineModelInternal* Internal; ///< Stores the pipeline representation.
-  QMap<QString, QPixmap> PixmapMap;  ///< Stores the item icons.
+  pqPipelineModelInternal* Internal;        ///< Stores the pipeline representation.
+  mutable QMap<QString, QPixmap> PixmapMap; ///< Stores the item icons.
   QPointer<pqView> View;
   bool Editable;
   bool FilterAnnotationMatching;
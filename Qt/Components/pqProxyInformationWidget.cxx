@@ -747,7 +747,12 @@ void pqProxyInformationWidget::updateUI()
 {
   auto& internals = (*this->Internals);
   auto proxy = internals.sourceProxy();
-  auto dinfo = this->dataInformation();
+  // don't gather the data information while updating: show what we have and
+  // update once the fresh information is available.
+  auto port = this->outputPort();
+  auto dinfo = port
+    ? port->requestDataInformation(this, [this](vtkPVDataInformation*) { this->updateUI(); })
+    : nullptr;
   internals.setFileName(proxy);
   internals.setDataGrouping(
     dinfo ? dinfo->GetHierarchy() : nullptr, dinfo ? dinfo->GetDataAssembly() : nullptr);
@@ -763,7 +768,13 @@ void pqProxyInformationWidget::updateSubsetUI()
 
   // all the following depends on subset data information, if the user chose to
   // see only part of the hierarchy.
-  auto subsetInfo = internals.subsetDataInformation();
+  // while data information is pending, subsets cannot be looked up without
+  // gathering; show the stale full information until `updateUI` is called
+  // with the fresh one.
+  auto smport = internals.Port ? internals.Port->getOutputPortProxy() : nullptr;
+  auto subsetInfo = (smport && !smport->IsDataInformationValid())
+    ? smport->GetCachedDataInformation()
+    : internals.subsetDataInformation();
   internals.setDataStatistics(subsetInfo);
   internals.setDataArrays(subsetInfo);
 }
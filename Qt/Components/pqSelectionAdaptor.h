@@ -63,6 +63,13 @@ protected Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
   virtual void currentProxyChanged();
   virtual void proxySelectionChanged();
 
+  /**
+   * called when the Qt-model is reset, which clears the selection in the
+   * Qt-model without notification, to restore it from the ServerManager level
+   * selection.
+   */
+  virtual void modelReset();
+
   /**
    * subclasses can override this method to provide model specific selection
    * overrides such as QItemSelection::Rows or QItemSelection::Columns etc.
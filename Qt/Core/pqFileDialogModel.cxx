@@ -12,6 +12,7 @@
 #include <QLocale>
 #include <QMessageBox>
 #include <QStyle>
+#include <QTimer>
 
 #include <pqApplicationCore.h>
 #include <pqServer.h>
@@ -352,9 +353,10 @@ public:
     return this->GetData(dirListing, this->CurrentPath, path, specialDirs);
   }
 
-  /// query the file system for information
+  /// query the file system for information. When pageSize is not 0, only
+  /// pageSize entries of the directory listing starting at offset are returned.
   vtkPVFileInformation* GetData(bool dirListing, const QString& workingDir, const QString& path,
-    bool specialDirs, bool forceClient = false)
+    bool specialDirs, bool forceClient = false, int offset = 0, int pageSize = 0)
   {
     if (this->FileInformationHelperProxy && !forceClient)
     {
@@ -365,6 +367,8 @@ public:
       pqSMAdaptor::setElementProperty(helper->GetProperty("Path"), path.toUtf8());
       pqSMAdaptor::setElementProperty(helper->GetProperty("SpecialDirectories"), specialDirs);
       pqSMAdaptor::setElementProperty(helper->GetProperty("GroupFileSequences"), this->GroupFiles);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListingOffset"), offset);
+      pqSMAdaptor::setElementProperty(helper->GetProperty("DirectoryListingPageSize"), pageSize);
       helper->UpdateVTKObjects();
 
       // get data from server
@@ -379,6 +383,8 @@ public:
       helper->SetSpecialDirectories(specialDirs);
       helper->SetWorkingDirectory(workingDir.toUtf8().data());
       helper->SetGroupFileSequences(this->GroupFiles);
+      helper->SetDirectoryListingOffset(offset);
+      helper->SetDirectoryListingPageSize(pageSize);
       this->FileInformation->CopyFromObject(helper);
     }
     return this->FileInformation;
@@ -389,7 +395,12 @@ public:
   {
     this->CurrentPath = path;
     this->FileList.clear();
+    this->Append(dir);
+  }
 
+  /// add the contents of a directory listing to our model
+  void Append(vtkPVFileInformation* dir)
+  {
     QList<pqFileDialogModelFileInfo> dirs;
     QList<pqFileDialogModelFileInfo> files;
 
@@ -515,6 +526,17 @@ public:
 
   /// Current path being displayed (server's filesystem).
   QString CurrentPath;
+
+  /// Directory listings are fetched in pages of this many entries, so that
+  /// the first entries of large directories are shown without waiting for
+  /// the complete listing.
+  static constexpr int ListingPageSize = 1000;
+  /// Full path of the directory being listed and offset of the next page to
+  /// fetch, 0 once the listing is complete.
+  QString ListingFullPath;
+  int NextListingOffset = 0;
+  /// Incremented whenever a new listing starts, to drop pages of older ones.
+  unsigned int ListingGeneration = 0;
   /// Caches information about the set of files within the current path.
   QVector<pqFileDialogModelFileInfo> FileList; // adjacent memory occupation for QModelIndex
 
@@ -634,12 +656,57 @@ pqServer* pqFileDialogModel::server() const
 
 void pqFileDialogModel::setCurrentPath(const QString& path)
 {
+  auto& impl = *this->Implementation;
   this->beginResetModel();
-  QString cPath = this->Implementation->cleanPath(path);
+  QString cPath = impl.cleanPath(path);
   vtkPVFileInformation* info;
-  info = this->Implementation->GetData(true, cPath, false);
-  this->Implementation->Update(cPath, info);
+  info = impl.GetData(true, impl.CurrentPath, cPath, false, false, 0, impl.ListingPageSize);
+  impl.Update(cPath, info);
   this->endResetModel();
+
+  // fetch the rest of the listing, if any, once the first page is shown.
+  const unsigned int generation = ++impl.ListingGeneration;
+  impl.ListingFullPath = QString::fromUtf8(info->GetFullPath());
+  impl.NextListingOffset = info->GetNumberOfRemainingEntries() > 0 ? impl.ListingPageSize : 0;
+  if (impl.NextListingOffset > 0)
+  {
+    QTimer::singleShot(0, this, [this, generation]() { this->fetchNextListingPage(generation); });
+  }
+}
+
+void pqFileDialogModel::fetchNextListingPage(unsigned int generation)
+{
+  auto& impl = *this->Implementation;
+  if (generation != impl.ListingGeneration || impl.NextListingOffset <= 0)
+  {
+    return;
+  }
+
+  vtkPVFileInformation* info = impl.GetData(true, impl.ListingFullPath, impl.ListingFullPath,
+    false, false, impl.NextListingOffset, impl.ListingPageSize);
+
+  // rows are simply appended, the view sorts them.
+  QVector<pqFileDialogModelFileInfo> fileList;
+  std::swap(fileList, impl.FileList);
+  impl.Append(info);
+  std::swap(fileList, impl.FileList);
+  if (!fileList.isEmpty())
+  {
+    const int first = impl.FileList.size();
+    this->beginInsertRows(QModelIndex(), first, first + fileList.size() - 1);
+    impl.FileList += fileList;
+    this->endInsertRows();
+  }
+
+  if (info->GetNumberOfRemainingEntries() > 0)
+  {
+    impl.NextListingOffset += impl.ListingPageSize;
+    QTimer::singleShot(0, this, [this, generation]() { this->fetchNextListingPage(generation); });
+  }
+  else
+  {
+    impl.NextListingOffset = 0;
+  }
 }
 
 QString pqFileDialogModel::getCurrentPath()
@@ -740,12 +807,7 @@ bool pqFileDialogModel::mkdir(const QString& dirName)
     ret = (vtkDirectory::MakeDirectory(dirPath.toUtf8().data()) != 0);
   }
 
-  this->beginResetModel();
-  QString cPath = this->Implementation->cleanPath(this->getCurrentPath());
-  vtkPVFileInformation* info;
-  info = this->Implementation->GetData(true, cPath, false);
-  this->Implementation->Update(cPath, info);
-  this->endResetModel();
+  this->setCurrentPath(this->getCurrentPath());
 
   return ret;
 }
@@ -775,12 +837,7 @@ bool pqFileDialogModel::rmdir(const QString& dirName)
     ret = (vtkDirectory::DeleteDirectory(dirPath.toUtf8().data()) != 0);
   }
 
-  this->beginResetModel();
-  QString cPath = this->Implementation->cleanPath(this->getCurrentPath());
-  vtkPVFileInformation* info;
-  info = this->Implementation->GetData(true, cPath, false);
-  this->Implementation->Update(cPath, info);
-  this->endResetModel();
+  this->setCurrentPath(this->getCurrentPath());
 
   return ret;
 }
@@ -830,11 +887,7 @@ bool pqFileDialogModel::rename(const QString& oldname, const QString& newname)
     ret = (vtkDirectory::Rename(oldPath.toUtf8().data(), newPath.toUtf8().data()) != 0);
   }
 
-  this->beginResetModel();
-  QString cPath = this->Implementation->cleanPath(this->getCurrentPath());
-  info = this->Implementation->GetData(true, cPath, false);
-  this->Implementation->Update(cPath, info);
-  this->endResetModel();
+  this->setCurrentPath(this->getCurrentPath());
 
   return ret;
 }
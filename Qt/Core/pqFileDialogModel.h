@@ -185,6 +185,12 @@ public:
   Qt::ItemFlags flags(const QModelIndex& idx) const override;
 
 private:
+  /**
+   * Appends the next page of the directory listing started by
+   * setCurrentPath(), unless another listing started since.
+   */
+  void fetchNextListingPage(unsigned int generation);
+
   class pqImplementation;
   pqImplementation* const Implementation;
 };
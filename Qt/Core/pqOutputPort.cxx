@@ -11,6 +11,8 @@
 
 // Qt Includes.
 #include <QList>
+#include <QPointer>
+#include <QTimer>
 #include <QtDebug>
 
 // ParaView Includes.
@@ -20,11 +22,43 @@
 #include "pqTimeKeeper.h"
 #include "pqView.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Gathers the data information requested through
+// pqOutputPort::requestDataInformation once control returns to the event loop,
+// one port at a time so that events are processed between the gathers.
+void scheduleDataInformationRequests()
+{
+  static bool scheduled = false;
+  if (!scheduled)
+  {
+    scheduled = true;
+    QTimer::singleShot(0, []() {
+      scheduled = false;
+      if (vtkSMOutputPort::ProcessNextDataInformationRequest())
+      {
+        scheduleDataInformationRequests();
+      }
+    });
+  }
+}
+}
+
 class pqOutputPort::pqInternal
 {
 public:
   QList<pqPipelineSource*> Consumers;
   QList<pqDataRepresentation*> Representations;
+
+  // Latest requestDataInformation() callback of each context, while a request
+  // is pending on the port.
+  using ContextCallback =
+    std::pair<QPointer<QObject>, std::function<void(vtkPVDataInformation*)>>;
+  std::vector<ContextCallback> DataInformationCallbacks;
 };
 
 //-----------------------------------------------------------------------------
@@ -81,6 +115,71 @@ vtkPVDataInformation* pqOutputPort::getDataInformation() const
   return source->GetDataInformation(this->PortNumber);
 }
 
+//-----------------------------------------------------------------------------
+vtkPVDataInformation* pqOutputPort::requestDataInformation(
+  QObject* context, std::function<void(vtkPVDataInformation*)> callback) const
+{
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(this->getSource()->getProxy());
+  if (!source)
+  {
+    return nullptr;
+  }
+
+  source->CreateOutputPorts();
+  vtkSMOutputPort* port = this->getOutputPortProxy();
+  if (!port)
+  {
+    return nullptr;
+  }
+  if (port->IsDataInformationValid())
+  {
+    return port->GetDataInformation();
+  }
+
+  if (!context || !callback)
+  {
+    return port->GetCachedDataInformation();
+  }
+
+  // only the latest callback of each context is kept, and the port is requested
+  // once for all of them.
+  auto& callbacks = this->Internal->DataInformationCallbacks;
+  const bool pending = !callbacks.empty();
+  auto iter = std::find_if(callbacks.begin(), callbacks.end(),
+    [context](const pqInternal::ContextCallback& item) { return item.first == context; });
+  if (iter != callbacks.end())
+  {
+    iter->second = std::move(callback);
+  }
+  else
+  {
+    callbacks.emplace_back(context, std::move(callback));
+  }
+
+  if (!pending)
+  {
+    QPointer<pqOutputPort> self(const_cast<pqOutputPort*>(this));
+    port->RequestDataInformation([self](vtkPVDataInformation* dinfo) {
+      if (!self)
+      {
+        return;
+      }
+      // callbacks may request data information again, so swap them out first.
+      std::vector<pqInternal::ContextCallback> current;
+      current.swap(self->Internal->DataInformationCallbacks);
+      for (const auto& item : current)
+      {
+        if (item.first)
+        {
+          item.second(dinfo);
+        }
+      }
+    });
+    scheduleDataInformationRequests();
+  }
+  return port->GetCachedDataInformation();
+}
+
 //-----------------------------------------------------------------------------
 vtkPVDataInformation* pqOutputPort::getRankDataInformation(int rank) const
 {
@@ -7,6 +7,8 @@
 #include "pqCoreModule.h"
 #include "pqProxy.h"
 
+#include <functional> // for std::function
+
 class pqDataRepresentation;
 class pqPipelineSource;
 class pqServer;
@@ -105,6 +107,20 @@ public:
    */
   vtkPVDataInformation* getDataInformation() const;
 
+  /**
+   * Deferred counterpart of getDataInformation(). If the data information is
+   * up-to-date, it is returned and `callback` is not invoked. Otherwise, the
+   * last gathered (possibly stale or empty) data information is returned and
+   * `callback` is invoked with the fresh one after control returns to the
+   * event loop, where it is gathered on the main thread. This still blocks the
+   * user interface while the servers respond, but only for one port at a time.
+   * Requests made in the meantime are coalesced in a single gather per port,
+   * and only the latest `callback` of each `context` is invoked. `callback` is
+   * not invoked if `context` is null or destroyed first.
+   */
+  vtkPVDataInformation* requestDataInformation(
+    QObject* context, std::function<void(vtkPVDataInformation*)> callback) const;
+
   /**
    * Returns rank-specific data information.
    */
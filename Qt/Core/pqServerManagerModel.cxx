@@ -36,6 +36,7 @@
 #include "vtkStringList.h"
 
 // Qt Includes.
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QPointer>
@@ -58,7 +59,46 @@ public:
 
   QList<QPointer<pqServerManagerModelItem>> ItemList;
 
+  // Position of each item in ItemList. Removed items are only cleared from
+  // ItemList, which is compacted once half of its entries are empty, so that
+  // unregistering many proxies does not scan ItemList for every one of them.
+  QHash<pqServerManagerModelItem*, int> ItemIndices;
+  int NumberOfRemovedItems = 0;
+
   pqServerResource ActiveResource;
+
+  void addItem(pqServerManagerModelItem* item)
+  {
+    this->ItemIndices[item] = this->ItemList.size();
+    this->ItemList.push_back(item);
+  }
+
+  void removeItem(pqServerManagerModelItem* item)
+  {
+    auto iter = this->ItemIndices.find(item);
+    if (iter == this->ItemIndices.end())
+    {
+      return;
+    }
+    this->ItemList[iter.value()] = nullptr;
+    this->ItemIndices.erase(iter);
+    if (++this->NumberOfRemovedItems > this->ItemList.size() / 2)
+    {
+      QList<QPointer<pqServerManagerModelItem>> items;
+      items.reserve(this->ItemIndices.size());
+      this->ItemIndices.clear();
+      for (const auto& entry : this->ItemList)
+      {
+        if (entry)
+        {
+          this->ItemIndices[entry] = items.size();
+          items.push_back(entry);
+        }
+      }
+      this->ItemList.swap(items);
+      this->NumberOfRemovedItems = 0;
+    }
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -78,6 +118,10 @@ pqServerManagerModel::pqServerManagerModel(
     observer, SIGNAL(connectionClosed(vtkIdType)), this, SLOT(onConnectionClosed(vtkIdType)));
   QObject::connect(observer, SIGNAL(stateLoaded(vtkPVXMLElement*, vtkSMProxyLocator*)), this,
     SLOT(onStateLoaded(vtkPVXMLElement*, vtkSMProxyLocator*)));
+  QObject::connect(
+    observer, SIGNAL(bulkRegistrationStarted()), this, SIGNAL(bulkRegistrationStarted()));
+  QObject::connect(
+    observer, SIGNAL(bulkRegistrationFinished()), this, SIGNAL(bulkRegistrationFinished()));
 }
 
 //-----------------------------------------------------------------------------
@@ -345,7 +389,7 @@ void pqServerManagerModel::onProxyRegistered(
   }
 
   this->Internal->Proxies[proxy] = item;
-  this->Internal->ItemList.push_back(item);
+  this->Internal->addItem(item);
 
   Q_EMIT this->itemAdded(item);
   Q_EMIT this->proxyAdded(item);
@@ -436,7 +480,7 @@ void pqServerManagerModel::onProxyUnRegistered(
   Q_EMIT this->preItemRemoved(item);
 
   QObject::disconnect(item, nullptr, this, nullptr);
-  this->Internal->ItemList.removeAll(item);
+  this->Internal->removeItem(item);
   this->Internal->Proxies.remove(item->getProxy());
 
   if (view)
@@ -492,7 +536,7 @@ void pqServerManagerModel::onConnectionCreated(vtkIdType id)
   Q_EMIT this->preServerAdded(server);
 
   this->Internal->Servers[id] = server;
-  this->Internal->ItemList.push_back(server);
+  this->Internal->addItem(server);
 
   // Lets the world know when the server name changes.
   this->connect(server, SIGNAL(nameChanged(pqServerManagerModelItem*)), this,
@@ -599,7 +643,7 @@ void pqServerManagerModel::onConnectionClosed(vtkIdType id)
   Q_EMIT this->preItemRemoved(server);
 
   this->Internal->Servers.remove(server->GetConnectionID());
-  this->Internal->ItemList.removeAll(server);
+  this->Internal->removeItem(server);
 
   Q_EMIT this->serverRemoved(server);
   Q_EMIT this->itemRemoved(server);
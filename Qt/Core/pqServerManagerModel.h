@@ -328,6 +328,17 @@ Q_SIGNALS:
    */
   void dataUpdated(pqPipelineSource*);
 
+  ///@{
+  /**
+   * Fired before/after a large number of proxies are registered or
+   * unregistered at once, e.g. when loading a state file. Models built on top
+   * of this one can use these to batch their updates instead of handling each
+   * item added/removed signal on its own.
+   */
+  void bulkRegistrationStarted();
+  void bulkRegistrationFinished();
+  ///@}
+
 protected Q_SLOTS:
   /**
    * Called when a proxy is registered.
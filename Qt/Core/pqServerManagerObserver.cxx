@@ -79,6 +79,12 @@ void pqServerManagerObserver::connectionCreated(vtkObject*, unsigned long, void*
     SLOT(stateLoaded(vtkObject*, unsigned long, void*, void*)));
   this->Internal->VTKConnect->Connect(proxyManager, vtkCommand::SaveStateEvent, this,
     SLOT(stateSaved(vtkObject*, unsigned long, void*, void*)));
+  this->Internal->VTKConnect->Connect(proxyManager,
+    vtkSMSessionProxyManager::BulkRegistrationStartEvent, this,
+    SLOT(bulkRegistrationStarted(vtkObject*, unsigned long, void*, void*)));
+  this->Internal->VTKConnect->Connect(proxyManager,
+    vtkSMSessionProxyManager::BulkRegistrationEndEvent, this,
+    SLOT(bulkRegistrationFinished(vtkObject*, unsigned long, void*, void*)));
   Q_EMIT this->connectionCreated(sessionId);
 }
 
@@ -163,3 +169,15 @@ void pqServerManagerObserver::stateSaved(vtkObject*, unsigned long, void*, void*
     *reinterpret_cast<vtkSMProxyManager::LoadStateInformation*>(callData);
   Q_EMIT this->stateSaved(info.RootElement);
 }
+
+//-----------------------------------------------------------------------------
+void pqServerManagerObserver::bulkRegistrationStarted(vtkObject*, unsigned long, void*, void*)
+{
+  Q_EMIT this->bulkRegistrationStarted();
+}
+
+//-----------------------------------------------------------------------------
+void pqServerManagerObserver::bulkRegistrationFinished(vtkObject*, unsigned long, void*, void*)
+{
+  Q_EMIT this->bulkRegistrationFinished();
+}
@@ -68,6 +68,17 @@ Q_SIGNALS:
    */
   void stateSaved(vtkPVXMLElement* root);
 
+  ///@{
+  /**
+   * Fired when the proxy manager starts/finishes registering or unregistering
+   * a large number of proxies at once, e.g. when loading a state file.
+   * Registration signals fired in between may be handled in a batch.
+   * @sa vtkSMSessionProxyManager::BeginBulkRegistration
+   */
+  void bulkRegistrationStarted();
+  void bulkRegistrationFinished();
+  ///@}
+
 private Q_SLOTS:
   void proxyRegistered(
     vtkObject* object, unsigned long e, void* clientData, void* callData, vtkCommand* command);
@@ -76,6 +87,8 @@ private Q_SLOTS:
   void connectionClosed(vtkObject*, unsigned long, void*, void* callData);
   void stateLoaded(vtkObject*, unsigned long, void*, void* callData);
   void stateSaved(vtkObject*, unsigned long, void*, void* callData);
+  void bulkRegistrationStarted(vtkObject*, unsigned long, void*, void*);
+  void bulkRegistrationFinished(vtkObject*, unsigned long, void*, void*);
 
 protected:
   pqServerManagerObserverInternal* Internal; ///< Stores the pipeline objects.
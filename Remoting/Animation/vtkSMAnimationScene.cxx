@@ -37,6 +37,19 @@ bool vtkSMAnimationScene::GetGlobalUseGeometryCache()
   return vtkSMAnimationScene::GlobalUseGeometryCache;
 }
 
+unsigned long vtkSMAnimationScene::GlobalGeometryCacheLimit = 0;
+//----------------------------------------------------------------------------
+void vtkSMAnimationScene::SetGlobalGeometryCacheLimit(unsigned long val)
+{
+  vtkSMAnimationScene::GlobalGeometryCacheLimit = val;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkSMAnimationScene::GetGlobalGeometryCacheLimit()
+{
+  return vtkSMAnimationScene::GlobalGeometryCacheLimit;
+}
+
 //----------------------------------------------------------------------------
 class vtkSMAnimationScene::vtkInternals
 {
@@ -109,6 +122,18 @@ public:
       iter->GetPointer()->UpdateProperty("UseCache");
     }
   }
+
+  void PassCacheSizeLimit(unsigned long limit)
+  {
+    for (const auto& view : this->ViewModules)
+    {
+      if (view->GetProperty("CacheSizeLimit"))
+      {
+        vtkSMPropertyHelper(view, "CacheSizeLimit").Set(static_cast<unsigned int>(limit));
+        view->UpdateProperty("CacheSizeLimit");
+      }
+    }
+  }
 };
 
 namespace
@@ -459,6 +484,7 @@ void vtkSMAnimationScene::TickInternal(double currenttime, double deltatime, dou
   if (caching_enabled)
   {
     this->Internals->PassUseCache(true);
+    this->Internals->PassCacheSizeLimit(vtkSMAnimationScene::GlobalGeometryCacheLimit);
     this->Internals->PassCacheTime(currenttime);
   }
 
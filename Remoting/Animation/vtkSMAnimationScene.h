@@ -195,6 +195,17 @@ public:
   static bool GetGlobalUseGeometryCache();
   ///@}
 
+  ///@{
+  /**
+   * Set the maximum memory, in kibibytes, used on any process by the geometry
+   * cached for each view when caching is on. When exceeded, the least recently
+   * used timesteps are discarded. 0 (default) means no limit. Typically, one uses
+   * vtkPVGeneralSettings to change this rather than using this API directly.
+   */
+  static void SetGlobalGeometryCacheLimit(unsigned long);
+  static unsigned long GetGlobalGeometryCacheLimit();
+  ///@}
+
 protected:
   vtkSMAnimationScene();
   ~vtkSMAnimationScene() override;
@@ -239,6 +250,7 @@ private:
   unsigned long TimestepValuesObserverID;
 
   static bool GlobalUseGeometryCache;
+  static unsigned long GlobalGeometryCacheLimit;
 };
 
 #endif
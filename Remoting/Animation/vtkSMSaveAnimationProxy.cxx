@@ -10,6 +10,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVXMLElement.h"
@@ -26,8 +27,11 @@
 #include "vtkSMTrace.h"
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
+#include "vtkTimerLog.h"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -87,11 +91,14 @@ protected:
     // since it's a waste of rendering, the code to save the images will call
     // render regardless.
     this->AnimationScene->SetOverrideStillRender(1);
+    this->Timings = FrameTimings();
+    this->Timings.Start = this->Timings.LastFrameEnd = vtkTimerLog::GetUniversalTime();
     return true;
   }
 
   bool SaveFrame(double time) override
   {
+    const double frameStart = vtkTimerLog::GetUniversalTime();
     auto image_pair = Friendship::Grab(this->Helper);
 
     // Now, in symmetric batch mode, while this method will get called on all
@@ -105,12 +112,37 @@ protected:
       return true;
     }
 
-    return this->WriteFrameImage(time, image_pair.first, image_pair.second);
+    const double captureEnd = vtkTimerLog::GetUniversalTime();
+    const bool status = this->WriteFrameImage(time, image_pair.first, image_pair.second);
+    const double frameEnd = vtkTimerLog::GetUniversalTime();
+
+    // "update" is the time spent since the previous frame, i.e. mostly updating
+    // the pipelines for this timestep.
+    const double update = frameStart - this->Timings.LastFrameEnd;
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "Frame %d (time %g): update %.3fs, capture %.3fs, write %.3fs", this->Timings.Count, time,
+      update, captureEnd - frameStart, frameEnd - captureEnd);
+    this->Timings.Add(update, captureEnd - frameStart, frameEnd - captureEnd);
+    this->Timings.LastFrameEnd = frameEnd;
+    return status;
   }
 
   bool SaveFinalize() override
   {
     this->AnimationScene->SetOverrideStillRender(0);
+    if (this->Timings.Count > 0)
+    {
+      // "write" is the time spent on the main thread, i.e. the full encoding time
+      // when writing serially but only the time waiting for a free writer otherwise.
+      const double total = vtkTimerLog::GetUniversalTime() - this->Timings.Start;
+      const double count = this->Timings.Count;
+      vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(),
+        "Saved %d frames in %.3fs (%.3f fps). Per frame average (max): update %.3fs (%.3fs), "
+        "capture %.3fs (%.3fs), write %.3fs (%.3fs)",
+        this->Timings.Count, total, total > 0 ? count / total : 0.0,
+        this->Timings.Sum[0] / count, this->Timings.Max[0], this->Timings.Sum[1] / count,
+        this->Timings.Max[1], this->Timings.Sum[2] / count, this->Timings.Max[2]);
+    }
     return true;
   }
 
@@ -122,6 +154,28 @@ protected:
   }
 
 private:
+  // update, capture and write times of the saved frames, in seconds.
+  struct FrameTimings
+  {
+    int Count = 0;
+    double Sum[3] = { 0, 0, 0 };
+    double Max[3] = { 0, 0, 0 };
+    double Start = 0;
+    double LastFrameEnd = 0;
+
+    void Add(double update, double capture, double write)
+    {
+      const double times[3] = { update, capture, write };
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Sum[cc] += times[cc];
+        this->Max[cc] = std::max(this->Max[cc], times[cc]);
+      }
+      ++this->Count;
+    }
+  };
+  FrameTimings Timings;
+
   SceneImageWriter(const SceneImageWriter&) = delete;
   void operator=(const SceneImageWriter&) = delete;
 };
@@ -235,7 +289,13 @@ vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter
 {
-  vtkSmartPointer<vtkSMSourceProxy> RemoteWriterHelper = nullptr;
+  // Writers are used in turn so that a frame can be encoded and written in the
+  // background while the next ones are updated and captured. Each one is only
+  // reused once the file it was writing is done, which bounds the number of
+  // frames in flight.
+  std::vector<vtkSmartPointer<vtkSMSourceProxy>> RemoteWriterHelpers;
+  std::vector<std::string> PendingFileNames;
+  size_t NextWriter = 0;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -248,11 +308,37 @@ public:
   vtkGetStringMacro(SuffixFormat);
 
   /**
-   * Set format proxy
+   * Set format proxy. When `framesInFlight` is greater than 1 and images are
+   * written on the client, as many copies of the format proxy are used to write
+   * images in the background.
    */
-  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location)
-  {
-    this->RemoteWriterHelper = this->GetRemoteWriterHelper(formatProxy, location);
+  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location, int framesInFlight = 1)
+  {
+    // Only the client can wait for images written in the background.
+    const size_t count =
+      location == vtkPVSession::CLIENT ? static_cast<size_t>(std::max(framesInFlight, 1)) : 1;
+    this->RemoteWriterHelpers.clear();
+    this->RemoteWriterHelpers.push_back(this->GetRemoteWriterHelper(formatProxy, location));
+    auto pxm = formatProxy->GetSessionProxyManager();
+    while (this->RemoteWriterHelpers.size() < count)
+    {
+      auto otherFormatProxy = vtkSmartPointer<vtkSMProxy>::Take(
+        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      otherFormatProxy->SetLocation(formatProxy->GetLocation());
+      otherFormatProxy->Copy(formatProxy);
+      otherFormatProxy->UpdateVTKObjects();
+      this->RemoteWriterHelpers.push_back(this->GetRemoteWriterHelper(otherFormatProxy, location));
+    }
+    if (count > 1)
+    {
+      for (const auto& remoteWriterHelper : this->RemoteWriterHelpers)
+      {
+        vtkSMPropertyHelper(remoteWriterHelper, "TryWritingInBackground").Set(1);
+        remoteWriterHelper->UpdateVTKObjects();
+      }
+    }
+    this->PendingFileNames.assign(count, std::string());
+    this->NextWriter = 0;
   }
 
 protected:
@@ -276,14 +362,8 @@ protected:
   bool WriteFrameImage(
     double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
   {
-    bool success = true;
-
-    const auto remoteWriterHelper = this->RemoteWriterHelper;
-    auto remoteWriterAlgorithm =
-      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
     assert(dataLeft);
     assert(this->SuffixFormat);
-    assert(remoteWriterAlgorithm);
 
     char buffer[1024];
     snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
@@ -292,49 +372,87 @@ protected:
     str << this->Prefix << buffer << this->Extension;
 
     const std::string filename = str.str();
+    bool success = true;
     if (dataRight)
     {
       // write right image.
-      const auto rFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(rFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/false).c_str());
-      rFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataRight);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/false), dataRight);
 
       // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/true).c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/true), dataLeft);
     }
     else
     {
       // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName").Set(filename.c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(filename, dataLeft);
     }
-    remoteWriterAlgorithm->SetInputDataObject(nullptr);
 
-    success &= remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
     this->Counter += success ? this->Stride : 0;
     return success;
   }
 
+  bool SaveFinalize() override
+  {
+    // make sure all the images have been written before returning.
+    bool success = true;
+    for (auto& pendingFileName : this->PendingFileNames)
+    {
+      success &= this->WaitForImage(pendingFileName);
+    }
+    return this->Superclass::SaveFinalize() && success;
+  }
+
+  // Waits for an image written in the background, if any, and reports whether
+  // it could be written.
+  bool WaitForImage(std::string& pendingFileName)
+  {
+    if (pendingFileName.empty())
+    {
+      return true;
+    }
+    const bool success = vtkRemoteWriterHelper::Wait(pendingFileName);
+    if (!success)
+    {
+      vtkErrorMacro("Failed to write '" << pendingFileName << "'.");
+    }
+    pendingFileName.clear();
+    return success;
+  }
+
+  bool WriteImage(const std::string& filename, vtkImageData* data)
+  {
+    const size_t index = this->NextWriter;
+    this->NextWriter = (this->NextWriter + 1) % this->RemoteWriterHelpers.size();
+
+    // wait for the previous image written by this writer, if any, and stop
+    // saving if it could not be written.
+    std::string& pendingFileName = this->PendingFileNames[index];
+    if (!this->WaitForImage(pendingFileName))
+    {
+      return false;
+    }
+
+    const auto remoteWriterHelper = this->RemoteWriterHelpers[index];
+    auto remoteWriterAlgorithm =
+      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
+    assert(remoteWriterAlgorithm);
+
+    const auto format = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
+    vtkSMPropertyHelper(format, "FileName").Set(filename.c_str());
+    format->UpdateVTKObjects();
+    remoteWriterAlgorithm->SetInputDataObject(data);
+    vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
+    remoteWriterHelper->UpdateVTKObjects();
+    remoteWriterHelper->UpdatePipeline();
+    remoteWriterAlgorithm->SetInputDataObject(nullptr);
+
+    if (this->RemoteWriterHelpers.size() > 1)
+    {
+      pendingFileName = filename;
+    }
+    return remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
+  }
+
 private:
   SceneImageWriterImageSeries(const SceneImageWriterImageSeries&) = delete;
   void operator=(const SceneImageWriterImageSeries&) = delete;
@@ -499,7 +617,9 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterImageSeries> realWriter;
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
-    realWriter->SetFormatProxy(formatProxy, location);
+    const int framesInFlight =
+      vtkSMPropertyHelper(this, "NumberOfFramesInFlight", /*quiet*/ true).GetAsInt();
+    realWriter->SetFormatProxy(formatProxy, location, framesInFlight);
     writer = realWriter;
   }
   else if (vtkGenericMovieWriter::SafeDownCast(formatObj))
@@ -35,11 +35,21 @@ s = Sphere()
 s.PhiResolution = 80
 s.ThetaResolution = 80
 
-SaveData(join(rootdir, "sphere-cont.stl"), s, NumberOfIORanks=2, RankAssignmentMode="Contiguous")
+SaveData(join(rootdir, "sphere-cont.stl"), s, NumberOfIORanks=2, RankAssignmentMode="Contiguous",
+         WritePartitionIndexFile=1)
 SaveData(join(rootdir, "sphere-rr.stl"), s, NumberOfIORanks=2, RankAssignmentMode="RoundRobin")
 
 
 Barrier()
+# the partition files are listed in an index written next to them.
+if pm.GetPartitionId() == 0:
+    import json
+    with open(join(rootdir, "sphere-cont.stl.partitions")) as f:
+        index = json.load(f)
+    names = [partition["name"] for partition in index["partitions"]]
+    if names != ["sphere-cont-0.stl", "sphere-cont-1.stl"]:
+        raise smtesting.TestError("Unexpected partition index: %s" % names)
+
 # now read the files and render the result
 
 c0 = OpenDataFile(join(rootdir, "sphere-cont-0.stl"))
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkClientServerStreamPool.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Builds a message similar to a property push.
+static void BuildMessage(vtkClientServerStream& stream, const std::vector<double>& values)
+{
+  stream << vtkClientServerStream::Invoke << "object"
+         << "SetValues"
+         << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+         << vtkClientServerStream::End;
+}
+
+int TestClientServerStreamPool(int, char*[])
+{
+  const std::vector<double> values(64, 1.0);
+
+  // Reset() keeps the memory of reasonably sized streams.
+  vtkClientServerStream stream;
+  BuildMessage(stream, values);
+  stream.Reset();
+  vtkTypeUInt64 allocations = vtkClientServerStream::GetNumberOfAllocations();
+  BuildMessage(stream, values);
+  if (vtkClientServerStream::GetNumberOfAllocations() != allocations ||
+    stream.GetNumberOfMessages() != 1)
+  {
+    std::cerr << "Reset stream should be reused without allocating." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Growing the offsets of the values counts as allocations, even when the data
+  // buffer is large enough.
+  vtkClientServerStream manyValues;
+  manyValues.Reserve(64 * 1024);
+  allocations = vtkClientServerStream::GetNumberOfAllocations();
+  manyValues << vtkClientServerStream::Invoke << "object"
+             << "SetValue";
+  for (int cc = 0; cc < 100; ++cc)
+  {
+    manyValues << cc;
+  }
+  manyValues << vtkClientServerStream::End;
+  if (vtkClientServerStream::GetNumberOfAllocations() == allocations)
+  {
+    std::cerr << "Growing the value offsets should count as allocations." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Streams returned to the pool are recycled, empty.
+  vtkClientServerStreamPool pool(2);
+  {
+    vtkClientServerStreamPool::Pointer pooled = pool.Acquire();
+    BuildMessage(*pooled, values);
+  }
+  if (pool.GetNumberOfIdleStreams() != 1)
+  {
+    std::cerr << "Released stream should be kept by the pool." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  allocations = vtkClientServerStream::GetNumberOfAllocations();
+  for (int cc = 0; cc < 100; ++cc)
+  {
+    vtkClientServerStreamPool::Pointer pooled = pool.Acquire();
+    if (pooled->GetNumberOfMessages() != 0)
+    {
+      std::cerr << "Recycled stream should be empty." << std::endl;
+      return EXIT_FAILURE;
+    }
+    BuildMessage(*pooled, values);
+  }
+  if (vtkClientServerStream::GetNumberOfAllocations() != allocations ||
+    pool.GetNumberOfReuses() != 100 || pool.GetNumberOfAcquisitions() != 101)
+  {
+    std::cerr << "Pooled streams should be reused without allocating." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The pool does not grow beyond its maximum size.
+  {
+    vtkClientServerStreamPool::Pointer a = pool.Acquire();
+    vtkClientServerStreamPool::Pointer b = pool.Acquire();
+    vtkClientServerStreamPool::Pointer c = pool.Acquire();
+  }
+  if (pool.GetNumberOfIdleStreams() != 2)
+  {
+    std::cerr << "Pool should keep at most 2 idle streams." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Large streams release their memory when reset.
+  const size_t limit = vtkClientServerStream::GetRetainedCapacityLimit();
+  vtkClientServerStream::SetRetainedCapacityLimit(1024);
+  const std::vector<double> large(1024, 1.0);
+  BuildMessage(stream, large);
+  stream.Reset();
+  allocations = vtkClientServerStream::GetNumberOfAllocations();
+  BuildMessage(stream, large);
+  vtkClientServerStream::SetRetainedCapacityLimit(limit);
+  if (vtkClientServerStream::GetNumberOfAllocations() == allocations)
+  {
+    std::cerr << "Stream larger than the retained capacity limit should be released."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@
 #include "vtkClientServerInterpreter.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkClientServerStreamPool.h"
 #include "vtkCommand.h"
 #include "vtkDynamicLoader.h"
 #include "vtkObjectFactory.h"
@@ -64,6 +65,7 @@ public:
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+  vtkClientServerStreamPool StreamPool;
 };
 
 //----------------------------------------------------------------------------
@@ -381,7 +383,8 @@ int vtkClientServerInterpreter::ProcessCommandNew(const vtkClientServerStream& c
 int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream& css, int midx)
 {
   // Create a message with all known id_value arguments expanded.
-  vtkClientServerStream msg;
+  vtkClientServerStreamPool::Pointer expanded = this->Internal->StreamPool.Acquire();
+  vtkClientServerStream& msg = *expanded;
   if (!this->ExpandMessage(css, midx, 0, msg))
   {
     // ExpandMessage left an error in the LastResultMessage for us.
@@ -509,7 +512,8 @@ int vtkClientServerInterpreter::ProcessCommandAssign(const vtkClientServerStream
 {
   // Create a message with all known id_value arguments expanded
   // except for the first argument.
-  vtkClientServerStream msg;
+  vtkClientServerStreamPool::Pointer expanded = this->Internal->StreamPool.Acquire();
+  vtkClientServerStream& msg = *expanded;
   if (!this->ExpandMessage(css, midx, 1, msg))
   {
     // ExpandMessage left an error in the LastResultMessage for us.
@@ -980,6 +984,12 @@ void vtkClientServerInterpreter::ClearLastResult()
 {
   this->LastResultMessage->Reset();
 }
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool* vtkClientServerInterpreter::GetStreamPool()
+{
+  return &this->Internal->StreamPool;
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerID vtkClientServerInterpreter::GetNextAvailableId()
 {
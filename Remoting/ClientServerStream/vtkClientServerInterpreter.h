@@ -19,6 +19,7 @@
 class vtkClientServerInterpreter;
 class vtkClientServerInterpreterInternals;
 class vtkClientServerStream;
+class vtkClientServerStreamPool;
 
 /**
  * The type of a command function.  One such function is generated per
@@ -172,6 +173,13 @@ public:
   int Load(const char* moduleName, const char* const* optionalPaths);
   ///@}
 
+  /**
+   * Get the pool of streams used by the interpreter to expand messages.
+   * Code building short-lived streams to process with this interpreter can use
+   * it too, to avoid allocating a new stream every time.
+   */
+  vtkClientServerStreamPool* GetStreamPool();
+
   /**
    * Return the next available Id that can be used to create a new object.
    * This only work if all class that created object into the interpretor have
@@ -13,6 +13,7 @@
 #include "vtkVariantExtract.h"
 
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -226,6 +227,29 @@ public:
   // Buffer for return value from StreamToString.
   std::string String;
 
+  // Statistics and settings shared by all streams.
+  static std::atomic<vtkTypeUInt64> NumberOfAllocations;
+  static std::atomic<size_t> RetainedCapacityLimit;
+
+  // Append a value to one of the vectors above, counting its reallocations.
+  template <typename VectorType>
+  static void Append(VectorType& vector, typename VectorType::value_type value)
+  {
+    const size_t capacity = vector.capacity();
+    vector.push_back(value);
+    if (vector.capacity() != capacity)
+    {
+      ++NumberOfAllocations;
+    }
+  }
+
+  // Number of the buffers of the stream that have memory allocated.
+  int GetNumberOfAllocatedBuffers() const
+  {
+    return (this->Data.capacity() ? 1 : 0) + (this->ValueOffsets.capacity() ? 1 : 0) +
+      (this->MessageIndexes.capacity() ? 1 : 0);
+  }
+
   // Access to protected members of vtkClientServerStream.
   static vtkClientServerStream& Write(vtkClientServerStream& css, const void* data, size_t length)
   {
@@ -240,12 +264,15 @@ public:
 const vtkClientServerStreamInternals::ValueOffsetsType::size_type
   vtkClientServerStreamInternals::InvalidStartIndex =
     static_cast<vtkClientServerStreamInternals::ValueOffsetsType::size_type>(-1);
+std::atomic<vtkTypeUInt64> vtkClientServerStreamInternals::NumberOfAllocations(0);
+std::atomic<size_t> vtkClientServerStreamInternals::RetainedCapacityLimit(64 * 1024);
 
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
 {
   // Initialize the internal representation of the stream.
   this->Internal = new vtkClientServerStreamInternals(owner);
+  ++vtkClientServerStreamInternals::NumberOfAllocations;
   this->Reserve(1024);
   this->Reset();
 }
@@ -261,12 +288,22 @@ vtkClientServerStream::vtkClientServerStream(const vtkClientServerStream& r, vtk
 {
   // Allocate and copy the internal representation of the stream.
   this->Internal = new vtkClientServerStreamInternals(*r.Internal, owner);
+  // One allocation for the state and one for each non-empty buffer.
+  vtkClientServerStreamInternals::NumberOfAllocations +=
+    1 + this->Internal->GetNumberOfAllocatedBuffers();
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator=(const vtkClientServerStream& that)
 {
-  *this->Internal = *that.Internal;
+  auto& internal = *this->Internal;
+  const size_t capacities[3] = { internal.Data.capacity(), internal.ValueOffsets.capacity(),
+    internal.MessageIndexes.capacity() };
+  internal = *that.Internal;
+  vtkClientServerStreamInternals::NumberOfAllocations +=
+    (internal.Data.capacity() != capacities[0] ? 1 : 0) +
+    (internal.ValueOffsets.capacity() != capacities[1] ? 1 : 0) +
+    (internal.MessageIndexes.capacity() != capacities[2] ? 1 : 0);
   return *this;
 }
 
@@ -291,7 +328,12 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
   }
 
   // Copy the value into the data.
+  const size_t capacity = this->Internal->Data.capacity();
   this->Internal->Data.resize(this->Internal->Data.size() + length);
+  if (this->Internal->Data.capacity() != capacity)
+  {
+    ++vtkClientServerStreamInternals::NumberOfAllocations;
+  }
   memcpy(&*(this->Internal->Data.end() - length), data, length);
   return *this;
 }
@@ -299,19 +341,51 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reserve(size_t size)
 {
+  if (size > this->Internal->Data.capacity())
+  {
+    ++vtkClientServerStreamInternals::NumberOfAllocations;
+  }
   this->Internal->Data.reserve(size);
 }
 
 //----------------------------------------------------------------------------
-void vtkClientServerStream::Reset()
+void vtkClientServerStream::SetRetainedCapacityLimit(size_t limit)
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  vtkClientServerStreamInternals::RetainedCapacityLimit = limit;
+}
 
-  this->Internal->ValueOffsets.erase(
-    this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
-  this->Internal->MessageIndexes.erase(
-    this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
+//----------------------------------------------------------------------------
+size_t vtkClientServerStream::GetRetainedCapacityLimit()
+{
+  return vtkClientServerStreamInternals::RetainedCapacityLimit;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerStream::GetNumberOfAllocations()
+{
+  return vtkClientServerStreamInternals::NumberOfAllocations;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStream::Reset()
+{
+  // Empty the entire stream, keeping the memory unless it grew too large.
+  if (this->Internal->Data.capacity() > vtkClientServerStreamInternals::RetainedCapacityLimit)
+  {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+    vtkClientServerStreamInternals::ValueOffsetsType().swap(this->Internal->ValueOffsets);
+  }
+  else
+  {
+    this->Internal->Data.clear();
+    this->Internal->ValueOffsets.clear();
+  }
+  if (this->Internal->Data.capacity() == 0)
+  {
+    // The byte order pushed below allocates.
+    ++vtkClientServerStreamInternals::NumberOfAllocations;
+  }
+  this->Internal->MessageIndexes.clear();
   this->Internal->Objects.Clear();
 
   // No message has yet been started.
@@ -343,7 +417,8 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   this->Internal->StartIndex = this->Internal->ValueOffsets.size();
 
   // The command counts as the first value in the message.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  vtkClientServerStreamInternals::Append(
+    this->Internal->ValueOffsets, this->Internal->Data.end() - this->Internal->Data.begin());
 
   // Store the command in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -366,7 +441,8 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
     }
 
     // Store the value index where this command started.
-    this->Internal->MessageIndexes.push_back(this->Internal->StartIndex);
+    vtkClientServerStreamInternals::Append(
+      this->Internal->MessageIndexes, this->Internal->StartIndex);
 
     // No current Command is being constructed.
     this->Internal->StartIndex = vtkClientServerStreamInternals::InvalidStartIndex;
@@ -374,7 +450,8 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 
   // All values write their type first.  Mark the start of this type
   // and optional value.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  vtkClientServerStreamInternals::Append(
+    this->Internal->ValueOffsets, this->Internal->Data.end() - this->Internal->Data.begin());
 
   // Store the type in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
@@ -387,8 +464,8 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   if (a.Data && a.Size)
   {
     // Mark the start of this type and optional value.
-    this->Internal->ValueOffsets.push_back(
-      this->Internal->Data.end() - this->Internal->Data.begin());
+    vtkClientServerStreamInternals::Append(
+      this->Internal->ValueOffsets, this->Internal->Data.end() - this->Internal->Data.begin());
 
     // If the argument is a vtk_object_pointer, we need to store a
     // reference to the object.
@@ -1488,7 +1565,12 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
   // Store the given data in the stream.
   if (data)
   {
+    const size_t capacity = this->Internal->Data.capacity();
     this->Internal->Data.insert(this->Internal->Data.begin(), data, data + length);
+    if (this->Internal->Data.capacity() != capacity)
+    {
+      ++vtkClientServerStreamInternals::NumberOfAllocations;
+    }
   }
 
   // Parse the stream to fill in ValueOffsets and MessageIndexes and
@@ -1630,7 +1712,7 @@ unsigned char* vtkClientServerStream::ParseCommand(
   // Mark the start of the command.
   this->Internal->StartIndex =
     this->Internal->ValueOffsets.end() - this->Internal->ValueOffsets.begin();
-  this->Internal->ValueOffsets.push_back(data - begin);
+  vtkClientServerStreamInternals::Append(this->Internal->ValueOffsets, data - begin);
 
   // Return the position after the command identifier.
   return data + sizeof(vtkTypeUInt32);
@@ -1640,7 +1722,8 @@ unsigned char* vtkClientServerStream::ParseCommand(
 void vtkClientServerStream::ParseEnd()
 {
   // Record completed message.
-  this->Internal->MessageIndexes.push_back(this->Internal->StartIndex);
+  vtkClientServerStreamInternals::Append(
+    this->Internal->MessageIndexes, this->Internal->StartIndex);
   this->Internal->StartIndex = vtkClientServerStreamInternals::InvalidStartIndex;
 }
 
@@ -1660,7 +1743,7 @@ unsigned char* vtkClientServerStream::ParseType(int order, unsigned char* data,
   *type = static_cast<vtkClientServerStream::Types>(tp);
 
   // Record the start of this type and optional value.
-  this->Internal->ValueOffsets.push_back(data - begin);
+  vtkClientServerStreamInternals::Append(this->Internal->ValueOffsets, data - begin);
 
   // Return the position after the type identifier.
   return data + sizeof(vtkTypeUInt32);
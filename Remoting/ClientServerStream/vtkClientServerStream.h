@@ -99,10 +99,29 @@ public:
   void Reserve(size_t size);
 
   /**
-   * Reset the stream to an empty state.
+   * Reset the stream to an empty state. The memory already allocated for the
+   * stream is kept, so that a stream reused for messages of similar sizes
+   * does not allocate again, unless it exceeds the retained capacity limit.
    */
   void Reset();
 
+  ///@{
+  /**
+   * Set/get the largest buffer size, in bytes, that Reset() keeps allocated.
+   * Streams that grew beyond it release their memory when reset. Default is
+   * 64 KiB.
+   */
+  static void SetRetainedCapacityLimit(size_t limit);
+  static size_t GetRetainedCapacityLimit();
+  ///@}
+
+  /**
+   * Get the number of memory allocations done so far by all streams for their
+   * internal state and data buffers. Useful to check that code paths invoked at
+   * high rates reuse their streams (see vtkClientServerStreamPool).
+   */
+  static vtkTypeUInt64 GetNumberOfAllocations();
+
   /**
    * Copy the stream contents from another stream.
    */
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkClientServerStreamPool.h"
+
+#include "vtkClientServerStream.h"
+
+//----------------------------------------------------------------------------
+void vtkClientServerStreamPool::Releaser::operator()(vtkClientServerStream* stream) const
+{
+  if (this->Pool)
+  {
+    this->Pool->Release(stream);
+  }
+  else
+  {
+    delete stream;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::vtkClientServerStreamPool(size_t maximumSize)
+  : MaximumSize(maximumSize)
+{
+  this->Streams.reserve(maximumSize);
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::~vtkClientServerStreamPool()
+{
+  this->Clear();
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::Pointer vtkClientServerStreamPool::Acquire()
+{
+  ++this->NumberOfAcquisitions;
+  if (this->Streams.empty())
+  {
+    return Pointer(new vtkClientServerStream(), Releaser{ this });
+  }
+  ++this->NumberOfReuses;
+  vtkClientServerStream* stream = this->Streams.back();
+  this->Streams.pop_back();
+  return Pointer(stream, Releaser{ this });
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::Pointer vtkClientServerStreamPool::Acquire(
+  vtkClientServerStreamPool* pool)
+{
+  return pool ? pool->Acquire() : Pointer(new vtkClientServerStream(), Releaser{ nullptr });
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStreamPool::Release(vtkClientServerStream* stream)
+{
+  if (this->Streams.size() < this->MaximumSize)
+  {
+    // Reset now so that objects stored in the stream are not kept around.
+    stream->Reset();
+    this->Streams.push_back(stream);
+  }
+  else
+  {
+    delete stream;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStreamPool::Clear()
+{
+  for (vtkClientServerStream* stream : this->Streams)
+  {
+    delete stream;
+  }
+  this->Streams.clear();
+}
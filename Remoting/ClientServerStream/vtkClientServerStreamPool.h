@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkClientServerStreamPool
+ * @brief   Recycles vtkClientServerStream instances.
+ *
+ * Code that builds a short-lived vtkClientServerStream at a high rate, such as
+ * pushing property values while interacting with a widget, pays for
+ * allocating the stream state and growing its buffers every time.
+ * vtkClientServerStreamPool keeps streams that are no longer used, along with
+ * their memory, and hands them out again:
+ *
+ * @code{cpp}
+ * vtkClientServerStreamPool::Pointer stream = pool.Acquire();
+ * *stream << vtkClientServerStream::Invoke << object << "Method" << value
+ *         << vtkClientServerStream::End;
+ * interpreter->ProcessStream(*stream);
+ * // the stream is reset and returned to the pool when `stream` goes away.
+ * @endcode
+ *
+ * Streams handed out by the pool have no owner, i.e. they do not hold
+ * references to the objects stored in them. The pool is not thread safe and
+ * must outlive the streams acquired from it.
+ */
+
+#ifndef vtkClientServerStreamPool_h
+#define vtkClientServerStreamPool_h
+
+#include "vtkRemotingClientServerStreamModule.h" // for export macro
+#include "vtkType.h"                             // for vtkTypeUInt64
+
+#include <memory> // for std::unique_ptr
+#include <vector> // for std::vector
+
+class vtkClientServerStream;
+
+class VTKREMOTINGCLIENTSERVERSTREAM_EXPORT vtkClientServerStreamPool
+{
+public:
+  /**
+   * Returns streams to the pool they were acquired from, or deletes them when
+   * there is no pool.
+   */
+  struct Releaser
+  {
+    vtkClientServerStreamPool* Pool;
+    void operator()(vtkClientServerStream* stream) const;
+  };
+  using Pointer = std::unique_ptr<vtkClientServerStream, Releaser>;
+
+  /**
+   * `maximumSize` is the number of idle streams kept by the pool; streams
+   * released while the pool is full are deleted.
+   */
+  vtkClientServerStreamPool(size_t maximumSize = 8);
+  ~vtkClientServerStreamPool();
+
+  /**
+   * Get an empty stream, recycled if possible.
+   */
+  Pointer Acquire();
+
+  /**
+   * Get an empty stream from `pool`, or a new stream if `pool` is nullptr.
+   */
+  static Pointer Acquire(vtkClientServerStreamPool* pool);
+
+  /**
+   * Delete all idle streams.
+   */
+  void Clear();
+
+  /**
+   * Get the number of idle streams held by the pool.
+   */
+  size_t GetNumberOfIdleStreams() const { return this->Streams.size(); }
+
+  ///@{
+  /**
+   * Get the number of streams acquired from the pool, and how many of those
+   * were recycled rather than newly created.
+   */
+  vtkTypeUInt64 GetNumberOfAcquisitions() const { return this->NumberOfAcquisitions; }
+  vtkTypeUInt64 GetNumberOfReuses() const { return this->NumberOfReuses; }
+  ///@}
+
+private:
+  vtkClientServerStreamPool(const vtkClientServerStreamPool&) = delete;
+  void operator=(const vtkClientServerStreamPool&) = delete;
+
+  void Release(vtkClientServerStream* stream);
+
+  std::vector<vtkClientServerStream*> Streams;
+  size_t MaximumSize;
+  vtkTypeUInt64 NumberOfAcquisitions = 0;
+  vtkTypeUInt64 NumberOfReuses = 0;
+};
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkClientServerStreamPool.h
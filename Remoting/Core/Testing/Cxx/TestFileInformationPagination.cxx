@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCollection.h"
+#include "vtkNew.h"
+#include "vtkPVFileInformation.h"
+#include "vtkPVFileInformationHelper.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Returns the names of the entries listed by `helper`, and the number of
+// remaining entries in `remaining`.
+std::vector<std::string> List(vtkPVFileInformationHelper* helper, int& remaining)
+{
+  vtkNew<vtkPVFileInformation> info;
+  info->CopyFromObject(helper);
+  std::vector<std::string> names;
+  vtkCollection* contents = info->GetContents();
+  for (int cc = 0; cc < contents->GetNumberOfItems(); ++cc)
+  {
+    names.push_back(
+      vtkPVFileInformation::SafeDownCast(contents->GetItemAsObject(cc))->GetName());
+  }
+  remaining = info->GetNumberOfRemainingEntries();
+  return names;
+}
+}
+
+// Checks that the pages of a paginated directory listing, whatever the order
+// they are requested in, are the slices of the complete listing.
+int TestFileInformationPagination(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string directory = std::string(tempDir) + "/TestFileInformationPagination";
+  delete[] tempDir;
+
+  vtksys::SystemTools::RemoveADirectory(directory);
+  vtksys::SystemTools::MakeDirectory(directory);
+  for (const char* name : { "dir_b", "Dir_a", "dir_c" })
+  {
+    vtksys::SystemTools::MakeDirectory(directory + "/" + name);
+  }
+  for (const char* name :
+    { "notes.txt", "File1.txt", "data_z.csv", "seq_1.vtk", "seq_2.vtk", "a.vtu", "e.vtp" })
+  {
+    vtksys::SystemTools::Touch(directory + "/" + name, true);
+  }
+
+  vtkNew<vtkPVFileInformationHelper> helper;
+  helper->SetPath(directory.c_str());
+  helper->SetDirectoryListing(1);
+  helper->SetReadDetailedFileInformation(true);
+
+  int remaining = 0;
+  const std::vector<std::string> expected = List(helper, remaining);
+  // the file sequence is grouped into a single entry.
+  const std::vector<std::string> directories = { "Dir_a", "dir_b", "dir_c" };
+  if (expected.size() != 9 || remaining != 0 ||
+    !std::equal(directories.begin(), directories.end(), expected.begin()))
+  {
+    std::cerr << "Unexpected complete listing of " << expected.size() << " entries." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // pages read in order, then skipping pages, then going back.
+  const int pageSize = 2;
+  helper->SetDirectoryListingPageSize(pageSize);
+  for (const int offset : { 0, 2, 4, 6, 8, 0, 6, 2, 8, 4, 12 })
+  {
+    helper->SetDirectoryListingOffset(offset);
+    const std::vector<std::string> page = List(helper, remaining);
+    const size_t begin = std::min(expected.size(), static_cast<size_t>(offset));
+    const size_t end = std::min(expected.size(), begin + pageSize);
+    const std::vector<std::string> expectedPage(expected.begin() + begin, expected.begin() + end);
+    if (page != expectedPage || remaining != static_cast<int>(expected.size() - end))
+    {
+      std::cerr << "Unexpected page at offset " << offset << ": " << page.size() << " entries, "
+                << remaining << " remaining." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtksys::SystemTools::RemoveADirectory(directory);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDummyController.h"
+#include "vtkLogRecorder.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVLogInformation.h"
+#include "vtkPVLogTimelineWriter.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Phases of the recorded trace events, in order.
+std::string GetPhases(vtkLogRecorder* recorder)
+{
+  std::istringstream stream(recorder->GetTraceEvents());
+  std::string phases;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    double time;
+    char phase;
+    std::istringstream fields(line);
+    if (fields >> time >> phase)
+    {
+      phases += phase;
+    }
+  }
+  return phases;
+}
+
+std::size_t Count(const std::string& text, const std::string& pattern)
+{
+  std::size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+void LogScope(const char* name, int numberOfMessages)
+{
+  vtkLogScopeF(TRACE, "%s", name);
+  for (int cc = 0; cc < numberOfMessages; ++cc)
+  {
+    vtkLogF(TRACE, "message %d", cc);
+  }
+}
+}
+
+// Checks that vtkLogRecorder records log scopes as matched begin/end trace
+// events, also when its buffer is full, and that vtkPVLogTimelineWriter writes
+// them as such.
+int TestPVLogTimelineWriter(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkNew<vtkLogRecorder> recorder;
+  recorder->SetVerbosity(vtkLogger::VERBOSITY_TRACE);
+  recorder->SetTraceEnabled(true);
+  LogScope("timeline scope", 1);
+  recorder->SetTraceEnabled(false);
+
+  if (GetPhases(recorder) != "BiE")
+  {
+    vtkLogF(ERROR, "Unexpected trace event phases '%s'.", GetPhases(recorder).c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPVLogInformation> info;
+  info->SetCollectTrace(true);
+  info->CopyFromObject(recorder);
+  vtkNew<vtkPVLogTimelineWriter> writer;
+  writer->AddProcess("Client", info);
+  const std::string timeline = writer->GetTimeline();
+  if (Count(timeline, "\"ph\":\"B\"") != 1 || Count(timeline, "\"ph\":\"E\"") != 1 ||
+    Count(timeline, "\"name\":\"timeline scope\"") != 1)
+  {
+    vtkLogF(ERROR, "Expected a single matched scope in:\n%s", timeline.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // When the buffer is full, events are dropped but the end of a kept scope is
+  // still recorded.
+  recorder->ClearTraceEvents();
+  recorder->SetMaximumNumberOfTraceEvents(1);
+  recorder->SetTraceEnabled(true);
+  {
+    vtkLogScopeF(TRACE, "outer scope");
+    LogScope("inner scope", 2);
+  }
+  recorder->SetTraceEnabled(false);
+
+  if (GetPhases(recorder) != "BE" || recorder->GetNumberOfDroppedTraceEvents() != 4)
+  {
+    vtkLogF(ERROR, "Unexpected trace event phases '%s' with %lld dropped events.",
+      GetPhases(recorder).c_str(),
+      static_cast<long long>(recorder->GetNumberOfDroppedTraceEvents()));
+    return EXIT_FAILURE;
+  }
+
+  // Messages more verbose than the recording verbosity are not recorded.
+  recorder->ClearTraceEvents();
+  recorder->SetVerbosity(vtkLogger::VERBOSITY_INFO);
+  recorder->SetTraceEnabled(true);
+  LogScope("verbose scope", 1);
+  recorder->SetTraceEnabled(false);
+  if (!GetPhases(recorder).empty())
+  {
+    vtkLogF(ERROR, "Unexpected trace events '%s' above the recording verbosity.",
+      GetPhases(recorder).c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
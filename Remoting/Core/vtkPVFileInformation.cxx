@@ -11,6 +11,7 @@
 #include "vtkPVFileInformationHelper.h"
 #include "vtkProcessModule.h"
 #include "vtkResourceFileLocator.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkVersion.h"
 
@@ -41,6 +42,7 @@
 #include <ctime>
 #include <set>
 #include <string>
+#include <vector>
 #include <vtksys/Encoding.hxx>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
@@ -358,6 +360,7 @@ vtkPVFileInformation::vtkPVFileInformation()
   this->Size = 0;
   this->GroupFileSequences = true;
   this->IncludeExamples = true;
+  this->NumberOfRemainingEntries = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(nullptr);
 #else
@@ -457,7 +460,14 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
 
   if (this->IsDirectory(this->Type) && helper->GetDirectoryListing())
   {
-    this->FetchDirectoryListing();
+    if (helper->GetDirectoryListingPageSize() > 0)
+    {
+      this->FetchDirectoryListingPage(helper);
+    }
+    else
+    {
+      this->FetchDirectoryListing();
+    }
   }
 }
 
@@ -873,8 +883,39 @@ void vtkPVFileInformation::FetchUnixDirectoryListing()
 #if defined(_WIN32)
   vtkErrorMacro("FetchUnixDirectoryListing() cannot be called on Windows systems.");
 #else
+  std::vector<vtkSmartPointer<vtkPVFileInformation>> contents;
+  this->ListUnixDirectory(contents);
+
+  // Sort the contents the way the file dialog shows them.
+  std::sort(contents.begin(), contents.end(), vtkPVFileInformation::IsListedBefore);
+  for (vtkPVFileInformation* obj : contents)
+  {
+    this->Contents->AddItem(obj);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVFileInformation::IsListedBefore(vtkPVFileInformation* a, vtkPVFileInformation* b)
+{
+  const bool aIsDir = a->IsDirectory() || a->Type == DIRECTORY_GROUP;
+  const bool bIsDir = b->IsDirectory() || b->Type == DIRECTORY_GROUP;
+  if (aIsDir != bIsDir)
+  {
+    return aIsDir;
+  }
+  return vtksys::SystemTools::Strucmp(a->Name, b->Name) < 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::ListUnixDirectory(
+  std::vector<vtkSmartPointer<vtkPVFileInformation>>& contents)
+{
+#if defined(_WIN32)
+  (void)contents;
+  vtkErrorMacro("ListUnixDirectory() cannot be called on Windows systems.");
+#else
 
-  vtkPVFileInformationSet info_set;
   std::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
@@ -886,7 +927,9 @@ void vtkPVFileInformation::FetchUnixDirectoryListing()
     return;
   }
 
-  // Loop through the directory listing.
+  // Loop through the directory listing. Only names are read here, the type of
+  // the entries being known from the directory itself on most file systems.
+  std::vector<vtkSmartPointer<vtkPVFileInformation>> entries;
   while (const dirent* d = readdir(dir))
   {
     // Skip the special directory entries.
@@ -894,83 +937,198 @@ void vtkPVFileInformation::FetchUnixDirectoryListing()
     {
       continue;
     }
-    vtkPVFileInformation* info = vtkPVFileInformation::New();
+    auto info = vtkSmartPointer<vtkPVFileInformation>::New();
     info->SetName(d->d_name);
     info->SetFullPath((prefix + d->d_name).c_str());
     info->Type = INVALID;
     info->SetHiddenFlag();
-
-    vtksys::SystemTools::Stat_t status;
-    int res;
-    if (this->ReadDetailedFileInformation)
-    {
-      // Recover status info
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-      if (res != -1)
-      {
-        if (!S_ISDIR(status.st_mode))
-        {
-          std::string::size_type pos = std::string(d->d_name).rfind('.');
-          if (pos != std::string::npos)
-          {
-            std::string ext = std::string(d->d_name).substr(pos + 1);
-            info->SetExtension(ext.c_str());
-          }
-        }
-        info->Size = status.st_size;
-        info->ModificationTime = status.st_mtime;
-      }
-    }
 // fix to bug #09452 such that directories with trailing names can be
-// shown in the file dialog
-#if defined(__SVR4) && defined(__sun)
-    if (!this->ReadDetailedFileInformation)
-    {
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-    }
-    if (res != -1 && status.st_mode & S_IFDIR)
+// shown in the file dialog: d_type is not available there, the type is
+// detected using stat below.
+#if !(defined(__SVR4) && defined(__sun))
+    if (d->d_type == DT_DIR)
     {
       info->Type = DIRECTORY;
     }
-#else
-    if (d->d_type & DT_DIR)
+    else if (d->d_type == DT_REG)
     {
-      info->Type = DIRECTORY;
+      info->Type = SINGLE_FILE;
     }
 #endif
-
     info->FastFileTypeDetection = this->FastFileTypeDetection;
-    info_set.insert(info);
-    info->Delete();
+    entries.push_back(info);
   }
   closedir(dir);
 
+  // Each stat call is a round-trip to the metadata server on network file
+  // systems, so links, entries of unknown type and the detailed information
+  // are processed concurrently.
+  const bool detailed = this->ReadDetailedFileInformation;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(entries.size()),
+    [&entries, detailed](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        vtkPVFileInformation* info = entries[cc];
+        if (detailed)
+        {
+          info->ReadDetailedInformation();
+        }
+        if (info->Type == INVALID)
+        {
+          info->DetectType();
+        }
+      }
+    });
+
+  vtkPVFileInformationSet info_set;
+  for (const auto& info : entries)
+  {
+    // entries that disappeared or are dangling links are skipped.
+    if (info->Type != INVALID)
+    {
+      info_set.insert(info);
+    }
+  }
+  entries.clear();
+
   this->OrganizeCollection(info_set);
 
   // Now we detect the file types for items.
   // We dissolve any groups that contain non-file items.
-
   for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end(); ++iter)
   {
     vtkPVFileInformation* obj = (*iter);
     if (obj->DetectType())
     {
-      this->Contents->AddItem(obj);
+      contents.push_back(obj);
     }
     else
     {
       // Add children to contents.
-      for (int cc = 0; cc < obj->Contents->GetNumberOfItems(); cc++)
+      vtkCollectionSimpleIterator childIter;
+      obj->Contents->InitTraversal(childIter);
+      while (vtkObject* item = obj->Contents->GetNextItemAsObject(childIter))
       {
-        vtkPVFileInformation* child =
-          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(cc));
+        vtkPVFileInformation* child = vtkPVFileInformation::SafeDownCast(item);
         if (child->DetectType())
         {
-          this->Contents->AddItem(child);
+          contents.push_back(child);
         }
       }
     }
   }
+
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::ReadDetailedInformation()
+{
+#if !defined(_WIN32)
+  vtksys::SystemTools::Stat_t status;
+  if (vtksys::SystemTools::Stat(this->FullPath, &status) != -1)
+  {
+    if (!S_ISDIR(status.st_mode))
+    {
+      std::string::size_type pos = std::string(this->Name).rfind('.');
+      if (pos != std::string::npos)
+      {
+        std::string ext = std::string(this->Name).substr(pos + 1);
+        this->SetExtension(ext.c_str());
+      }
+    }
+    this->Size = status.st_size;
+    this->ModificationTime = status.st_mtime;
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVFileInformation::FetchDirectoryListingPage(vtkPVFileInformationHelper* helper)
+{
+  const int offset = helper->GetDirectoryListingOffset();
+  const int pageSize = helper->GetDirectoryListingPageSize();
+
+  // The complete listing, without detailed information, is cached by the
+  // helper and only read again when the first page is requested.
+  vtkPVFileInformation* listing = helper->CachedDirectoryListing;
+  auto& entries = helper->CachedDirectoryEntries;
+  if (offset == 0 || !listing || strcmp(listing->FullPath, this->FullPath) != 0 ||
+    listing->GroupFileSequences != this->GroupFileSequences)
+  {
+    auto newListing = vtkSmartPointer<vtkPVFileInformation>::New();
+    newListing->SetName(this->Name);
+    newListing->SetFullPath(this->FullPath);
+    newListing->Type = this->Type;
+    newListing->FastFileTypeDetection = this->FastFileTypeDetection;
+    newListing->GroupFileSequences = this->GroupFileSequences;
+    newListing->ReadDetailedFileInformation = false;
+    entries.clear();
+#if defined(_WIN32)
+    // the Windows listing is sorted by the file system.
+    newListing->FetchWindowsDirectoryListing();
+    vtkCollectionSimpleIterator iter;
+    newListing->Contents->InitTraversal(iter);
+    while (vtkObject* item = newListing->Contents->GetNextItemAsObject(iter))
+    {
+      entries.push_back(vtkPVFileInformation::SafeDownCast(item));
+    }
+    helper->NumberOfSortedEntries = entries.size();
+#else
+    // the entries are sorted as the pages are requested, so that the first
+    // page of a large directory does not wait for the whole listing to be
+    // sorted.
+    newListing->ListUnixDirectory(entries);
+    helper->NumberOfSortedEntries = 0;
+#endif
+    helper->CachedDirectoryListing = newListing;
+  }
+
+  const size_t numberOfEntries = entries.size();
+  const size_t begin = std::min(numberOfEntries, static_cast<size_t>(offset));
+  const size_t end = std::min(numberOfEntries - begin, static_cast<size_t>(pageSize)) + begin;
+  if (end > helper->NumberOfSortedEntries)
+  {
+    std::partial_sort(entries.begin() + helper->NumberOfSortedEntries, entries.begin() + end,
+      entries.end(), [](const vtkSmartPointer<vtkPVFileInformation>& a,
+                       const vtkSmartPointer<vtkPVFileInformation>& b)
+      { return vtkPVFileInformation::IsListedBefore(a, b); });
+    helper->NumberOfSortedEntries = end;
+  }
+
+  // Copy the requested page, gathering the files whose details are needed.
+  std::vector<vtkPVFileInformation*> details;
+  for (size_t cc = begin; cc < end; ++cc)
+  {
+    vtkPVFileInformation* obj = entries[cc];
+    this->Contents->AddItem(obj);
+    details.push_back(obj);
+    vtkCollectionSimpleIterator childIter;
+    obj->Contents->InitTraversal(childIter);
+    while (vtkObject* child = obj->Contents->GetNextItemAsObject(childIter))
+    {
+      details.push_back(vtkPVFileInformation::SafeDownCast(child));
+    }
+  }
+  this->NumberOfRemainingEntries = static_cast<int>(numberOfEntries - end);
+
+#if !defined(_WIN32)
+  // the Windows listing provides the detailed information for free.
+  if (this->ReadDetailedFileInformation)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(details.size()),
+      [&details](vtkIdType begin, vtkIdType last)
+      {
+        for (vtkIdType cc = begin; cc < last; ++cc)
+        {
+          if (!details[cc]->IsGroup())
+          {
+            details[cc]->ReadDetailedInformation();
+          }
+        }
+      });
+  }
 #endif
 }
 
@@ -1138,7 +1296,7 @@ void vtkPVFileInformation::CopyToStream(vtkClientServerStream* stream)
 {
   *stream << vtkClientServerStream::Reply << this->Name << this->FullPath << this->Type
           << this->Hidden << this->Contents->GetNumberOfItems() << this->Extension << this->Size
-          << this->ModificationTime;
+          << this->ModificationTime << this->NumberOfRemainingEntries;
 
   vtkSmartPointer<vtkCollectionIterator> iter;
   iter.TakeReference(this->Contents->NewIterator());
@@ -1205,11 +1363,16 @@ void vtkPVFileInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing File extension.");
     return;
   }
+  if (!css->GetArgument(0, 8, &this->NumberOfRemainingEntries))
+  {
+    vtkErrorMacro("Error parsing Number of remaining entries.");
+    return;
+  }
   for (int cc = 0; cc < num_of_children; cc++)
   {
     vtkPVFileInformation* child = vtkPVFileInformation::New();
     vtkClientServerStream childStream;
-    if (!css->GetArgument(0, 8 + cc, &childStream))
+    if (!css->GetArgument(0, 9 + cc, &childStream))
     {
       vtkErrorMacro("Error parsing child #" << cc);
       return;
@@ -1231,6 +1394,7 @@ void vtkPVFileInformation::Initialize()
   this->SetExtension(nullptr);
   this->Size = 0;
   this->GroupFileSequences = true;
+  this->NumberOfRemainingEntries = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(nullptr);
 #else
@@ -1308,6 +1472,7 @@ void vtkPVFileInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Hidden: " << this->Hidden << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "NumberOfRemainingEntries: " << this->NumberOfRemainingEntries << endl;
 
   for (int cc = 0; cc < this->Contents->GetNumberOfItems(); cc++)
   {
@@ -17,10 +17,13 @@
 
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
+#include "vtkSmartPointer.h"       // Needed for vtkSmartPointer
 
 #include <string> // Needed for std::string
+#include <vector> // Needed for std::vector
 
 class vtkCollection;
+class vtkPVFileInformationHelper;
 class vtkPVFileInformationSet;
 class vtkFileSequenceParser;
 
@@ -156,6 +159,14 @@ public:
    */
   void FetchDirectoryListing();
 
+  /**
+   * When the directory listing was paginated (see
+   * vtkPVFileInformationHelper::SetDirectoryListingPageSize()), returns the
+   * number of entries of the listing that come after the ones in the
+   * contents. 0 otherwise.
+   */
+  vtkGetMacro(NumberOfRemainingEntries, int);
+
   /**
    * Returns the path to the base data directory path holding various files
    * packaged with ParaView.
@@ -199,6 +210,20 @@ protected:
   void FetchWindowsDirectoryListing();
   void FetchUnixDirectoryListing();
 
+  // Lists the entries of the directory, with file sequences grouped, in no
+  // particular order.
+  void ListUnixDirectory(std::vector<vtkSmartPointer<vtkPVFileInformation>>& contents);
+
+  // Order of the entries of a directory listing: directories first, then by name.
+  static bool IsListedBefore(vtkPVFileInformation* a, vtkPVFileInformation* b);
+
+  // Fills the contents with a page of the listing cached by the helper. The
+  // cached entries are only sorted as far as the pages requested so far.
+  void FetchDirectoryListingPage(vtkPVFileInformationHelper* helper);
+
+  // Reads the extension, size and modification time of the file.
+  void ReadDetailedInformation();
+
   // Goes thru the collection of vtkPVFileInformation objects
   // are creates file groups, if possible.
   void OrganizeCollection(vtkPVFileInformationSet& vector);
@@ -210,6 +235,7 @@ protected:
   bool ReadDetailedFileInformation;
   bool GroupFileSequences;
   bool IncludeExamples;
+  int NumberOfRemainingEntries;
 
 private:
   vtkPVFileInformation(const vtkPVFileInformation&) = delete;
@@ -3,6 +3,7 @@
 #include "vtkPVFileInformationHelper.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkPVFileInformation.h"
 
 #if defined(_WIN32)
 #include <wchar.h>
@@ -57,4 +58,6 @@ void vtkPVFileInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PathSeparator: " << (this->PathSeparator ? this->PathSeparator : "(null)")
      << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "DirectoryListingOffset: " << this->DirectoryListingOffset << endl;
+  os << indent << "DirectoryListingPageSize: " << this->DirectoryListingPageSize << endl;
 }
@@ -18,8 +18,12 @@
 
 #include "vtkObject.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
+#include "vtkSmartPointer.h"       // needed for vtkSmartPointer
 
 #include <string> // needed for std::string
+#include <vector> // needed for std::vector
+
+class vtkPVFileInformation;
 
 class VTKREMOTINGCORE_EXPORT vtkPVFileInformationHelper : public vtkObject
 {
@@ -137,6 +141,25 @@ public:
   vtkSetMacro(ReadDetailedFileInformation, bool);
   ///@}
 
+  ///@{
+  /**
+   * Paginate the directory listing. When DirectoryListingPageSize is greater
+   * than 0, only DirectoryListingPageSize entries of the listing, starting at
+   * DirectoryListingOffset, are returned and
+   * vtkPVFileInformation::GetNumberOfRemainingEntries() tells how many are
+   * left. The listing is cached by this helper so that the directory is only
+   * read again when the first page (offset 0) is requested, and the detailed
+   * information is only read for the entries of the page. Entries are only
+   * sorted as far as the requested page, so that the first page of a large
+   * directory is returned without sorting the whole listing.
+   * Both default to 0 i.e. the complete listing is returned at once.
+   */
+  vtkSetClampMacro(DirectoryListingOffset, int, 0, VTK_INT_MAX);
+  vtkGetMacro(DirectoryListingOffset, int);
+  vtkSetClampMacro(DirectoryListingPageSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(DirectoryListingPageSize, int);
+  ///@}
+
 protected:
   vtkPVFileInformationHelper();
   ~vtkPVFileInformationHelper() override;
@@ -153,10 +176,19 @@ protected:
 
   bool ReadDetailedFileInformation = false;
   char* PathSeparator = nullptr;
+  int DirectoryListingOffset = 0;
+  int DirectoryListingPageSize = 0;
 
 private:
   vtkPVFileInformationHelper(const vtkPVFileInformationHelper&) = delete;
   void operator=(const vtkPVFileInformationHelper&) = delete;
+
+  friend class vtkPVFileInformation;
+  vtkSmartPointer<vtkPVFileInformation> CachedDirectoryListing;
+  // Entries of the directory of CachedDirectoryListing, the first
+  // NumberOfSortedEntries being the first ones of the listing, in order.
+  std::vector<vtkSmartPointer<vtkPVFileInformation>> CachedDirectoryEntries;
+  size_t NumberOfSortedEntries = 0;
 };
 
 #endif
@@ -20,6 +20,9 @@ void vtkPVLogInformation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Logs: " << this->Logs << endl;
   os << indent << "Starting Logs: " << this->StartingLogs << endl;
   os << indent << "Verbosity" << this->Verbosity << endl;
+  os << indent << "CollectTrace: " << this->CollectTrace << endl;
+  os << indent << "TraceTime: " << this->TraceTime << endl;
+  os << indent << "TraceEvents: " << this->TraceEvents.size() << " ranks" << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -43,6 +46,14 @@ void vtkPVLogInformation::CopyFromObject(vtkObject* obj)
       this->StartingLogs = logRecorder->GetStartingLog();
     }
     this->Verbosity = vtkLogger::GetCurrentVerbosityCutoff();
+    if (this->CollectTrace)
+    {
+      this->TraceEvents[logRecorder->GetMyRank()] = logRecorder->GetTraceEvents();
+    }
+    if (logRecorder->GetMyRank() == 0)
+    {
+      this->TraceTime = logRecorder->GetTraceTime();
+    }
   }
 }
 
@@ -57,6 +68,14 @@ void vtkPVLogInformation::AddInformation(vtkPVInformation* info)
     {
       this->Verbosity = vtkPVLogInformation::SafeDownCast(info)->Verbosity;
     }
+    for (const auto& item : vtkPVLogInformation::SafeDownCast(info)->TraceEvents)
+    {
+      this->TraceEvents[item.first] += item.second;
+    }
+    if (this->TraceTime == 0.0)
+    {
+      this->TraceTime = vtkPVLogInformation::SafeDownCast(info)->TraceTime;
+    }
   }
 }
 
@@ -66,19 +85,33 @@ void vtkPVLogInformation::CopyFromStream(const vtkClientServerStream* css)
   css->GetArgument(0, 0, &Logs);
   css->GetArgument(0, 1, &StartingLogs);
   css->GetArgument(0, 2, &Verbosity);
+  css->GetArgument(0, 3, &TraceTime);
+
+  this->TraceEvents.clear();
+  int numRanks = 0;
+  css->GetArgument(0, 4, &numRanks);
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    int rank = 0;
+    std::string events;
+    if (css->GetArgument(0, 5 + 2 * cc, &rank) && css->GetArgument(0, 6 + 2 * cc, &events))
+    {
+      this->TraceEvents[rank] = std::move(events);
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVLogInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 557499 << this->Rank;
+  str << 557499 << this->Rank << this->CollectTrace;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVLogInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->Rank;
+  str >> magic_number >> this->Rank >> this->CollectTrace;
   if (magic_number != 557499)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -90,5 +123,10 @@ void vtkPVLogInformation::CopyToStream(vtkClientServerStream* css)
 {
   css->Reset();
   *css << vtkClientServerStream::Reply << this->Logs << this->StartingLogs << this->Verbosity
-       << vtkClientServerStream::End;
+       << this->TraceTime << static_cast<int>(this->TraceEvents.size());
+  for (const auto& item : this->TraceEvents)
+  {
+    *css << item.first << item.second;
+  }
+  *css << vtkClientServerStream::End;
 }
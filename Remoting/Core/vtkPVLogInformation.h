@@ -8,6 +8,7 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" // needed for exports
 
+#include <map>    // for std::map
 #include <string> // for std::string
 
 class vtkClientServerStream;
@@ -15,6 +16,12 @@ class vtkClientServerStream;
 /**
  * @class vtkPVLogInformation
  * @brief Gets the log of a specific rank as well as the verbosity level
+ *
+ * When CollectTrace is on, the trace events recorded by vtkLogRecorder on every
+ * rank are gathered as well. The time at which the information is gathered is
+ * always collected so that the client can align the clocks of different
+ * processes: with the default Rank and CollectTrace, gathering this
+ * information is a cheap round trip that only reads this time.
  */
 class VTKREMOTINGCORE_EXPORT vtkPVLogInformation : public vtkPVInformation
 {
@@ -72,6 +79,27 @@ public:
    */
   vtkGetMacro(Verbosity, int);
 
+  ///@{
+  /**
+   * Set/get whether to collect the trace events recorded on all ranks.
+   * Default is false.
+   */
+  vtkSetMacro(CollectTrace, bool);
+  vtkGetMacro(CollectTrace, bool);
+  ///@}
+
+  /**
+   * Get the trace events collected on each rank, keyed by rank, in the format
+   * returned by vtkLogRecorder::GetTraceEvents().
+   */
+  const std::map<int, std::string>& GetTraceEvents() const { return this->TraceEvents; }
+
+  /**
+   * Get the time, in microseconds on the clock of rank 0, at which the
+   * information was gathered.
+   */
+  vtkGetMacro(TraceTime, double);
+
 protected:
   vtkPVLogInformation() = default;
   ~vtkPVLogInformation() override = default;
@@ -80,6 +108,9 @@ protected:
   std::string Logs;
   std::string StartingLogs;
   int Verbosity = 20;
+  bool CollectTrace = false;
+  std::map<int, std::string> TraceEvents;
+  double TraceTime = 0.0;
 
   vtkPVLogInformation(const vtkPVLogInformation&) = delete;
   void operator=(const vtkPVLogInformation&) = delete;
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVLogTimelineWriter.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkPVLogInformation.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+struct vtkTimelineEvent
+{
+  double Time;
+  char Phase;
+  int Thread;
+  std::string Name;
+};
+
+// Parses lines formatted as `<time> <phase> <thread> <name>`.
+std::vector<vtkTimelineEvent> ParseEvents(const std::string& text)
+{
+  std::vector<vtkTimelineEvent> events;
+  std::istringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    std::istringstream fields(line);
+    vtkTimelineEvent event;
+    if (!(fields >> event.Time >> event.Phase >> event.Thread))
+    {
+      continue;
+    }
+    fields.get(); // skip the separator before the name.
+    std::getline(fields, event.Name);
+    events.push_back(std::move(event));
+  }
+  return events;
+}
+
+std::string EscapeJSON(const std::string& text)
+{
+  std::string result;
+  result.reserve(text.size());
+  for (const char c : text)
+  {
+    switch (c)
+    {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+          result += buffer;
+        }
+        else
+        {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+}
+
+class vtkPVLogTimelineWriter::vtkInternals
+{
+public:
+  struct Process
+  {
+    std::string Name;
+    std::map<int, std::vector<vtkTimelineEvent>> Ranks;
+  };
+  std::vector<Process> Processes;
+};
+
+vtkStandardNewMacro(vtkPVLogTimelineWriter);
+
+//----------------------------------------------------------------------------
+vtkPVLogTimelineWriter::vtkPVLogTimelineWriter()
+  : Internals(new vtkPVLogTimelineWriter::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogTimelineWriter::~vtkPVLogTimelineWriter()
+{
+  this->SetFileName(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogTimelineWriter::AddProcess(
+  const std::string& name, vtkPVLogInformation* info, double clockOffset)
+{
+  if (!info)
+  {
+    return;
+  }
+  vtkInternals::Process process;
+  process.Name = name;
+  for (const auto& item : info->GetTraceEvents())
+  {
+    auto events = ::ParseEvents(item.second);
+    for (auto& event : events)
+    {
+      event.Time += clockOffset;
+    }
+    process.Ranks[item.first] = std::move(events);
+  }
+  this->Internals->Processes.push_back(std::move(process));
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogTimelineWriter::Initialize()
+{
+  this->Internals->Processes.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkPVLogTimelineWriter::EstimateClockOffset(
+  double requestTime, double replyTime, double remoteTime)
+{
+  // Assume the remote time was read halfway through the round trip.
+  return 0.5 * (requestTime + replyTime) - remoteTime;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVLogTimelineWriter::GetTimeline() const
+{
+  // Times are written relative to the earliest event to keep them short.
+  double origin = std::numeric_limits<double>::max();
+  for (const auto& process : this->Internals->Processes)
+  {
+    for (const auto& rank : process.Ranks)
+    {
+      if (!rank.second.empty())
+      {
+        origin = std::min(origin, rank.second.front().Time);
+      }
+    }
+  }
+
+  std::ostringstream stream;
+  stream.precision(3);
+  stream << std::fixed;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char* separator = "\n";
+  int pid = 0;
+  for (const auto& process : this->Internals->Processes)
+  {
+    for (const auto& rank : process.Ranks)
+    {
+      stream << separator << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid
+             << ",\"args\":{\"name\":\"" << ::EscapeJSON(process.Name) << " - Rank " << rank.first
+             << "\"}}";
+      separator = ",\n";
+      stream << separator << "{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":" << pid
+             << ",\"args\":{\"sort_index\":" << pid << "}}";
+
+      std::set<int> threads;
+      for (const auto& event : rank.second)
+      {
+        threads.insert(event.Thread);
+        stream << separator << "{\"ph\":\"" << event.Phase << "\",\"pid\":" << pid
+               << ",\"tid\":" << event.Thread << ",\"ts\":" << (event.Time - origin);
+        if (event.Phase == 'i')
+        {
+          stream << ",\"s\":\"t\"";
+        }
+        if (event.Phase != 'E')
+        {
+          stream << ",\"name\":\"" << ::EscapeJSON(event.Name) << "\"";
+        }
+        stream << "}";
+      }
+      for (const int thread : threads)
+      {
+        stream << separator << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+               << ",\"tid\":" << thread << ",\"args\":{\"name\":\""
+               << (thread == 0 ? "Main Thread" : "Thread " + std::to_string(thread)) << "\"}}";
+      }
+      ++pid;
+    }
+  }
+  stream << "\n]}\n";
+  return stream.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVLogTimelineWriter::Write()
+{
+  if (!this->FileName || !this->FileName[0])
+  {
+    vtkErrorMacro("FileName must be specified.");
+    return false;
+  }
+  vtksys::ofstream file(this->FileName);
+  if (!file)
+  {
+    vtkErrorMacro("Failed to open '" << this->FileName << "' for writing.");
+    return false;
+  }
+  file << this->GetTimeline();
+  return static_cast<bool>(file);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogTimelineWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "Processes: " << this->Internals->Processes.size() << endl;
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVLogTimelineWriter
+ * @brief   writes trace events from several processes as a single timeline.
+ *
+ * vtkPVLogTimelineWriter merges the trace events collected by
+ * vtkPVLogInformation from the client, data server and render server processes
+ * into a single file in the Chrome trace event JSON format, which can be opened
+ * with Perfetto (https://ui.perfetto.dev) or `chrome://tracing`. Each rank of
+ * each process is shown as its own process in the timeline, with one track per
+ * thread.
+ *
+ * Events of different ranks of the same process are already aligned by
+ * vtkLogRecorder::SynchronizeClocks(). To align events across processes, each
+ * process is added with the offset between its clock and the clock of the
+ * client, see `EstimateClockOffset`.
+ */
+
+#ifndef vtkPVLogTimelineWriter_h
+#define vtkPVLogTimelineWriter_h
+
+#include "vtkObject.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+#include <string> // needed for std::string
+
+class vtkPVLogInformation;
+
+class VTKREMOTINGCORE_EXPORT vtkPVLogTimelineWriter : public vtkObject
+{
+public:
+  static vtkPVLogTimelineWriter* New();
+  vtkTypeMacro(vtkPVLogTimelineWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/get the name of the file to write.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  ///@}
+
+  /**
+   * Add the trace events collected from a process. `name` is used to label
+   * the ranks of that process in the timeline, e.g. "Data Server".
+   * `clockOffset` is added to the times of all its events, in microseconds.
+   */
+  void AddProcess(const std::string& name, vtkPVLogInformation* info, double clockOffset = 0.0);
+
+  /**
+   * Remove all processes added so far.
+   */
+  void Initialize();
+
+  /**
+   * Write the timeline to FileName. Returns true on success.
+   */
+  bool Write();
+
+  /**
+   * Get the timeline as a JSON string.
+   */
+  std::string GetTimeline() const;
+
+  /**
+   * Estimate the offset to add to the times of a remote process so that they
+   * line up with the local clock, given the local times before sending the
+   * request and after receiving the reply, and the remote time reported in
+   * the reply (vtkPVLogInformation::GetTraceTime()).
+   */
+  static double EstimateClockOffset(double requestTime, double replyTime, double remoteTime);
+
+protected:
+  vtkPVLogTimelineWriter();
+  ~vtkPVLogTimelineWriter() override;
+
+  char* FileName = nullptr;
+
+private:
+  vtkPVLogTimelineWriter(const vtkPVLogTimelineWriter&) = delete;
+  void operator=(const vtkPVLogTimelineWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMOutputPort.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+// Checks that vtkSMOutputPort::RequestDataInformation callbacks are only
+// invoked by ProcessDataInformationRequests, with the fresh data information,
+// or one port at a time by ProcessNextDataInformationRequest.
+int TestOutputPortDataInformationRequests(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  if (!controller->InitializeSession(session))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(16);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(8);
+  sphere->UpdateVTKObjects();
+  sphere->UpdatePipeline();
+  vtkSMOutputPort* port = sphere->GetOutputPort(0u);
+
+  vtkIdType numberOfPoints[2] = { -1, -1 };
+  int numberOfCalls[2] = { 0, 0 };
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    port->RequestDataInformation(
+      [&numberOfPoints, &numberOfCalls, cc](vtkPVDataInformation* info) {
+        numberOfPoints[cc] = info->GetNumberOfPoints();
+        ++numberOfCalls[cc];
+      });
+  }
+  if (!vtkSMOutputPort::HasPendingDataInformationRequests())
+  {
+    cerr << "Requests are not pending." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // gathering the information does not invoke the callbacks re-entrantly.
+  port->GetDataInformation();
+  if (numberOfCalls[0] != 0 || numberOfCalls[1] != 0)
+  {
+    cerr << "Callbacks invoked before the requests are processed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSMOutputPort::ProcessDataInformationRequests();
+  const vtkIdType expected = 16 * 6 + 2;
+  if (numberOfCalls[0] != 1 || numberOfCalls[1] != 1 || numberOfPoints[0] != expected ||
+    numberOfPoints[1] != expected || vtkSMOutputPort::HasPendingDataInformationRequests())
+  {
+    cerr << "Unexpected callbacks: " << numberOfCalls[0] << ", " << numberOfCalls[1]
+         << " calls with " << numberOfPoints[0] << ", " << numberOfPoints[1] << " points."
+         << endl;
+    return EXIT_FAILURE;
+  }
+
+  // with valid information, the callback is still deferred.
+  sphere->RequestDataInformation(
+    0, [&numberOfCalls](vtkPVDataInformation*) { ++numberOfCalls[0]; });
+  if (numberOfCalls[0] != 1)
+  {
+    cerr << "Callback invoked from the request." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkSMOutputPort::ProcessDataInformationRequests();
+  if (numberOfCalls[0] != 2)
+  {
+    cerr << "Callback not invoked." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // requests on different ports can be served one port at a time.
+  vtkSmartPointer<vtkSMSourceProxy> cone;
+  cone.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "ConeSource")));
+  controller->InitializeProxy(cone);
+  cone->UpdateVTKObjects();
+  cone->UpdatePipeline();
+  numberOfCalls[0] = numberOfCalls[1] = 0;
+  sphere->RequestDataInformation(
+    0, [&numberOfCalls](vtkPVDataInformation*) { ++numberOfCalls[0]; });
+  cone->RequestDataInformation(0, [&numberOfCalls](vtkPVDataInformation*) { ++numberOfCalls[1]; });
+  if (!vtkSMOutputPort::ProcessNextDataInformationRequest() || numberOfCalls[0] != 1 ||
+    numberOfCalls[1] != 0)
+  {
+    cerr << "The first request was not served alone." << endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkSMOutputPort::ProcessNextDataInformationRequest() || numberOfCalls[0] != 1 ||
+    numberOfCalls[1] != 1)
+  {
+    cerr << "The second request was not served." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cone = nullptr;
+  sphere = nullptr;
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCommand.h"
+#include "vtkImageData.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPNGWriter.h"
+#include "vtkProcessModule.h"
+#include "vtkRemoteWriterHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+
+namespace
+{
+// Writes `image` to `fileName` in the background, the errors of the writer
+// being caught by `observer`.
+void WriteInBackground(vtkImageData* image, const std::string& fileName, vtkCommand* observer)
+{
+  vtkNew<vtkPNGWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->AddObserver(vtkCommand::ErrorEvent, observer);
+  vtkNew<vtkRemoteWriterHelper> helper;
+  helper->SetWriter(writer);
+  helper->SetTryWritingInBackground(true);
+  helper->SetInputData(image);
+  helper->Write();
+}
+}
+
+// Checks that files failing to be written in the background are reported by
+// vtkRemoteWriterHelper::Wait.
+int TestRemoteWriterHelperBackgroundErrors(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  auto session = vtkSmartPointer<vtkSMSession>::New();
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string validName = std::string(tempDir) + "/TestRemoteWriterHelperBackground.png";
+  const std::string invalidName =
+    std::string(tempDir) + "/missing-directory/TestRemoteWriterHelperBackground.png";
+  delete[] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(8, 8, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  vtkNew<vtkTest::ErrorObserver> observer;
+
+  bool success = true;
+  WriteInBackground(image, validName, observer);
+  WriteInBackground(image, invalidName, observer);
+  if (!vtkRemoteWriterHelper::Wait(validName))
+  {
+    cerr << "Writing a valid file was reported as failed." << endl;
+    success = false;
+  }
+  if (vtkRemoteWriterHelper::Wait(invalidName) || !observer->GetError())
+  {
+    cerr << "Writing into a missing directory was not reported as failed." << endl;
+    success = false;
+  }
+  if (!vtkRemoteWriterHelper::Wait(invalidName))
+  {
+    cerr << "The failure was reported twice." << endl;
+    success = false;
+  }
+
+  // failures are also reported when waiting for all files.
+  observer->Clear();
+  WriteInBackground(image, invalidName, observer);
+  if (vtkRemoteWriterHelper::Wait() || !observer->GetError() || !vtkRemoteWriterHelper::Wait())
+  {
+    cerr << "Waiting for all files did not report the failure once." << endl;
+    success = false;
+  }
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  session = nullptr;
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
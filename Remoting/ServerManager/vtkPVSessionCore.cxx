@@ -196,6 +196,17 @@ public:
     }
   }
   //---------------------------------------------------------------------------
+  void GetAllSIObjects(vtkCollection* collection)
+  {
+    for (const auto& iter : this->SIObjectMap)
+    {
+      if (iter.second)
+      {
+        collection->AddItem(iter.second);
+      }
+    }
+  }
+  //---------------------------------------------------------------------------
   void PrintRemoteMap()
   {
     RemoteObjectMapType::iterator iter = this->RemoteObjectMap.begin();
@@ -979,6 +990,12 @@ void vtkPVSessionCore::GetAllRemoteObjects(vtkCollection* collection)
   this->Internals->GetAllRemoteObjects(collection);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::GetAllSIObjects(vtkCollection* collection)
+{
+  this->Internals->GetAllSIObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkPVSessionCore::GetLastResult()
 {
@@ -170,6 +170,12 @@ public:
    */
   virtual void GetAllRemoteObjects(vtkCollection* collection);
 
+  /**
+   * Fill a vtkCollection with all the SIObjects of this process, for instance
+   * to account for the memory used by each proxy.
+   */
+  virtual void GetAllSIObjects(vtkCollection* collection);
+
   /**
    * Delete SIObject that are held by clients that disappeared
    * from the given list.
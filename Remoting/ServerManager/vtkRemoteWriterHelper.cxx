@@ -8,6 +8,7 @@
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataObject.h"
+#include "vtkErrorCode.h"
 #include "vtkImageWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -42,6 +43,12 @@ using FutureContainer = std::unordered_map<std::string,
 FutureContainer SharedFutures;
 std::mutex FutureMutex;
 
+/**
+ * Error codes of the files that failed to be written in the background, until
+ * they are reported by `Wait()`. Also protected by FutureMutex.
+ */
+std::unordered_map<std::string, unsigned long> WriteErrors;
+
 //============================================================================
 struct FutureWorker
 {
@@ -54,8 +61,13 @@ struct FutureWorker
   void operator()(vtkImageWriter* writer)
   {
     writer->Write();
+    const std::string path = vtksys::SystemTools::CollapseFullPath(this->FileName);
     std::lock_guard<std::mutex> lock(FutureMutex);
-    auto it = SharedFutures.find(vtksys::SystemTools::CollapseFullPath(this->FileName));
+    if (writer->GetErrorCode() != vtkErrorCode::NoError)
+    {
+      WriteErrors[path] = writer->GetErrorCode();
+    }
+    auto it = SharedFutures.find(path);
     if (it->second.first == this->TimeStamp)
     {
       SharedFutures.erase(it);
@@ -202,24 +214,46 @@ int vtkRemoteWriterHelper::RequestData(
 }
 
 //----------------------------------------------------------------------------
-void vtkRemoteWriterHelper::Wait(const std::string& fileName)
+bool vtkRemoteWriterHelper::Wait(const std::string& fileName)
 {
-  auto it = ::SharedFutures.find(vtksys::SystemTools::CollapseFullPath(fileName));
-  if (it != ::SharedFutures.end())
+  // SharedFutures is modified by the workers once they are done, so we only hold
+  // the lock while looking the future up, not while waiting for it.
+  const std::string path = vtksys::SystemTools::CollapseFullPath(fileName);
+  vtkThreadedCallbackQueue::SharedFutureBasePointer future;
   {
-    it->second.second->Wait();
+    std::lock_guard<std::mutex> lock(::FutureMutex);
+    auto it = ::SharedFutures.find(path);
+    if (it != ::SharedFutures.end())
+    {
+      future = it->second.second;
+    }
   }
+  if (future)
+  {
+    future->Wait();
+  }
+
+  std::lock_guard<std::mutex> lock(::FutureMutex);
+  return ::WriteErrors.erase(path) == 0;
 }
 
 //----------------------------------------------------------------------------
-void vtkRemoteWriterHelper::Wait()
+bool vtkRemoteWriterHelper::Wait()
 {
   std::vector<vtkThreadedCallbackQueue::SharedFutureBasePointer> filenames;
-  for (auto& item : ::SharedFutures)
   {
-    filenames.push_back(item.second.second);
+    std::lock_guard<std::mutex> lock(::FutureMutex);
+    for (auto& item : ::SharedFutures)
+    {
+      filenames.push_back(item.second.second);
+    }
   }
   vtkProcessModule::GetProcessModule()->GetCallbackQueue()->Wait(filenames);
+
+  std::lock_guard<std::mutex> lock(::FutureMutex);
+  const bool success = ::WriteErrors.empty();
+  ::WriteErrors.clear();
+  return success;
 }
 
 //----------------------------------------------------------------------------
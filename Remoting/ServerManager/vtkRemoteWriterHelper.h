@@ -112,15 +112,19 @@ public:
    * background in parallel, this thread might hang if the file is not finished being written.
    * Otherwise, there is no waiting.
    *
+   * Returns false if writing the file in the background failed. The failure is only
+   * reported once.
+   *
    * @param fileName File name to wait for. It can be provided with its absolute or relative path
    * regardless.
    */
-  static void Wait(const std::string& fileName);
+  static bool Wait(const std::string& fileName);
 
   /**
-   * Wait for all jobs saving screenshot to finish.
+   * Wait for all jobs saving screenshot to finish. Returns false if any of the files
+   * written in the background since the last call failed to be written.
    */
-  static void Wait();
+  static bool Wait();
 
   /**
    * Write the data.
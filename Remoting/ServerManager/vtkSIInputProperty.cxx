@@ -65,7 +65,8 @@ bool vtkSIInputProperty::Push(vtkSMMessage* message, int offset)
     output_ports[cc] = variant->port_number(cc);
   }
 
-  vtkClientServerStream stream;
+  vtkClientServerStreamPool::Pointer pooled = this->AcquireStream();
+  vtkClientServerStream& stream = *pooled;
   if (this->CleanCommand)
   {
     stream << vtkClientServerStream::Invoke << this->SIProxyObject << "CleanInputs"
@@ -126,6 +126,13 @@ bool vtkSIProperty::ProcessMessage(vtkClientServerStream& stream)
   return this->SIProxyObject ? true : false;
 }
 
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::Pointer vtkSIProperty::AcquireStream()
+{
+  return vtkClientServerStreamPool::Acquire(
+    this->SIProxyObject ? this->SIProxyObject->GetInterpreter()->GetStreamPool() : nullptr);
+}
+
 //----------------------------------------------------------------------------
 vtkObjectBase* vtkSIProperty::GetVTKObject()
 {
@@ -163,7 +170,8 @@ bool vtkSIProperty::Push(vtkSMMessage*, int)
     return true;
   }
 
-  vtkClientServerStream stream;
+  vtkClientServerStreamPool::Pointer pooled = this->AcquireStream();
+  vtkClientServerStream& stream = *pooled;
   stream << vtkClientServerStream::Invoke;
   stream << this->GetVTKObject() << this->Command;
   stream << vtkClientServerStream::End;
@@ -11,6 +11,7 @@
 #ifndef vtkSIProperty_h
 #define vtkSIProperty_h
 
+#include "vtkClientServerStreamPool.h"      // needed for vtkClientServerStreamPool::Pointer
 #include "vtkObject.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMMessageMinimal.h"            // needed for vtkSMMessage
@@ -106,6 +107,13 @@ protected:
   vtkObjectBase* GetVTKObject();
   ///@}
 
+  /**
+   * Get an empty stream to build a message for ProcessMessage(), recycled
+   * from the interpreter's pool. Properties are pushed at high rates while
+   * interacting, so this avoids allocating a new stream for every push.
+   */
+  vtkClientServerStreamPool::Pointer AcquireStream();
+
   vtkSetStringMacro(Command);
   vtkSetStringMacro(XMLName);
 
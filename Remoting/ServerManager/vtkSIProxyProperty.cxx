@@ -125,7 +125,8 @@ bool vtkSIProxyProperty::Push(vtkSMMessage* message, int offset)
 
   std::vector<vtkTypeUInt32> to_add = new_value;
 
-  vtkClientServerStream stream;
+  vtkClientServerStreamPool::Pointer pooled = this->AcquireStream();
+  vtkClientServerStream& stream = *pooled;
   vtkObjectBase* object = this->GetVTKObject();
 
   // Deal with previous values to remove
@@ -218,7 +218,8 @@ bool vtkSIStringVectorProperty::Push(const vtkVectorOfStrings& values)
     return true;
   }
 
-  vtkClientServerStream stream;
+  vtkClientServerStreamPool::Pointer pooled = this->AcquireStream();
+  vtkClientServerStream& stream = *pooled;
   vtkObjectBase* object = this->GetVTKObject();
   if (this->CleanCommand)
   {
@@ -204,7 +204,8 @@ bool vtkSIVectorPropertyTemplate<T, force_idtype>::Push(T* values, int number_of
     return true;
   }
 
-  vtkClientServerStream stream;
+  vtkClientServerStreamPool::Pointer pooled = this->AcquireStream();
+  vtkClientServerStream& stream = *pooled;
   vtkObjectBase* object = this->GetVTKObject();
 
   if (this->CleanCommand)
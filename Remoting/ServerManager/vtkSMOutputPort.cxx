@@ -21,6 +21,13 @@
 #include "vtkTimerLog.h"
 
 #include <sstream>
+#include <utility>
+
+namespace
+{
+// Ports with pending `RequestDataInformation` callbacks, in request order.
+std::vector<vtkWeakPointer<vtkSMOutputPort>> PendingDataInformationPorts;
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
@@ -63,6 +70,82 @@ vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
   return this->DataInformation;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::RequestDataInformation(DataInformationCallback callback)
+{
+  if (!callback)
+  {
+    return;
+  }
+  // callbacks are never invoked from here, even if the data information is
+  // valid, so that callers need not be re-entrant.
+  if (this->PendingDataInformationCallbacks.empty())
+  {
+    PendingDataInformationPorts.emplace_back(this);
+  }
+  this->PendingDataInformationCallbacks.push_back(std::move(callback));
+}
+
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::FlushDataInformationCallbacks()
+{
+  // callbacks may request data information again, so swap them out first.
+  std::vector<DataInformationCallback> callbacks;
+  callbacks.swap(this->PendingDataInformationCallbacks);
+  for (const auto& callback : callbacks)
+  {
+    callback(this->DataInformation);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::ProcessDataInformationRequests()
+{
+  std::vector<vtkWeakPointer<vtkSMOutputPort>> ports;
+  ports.swap(PendingDataInformationPorts);
+  for (const auto& port : ports)
+  {
+    if (port && !port->PendingDataInformationCallbacks.empty())
+    {
+      // keep the port alive should a callback release the last reference to it.
+      vtkSmartPointer<vtkSMOutputPort> guard = port.GetPointer();
+      guard->GetDataInformation();
+      // also flushed if gathering failed, not to leave the callbacks waiting forever.
+      guard->FlushDataInformationCallbacks();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMOutputPort::ProcessNextDataInformationRequest()
+{
+  while (!PendingDataInformationPorts.empty())
+  {
+    vtkSmartPointer<vtkSMOutputPort> port = PendingDataInformationPorts.front().GetPointer();
+    PendingDataInformationPorts.erase(PendingDataInformationPorts.begin());
+    if (port && !port->PendingDataInformationCallbacks.empty())
+    {
+      port->GetDataInformation();
+      port->FlushDataInformationCallbacks();
+      break;
+    }
+  }
+  return vtkSMOutputPort::HasPendingDataInformationRequests();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMOutputPort::HasPendingDataInformationRequests()
+{
+  for (const auto& port : PendingDataInformationPorts)
+  {
+    if (port && !port->PendingDataInformationCallbacks.empty())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation()
 {
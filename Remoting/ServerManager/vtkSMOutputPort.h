@@ -23,7 +23,9 @@
 #include "vtkSmartPointer.h" // needed for vtkSmartPointer
 #include "vtkWeakPointer.h"  // needed for vtkWeakPointer
 
-#include <map> // needed for std::map
+#include <functional> // needed for std::function
+#include <map>        // needed for std::map
+#include <vector>     // needed for std::vector
 
 class vtkCollection;
 class vtkPVClassNameInformation;
@@ -48,6 +50,45 @@ public:
    */
   virtual vtkPVDataInformation* GetDataInformation();
 
+  ///@{
+  /**
+   * Deferred counterpart of `GetDataInformation`. `callback` is queued and
+   * invoked with the data information by the next call to
+   * `ProcessDataInformationRequests`, which gathers it first if needed. It is
+   * never invoked from `RequestDataInformation` or `GetDataInformation`, so
+   * callers need not be re-entrant. Multiple requests on the same port are
+   * coalesced in a single gather.
+   *
+   * `ProcessNextDataInformationRequest` only serves the port requested first
+   * and returns true if requests remain, so that applications can process
+   * events between the gathers.
+   *
+   * Pending callbacks are discarded if the port is destroyed. Like every other
+   * server-manager call, requests must be made and processed on the main thread,
+   * and gathering blocks it until the servers respond; applications typically
+   * process the requests once control returns to their event loop.
+   */
+  using DataInformationCallback = std::function<void(vtkPVDataInformation*)>;
+  void RequestDataInformation(DataInformationCallback callback);
+  static void ProcessDataInformationRequests();
+  static bool ProcessNextDataInformationRequest();
+  static bool HasPendingDataInformationRequests();
+  ///@}
+
+  /**
+   * Returns true if the data information is valid i.e. `GetDataInformation`
+   * will not need to gather it from the server.
+   */
+  bool IsDataInformationValid() const { return this->DataInformationValid; }
+
+  /**
+   * Returns the data information gathered last, without gathering it again
+   * if it has been invalidated since. The returned information may thus be
+   * stale or empty; it is meant to be shown while a `RequestDataInformation`
+   * is pending.
+   */
+  vtkPVDataInformation* GetCachedDataInformation() { return this->DataInformation; }
+
   /**
    * Get rank-specific data information.
    */
@@ -182,6 +223,8 @@ protected:
     TemporalSubsetDataInformations;
   std::map<int, vtkSmartPointer<vtkPVDataInformation>> RankDataInformations;
 
+  std::vector<DataInformationCallback> PendingDataInformationCallbacks;
+
 private:
   vtkSMOutputPort(const vtkSMOutputPort&) = delete;
   void operator=(const vtkSMOutputPort&) = delete;
@@ -192,6 +235,9 @@ private:
 
   // Update Pipeline with the given timestep request.
   void UpdatePipeline(double time);
+
+  // Invokes and clears the pending `RequestDataInformation` callbacks.
+  void FlushDataInformationCallbacks();
 };
 
 #endif
@@ -285,6 +285,10 @@ bool vtkSMParaViewPipelineController::InitializeSession(vtkSMSession* session)
   // a collaborative session.
   pxm->UpdateFromRemote();
 
+  // Essential and settings proxies are registered together, let observers
+  // batch their updates.
+  pxm->BeginBulkRegistration();
+
   //---------------------------------------------------------------------------
   // Setup selection models used to track active view/active proxy.
   vtkSMProxySelectionModel* selmodel = pxm->GetSelectionModel("ActiveSources");
@@ -312,6 +316,7 @@ bool vtkSMParaViewPipelineController::InitializeSession(vtkSMSession* session)
     if (!timeKeeper)
     {
       vtkErrorMacro("Failed to create 'TimeKeeper' proxy. ");
+      pxm->EndBulkRegistration();
       return false;
     }
     this->InitializeProxy(timeKeeper);
@@ -348,6 +353,8 @@ bool vtkSMParaViewPipelineController::InitializeSession(vtkSMSession* session)
   //---------------------------------------------------------------------------
   // Setup global settings/state for the visualization state.
   this->UpdateSettingsProxies(session);
+
+  pxm->EndBulkRegistration();
   return true;
 }
 
@@ -123,6 +123,7 @@ vtkSMSessionProxyManager::vtkSMSessionProxyManager(vtkSMSession* session)
   this->StateUpdateNotification = true;
   this->UpdateInputProxies = 0;
   this->InLoadXMLState = false;
+  this->BulkRegistrationDepth = 0;
 
   this->Internals = new vtkSMSessionProxyManagerInternals;
   this->Internals->ProxyManager = this;
@@ -705,6 +706,7 @@ struct vtkSMProxyManagerProxyInformation
 //---------------------------------------------------------------------------
 void vtkSMSessionProxyManager::UnRegisterProxies()
 {
+  this->BeginBulkRegistration();
 
   // Clear internal proxy containers
   std::vector<vtkSMProxyManagerProxyInformation> toUnRegister;
@@ -736,6 +738,31 @@ void vtkSMSessionProxyManager::UnRegisterProxies()
   {
     this->TriggerStateUpdate();
   }
+
+  this->EndBulkRegistration();
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::BeginBulkRegistration()
+{
+  if (this->BulkRegistrationDepth++ == 0)
+  {
+    this->InvokeEvent(BulkRegistrationStartEvent);
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::EndBulkRegistration()
+{
+  if (this->BulkRegistrationDepth <= 0)
+  {
+    vtkErrorMacro("EndBulkRegistration called without a matching BeginBulkRegistration.");
+    return;
+  }
+  if (--this->BulkRegistrationDepth == 0)
+  {
+    this->InvokeEvent(BulkRegistrationEndEvent);
+  }
 }
 
 //---------------------------------------------------------------------------
@@ -417,6 +417,29 @@ public:
    */
   vtkGetMacro(InLoadXMLState, bool);
 
+  /**
+   * Events fired by `BeginBulkRegistration` and `EndBulkRegistration`.
+   */
+  enum BulkRegistrationEvents
+  {
+    BulkRegistrationStartEvent = 9760,
+    BulkRegistrationEndEvent
+  };
+
+  ///@{
+  /**
+   * Brackets code that registers or unregisters a large number of proxies at
+   * once, e.g. when loading a state file. Calls may be nested:
+   * `BulkRegistrationStartEvent` is fired by the outermost
+   * `BeginBulkRegistration` and `BulkRegistrationEndEvent` by the matching
+   * `EndBulkRegistration`. The application may use these events to batch
+   * updates to the GUI instead of handling each registration on its own.
+   */
+  void BeginBulkRegistration();
+  void EndBulkRegistration();
+  bool GetInBulkRegistration() const { return this->BulkRegistrationDepth > 0; }
+  ///@}
+
   /**
    * Save a string to a file at the given location.
    */
@@ -652,6 +675,7 @@ private:
   vtkSMSessionProxyManagerInternals* Internals;
   vtkSMProxyManagerObserver* Observer;
   bool InLoadXMLState;
+  int BulkRegistrationDepth;
 
 #ifndef __WRAP__
   static vtkSMSessionProxyManager* New() { return nullptr; }
@@ -29,6 +29,7 @@
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define OUTPUT_PORTNAME_PREFIX "Output-"
@@ -537,6 +538,17 @@ vtkPVDataInformation* vtkSMSourceProxy::GetDataInformation(unsigned int idx)
   return this->GetOutputPort(idx)->GetDataInformation();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSourceProxy::RequestDataInformation(
+  unsigned int idx, std::function<void(vtkPVDataInformation*)> callback)
+{
+  this->CreateOutputPorts();
+  if (idx < this->GetNumberOfOutputPorts())
+  {
+    this->GetOutputPort(idx)->RequestDataInformation(std::move(callback));
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation* vtkSMSourceProxy::GetRankDataInformation(unsigned int idx, int rank)
 {
@@ -24,6 +24,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMProxy.h"
 
+#include <functional> // for std::function
+
 class vtkPVArrayInformation;
 class vtkPVDataInformation;
 class vtkPVDataSetAttributesInformation;
@@ -130,6 +132,16 @@ public:
   vtkPVDataInformation* GetDataInformation(unsigned int outputIdx);
   ///@}
 
+  /**
+   * Deferred counterpart of `GetDataInformation`: `callback` is invoked with
+   * the data information of the given output by the next call to
+   * `vtkSMOutputPort::ProcessDataInformationRequests`.
+   * Nothing is invoked if the output does not exist.
+   * @sa vtkSMOutputPort::RequestDataInformation
+   */
+  void RequestDataInformation(
+    unsigned int outputIdx, std::function<void(vtkPVDataInformation*)> callback);
+
   ///@{
   /**
    * For composite datasets, `GetDataInformation` returns summary data information for
@@ -532,7 +532,9 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
   }
 
   this->ProxyLocator->SetDeserializer(this);
+  pxm->BeginBulkRegistration();
   int ret = this->LoadStateInternal(elem);
+  pxm->EndBulkRegistration();
   this->ProxyLocator->SetDeserializer(nullptr);
 
   // BUG #10650. When animation scene time ranges are read from the state, they
@@ -28,6 +28,10 @@
 #include "vtkSMTransferFunctionManager.h"
 #endif
 
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+#include "vtkFileSeriesReader.h"
+#endif
+
 #if VTK_MODULE_ENABLE_VTK_AcceleratorsVTKmFilters
 #include "vtkmFilterOverrides.h"
 #endif
@@ -101,6 +105,9 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   if (this->AnimationGeometryCacheLimit != val)
   {
     this->AnimationGeometryCacheLimit = val;
+#if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
+    vtkSMAnimationScene::SetGlobalGeometryCacheLimit(val);
+#endif
     this->Modified();
   }
 }
@@ -244,6 +251,54 @@ bool vtkPVGeneralSettings::GetUseAcceleratedFilters()
 #endif
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetPrefetchFileSeries(bool val)
+{
+  static_cast<void>(val);
+
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  if (this->GetPrefetchFileSeries() != val)
+  {
+    vtkFileSeriesReader::SetGlobalPrefetch(val);
+    this->Modified();
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetPrefetchFileSeries()
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  return vtkFileSeriesReader::GetGlobalPrefetch();
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesPrefetchSizeLimit(int val)
+{
+  static_cast<void>(val);
+
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  if (this->GetFileSeriesPrefetchSizeLimit() != val)
+  {
+    vtkFileSeriesReader::SetGlobalPrefetchSizeLimit(val);
+    this->Modified();
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetFileSeriesPrefetchSizeLimit()
+{
+#if VTK_MODULE_ENABLE_ParaView_VTKExtensionsIOCore
+  return vtkFileSeriesReader::GetGlobalPrefetchSizeLimit();
+#else
+  return 0;
+#endif
+}
+
 //----------------------------------------------------------------------------
 int vtkPVGeneralSettings::GetNumberOfCallbackThreads()
 {
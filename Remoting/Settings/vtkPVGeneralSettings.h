@@ -133,7 +133,7 @@ public:
 
   ///@{
   /**
-   * Set the animation cache limit in KBs.
+   * Set the animation cache limit in KBs. 0 means no limit.
    */
   void SetAnimationGeometryCacheLimit(unsigned long val);
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
@@ -323,6 +323,17 @@ public:
   vtkBooleanMacro(UseAcceleratedFilters, bool);
   ///@}
 
+  ///@{
+  /**
+   * Enable prefetching of the next file by readers of file series, and limit
+   * the size prefetched for each file, in MiB.
+   */
+  void SetPrefetchFileSeries(bool);
+  bool GetPrefetchFileSeries();
+  void SetFileSeriesPrefetchSizeLimit(int);
+  int GetFileSeriesPrefetchSizeLimit();
+  ///@}
+
   ///@{
   /**
    * ActiveSelection is hooked up in the MultiBlock Inspector such that a click on a/multiple
@@ -0,0 +1,365 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Micro-benchmarks for the hot paths of moving data and information between
+// processes: vtkClientServerStream serialization, information gathering
+// through a session, vtkMPIMoveData marshalling and image compressors.
+//
+// Each benchmark runs on synthetic payloads of increasing size. Results are
+// reported as CTest measurements, so that they are tracked on CDash, and can
+// also be written as JSON in the format used by Google Benchmark with
+// `--benchmark_out=<file>`, for use with its comparison tools.
+// `--benchmark_min_time=<seconds>` sets how long each benchmark is repeated
+// (0.1s by default) and `--benchmark_filter=<text>` only runs the benchmarks
+// whose name contains the given text.
+
+#include "vtkClientServerStream.h"
+#include "vtkDataObject.h"
+#include "vtkDummyController.h"
+#include "vtkImageData.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLZ4Compressor.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkZlibImageCompressor.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+class BenchmarkRunner
+{
+public:
+  struct Result
+  {
+    std::string Name;
+    long Iterations;
+    double Seconds; // per iteration
+    double Bytes;   // processed per iteration
+  };
+
+  BenchmarkRunner(int argc, char* argv[])
+  {
+    for (int cc = 1; cc < argc; ++cc)
+    {
+      const std::string arg = argv[cc];
+      if (arg.compare(0, 16, "--benchmark_out=") == 0)
+      {
+        this->OutputFileName = arg.substr(16);
+      }
+      else if (arg.compare(0, 21, "--benchmark_min_time=") == 0)
+      {
+        this->MinTime = std::atof(arg.substr(21).c_str());
+      }
+      else if (arg.compare(0, 19, "--benchmark_filter=") == 0)
+      {
+        this->Filter = arg.substr(19);
+      }
+    }
+  }
+
+  // Calls `iteration` repeatedly until MinTime has elapsed, after a warm-up
+  // call, and records the mean time per call.
+  void Run(const std::string& name, double bytes, const std::function<void()>& iteration)
+  {
+    if (!this->Filter.empty() && name.find(this->Filter) == std::string::npos)
+    {
+      return;
+    }
+    using clock = std::chrono::steady_clock;
+    iteration();
+    long iterations = 0;
+    const auto start = clock::now();
+    double elapsed = 0.0;
+    do
+    {
+      iteration();
+      ++iterations;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < this->MinTime);
+
+    Result result{ name, iterations, elapsed / iterations, bytes };
+    cout << name << ": " << result.Seconds * 1e3 << " ms ("
+         << (bytes > 0 ? bytes / result.Seconds / (1 << 20) : 0.0) << " MiB/s, " << iterations
+         << " iterations)" << endl;
+    cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">"
+         << result.Seconds * 1e3 << "</DartMeasurement>" << endl;
+    this->Results.push_back(result);
+  }
+
+  bool WriteResults() const
+  {
+    if (this->OutputFileName.empty())
+    {
+      return true;
+    }
+    vtksys::ofstream file(this->OutputFileName.c_str());
+    if (!file)
+    {
+      cerr << "Failed to open '" << this->OutputFileName << "' for writing." << endl;
+      return false;
+    }
+    file << "{\n  \"context\": {\"executable\": \"BenchmarkRemoting\"},\n  \"benchmarks\": [";
+    const char* separator = "\n";
+    for (const auto& result : this->Results)
+    {
+      file << separator << "    {\"name\": \"" << result.Name
+           << "\", \"run_type\": \"iteration\", \"iterations\": " << result.Iterations
+           << ", \"real_time\": " << result.Seconds * 1e9
+           << ", \"cpu_time\": " << result.Seconds * 1e9 << ", \"time_unit\": \"ns\"";
+      if (result.Bytes > 0)
+      {
+        file << ", \"bytes_per_second\": " << result.Bytes / result.Seconds;
+      }
+      file << "}";
+      separator = ",\n";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+  }
+
+private:
+  std::vector<Result> Results;
+  std::string OutputFileName;
+  std::string Filter;
+  double MinTime = 0.1;
+};
+
+//----------------------------------------------------------------------------
+// Exposes the marshalling done by vtkMPIMoveData before any communication.
+class BenchmarkMoveData : public vtkMPIMoveData
+{
+public:
+  static BenchmarkMoveData* New();
+  vtkTypeMacro(BenchmarkMoveData, vtkMPIMoveData);
+
+  vtkIdType Marshal(vtkDataObject* data)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(data);
+    return this->BufferTotalLength;
+  }
+
+  void Reconstruct(vtkDataObject* data) { this->ReconstructDataFromBuffer(data); }
+};
+vtkStandardNewMacro(BenchmarkMoveData);
+
+//----------------------------------------------------------------------------
+std::string SizeLabel(double bytes)
+{
+  if (bytes >= (1 << 20))
+  {
+    return std::to_string(static_cast<long>(bytes / (1 << 20))) + "MiB";
+  }
+  return std::to_string(static_cast<long>(bytes / (1 << 10))) + "KiB";
+}
+
+//----------------------------------------------------------------------------
+void BenchmarkClientServerStream(BenchmarkRunner& runner)
+{
+  for (const vtkIdType count : { vtkIdType(128), vtkIdType(128) << 10, vtkIdType(2) << 20 })
+  {
+    std::vector<double> values(count);
+    for (vtkIdType cc = 0; cc < count; ++cc)
+    {
+      values[cc] = 0.5 * cc;
+    }
+    const double bytes = static_cast<double>(count * sizeof(double));
+    const std::string label = SizeLabel(bytes);
+
+    vtkClientServerStream stream;
+    runner.Run("ClientServerStream/Serialize/" + label, bytes, [&]() {
+      stream.Reset();
+      stream << vtkClientServerStream::Reply << "values" << count
+             << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(count))
+             << vtkClientServerStream::End;
+    });
+
+    const unsigned char* data;
+    size_t length;
+    stream.GetData(&data, &length);
+    const std::vector<unsigned char> message(data, data + length);
+    vtkClientServerStream received;
+    std::vector<double> result(count);
+    runner.Run("ClientServerStream/Deserialize/" + label, bytes, [&]() {
+      received.SetData(message.data(), message.size());
+      received.GetArgument(0, 2, result.data(), static_cast<vtkTypeUInt32>(count));
+    });
+  }
+}
+
+//----------------------------------------------------------------------------
+void BenchmarkGatherInformation(BenchmarkRunner& runner)
+{
+  vtkSMSession* session = vtkSMSession::New();
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  for (const int extent : { 16, 64, 128 })
+  {
+    vtkSmartPointer<vtkSMSourceProxy> wavelet;
+    wavelet.TakeReference(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "RTAnalyticSource")));
+    const int wholeExtent[6] = { -extent, extent - 1, -extent, extent - 1, -extent, extent - 1 };
+    vtkSMPropertyHelper(wavelet, "WholeExtent").Set(wholeExtent, 6);
+    wavelet->UpdateVTKObjects();
+    wavelet->UpdatePipeline();
+
+    const double points = 8.0 * extent * extent * extent;
+    runner.Run("GatherInformation/DataInformation/" + std::to_string(2 * extent) + "^3",
+      points * sizeof(float), [&]() {
+        vtkNew<vtkPVDataInformation> info;
+        wavelet->GatherInformation(info);
+      });
+  }
+  session->Delete();
+}
+
+//----------------------------------------------------------------------------
+void BenchmarkMoveDataMarshalling(BenchmarkRunner& runner, const std::string& format)
+{
+  vtkNew<vtkDummyController> controller;
+  vtkNew<BenchmarkMoveData> moveData;
+  moveData->SetController(controller);
+
+  for (const int extent : { 16, 64 })
+  {
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    wavelet->SetWholeExtent(-extent, extent - 1, -extent, extent - 1, -extent, extent - 1);
+    wavelet->Update();
+    vtkImageData* image = wavelet->GetOutput();
+    const double bytes = static_cast<double>(moveData->Marshal(image));
+    const std::string label = format + "/" + std::to_string(2 * extent) + "^3";
+    runner.Run("MoveData/MarshalImage/" + label, bytes, [&]() { moveData->Marshal(image); });
+    vtkNew<vtkImageData> received;
+    runner.Run("MoveData/ReconstructImage/" + label, bytes,
+      [&]() { moveData->Reconstruct(received); });
+  }
+
+  for (const int resolution : { 64, 512 })
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution);
+    sphere->Update();
+    vtkPolyData* polydata = sphere->GetOutput();
+    const double bytes = static_cast<double>(moveData->Marshal(polydata));
+    const std::string label =
+      format + "/" + std::to_string(resolution) + "x" + std::to_string(resolution);
+    runner.Run("MoveData/MarshalPolyData/" + label, bytes, [&]() { moveData->Marshal(polydata); });
+    vtkNew<vtkPolyData> received;
+    runner.Run("MoveData/ReconstructPolyData/" + label, bytes,
+      [&]() { moveData->Reconstruct(received); });
+  }
+}
+
+//----------------------------------------------------------------------------
+void BenchmarkMoveDataMarshalling(BenchmarkRunner& runner)
+{
+  // Compare the legacy format with the native binary one, with and without
+  // compression.
+  const bool binary = vtkMPIMoveData::GetUseBinaryMarshalling();
+  const bool lz4 = vtkMPIMoveData::GetUseLZ4Compression();
+  const bool zlib = vtkMPIMoveData::GetUseZLibCompression();
+
+  vtkMPIMoveData::SetUseBinaryMarshalling(false);
+  BenchmarkMoveDataMarshalling(runner, "Legacy");
+  vtkMPIMoveData::SetUseZLibCompression(true);
+  BenchmarkMoveDataMarshalling(runner, "LegacyZlib");
+  vtkMPIMoveData::SetUseZLibCompression(false);
+  vtkMPIMoveData::SetUseBinaryMarshalling(true);
+  BenchmarkMoveDataMarshalling(runner, "Binary");
+  vtkMPIMoveData::SetUseLZ4Compression(true);
+  BenchmarkMoveDataMarshalling(runner, "BinaryLZ4");
+
+  vtkMPIMoveData::SetUseBinaryMarshalling(binary);
+  vtkMPIMoveData::SetUseLZ4Compression(lz4);
+  vtkMPIMoveData::SetUseZLibCompression(zlib);
+}
+
+//----------------------------------------------------------------------------
+void BenchmarkCompressor(
+  BenchmarkRunner& runner, const std::string& name, vtkImageCompressor* compressor)
+{
+  for (const int size : { 256, 1024 })
+  {
+    // A smooth gradient with some flat regions, closer to a rendered image
+    // than random noise.
+    vtkNew<vtkUnsignedCharArray> image;
+    image->SetNumberOfComponents(4);
+    image->SetNumberOfTuples(size * size);
+    for (int j = 0; j < size; ++j)
+    {
+      for (int i = 0; i < size; ++i)
+      {
+        unsigned char* pixel = image->GetPointer(4 * (j * size + i));
+        const bool background = (i / 64 + j / 64) % 3 == 0;
+        pixel[0] = background ? 82 : static_cast<unsigned char>(i * 255 / size);
+        pixel[1] = background ? 87 : static_cast<unsigned char>(j * 255 / size);
+        pixel[2] = background ? 110 : static_cast<unsigned char>((i + j) * 127 / size);
+        pixel[3] = 255;
+      }
+    }
+    const double bytes = 4.0 * size * size;
+    const std::string label = std::to_string(size) + "x" + std::to_string(size);
+
+    vtkNew<vtkUnsignedCharArray> compressed;
+    compressor->SetImageResolution(size, size);
+    compressor->SetInput(image);
+    compressor->SetOutput(compressed);
+    runner.Run(
+      "Compressor/" + name + "/Compress/" + label, bytes, [&]() { compressor->Compress(); });
+
+    vtkNew<vtkUnsignedCharArray> decompressed;
+    decompressed->SetNumberOfComponents(4);
+    decompressed->SetNumberOfTuples(size * size);
+    compressor->SetInput(compressed);
+    compressor->SetOutput(decompressed);
+    runner.Run(
+      "Compressor/" + name + "/Decompress/" + label, bytes, [&]() { compressor->Decompress(); });
+  }
+}
+}
+
+//----------------------------------------------------------------------------
+int BenchmarkRemoting(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  BenchmarkRunner runner(argc, argv);
+  BenchmarkClientServerStream(runner);
+  BenchmarkGatherInformation(runner);
+  BenchmarkMoveDataMarshalling(runner);
+  {
+    vtkNew<vtkSquirtCompressor> squirt;
+    BenchmarkCompressor(runner, "Squirt", squirt);
+    vtkNew<vtkZlibImageCompressor> zlib;
+    BenchmarkCompressor(runner, "Zlib", zlib);
+    vtkNew<vtkLZ4Compressor> lz4;
+    BenchmarkCompressor(runner, "LZ4", lz4);
+  }
+  const bool success = runner.WriteResults();
+
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBlockStreamingPriorityQueue.h"
+#include "vtkCamera.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector>
+
+namespace
+{
+// Pops all the blocks of `queue`, one at a time.
+std::vector<unsigned int> PopAll(vtkBlockStreamingPriorityQueue* queue)
+{
+  std::vector<unsigned int> order;
+  while (!queue->IsEmpty())
+  {
+    for (unsigned int index : queue->Pop(1))
+    {
+      order.push_back(index);
+    }
+  }
+  return order;
+}
+}
+
+// Checks the order in which vtkBlockStreamingPriorityQueue hands out the
+// blocks of a composite dataset meta-data, with and without view planes.
+int TestBlockStreamingPriorityQueue(int, char*[])
+{
+  // 4 unit cubes along the X axis, with bounds in their meta-data, and a last
+  // block without bounds.
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  metadata->SetNumberOfBlocks(5);
+  for (unsigned int cc = 0; cc < 4; ++cc)
+  {
+    const double bounds[6] = { 10.0 * cc, 10.0 * cc + 1, 0, 1, 0, 1 };
+    metadata->GetMetaData(cc)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), bounds, 6);
+  }
+
+  vtkNew<vtkBlockStreamingPriorityQueue> queue;
+  queue->SetController(nullptr);
+  queue->Initialize(metadata);
+
+  double bounds[6];
+  queue->GetBounds(bounds);
+  if (bounds[0] != 0 || bounds[1] != 31 || bounds[2] != 0 || bounds[3] != 1)
+  {
+    vtkLogF(ERROR, "Unexpected bounds (%g, %g, %g, %g, %g, %g)", bounds[0], bounds[1],
+      bounds[2], bounds[3], bounds[4], bounds[5]);
+    return EXIT_FAILURE;
+  }
+
+  // Without view planes, blocks come in flat index order, unbounded ones last.
+  const std::vector<unsigned int> flatOrder = { 1, 2, 3, 4, 5 };
+  if (PopAll(queue) != flatOrder)
+  {
+    vtkLogF(ERROR, "Blocks are not popped in flat index order without view planes.");
+    return EXIT_FAILURE;
+  }
+
+  // Looking at the third cube only: it must come first.
+  vtkNew<vtkCamera> camera;
+  camera->SetFocalPoint(20.5, 0.5, 0.5);
+  camera->SetPosition(20.5, 0.5, 5);
+  camera->SetViewAngle(20);
+  double planes[24];
+  camera->GetFrustumPlanes(1.0, planes);
+
+  queue->Reinitialize();
+  queue->Update(planes);
+  const std::vector<unsigned int> order = PopAll(queue);
+  if (order.size() != 5 || order[0] != 3 || order[4] != 5)
+  {
+    vtkLogF(ERROR, "The block in view was not popped first.");
+    return EXIT_FAILURE;
+  }
+
+  // Pop(count) returns at most `count` blocks.
+  queue->Reinitialize();
+  if (queue->Pop(2).size() != 2 || queue->Pop(10).size() != 3 || !queue->IsEmpty())
+  {
+    vtkLogF(ERROR, "Unexpected number of popped blocks.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
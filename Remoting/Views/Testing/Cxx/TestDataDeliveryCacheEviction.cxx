@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVRenderViewDataDeliveryManager.h"
+#include "vtkPolyData.h"
+
+namespace
+{
+class TestCacheRepresentation : public vtkPVDataRepresentation
+{
+public:
+  static TestCacheRepresentation* New();
+  vtkTypeMacro(TestCacheRepresentation, vtkPVDataRepresentation);
+};
+vtkStandardNewMacro(TestCacheRepresentation);
+
+bool IsCached(vtkPVDataDeliveryManager* dmgr, vtkPVDataRepresentation* repr, double key)
+{
+  const double currentKey = repr->GetForcedCacheKey();
+  repr->SetForcedCacheKey(key);
+  const bool cached = dmgr->HasPiece(repr);
+  repr->SetForcedCacheKey(currentKey);
+  return cached;
+}
+}
+
+// Checks that the delivery manager evicts the least recently used cache
+// entries to fit the cache size limit, and never the current one.
+int TestDataDeliveryCacheEviction(int, char*[])
+{
+  vtkNew<vtkPVRenderViewDataDeliveryManager> dmgr;
+  vtkNew<TestCacheRepresentation> repr;
+  repr->Initialize(1, 10);
+  repr->SetForceUseCache(true);
+  dmgr->RegisterRepresentation(repr);
+
+  // Cache 4 timesteps of 100 KiB each.
+  vtkNew<vtkPolyData> data;
+  for (int key = 0; key < 4; ++key)
+  {
+    repr->SetForcedCacheKey(key);
+    dmgr->SetPiece(repr, data, /*low_res=*/false, /*trueSize=*/100);
+  }
+
+  // Use timestep 0 again: 1 is now the least recently used, then 2.
+  if (!IsCached(dmgr, repr, 0))
+  {
+    vtkLogF(ERROR, "Timestep 0 is not cached.");
+    return EXIT_FAILURE;
+  }
+
+  if (dmgr->GetNumberOfCacheEntriesToEvict(400) != 0)
+  {
+    vtkLogF(ERROR, "Nothing should be evicted when the cache fits the limit.");
+    return EXIT_FAILURE;
+  }
+
+  dmgr->EvictCacheEntries(dmgr->GetNumberOfCacheEntriesToEvict(250));
+  if (!IsCached(dmgr, repr, 0) || IsCached(dmgr, repr, 1) || IsCached(dmgr, repr, 2) ||
+    !IsCached(dmgr, repr, 3))
+  {
+    vtkLogF(ERROR, "Expected timesteps 1 and 2 to be evicted, and 0 and 3 to be kept.");
+    return EXIT_FAILURE;
+  }
+  if (dmgr->GetNumberOfCacheEntriesToEvict(250) != 0)
+  {
+    vtkLogF(ERROR, "The cache should fit the limit after eviction.");
+    return EXIT_FAILURE;
+  }
+
+  // The entry for the current cache key is never evicted.
+  dmgr->EvictCacheEntries(dmgr->GetNumberOfCacheEntriesToEvict(0));
+  if (IsCached(dmgr, repr, 0) || !IsCached(dmgr, repr, 3))
+  {
+    vtkLogF(ERROR, "Expected only the current timestep to be kept.");
+    return EXIT_FAILURE;
+  }
+
+  dmgr->UnRegisterRepresentation(repr);
+  return EXIT_SUCCESS;
+}
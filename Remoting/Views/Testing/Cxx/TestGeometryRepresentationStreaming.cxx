@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSet.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkMapper.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVLODActor.h"
+#include "vtkPVView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int NumberOfBlocks = 6;
+
+// Writes a multiblock dataset of spheres with different numbers of cells.
+std::string WriteBlocks(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestGeometryRepresentationStreaming.vtm";
+  delete[] tempDir;
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(NumberOfBlocks);
+  for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * cc, 0.0, 0.0);
+    sphere->SetThetaResolution(8 + 4 * cc);
+    sphere->SetPhiResolution(8);
+    sphere->Update();
+    blocks->SetBlock(cc, sphere->GetOutput());
+  }
+  vtkNew<vtkXMLMultiBlockDataWriter> writer;
+  writer->SetInputData(blocks);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+  return fileName;
+}
+
+// Returns the number of cells of each leaf of the data rendered by `repr`,
+// -1 for empty leaves.
+std::vector<vtkIdType> GetRenderedCells(vtkSMProxy* repr)
+{
+  auto geometry = vtkGeometryRepresentation::SafeDownCast(
+    repr->GetSubProxy("SurfaceRepresentation")->GetClientSideObject());
+  auto tree = vtkDataObjectTree::SafeDownCast(
+    geometry->GetActor()->GetMapper()->GetInputDataObject(0, 0));
+  std::vector<vtkIdType> cells;
+  if (!tree)
+  {
+    return cells;
+  }
+  auto iter = vtk::TakeSmartPointer(tree->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    cells.push_back(ds ? ds->GetNumberOfCells() : -1);
+  }
+  return cells;
+}
+
+vtkSmartPointer<vtkSMRenderViewProxy> CreateView(
+  vtkSMSessionProxyManager* pxm, vtkSMParaViewPipelineControllerWithRendering* controller)
+{
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  view->UpdateVTKObjects();
+  return view;
+}
+}
+
+// Streams the blocks of a multiblock dataset through vtkGeometryRepresentation
+// and checks that once all blocks are streamed, the rendered data matches the
+// data rendered without streaming.
+int TestGeometryRepresentationStreaming(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkPVView::SetEnableStreaming(true);
+  const std::string fileName = WriteBlocks(argc, argv);
+
+  auto session = vtkSmartPointer<vtkSMSession>::New();
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMSourceProxy> reader;
+  reader.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "XMLMultiBlockDataReader")));
+  controller->InitializeProxy(reader);
+  vtkSMPropertyHelper(reader, "FileName").Set(fileName.c_str());
+  reader->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(reader);
+
+  // reference: without streaming.
+  auto referenceView = CreateView(pxm, controller);
+  vtkSMProxy* referenceRepr = controller->Show(reader, 0, referenceView);
+  referenceView->StillRender();
+  const std::vector<vtkIdType> expected = GetRenderedCells(referenceRepr);
+
+  // the regular update only renders the first blocks, then the others are streamed.
+  auto view = CreateView(pxm, controller);
+  vtkSMProxy* repr = controller->Show(reader, 0, view);
+  vtkSMPropertyHelper(repr, "StreamingRequestSize").Set(2);
+  repr->UpdateVTKObjects();
+  view->StillRender();
+
+  bool success = true;
+  if (expected.size() != NumberOfBlocks ||
+    std::find(expected.begin(), expected.end(), -1) != expected.end())
+  {
+    vtkLogF(ERROR, "Expected %u non-empty blocks without streaming.", NumberOfBlocks);
+    success = false;
+  }
+  if (GetRenderedCells(repr) == expected)
+  {
+    vtkLogF(ERROR, "All blocks were rendered before streaming.");
+    success = false;
+  }
+
+  unsigned int numberOfPasses = 0;
+  while (view->StreamingUpdate(/*render_if_needed=*/true) && numberOfPasses <= NumberOfBlocks)
+  {
+    ++numberOfPasses;
+  }
+  if (numberOfPasses != NumberOfBlocks / 2 - 1)
+  {
+    vtkLogF(ERROR, "Expected %u streaming passes, got %u.", NumberOfBlocks / 2 - 1, numberOfPasses);
+    success = false;
+  }
+  if (GetRenderedCells(repr) != expected)
+  {
+    vtkLogF(ERROR, "The streamed blocks do not match the blocks rendered without streaming.");
+    success = false;
+  }
+
+  pxm->UnRegisterProxies();
+  view = nullptr;
+  referenceView = nullptr;
+  reader = nullptr;
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  session = nullptr;
+
+  vtkPVView::SetEnableStreaming(false);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAbstractArray.h"
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+
+namespace
+{
+// Enough tuples for the scan to be split between several threads.
+constexpr vtkIdType NumberOfTuples = 200000;
+
+void InitializeParameters(vtkPVProminentValuesInformation* info, int numComps)
+{
+  info->SetFieldAssociation("POINTS");
+  info->SetFieldName("values");
+  info->SetNumberOfComponents(numComps);
+}
+
+// Number of prominent values (or tuples) found for `component`, -1 if none.
+vtkIdType GetNumberOfValues(vtkPVProminentValuesInformation* info, int component)
+{
+  auto values = vtk::TakeSmartPointer(info->GetProminentComponentValues(component));
+  return values ? values->GetNumberOfTuples() : -1;
+}
+
+bool CheckCounts(vtkPVProminentValuesInformation* info, bool valid, vtkIdType tuples,
+  vtkIdType comp0, vtkIdType comp1, const char* label)
+{
+  if (info->GetValid() != valid || GetNumberOfValues(info, -1) != tuples ||
+    GetNumberOfValues(info, 0) != comp0 || GetNumberOfValues(info, 1) != comp1)
+  {
+    vtkLogF(ERROR, "%s: unexpected valid=%d tuples=%lld comp0=%lld comp1=%lld", label,
+      info->GetValid() ? 1 : 0, static_cast<long long>(GetNumberOfValues(info, -1)),
+      static_cast<long long>(GetNumberOfValues(info, 0)),
+      static_cast<long long>(GetNumberOfValues(info, 1)));
+    return false;
+  }
+  return true;
+}
+}
+
+// Checks the distinct values collected by vtkPVProminentValuesInformation from
+// numeric arrays, and their merge and stream round trips.
+int TestProminentValuesInformation(int, char*[])
+{
+  // 2 components taking 4 and 3 values, making 12 distinct tuples.
+  vtkNew<vtkIntArray> discrete;
+  discrete->SetName("values");
+  discrete->SetNumberOfComponents(2);
+  discrete->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    discrete->SetTypedComponent(cc, 0, static_cast<int>(cc % 4));
+    discrete->SetTypedComponent(cc, 1, static_cast<int>(cc % 3));
+  }
+
+  vtkNew<vtkPVProminentValuesInformation> info;
+  InitializeParameters(info, 2);
+  info->CopyDistinctValuesFromObject(discrete);
+  if (!CheckCounts(info, true, 12, 4, 3, "discrete"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A continuous array is rejected, unless forced. -0 and 0 are a single value.
+  vtkNew<vtkDoubleArray> continuous;
+  continuous->SetName("values");
+  continuous->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    continuous->SetValue(cc, cc < 100 ? 0.5 * cc : (cc % 2 ? -0.0 : 0.0));
+  }
+  vtkNew<vtkPVProminentValuesInformation> continuousInfo;
+  InitializeParameters(continuousInfo, 1);
+  continuousInfo->CopyDistinctValuesFromObject(continuous);
+  if (!CheckCounts(continuousInfo, false, -1, -1, -1, "continuous"))
+  {
+    return EXIT_FAILURE;
+  }
+  continuousInfo->SetForce(true);
+  continuousInfo->CopyDistinctValuesFromObject(continuous);
+  if (!CheckCounts(continuousInfo, true, 100, 100, -1, "forced"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Merging keeps the union of the distinct tuples, not only of the components.
+  vtkNew<vtkIntArray> shifted;
+  shifted->DeepCopy(discrete);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    shifted->SetTypedComponent(cc, 1, static_cast<int>(cc % 3) + 1);
+  }
+  vtkNew<vtkPVProminentValuesInformation> other;
+  InitializeParameters(other, 2);
+  other->CopyDistinctValuesFromObject(shifted);
+  vtkNew<vtkPVProminentValuesInformation> merged;
+  InitializeParameters(merged, 2);
+  merged->AddInformation(info);
+  merged->AddInformation(other);
+  if (!CheckCounts(merged, true, 16, 4, 4, "merged"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The distinct tuples survive a stream round trip.
+  vtkClientServerStream css;
+  merged->CopyToStream(&css);
+  vtkNew<vtkPVProminentValuesInformation> received;
+  received->CopyFromStream(&css);
+  if (!CheckCounts(received, true, 16, 4, 4, "received"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // So does the subset selector.
+  info->SetSubsetAssemblyName("Hierarchy");
+  info->SetSubsetSelector("/Root/block0");
+  vtkMultiProcessStream mps;
+  info->CopyParametersToStream(mps);
+  vtkNew<vtkPVProminentValuesInformation> parameters;
+  parameters->CopyParametersFromStream(mps);
+  if (!parameters->GetSubsetSelector() ||
+    strcmp(parameters->GetSubsetSelector(), "/Root/block0") != 0)
+  {
+    vtkLogF(ERROR, "Subset selector lost in the parameters stream.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVProxyMemoryInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+// Returns the memory reported for the given kind of data held by `proxy` or
+// by one of its subproxies.
+long long GetMemorySize(
+  vtkPVProxyMemoryInformation* info, vtkSMSession* session, vtkSMProxy* proxy, int kind)
+{
+  long long size = 0;
+  for (size_t cc = 0; cc < info->GetNumberOfEntries(); ++cc)
+  {
+    auto owner = vtkSMProxy::SafeDownCast(session->GetRemoteObject(info->GetGlobalID(cc)));
+    if (owner && owner->GetTrueParentProxy() == proxy && info->GetKind(cc) == kind)
+    {
+      size += info->GetMemorySize(cc);
+    }
+  }
+  return size;
+}
+}
+
+int TestProxyMemoryInformation(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  auto session = vtkSmartPointer<vtkSMSession>::New();
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  view->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(256);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(256);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  view->StillRender();
+
+  vtkNew<vtkPVProxyMemoryInformation> info;
+  session->GatherInformation(vtkPVSession::CLIENT, info, 0);
+  const long long output =
+    GetMemorySize(info, session, sphere, vtkPVProxyMemoryInformation::OUTPUT);
+  if (output <= 0)
+  {
+    vtkLogF(ERROR, "Missing memory for the output of the source.");
+    return EXIT_FAILURE;
+  }
+  if (GetMemorySize(info, session, repr, vtkPVProxyMemoryInformation::REPRESENTATION_CACHE) <= 0)
+  {
+    vtkLogF(ERROR, "Missing memory for the data of the representation.");
+    return EXIT_FAILURE;
+  }
+
+  // entries must survive serialization.
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  vtkNew<vtkPVProxyMemoryInformation> copy;
+  copy->CopyFromStream(&stream);
+  if (copy->GetNumberOfEntries() != info->GetNumberOfEntries() ||
+    GetMemorySize(copy, session, sphere, vtkPVProxyMemoryInformation::OUTPUT) != output)
+  {
+    vtkLogF(ERROR, "Entries differ after serialization.");
+    return EXIT_FAILURE;
+  }
+
+  pxm->UnRegisterProxies();
+  view = nullptr;
+  sphere = nullptr;
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  session = nullptr;
+
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
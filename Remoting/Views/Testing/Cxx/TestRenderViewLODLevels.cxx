@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+
+namespace
+{
+// Sets the targeted frame rate and renders interactively once.
+int InteractiveRender(vtkSMRenderViewProxy* view, double targetFrameRate)
+{
+  vtkSMPropertyHelper(view, "LODTargetFrameRate").Set(targetFrameRate);
+  view->UpdateVTKObjects();
+  view->InteractiveRender();
+  return vtkPVRenderView::SafeDownCast(view->GetClientSideObject())->GetLODLevel();
+}
+}
+
+// Checks that the level of detail used by interactive renders follows
+// LODTargetFrameRate, and that the levels built for a geometry are reused
+// until the geometry changes.
+int TestRenderViewLODLevels(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  auto session = vtkSmartPointer<vtkSMSession>::New();
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  controller->InitializeSession(session.Get());
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  // always render interactively with levels of detail.
+  vtkSMPropertyHelper(view, "LODThreshold").Set(0.0);
+  vtkSMPropertyHelper(view, "LODResolution").Set(0.5);
+  view->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(128);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(128);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  view->StillRender();
+
+  auto renderView = vtkPVRenderView::SafeDownCast(view->GetClientSideObject());
+  auto geometry = vtkPVDataRepresentation::SafeDownCast(
+    repr->GetSubProxy("SurfaceRepresentation")->GetClientSideObject());
+  vtkPVDataDeliveryManager* dmgr = renderView->GetDeliveryManager();
+
+  // without a target frame rate, level 0 i.e. the LODResolution is used.
+  if (InteractiveRender(view, 0.0) != 0 || !dmgr->GetPieceLODLevel(geometry, 0.5))
+  {
+    vtkLogF(ERROR, "Expected level 0 to be built and used.");
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkDataObject> level0 = dmgr->GetPieceLODLevel(geometry, 0.5);
+
+  // renders slower than an unreachable target use coarser levels, one at a
+  // time, down to the coarsest one.
+  int expected = 0;
+  for (int cc = 0; cc < vtkPVRenderView::NUMBER_OF_LOD_LEVELS + 1; ++cc)
+  {
+    const int level = InteractiveRender(view, 1e9);
+    expected = std::min(expected + 1, vtkPVRenderView::NUMBER_OF_LOD_LEVELS - 1);
+    if (level != expected)
+    {
+      vtkLogF(ERROR, "Expected level %d with a high target frame rate, got %d.", expected, level);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // renders well within a target that is easy to reach go back to finer
+  // levels, one at a time.
+  for (int cc = 0; cc < vtkPVRenderView::NUMBER_OF_LOD_LEVELS + 1; ++cc)
+  {
+    const int level = InteractiveRender(view, 1e-9);
+    expected = std::max(expected - 1, 0);
+    if (level != expected)
+    {
+      vtkLogF(ERROR, "Expected level %d with a low target frame rate, got %d.", expected, level);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the geometry did not change: going back to level 0 reuses the cached one.
+  if (dmgr->GetPieceLODLevel(geometry, 0.5) != level0)
+  {
+    vtkLogF(ERROR, "Level 0 was built again for the same geometry.");
+    return EXIT_FAILURE;
+  }
+
+  // a new geometry gets new levels of detail.
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(64);
+  sphere->UpdateVTKObjects();
+  view->StillRender();
+  InteractiveRender(view, 0.0);
+  vtkDataObject* newLevel0 = dmgr->GetPieceLODLevel(geometry, 0.5);
+  if (!newLevel0 || newLevel0 == level0)
+  {
+    vtkLogF(ERROR, "Level 0 was not built again for the new geometry.");
+    return EXIT_FAILURE;
+  }
+
+  level0 = nullptr;
+  pxm->UnRegisterProxies();
+  view = nullptr;
+  sphere = nullptr;
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  session = nullptr;
+
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBlockStreamingPriorityQueue.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
+
+#include <cassert>
+#include <deque>
+
+class vtkBlockStreamingPriorityQueue::vtkInternals
+{
+public:
+  vtkStreamingPriorityQueue<> PriorityQueue;
+  // leaves without bounds, requested once the prioritized ones are done.
+  std::deque<unsigned int> UnboundedBlocks;
+  vtkSmartPointer<vtkDataObjectTree> Metadata;
+  vtkBoundingBox Bounds;
+
+  bool IsEmpty() const { return this->PriorityQueue.empty() && this->UnboundedBlocks.empty(); }
+
+  unsigned int PopNext()
+  {
+    unsigned int index;
+    if (!this->PriorityQueue.empty())
+    {
+      index = this->PriorityQueue.top().Identifier;
+      this->PriorityQueue.pop();
+    }
+    else
+    {
+      index = this->UnboundedBlocks.front();
+      this->UnboundedBlocks.pop_front();
+    }
+    return index;
+  }
+};
+
+vtkStandardNewMacro(vtkBlockStreamingPriorityQueue);
+vtkCxxSetObjectMacro(vtkBlockStreamingPriorityQueue, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkBlockStreamingPriorityQueue::vtkBlockStreamingPriorityQueue()
+{
+  this->Internals = new vtkInternals();
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkBlockStreamingPriorityQueue::~vtkBlockStreamingPriorityQueue()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::Initialize(vtkDataObjectTree* metadata)
+{
+  delete this->Internals;
+  this->Internals = new vtkInternals();
+  this->Internals->Metadata = metadata;
+  if (!metadata)
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(metadata->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOff();
+  unsigned int count = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++count)
+  {
+    vtkInformation* info = iter->HasCurrentMetaData() ? iter->GetCurrentMetaData() : nullptr;
+    if (info == nullptr || !info->Has(vtkStreamingDemandDrivenPipeline::BOUNDS()))
+    {
+      this->Internals->UnboundedBlocks.push_back(iter->GetCurrentFlatIndex());
+      continue;
+    }
+
+    vtkStreamingPriorityQueueItem item;
+    item.Identifier = iter->GetCurrentFlatIndex();
+    // default priority is the flat index order. Thus even without view-planes
+    // blocks are requested in the order a non-streaming update would read them.
+    item.Priority = -static_cast<double>(count);
+    item.Bounds.SetBounds(info->Get(vtkStreamingDemandDrivenPipeline::BOUNDS()));
+    this->Internals->Bounds.AddBox(item.Bounds);
+    this->Internals->PriorityQueue.push(item);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::Reinitialize()
+{
+  if (this->Internals->Metadata)
+  {
+    vtkSmartPointer<vtkDataObjectTree> metadata = this->Internals->Metadata;
+    this->Initialize(metadata);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkBlockStreamingPriorityQueue::IsEmpty()
+{
+  return this->Internals->IsEmpty();
+}
+
+//----------------------------------------------------------------------------
+std::vector<unsigned int> vtkBlockStreamingPriorityQueue::Pop(unsigned int count)
+{
+  const int num_procs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  const int myid = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  assert(myid < num_procs);
+
+  // deal blocks round-robin so that every process gets its share of the
+  // highest priority blocks.
+  std::vector<unsigned int> indices;
+  for (unsigned int cc = 0; cc < count; ++cc)
+  {
+    for (int rank = 0; rank < num_procs && !this->Internals->IsEmpty(); ++rank)
+    {
+      const unsigned int index = this->Internals->PopNext();
+      if (rank == myid)
+      {
+        indices.push_back(index);
+      }
+    }
+  }
+  return indices;
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::Update(const double view_planes[24])
+{
+  if (!this->Internals->Metadata)
+  {
+    return;
+  }
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  this->Internals->PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::GetBounds(double bounds[6])
+{
+  if (this->Internals->Bounds.IsValid())
+  {
+    this->Internals->Bounds.GetBounds(bounds);
+  }
+  else
+  {
+    vtkMath::UninitializeBounds(bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockStreamingPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+}
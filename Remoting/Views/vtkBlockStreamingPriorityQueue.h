@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBlockStreamingPriorityQueue
+ * @brief   implements a coverage based priority
+ * queue for the leaves of a composite dataset.
+ *
+ * vtkBlockStreamingPriorityQueue is used by representations supporting
+ * streaming of composite datasets (vtkMultiBlockDataSet,
+ * vtkPartitionedDataSetCollection...) to determine the order in which blocks
+ * are requested from the pipeline. It relies on the meta-data provided by
+ * readers in vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA(): leaves are
+ * identified by their flat composite index and, when the meta-data provides
+ * vtkStreamingDemandDrivenPipeline::BOUNDS(), prioritized by their screen
+ * coverage given the view planes passed to Update(). Leaves without bounds
+ * are requested last, in flat index order.
+ *
+ * @sa
+ * vtkAMRStreamingPriorityQueue, vtkGeometryRepresentation.
+ */
+
+#ifndef vtkBlockStreamingPriorityQueue_h
+#define vtkBlockStreamingPriorityQueue_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" // for export macros
+
+#include <vector> // for std::vector
+
+class vtkDataObjectTree;
+class vtkMultiProcessController;
+
+class VTKREMOTINGVIEWS_EXPORT vtkBlockStreamingPriorityQueue : public vtkObject
+{
+public:
+  static vtkBlockStreamingPriorityQueue* New();
+  vtkTypeMacro(vtkBlockStreamingPriorityQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * If the controller is specified, the queue can be used in parallel. So long
+   * as Initialize(), Update() and Pop() methods are called on all processes
+   * with the same meta-data and view planes, the blocks are distributed among
+   * the processes. By default, this is set to the
+   * vtkMultiProcessController::GetGlobalController();
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  /**
+   * Initializes the queue with the leaves of `metadata`. All information
+   * about items in the queue is lost.
+   */
+  void Initialize(vtkDataObjectTree* metadata);
+
+  /**
+   * Re-initializes the priority queue using the meta-data given to the most
+   * recent call to Initialize().
+   */
+  void Reinitialize();
+
+  /**
+   * Updates the priorities of blocks based on the new view frustum planes.
+   * Blocks already "popped" from the queue are not reinserted.
+   */
+  void Update(const double view_planes[24]);
+
+  /**
+   * Returns if the queue is empty.
+   */
+  bool IsEmpty();
+
+  /**
+   * Pops up to `count` blocks per process and returns the flat composite
+   * indices of the ones assigned to this process. The result may be empty on
+   * some processes when the queue empties out.
+   */
+  std::vector<unsigned int> Pop(unsigned int count);
+
+  /**
+   * Returns the union of the bounds of all the leaves given to Initialize().
+   * The bounds are left uninitialized if the meta-data has none.
+   */
+  void GetBounds(double bounds[6]);
+
+protected:
+  vtkBlockStreamingPriorityQueue();
+  ~vtkBlockStreamingPriorityQueue() override;
+
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkBlockStreamingPriorityQueue(const vtkBlockStreamingPriorityQueue&) = delete;
+  void operator=(const vtkBlockStreamingPriorityQueue&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -4,14 +4,18 @@
 #include "vtkGeometryRepresentationInternal.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkBlockStreamingPriorityQueue.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCommand.h"
 #include "vtkCompositeCellGridMapper.h"
 #include "vtkCompositeDataDisplayAttributes.h"
+#include "vtkCompositeDataPipeline.h"
 #include "vtkCompositePolyDataMapper.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataAssemblyUtilities.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkDataObjectTreeRange.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkHyperTreeGrid.h"
@@ -27,12 +31,16 @@
 #include "vtkPVLODActor.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVStreamingMacros.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkScalarsToColors.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
@@ -51,8 +59,11 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <memory>
 #include <numeric>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -186,6 +197,24 @@ protected:
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkGeometryRepresentationMultiBlockMaker);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Adds the non-empty leaves of a streamed piece to the accumulated data. Both
+// have the structure of the meta-data, the piece only having the requested
+// leaves set.
+void MergeStreamedPiece(vtkDataObjectTree* target, vtkDataObjectTree* piece)
+{
+  auto iter = vtk::TakeSmartPointer(piece->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    target->SetDataSet(iter, iter->GetCurrentDataObject());
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkGeometryRepresentation);
 
@@ -279,6 +308,9 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->UseShaderReplacements = false;
   this->ShaderReplacementsString = "";
 
+  this->PriorityQueue = vtkSmartPointer<vtkBlockStreamingPriorityQueue>::New();
+  std::fill(this->ViewPlanes, this->ViewPlanes + 24, 0.0);
+
   // By default, show everything.
   this->AddBlockSelector("/");
 }
@@ -403,7 +435,7 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   {
     // provide the "geometry" to the view so the view can deliver it to the
     // rendering nodes as and when needed.
-    vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    vtkPVView::SetPiece(inInfo, this, this->GetProcessedDataObject());
 
     if (this->UseDataPartitions == true)
     {
@@ -430,9 +462,70 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     // that the bounds we report include the transformation as well.
     this->ComputeVisibleDataBounds();
 
+    // When streaming, the bounds of the blocks yet to be streamed are known
+    // from the meta-data; include them so that the camera does not need to be
+    // reset as blocks arrive.
+    double bounds[6];
+    std::copy(this->VisibleDataBounds, this->VisibleDataBounds + 6, bounds);
+    if (this->StreamingCapablePipeline)
+    {
+      double streamingBounds[6];
+      this->PriorityQueue->GetBounds(streamingBounds);
+      vtkBoundingBox bbox;
+      if (vtkMath::AreBoundsInitialized(bounds))
+      {
+        bbox.AddBounds(bounds);
+      }
+      if (vtkMath::AreBoundsInitialized(streamingBounds))
+      {
+        bbox.AddBounds(streamingBounds);
+      }
+      if (bbox.IsValid())
+      {
+        bbox.GetBounds(bounds);
+      }
+    }
+
     vtkNew<vtkMatrix4x4> matrix;
     this->Actor->GetMatrix(matrix);
-    vtkPVRenderView::SetGeometryBounds(inInfo, this, this->VisibleDataBounds, matrix);
+    vtkPVRenderView::SetGeometryBounds(inInfo, this, bounds, matrix);
+
+    // let the view know that this representation is streaming capable (or not).
+    vtkPVRenderView::SetStreamable(inInfo, this, this->StreamingCapablePipeline);
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->StreamingCapablePipeline)
+    {
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      if (this->StreamingUpdate(view_planes))
+      {
+        // give the next piece to the view so it can deliver it to the
+        // rendering nodes.
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->ProcessedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    auto delivered = vtkDataObjectTree::SafeDownCast(vtkPVView::GetDeliveredPiece(inInfo, this));
+    auto piece =
+      vtkDataObjectTree::SafeDownCast(vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this));
+    if (delivered && piece)
+    {
+      if (!this->StreamedData || this->StreamedDataBase != delivered ||
+        this->StreamedDataBaseMTime != delivered->GetMTime())
+      {
+        vtkStreamingStatusMacro(<< this << ": cloning delivered data.");
+        this->StreamedData.TakeReference(delivered->NewInstance());
+        this->StreamedData->ShallowCopy(delivered);
+        this->StreamedDataBase = delivered;
+        this->StreamedDataBaseMTime = delivered->GetMTime();
+      }
+      MergeStreamedPiece(vtkDataObjectTree::SafeDownCast(this->StreamedData), piece);
+      this->StreamedData->Modified();
+    }
   }
   else if (request_type == vtkPVView::REQUEST_UPDATE_LOD())
   {
@@ -452,20 +545,23 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        const double resolution = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+
+        // Levels of detail are cached alongside the geometry, so each one is
+        // only built once per geometry no matter how often the view switches
+        // between levels or cached timesteps.
+        vtkSmartPointer<vtkDataObject> lod = vtkPVView::GetPieceLODLevel(inInfo, this, resolution);
+        if (!lod)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          lod = this->BuildLOD(data, resolution);
+          vtkPVView::SetPieceLODLevel(inInfo, this, resolution, lod);
         }
 
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
-
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        vtkPVView::SetPieceLOD(inInfo, this, lod);
       }
     }
   }
@@ -473,6 +569,19 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   {
     auto outputData = vtkPVView::GetDeliveredPiece(inInfo, this);
     // vtkLogF(INFO, "%p: %s", (void*)data, this->GetLogName().c_str());
+    if (this->StreamedData)
+    {
+      // use the streamed blocks for as long as the delivered data is unchanged.
+      if (outputData && this->StreamedDataBase == outputData &&
+        this->StreamedDataBaseMTime == outputData->GetMTime())
+      {
+        outputData = this->StreamedData;
+      }
+      else
+      {
+        this->StreamedData = nullptr;
+      }
+    }
     auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
     this->Mapper->SetInputDataObject(outputData);
     this->LODMapper->SetInputDataObject(dataLOD);
@@ -510,6 +619,83 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkGeometryRepresentation::BuildLOD(
+  vtkDataObject* data, double resolution)
+{
+  auto tree = vtkDataObjectTree::SafeDownCast(data);
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  std::vector<vtkDataObject*> blocks;
+  if (tree)
+  {
+    iter.TakeReference(tree->NewTreeIterator());
+    iter->SkipEmptyNodesOn();
+    iter->VisitOnlyLeavesOn();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      blocks.push_back(iter->GetCurrentDataObject());
+    }
+  }
+
+  if (blocks.size() <= 1 || !vtkGeometryRepresentation_detail::DecimateBlocksInParallel)
+  {
+    // We handle the resolution differently depending on decimator
+    // implementation.
+    this->Decimator->SetLODFactor(resolution);
+    this->Decimator->SetInputDataObject(data);
+    this->Decimator->Update();
+
+    // the decimator output is reused for the next level, so copy it.
+    vtkDataObject* output = this->Decimator->GetOutputDataObject(0);
+    auto lod = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+    lod->ShallowCopy(output);
+    return lod;
+  }
+
+  // decimate the blocks in parallel, with one decimator per thread. Progress
+  // is reported per block, from the calling thread only.
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkSmartPointer<vtkDataObject>> lodBlocks(blocks.size());
+  vtkSMPThreadLocalObject<vtkGeometryRepresentation_detail::DecimationFilterType> decimators;
+  std::atomic<vtkIdType> numDecimated(0);
+  const std::thread::id callingThread = std::this_thread::get_id();
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    auto decimator = decimators.Local();
+    decimator->SetLODFactor(resolution);
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      auto block = vtkPolyData::SafeDownCast(blocks[cc]);
+      if (!block)
+      {
+        lodBlocks[cc] = blocks[cc];
+      }
+      else
+      {
+        decimator->SetInputDataObject(block);
+        decimator->Update();
+        auto lodBlock = vtkSmartPointer<vtkPolyData>::New();
+        lodBlock->ShallowCopy(decimator->GetOutput());
+        lodBlocks[cc] = lodBlock;
+      }
+      const vtkIdType done = ++numDecimated;
+      if (std::this_thread::get_id() == callingThread)
+      {
+        this->UpdateProgress(0.85 + 0.10 * done / numBlocks);
+      }
+    }
+  });
+
+  // visit the blocks in the same order to assemble the result.
+  auto lod = vtkSmartPointer<vtkDataObjectTree>::Take(tree->NewInstance());
+  lod->CopyStructure(tree);
+  size_t index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++index)
+  {
+    lod->SetDataSet(iter, lodBlocks[index]);
+  }
+  return lod;
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -530,12 +716,98 @@ int vtkGeometryRepresentation::RequestUpdateExtent(
         ghostLevels += vtkProcessModule::GetNumberOfGhostLevelsToRequest(inInfo);
       }
       inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), ghostLevels);
+
+      if (!this->StreamingCapablePipeline)
+      {
+        inInfo->Remove(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS());
+        inInfo->Remove(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+        continue;
+      }
+
+      if (!this->InStreamingUpdate)
+      {
+        // The representation is going to re-execute, so the input changed and
+        // streaming starts over. The regular update only reads the first
+        // batch of blocks, picked using the last known view planes if any.
+        this->PriorityQueue->Initialize(vtkDataObjectTree::SafeDownCast(
+          inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA())));
+        if (this->HasViewPlanes)
+        {
+          this->PriorityQueue->Update(this->ViewPlanes);
+        }
+      }
+
+      std::vector<unsigned int> indices =
+        this->PriorityQueue->Pop(static_cast<unsigned int>(this->StreamingRequestSize));
+      std::vector<int> request_ids(indices.begin(), indices.end());
+      vtkStreamingStatusMacro(<< this << ": requesting " << request_ids.size() << " blocks.");
+      inInfo->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+      inInfo->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(), request_ids.data(),
+        static_cast<int>(request_ids.size()));
     }
   }
 
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::RequestInformation(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // A pipeline is streaming capable if it provides COMPOSITE_DATA_META_DATA()
+  // with the structure of the composite dataset, which implies that we can
+  // request arbitrary blocks from it.
+  this->StreamingCapablePipeline = false;
+  if (this->StreamingRequestSize > 0 && vtkPVView::GetEnableStreaming() &&
+    inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    this->StreamingCapablePipeline = vtkDataObjectTree::SafeDownCast(
+      inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA())) != nullptr;
+  }
+
+  vtkStreamingStatusMacro(<< this << ": streaming capable input pipeline? "
+                          << (this->StreamingCapablePipeline ? "yes" : "no"));
+  return this->Superclass::RequestInformation(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::StreamingUpdate(const double view_planes[24])
+{
+  assert(this->InStreamingUpdate == false);
+  std::copy(view_planes, view_planes + 24, this->ViewPlanes);
+  this->HasViewPlanes = true;
+  if (this->PriorityQueue->IsEmpty())
+  {
+    return false;
+  }
+
+  this->InStreamingUpdate = true;
+  this->PriorityQueue->Update(view_planes);
+  this->MarkModified();
+  this->Update();
+  this->InStreamingUpdate = false;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetProcessedDataObject()
+{
+  return this->ProcessedData ? this->ProcessedData.GetPointer()
+                             : this->MultiBlockMaker->GetOutputDataObject(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetStreamingRequestSize(int size)
+{
+  size = std::min(std::max(size, 0), 10000);
+  if (this->StreamingRequestSize != size)
+  {
+    this->StreamingRequestSize = size;
+    this->MarkModified();
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -568,6 +840,26 @@ int vtkGeometryRepresentation::RequestData(
     this->GeometryFilter->Modified();
   }
   this->MultiBlockMaker->Update();
+
+  // Keep the blocks of a streaming pass apart from the ones of the regular
+  // update, which are the ones given to the view in REQUEST_UPDATE.
+  vtkDataObject* output = this->MultiBlockMaker->GetOutputDataObject(0);
+  if (this->InStreamingUpdate)
+  {
+    this->ProcessedPiece.TakeReference(output->NewInstance());
+    this->ProcessedPiece->ShallowCopy(output);
+  }
+  else if (this->StreamingCapablePipeline)
+  {
+    this->ProcessedData.TakeReference(output->NewInstance());
+    this->ProcessedData->ShallowCopy(output);
+    this->ProcessedPiece = nullptr;
+  }
+  else
+  {
+    this->ProcessedData = nullptr;
+    this->ProcessedPiece = nullptr;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
@@ -603,7 +895,7 @@ vtkDataObject* vtkGeometryRepresentation::GetRenderedDataObject(int vtkNotUsed(p
 {
   if (this->GeometryFilter->GetNumberOfInputConnections(0) > 0)
   {
-    return this->MultiBlockMaker->GetOutputDataObject(0);
+    return this->GetProcessedDataObject();
   }
   return nullptr;
 }
@@ -1978,7 +2270,7 @@ void vtkGeometryRepresentation::ComputeVisibleDataBounds()
     // REQUEST_RENDER pass.  This constructs a dummy vtkCompositeDataDisplayAttributes
     // with only the visibilities set and calls the helper function to compute the visible
     // bounds with that.
-    vtkDataObject* outputData = this->MultiBlockMaker->GetOutputDataObject(0);
+    vtkDataObject* outputData = this->GetProcessedDataObject();
     vtkNew<vtkCompositeDataDisplayAttributes> cdAttributes;
     this->PopulateBlockAttributes(cdAttributes, outputData);
     this->GetBounds(outputData, this->VisibleDataBounds, cdAttributes);
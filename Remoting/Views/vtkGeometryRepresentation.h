@@ -20,13 +20,16 @@
 #include "vtkParaViewDeprecation.h" // for PV_DEPRECATED
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // for vtkSmartPointer
 #include "vtkVector.h"              // for vtkVector.
+#include "vtkWeakPointer.h"         // for vtkWeakPointer
 
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
 #include <unordered_map> // needed for std::unordered_map
 #include <vector>        // needed for std::vector
 
+class vtkBlockStreamingPriorityQueue;
 class vtkCompositeDataDisplayAttributes;
 class vtkMapper;
 class vtkPiecewiseFunction;
@@ -154,6 +157,20 @@ public:
   vtkBooleanMacro(RequestGhostCellsIfNeeded, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of blocks of a composite dataset to request per process
+   * in each streaming pass. When greater than 0, streaming is enabled on the
+   * view (see vtkPVView::GetEnableStreaming()) and the input pipeline provides
+   * vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA(), only the first
+   * blocks are read in the regular update, the others being requested in
+   * subsequent streaming passes, prioritized by their coverage of the view
+   * (see vtkBlockStreamingPriorityQueue). Default is 0 i.e. no streaming.
+   */
+  void SetStreamingRequestSize(int);
+  vtkGetMacro(StreamingRequestSize, int);
+  ///@}
+
   /**
    * Set the normal array used for smooth shading.
    * It must be a three components array.
@@ -462,6 +479,26 @@ protected:
   int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Overridden to determine if the input pipeline supports block streaming,
+   * see SetStreamingRequestSize().
+   */
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * Requests the next batch of blocks from the input pipeline, in order of
+   * priority for the given view planes. Returns false if there is nothing
+   * left to stream.
+   */
+  bool StreamingUpdate(const double view_planes[24]);
+
+  /**
+   * Returns the data produced by the last regular (non-streaming) update i.e.
+   * the output of the MultiBlockMaker, unaffected by streaming passes.
+   */
+  vtkDataObject* GetProcessedDataObject();
+
   /**
    * Adds the representation to the view.  This is called from
    * vtkView::AddRepresentation().  Subclasses should override this method.
@@ -498,6 +535,13 @@ protected:
    */
   void PopulateBlockAttributes(vtkCompositeDataDisplayAttributes* attrs, vtkDataObject* outputData);
 
+  /**
+   * Builds the level of detail for `data` at the given LOD resolution. Blocks
+   * of composite datasets are decimated in parallel, unless the decimation
+   * filter is itself multithreaded.
+   */
+  vtkSmartPointer<vtkDataObject> BuildLOD(vtkDataObject* data, double resolution);
+
   /**
    * Computes the bounds of the visible data based on the block visibilities in the
    * composite data attributes of the mapper.
@@ -566,6 +610,27 @@ protected:
   // This is used to be able to create the correct placeHolder in RequestData for the client
   int PlaceHolderDataType = VTK_PARTITIONED_DATA_SET_COLLECTION;
 
+  ///@{
+  /**
+   * Block streaming state. ProcessedData is a snapshot of the MultiBlockMaker
+   * output taken in the regular update and ProcessedPiece holds the blocks
+   * produced by the current streaming pass. On the rendering side,
+   * StreamedData accumulates the streamed pieces on top of the delivered data
+   * (StreamedDataBase) until new data is delivered.
+   */
+  int StreamingRequestSize = 0;
+  bool StreamingCapablePipeline = false;
+  bool InStreamingUpdate = false;
+  bool HasViewPlanes = false;
+  double ViewPlanes[24];
+  vtkSmartPointer<vtkBlockStreamingPriorityQueue> PriorityQueue;
+  vtkSmartPointer<vtkDataObject> ProcessedData;
+  vtkSmartPointer<vtkDataObject> ProcessedPiece;
+  vtkSmartPointer<vtkDataObject> StreamedData;
+  vtkWeakPointer<vtkDataObject> StreamedDataBase;
+  vtkMTimeType StreamedDataBaseMTime = 0;
+  ///@}
+
   // These block variables are similar to the ones in vtkCompositeDataDisplayAttributes
   // Some of them are exposed and some others are not because, as of now, they are not needed.
 
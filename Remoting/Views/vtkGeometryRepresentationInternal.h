@@ -21,6 +21,10 @@
 #include "vtkmLevelOfDetail.h"
 namespace vtkGeometryRepresentation_detail
 {
+// vtkmLevelOfDetail is already multithreaded, so blocks are decimated one at a
+// time rather than with a filter per thread.
+constexpr bool DecimateBlocksInParallel = false;
+
 class DecimationFilterType : public vtkmLevelOfDetail
 {
 public:
@@ -96,6 +100,8 @@ protected:
 #include "vtkQuadricClustering.h"
 namespace vtkGeometryRepresentation_detail
 {
+constexpr bool DecimateBlocksInParallel = true;
+
 class DecimationFilterType : public vtkQuadricClustering
 {
 public:
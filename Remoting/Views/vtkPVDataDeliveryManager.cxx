@@ -13,6 +13,9 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <set>
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
@@ -98,12 +101,16 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
+    // for low-res data, also replace the piece when the representation switches
+    // to another (cached) level of detail.
     if (item->GetDataObject(cacheKey) == nullptr ||
-      repr->GetPipelineDataTime() > item->GetTimeStamp())
+      repr->GetPipelineDataTime() > item->GetTimeStamp() ||
+      (low_res && data && item->GetSourceDataObject(cacheKey) != data))
     {
       vtkLogF(
         TRACE, "SetDataObject %s (key=%g) : %p", repr->GetLogName().c_str(), cacheKey, (void*)data);
       item->SetDataObject(data, this->Internals, cacheKey);
+      item->Touch(cacheKey, ++this->Internals->CacheAccessCounter);
       if (trueSize > 0)
       {
         item->SetActualMemorySize(trueSize, cacheKey);
@@ -123,6 +130,27 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SetPieceLODLevel(
+  vtkPVDataRepresentation* repr, double resolution, vtkDataObject* data, int port)
+{
+  vtkInternals::vtkItem* item =
+    this->Internals->GetItem(repr, /*low_res=*/false, port, /*create_if_needed=*/false);
+  if (item)
+  {
+    item->SetLODLevel(resolution, data, this->GetCacheKey(repr));
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkPVDataDeliveryManager::GetPieceLODLevel(
+  vtkPVDataRepresentation* repr, double resolution, int port)
+{
+  vtkInternals::vtkItem* item =
+    this->Internals->GetItem(repr, /*low_res=*/false, port, /*create_if_needed=*/false);
+  return item ? item->GetLODLevel(resolution, this->GetCacheKey(repr)) : nullptr;
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkPVDataDeliveryManager::GetPiece(
   vtkPVDataRepresentation* repr, bool low_res, int port)
@@ -140,6 +168,10 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
+  if (val)
+  {
+    item->Touch(cacheKey, ++this->Internals->CacheAccessCounter);
+  }
 
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
@@ -285,6 +317,94 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataDeliveryManager::GetNumberOfCacheEntriesToEvict(unsigned long limit)
+{
+  unsigned long totalSize = 0;
+  const auto entries = this->Internals->GetEvictableCacheEntries(this, totalSize);
+  vtkIdType count = 0;
+  for (const auto& entry : entries)
+  {
+    if (totalSize <= limit)
+    {
+      break;
+    }
+    totalSize -= entry.Size;
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::GetMemoryUse(vtkPVDataRepresentation* repr, bool low_res,
+  unsigned long& pieces, unsigned long& delivered, unsigned long& redistributed)
+{
+  pieces = delivered = redistributed = 0;
+  if (repr == nullptr)
+  {
+    return;
+  }
+
+  const unsigned int rid = repr->GetUniqueIdentifier();
+  const int redistributedKey = this->GetRedistributedDataKey();
+  std::set<vtkDataObject*> counted;
+  for (const auto& ipair : this->Internals->ItemsMap)
+  {
+    if (ipair.first.first != rid)
+    {
+      continue;
+    }
+    const auto& item = low_res ? ipair.second.second : ipair.second.first;
+    for (const auto& dpair : item.GetCachedData())
+    {
+      const vtkInternals::vtkRepresentedData& store = dpair.second;
+      if (store.DataObject && counted.insert(store.DataObject).second)
+      {
+        pieces += store.DataObject->GetActualMemorySize();
+      }
+      for (const auto& delivery : store.DeliveredDataObjects)
+      {
+        vtkDataObject* dobj = delivery.second;
+        if (dobj && counted.insert(dobj).second)
+        {
+          (delivery.first == redistributedKey ? redistributed : delivered) +=
+            dobj->GetActualMemorySize();
+        }
+      }
+    }
+    if (low_res)
+    {
+      // levels of detail are cached alongside the full-res pieces. Skip the
+      // one in use, already counted through the low-res piece copied from it.
+      for (const auto& dpair : ipair.second.first.GetCachedData())
+      {
+        vtkDataObject* inUse = ipair.second.second.GetSourceDataObject(dpair.first);
+        for (const auto& level : dpair.second.LODLevels)
+        {
+          vtkDataObject* dobj = level.second;
+          if (dobj && dobj != inUse && counted.insert(dobj).second)
+          {
+            pieces += dobj->GetActualMemorySize();
+          }
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheEntries(vtkIdType count)
+{
+  unsigned long totalSize = 0;
+  const auto entries = this->Internals->GetEvictableCacheEntries(this, totalSize);
+  count = std::min(count, static_cast<vtkIdType>(entries.size()));
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    vtkLogF(TRACE, "evict cache entry (key=%g)", entries[cc].CacheKey);
+    entries[cc].Item->ClearCache(entries[cc].CacheKey);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
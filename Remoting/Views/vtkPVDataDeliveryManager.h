@@ -90,11 +90,51 @@ public:
    */
   vtkDataObject* GetDeliveredPiece(vtkPVDataRepresentation* repr, bool low_res, int port = 0);
 
+  ///@{
+  /**
+   * Store/retrieve the levels of detail a representation built from its
+   * (full-res) piece, keyed by LOD resolution. Levels are cached alongside the
+   * piece for the current cache key and discarded whenever the piece changes,
+   * so representations only need to build each level once per geometry. Use
+   * `SetPiece` with `low_res` set to true to pick the level to render.
+   */
+  void SetPieceLODLevel(
+    vtkPVDataRepresentation* repr, double resolution, vtkDataObject* data, int port = 0);
+  vtkDataObject* GetPieceLODLevel(vtkPVDataRepresentation* repr, double resolution, int port = 0);
+  ///@}
+
   /**
    * Clear all cached data objects for the given representation.
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  ///@{
+  /**
+   * Bound the memory used by the data objects cached for all the
+   * representations of the view when vtkPVView::GetUseCache() is true.
+   * `GetNumberOfCacheEntriesToEvict` returns how many of the least recently
+   * used cache entries must be discarded for the cache to fit in `limit`
+   * kibibytes on this process, and `EvictCacheEntries` discards the `count`
+   * least recently used ones. The entry for the current cache key of a
+   * representation is never evicted. The recency order only depends on the
+   * sequence of updates, so it is the same on all processes: views reduce the
+   * count across processes before evicting to keep the caches consistent.
+   */
+  vtkIdType GetNumberOfCacheEntriesToEvict(unsigned long limit);
+  void EvictCacheEntries(vtkIdType count);
+  ///@}
+
+  /**
+   * Memory used on this process, in kibibytes, by the data objects stored for
+   * a representation, over all its ports and cache keys. `pieces` is for the
+   * data produced by the representation, `delivered` for the data objects
+   * obtained after delivery and `redistributed` for the ones redistributed for
+   * ordered compositing. A data object stored more than once is counted once.
+   * When `low_res` is true, `pieces` includes the cached levels of detail.
+   */
+  void GetMemoryUse(vtkPVDataRepresentation* repr, bool low_res, unsigned long& pieces,
+    unsigned long& delivered, unsigned long& redistributed);
+
   ///@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -163,6 +203,12 @@ protected:
 
   double GetCacheKey(vtkPVDataRepresentation* repr) const;
 
+  /**
+   * Key used for the delivered data objects that hold redistributed data, if
+   * any. Default implementation returns -1, i.e. no redistribution.
+   */
+  virtual int GetRedistributedDataKey() const { return -1; }
+
   /**
    * This method is called to request that the subclass do appropriate transfer
    * for the indicated representation.
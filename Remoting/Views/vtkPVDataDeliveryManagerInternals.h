@@ -13,10 +13,12 @@
 #include "vtkSmartPointer.h"         // for vtkSmartPointer
 #include "vtkWeakPointer.h"          // for vtkWeakPointer
 
-#include <cassert> // for assert
-#include <map>     // for std::map
-#include <numeric> // for std::accumulate
-#include <utility> // for std::pair
+#include <algorithm> // for std::sort
+#include <cassert>   // for assert
+#include <map>       // for std::map
+#include <numeric>   // for std::accumulate
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -51,13 +53,22 @@ public:
     // Data object produced by the representation.
     vtkSmartPointer<vtkDataObject> DataObject;
 
+    // Data object passed by the representation, `DataObject` is a copy of it.
+    vtkSmartPointer<vtkDataObject> SourceDataObject;
+
     // Data object available after delivery to the "rendering" node.
     std::map<int, vtkSmartPointer<vtkDataObject>> DeliveredDataObjects;
 
+    // Levels of detail built from `DataObject`, keyed by LOD resolution.
+    std::map<double, vtkSmartPointer<vtkDataObject>> LODLevels;
+
     // Some useful meta-data.
     vtkMTimeType TimeStamp{ 0 };
     vtkMTimeType ActualMemorySize{ 0 };
 
+    // Value of vtkInternals::CacheAccessCounter when this entry was last used.
+    vtkTypeUInt64 LastAccess{ 0 };
+
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
   };
@@ -77,6 +88,18 @@ public:
     vtkItem() = default;
 
     void ClearCache() { this->Data.clear(); }
+    void ClearCache(double cacheKey) { this->Data.erase(cacheKey); }
+
+    void Touch(double cacheKey, vtkTypeUInt64 stamp)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end())
+      {
+        iter->second.LastAccess = stamp;
+      }
+    }
+
+    const std::map<double, vtkRepresentedData>& GetCachedData() const { return this->Data; }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
     {
@@ -91,7 +114,9 @@ public:
         store.DataObject = nullptr;
       }
 
+      store.SourceDataObject = data;
       store.DeliveredDataObjects.clear();
+      store.LODLevels.clear();
       store.ActualMemorySize = data ? data->GetActualMemorySize() : 0;
       // This method gets called when data is entirely changed. That means that any
       // data we may have delivered or redistributed would also be obsolete.
@@ -162,6 +187,32 @@ public:
       return iter != this->Data.end() ? iter->second.DataObject.GetPointer() : nullptr;
     }
 
+    vtkDataObject* GetSourceDataObject(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      return iter != this->Data.end() ? iter->second.SourceDataObject.GetPointer() : nullptr;
+    }
+
+    void SetLODLevel(double resolution, vtkDataObject* data, double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end() && iter->second.DataObject)
+      {
+        iter->second.LODLevels[resolution] = data;
+      }
+    }
+
+    vtkDataObject* GetLODLevel(double resolution, double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return nullptr;
+      }
+      auto level = iter->second.LODLevels.find(resolution);
+      return level != iter->second.LODLevels.end() ? level->second.GetPointer() : nullptr;
+    }
+
     vtkMTimeType GetTimeStamp(double cacheKey) const
     {
       auto iter = this->Data.find(cacheKey);
@@ -276,8 +327,67 @@ public:
     }
   }
 
+  struct vtkCacheEntry
+  {
+    vtkItem* Item;
+    double CacheKey;
+    vtkTypeUInt64 LastAccess;
+    unsigned long Size;
+  };
+
+  // Returns the cache entries that may be evicted, least recently used first.
+  // The entries for the current cache key of each representation are skipped
+  // since they are the ones being rendered.
+  std::vector<vtkCacheEntry> GetEvictableCacheEntries(
+    vtkPVDataDeliveryManager* dmgr, unsigned long& totalSize)
+  {
+    std::vector<vtkCacheEntry> entries;
+    totalSize = 0;
+    for (auto& ipair : this->ItemsMap)
+    {
+      auto repr = this->RepresentationsMap[ipair.first.first];
+      if (repr == nullptr)
+      {
+        continue;
+      }
+      const double currentKey = dmgr->GetCacheKey(repr);
+      for (vtkItem* item : { &ipair.second.first, &ipair.second.second })
+      {
+        for (const auto& dpair : item->GetCachedData())
+        {
+          // on rendering ranks the delivered data objects may be the only ones
+          // holding the geometry, on data ranks the representation output is.
+          unsigned long size = dpair.second.ActualMemorySize;
+          unsigned long deliveredSize = 0;
+          for (const auto& delivered : dpair.second.DeliveredDataObjects)
+          {
+            deliveredSize += delivered.second ? delivered.second->GetActualMemorySize() : 0;
+          }
+          size = std::max(size, deliveredSize);
+          for (const auto& level : dpair.second.LODLevels)
+          {
+            size += level.second ? level.second->GetActualMemorySize() : 0;
+          }
+          totalSize += size;
+          if (dpair.first != currentKey)
+          {
+            entries.push_back(vtkCacheEntry{ item, dpair.first, dpair.second.LastAccess, size });
+          }
+        }
+      }
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+      [](const vtkCacheEntry& a, const vtkCacheEntry& b) { return a.LastAccess < b.LastAccess; });
+    return entries;
+  }
+
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // Incremented every time a cache entry is set or found, to order entries
+  // from least to most recently used. Since representations are updated in
+  // the same order on all processes, so is this counter.
+  vtkTypeUInt64 CacheAccessCounter{ 0 };
 };
 
 #endif // __WRAP__
@@ -4,12 +4,14 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkClientServerStream.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
@@ -25,12 +27,20 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -38,6 +48,225 @@
 namespace
 {
 typedef std::map<int, std::set<std::vector<vtkVariant>>> vtkInternalDistinctValuesBase;
+
+//----------------------------------------------------------------------------
+// Set of distinct tuples of a given size, kept in a flat value buffer indexed
+// by an open-addressing hash table. Once more than `MaxCount` distinct tuples
+// have been seen the set stops growing and is flagged as overflowed, which is
+// the point at which the array is no longer considered discrete. All NaNs
+// compare equal so that they end up as a single prominent value.
+template <typename ValueT>
+class vtkDistinctTupleSet
+{
+public:
+  vtkDistinctTupleSet(int tupleSize, std::size_t maxCount)
+    : TupleSize(tupleSize)
+    , MaxCount(maxCount)
+    , Slots(64, 0)
+  {
+  }
+
+  bool Insert(const ValueT* tuple)
+  {
+    if (this->Overflow)
+    {
+      return false;
+    }
+    const std::size_t mask = this->Slots.size() - 1;
+    std::size_t slot = this->Hash(tuple) & mask;
+    while (const std::size_t entry = this->Slots[slot])
+    {
+      if (this->Equal(this->GetTuple(entry - 1), tuple))
+      {
+        return true;
+      }
+      slot = (slot + 1) & mask;
+    }
+    if (this->Size() >= this->MaxCount)
+    {
+      this->Overflow = true;
+      return false;
+    }
+    this->Values.insert(this->Values.end(), tuple, tuple + this->TupleSize);
+    this->Slots[slot] = this->Size();
+    if (2 * this->Size() > this->Slots.size())
+    {
+      this->Rehash();
+    }
+    return true;
+  }
+
+  bool Merge(const vtkDistinctTupleSet& other)
+  {
+    this->Overflow = this->Overflow || other.Overflow;
+    for (std::size_t cc = 0, max = other.Size(); cc < max && !this->Overflow; ++cc)
+    {
+      this->Insert(other.GetTuple(cc));
+    }
+    return !this->Overflow;
+  }
+
+  bool GetOverflow() const { return this->Overflow; }
+  std::size_t Size() const { return this->Values.size() / this->TupleSize; }
+  const ValueT* GetTuple(std::size_t index) const { return &this->Values[index * this->TupleSize]; }
+
+private:
+  static bool IsNaN(ValueT value) { return value != value; }
+
+  bool Equal(const ValueT* a, const ValueT* b) const
+  {
+    for (int cc = 0; cc < this->TupleSize; ++cc)
+    {
+      if (!(a[cc] == b[cc] || (IsNaN(a[cc]) && IsNaN(b[cc]))))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::size_t Hash(const ValueT* tuple) const
+  {
+    std::uint64_t hash = 0;
+    for (int cc = 0; cc < this->TupleSize; ++cc)
+    {
+      const ValueT value = tuple[cc];
+      // -0 == 0 and all NaNs are equal, so they must hash alike too.
+      const std::uint64_t vhash = IsNaN(value)
+        ? 0x7ff8000000000000ull
+        : static_cast<std::uint64_t>(std::hash<ValueT>()(value == 0 ? ValueT(0) : value));
+      hash ^= vhash + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    // std::hash is often the identity for integers; mix so that the low bits
+    // used to pick a slot depend on every bit of the value.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return static_cast<std::size_t>(hash);
+  }
+
+  void Rehash()
+  {
+    this->Slots.assign(this->Slots.size() * 2, 0);
+    const std::size_t mask = this->Slots.size() - 1;
+    for (std::size_t cc = 0, max = this->Size(); cc < max; ++cc)
+    {
+      std::size_t slot = this->Hash(this->GetTuple(cc)) & mask;
+      while (this->Slots[slot])
+      {
+        slot = (slot + 1) & mask;
+      }
+      this->Slots[slot] = cc + 1;
+    }
+  }
+
+  int TupleSize;
+  std::size_t MaxCount;
+  bool Overflow = false;
+  std::vector<ValueT> Values;
+  std::vector<std::size_t> Slots; // 0 means empty, otherwise tuple index + 1.
+};
+
+//----------------------------------------------------------------------------
+// Collects the distinct values of every component (and of whole tuples when
+// there is more than one component) in a single parallel pass over the array.
+// Each thread fills its own sets, giving up on a component as soon as any
+// thread has seen too many values for it; the sets are merged afterwards.
+struct vtkCollectDistinctValuesWorker
+{
+  // Number of tuples processed between checks for components to give up on.
+  static constexpr vtkIdType CheckInterval = 1024;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array, std::size_t maxCount, vtkInternalDistinctValuesBase& result,
+    std::vector<bool>& overflowed)
+  {
+    using ValueT = vtk::GetAPIType<ArrayT>;
+    using SetsT = std::vector<vtkDistinctTupleSet<ValueT>>;
+
+    const int nc = array->GetNumberOfComponents();
+    const int first = nc > 1 ? -1 : 0;
+    const int numSets = nc - first;
+
+    SetsT prototype;
+    for (int c = first; c < nc; ++c)
+    {
+      prototype.emplace_back(c < 0 ? nc : 1, maxCount);
+    }
+    vtkSMPThreadLocal<SetsT> localSets(prototype);
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[numSets]);
+    for (int k = 0; k < numSets; ++k)
+    {
+      done[k] = false;
+    }
+
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      SetsT& sets = localSets.Local();
+      std::vector<ValueT> tuple(nc);
+      std::vector<int> active(numSets);
+      for (vtkIdType chunk = begin; chunk < end; chunk += CheckInterval)
+      {
+        active.clear();
+        for (int k = 0; k < numSets; ++k)
+        {
+          if (!done[k])
+          {
+            active.push_back(k);
+          }
+        }
+        if (active.empty())
+        {
+          return;
+        }
+        const vtkIdType chunkEnd = std::min(end, chunk + CheckInterval);
+        for (const auto t : vtk::DataArrayTupleRange(array, chunk, chunkEnd))
+        {
+          std::copy(t.begin(), t.end(), tuple.begin());
+          for (const int k : active)
+          {
+            const int c = first + k;
+            if (!sets[k].Insert(c < 0 ? tuple.data() : tuple.data() + c))
+            {
+              done[k] = true;
+            }
+          }
+        }
+      }
+    });
+
+    SetsT merged(prototype);
+    for (SetsT& sets : localSets)
+    {
+      for (int k = 0; k < numSets; ++k)
+      {
+        merged[k].Merge(sets[k]);
+      }
+    }
+
+    overflowed.assign(numSets, false);
+    for (int k = 0; k < numSets; ++k)
+    {
+      const int c = first + k;
+      auto& distincts = result[c];
+      if (merged[k].GetOverflow())
+      {
+        overflowed[k] = true;
+        continue;
+      }
+      const int tupleSize = c < 0 ? nc : 1;
+      std::vector<vtkVariant> tuple(tupleSize);
+      for (std::size_t cc = 0, max = merged[k].Size(); cc < max; ++cc)
+      {
+        const ValueT* values = merged[k].GetTuple(cc);
+        for (int i = 0; i < tupleSize; ++i)
+        {
+          tuple[i] = vtkVariant(values[i]);
+        }
+        distincts.insert(tuple);
+      }
+    }
+  }
+};
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -357,9 +586,31 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
     this->DistinctValues = new vtkInternalDistinctValues;
   }
   int nc = this->GetNumberOfComponents();
+
+  // Numeric arrays are scanned exhaustively in parallel, stopping early for
+  // each component once it takes on more than MaxDiscreteValues values.
+  if (auto dataArray = vtkDataArray::SafeDownCast(array))
+  {
+    if (nc > 0 && dataArray->GetNumberOfComponents() == nc)
+    {
+      const std::size_t maxCount = this->Force
+        ? std::numeric_limits<std::size_t>::max()
+        : static_cast<std::size_t>(dataArray->GetMaxDiscreteValues());
+      std::vector<bool> overflowed;
+      vtkCollectDistinctValuesWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            dataArray, worker, maxCount, *this->DistinctValues, overflowed))
+      {
+        worker(dataArray, maxCount, *this->DistinctValues, overflowed);
+      }
+      // As before, validity is decided by the last component processed.
+      this->Valid = !overflowed.back() && !this->DistinctValues->rbegin()->second.empty();
+      return;
+    }
+  }
+
   vtkNew<vtkVariantArray> cvalues;
   std::vector<vtkVariant> tuple;
-  // bool tooManyValues;
   for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
   {
     int tupleSize = c < 0 ? nc : 1;
@@ -383,14 +634,6 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
           tuple[i] = cvalues->GetValue(i + t * tupleSize);
         }
         compDistincts.insert(tuple);
-        /*
-        if (compDistincts.insert(tuple).second)
-          {
-          if ((tooManyValues =
-            compDistincts.size() > vtkAbstractArray::MAX_DISCRETE_VALUES))
-            break;
-          }
-          */
       }
       this->Valid = true;
     }
@@ -565,7 +808,7 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
       {
         for (int k = 0; k < tupleSize; ++k)
         {
-          if (!css->GetArgument(0, pos, &tuple[k]))
+          if (!css->GetArgument(0, pos++, &tuple[k]))
           {
             vtkErrorMacro("Error decoding the " << k << "-th entry of the " << j
                                                 << "-th unique tuple for component " << i);
@@ -605,7 +848,7 @@ void vtkPVProminentValuesInformation::CopyParametersFromStream(vtkMultiProcessSt
     vtkErrorMacro("Magic number mismatch.");
   }
   this->SetSubsetAssemblyName(assemblyName.empty() ? nullptr : assemblyName.c_str());
-  this->SetSubsetSelector(selector.c_str() ? nullptr : selector.c_str());
+  this->SetSubsetSelector(selector.empty() ? nullptr : selector.c_str());
   this->SetFieldAssociation(fieldAssoc.c_str());
   this->SetFieldName(fieldName.c_str());
 }
@@ -618,7 +861,7 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     return;
   }
 
-  for (int i = 0; i <= this->NumberOfComponents; ++i)
+  for (int i = (this->NumberOfComponents > 1 ? -1 : 0); i < this->NumberOfComponents; ++i)
   {
     vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(i);
     vtkInternalDistinctValues::mapped_type::iterator
@@ -14,7 +14,10 @@
  * given confidence that dictates the number of samples required), then
  * the prominent values are also made available.
  *
- * This class uses vtkAbstractArray::GetProminentComponentValues().
+ * Numeric arrays are scanned in parallel with vtkSMPTools, collecting the
+ * distinct values of each component into typed hash sets and giving up on a
+ * component as soon as it exceeds the array's MaxDiscreteValues. Other arrays
+ * use vtkAbstractArray::GetProminentComponentValues().
  */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVProxyMemoryInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkCollection.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVSessionBase.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPVView.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxy.h"
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    return;                                                                                        \
+  }
+
+vtkStandardNewMacro(vtkPVProxyMemoryInformation);
+
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryInformation::vtkPVProxyMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryInformation::~vtkPVProxyMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+const char* vtkPVProxyMemoryInformation::GetMemoryKindAsString(int kind)
+{
+  switch (kind)
+  {
+    case OUTPUT:
+      return "Output";
+    case REPRESENTATION_CACHE:
+      return "Representation cache";
+    case DELIVERED:
+      return "Delivered";
+    case LOW_RESOLUTION_CACHE:
+      return "Low-resolution cache";
+    case LOW_RESOLUTION_DELIVERED:
+      return "Low-resolution delivered";
+    case REDISTRIBUTED:
+      return "Redistributed";
+    default:
+      return "Unknown";
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyFromObject(vtkObject* vtkNotUsed(obj))
+{
+  this->Entries.clear();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkPVSessionBase* session = pm ? vtkPVSessionBase::SafeDownCast(pm->GetSession()) : nullptr;
+  vtkPVSessionCore* core = session ? session->GetSessionCore() : nullptr;
+  if (!core)
+  {
+    return;
+  }
+
+  Entry entry;
+  entry.ProcessType = vtkProcessModule::GetProcessType();
+  entry.Rank = pm->GetPartitionId();
+  auto addEntry = [&](int kind, unsigned long size) {
+    if (size > 0)
+    {
+      entry.Kind = kind;
+      entry.MemorySize = static_cast<long long>(size);
+      this->Entries.push_back(entry);
+    }
+  };
+
+  vtkNew<vtkCollection> siObjects;
+  core->GetAllSIObjects(siObjects);
+  for (int cc = 0, max = siObjects->GetNumberOfItems(); cc < max; ++cc)
+  {
+    vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(siObjects->GetItemAsObject(cc));
+    if (!siProxy)
+    {
+      continue;
+    }
+    entry.GlobalID = siProxy->GetGlobalID();
+
+    if (auto repr = vtkPVDataRepresentation::SafeDownCast(siProxy->GetVTKObject()))
+    {
+      // representations hold their data in the delivery manager of their view.
+      auto view = vtkPVView::SafeDownCast(repr->GetView());
+      vtkPVDataDeliveryManager* dmgr = view ? view->GetDeliveryManager() : nullptr;
+      if (dmgr)
+      {
+        unsigned long pieces, delivered, redistributed;
+        dmgr->GetMemoryUse(repr, false, pieces, delivered, redistributed);
+        addEntry(REPRESENTATION_CACHE, pieces);
+        addEntry(DELIVERED, delivered);
+        unsigned long redistributedSize = redistributed;
+        dmgr->GetMemoryUse(repr, true, pieces, delivered, redistributed);
+        addEntry(LOW_RESOLUTION_CACHE, pieces);
+        addEntry(LOW_RESOLUTION_DELIVERED, delivered);
+        addEntry(REDISTRIBUTED, redistributedSize + redistributed);
+      }
+    }
+    else if (auto algorithm = vtkAlgorithm::SafeDownCast(siProxy->GetVTKObject()))
+    {
+      // does not update the pipeline, only accounts for existing outputs.
+      unsigned long size = 0;
+      for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+      {
+        if (auto executive = algorithm->GetExecutive())
+        {
+          if (auto output = executive->GetOutputData(port))
+          {
+            size += output->GetActualMemorySize();
+          }
+        }
+      }
+      addEntry(OUTPUT, size);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  auto info = vtkPVProxyMemoryInformation::SafeDownCast(pvinfo);
+  if (!info)
+  {
+    return;
+  }
+
+  this->Entries.insert(this->Entries.end(), info->Entries.begin(), info->Entries.end());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<vtkTypeUInt64>(this->Entries.size());
+  for (const auto& entry : this->Entries)
+  {
+    *css << entry.ProcessType << entry.Rank << entry.GlobalID << entry.Kind << entry.MemorySize;
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  int offset = 0;
+  vtkTypeUInt64 count = 0;
+  this->Entries.clear();
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &count), "count");
+
+  this->Entries.resize(static_cast<size_t>(count));
+  for (auto& entry : this->Entries)
+  {
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.ProcessType), "ProcessType");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.Rank), "Rank");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.GlobalID), "GlobalID");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.Kind), "Kind");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.MemorySize), "MemorySize");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfEntries: " << this->Entries.size() << endl;
+  for (const auto& entry : this->Entries)
+  {
+    os << indent.GetNextIndent() << "Rank " << entry.Rank << ", proxy " << entry.GlobalID << ", "
+       << GetMemoryKindAsString(entry.Kind) << ": " << entry.MemorySize << " KiB" << endl;
+  }
+}
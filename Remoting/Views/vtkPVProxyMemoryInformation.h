@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVProxyMemoryInformation
+ *
+ * vtkPVProxyMemoryInformation reports, for each process, the memory used by
+ * the data held for each proxy: the output data objects of sources and
+ * filters, and the data objects stored by the view delivery managers for
+ * representations, i.e. cached, delivered, low-resolution and redistributed
+ * data. Each entry is identified by the global id of the proxy owning the data,
+ * which may be a subproxy of a registered proxy.
+ *
+ * It must be gathered with a global id of 0: the SIObjects are enumerated from
+ * the vtkPVSessionCore of the session of each process. Data objects
+ * sharing arrays through shallow copies are accounted for each of them, so the
+ * sum of the entries can exceed the memory actually used by the process.
+ */
+
+#ifndef vtkPVProxyMemoryInformation_h
+#define vtkPVProxyMemoryInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+#include <vector> // needed for std::vector
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVProxyMemoryInformation : public vtkPVInformation
+{
+public:
+  static vtkPVProxyMemoryInformation* New();
+  vtkTypeMacro(vtkPVProxyMemoryInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Kind of data an entry accounts for.
+   */
+  enum MemoryKinds
+  {
+    OUTPUT = 0,
+    REPRESENTATION_CACHE,
+    DELIVERED,
+    LOW_RESOLUTION_CACHE,
+    LOW_RESOLUTION_DELIVERED,
+    REDISTRIBUTED,
+    NUMBER_OF_MEMORY_KINDS
+  };
+
+  /**
+   * Returns a human readable name for a MemoryKinds value.
+   */
+  static const char* GetMemoryKindAsString(int kind);
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  ///@{
+  /**
+   * Access the entries. There is at most one entry per process, proxy and
+   * kind, summed over all ports. `GetMemorySize` is in kibibytes.
+   */
+  size_t GetNumberOfEntries() const { return this->Entries.size(); }
+  int GetProcessType(size_t i) const { return this->Entries[i].ProcessType; }
+  int GetRank(size_t i) const { return this->Entries[i].Rank; }
+  vtkTypeUInt32 GetGlobalID(size_t i) const { return this->Entries[i].GlobalID; }
+  int GetKind(size_t i) const { return this->Entries[i].Kind; }
+  long long GetMemorySize(size_t i) const { return this->Entries[i].MemorySize; }
+  ///@}
+
+protected:
+  vtkPVProxyMemoryInformation();
+  ~vtkPVProxyMemoryInformation() override;
+
+private:
+  vtkPVProxyMemoryInformation(const vtkPVProxyMemoryInformation&) = delete;
+  void operator=(const vtkPVProxyMemoryInformation&) = delete;
+
+  struct Entry
+  {
+    int ProcessType;
+    int Rank;
+    vtkTypeUInt32 GlobalID;
+    int Kind;
+    long long MemorySize;
+  };
+  std::vector<Entry> Entries;
+};
+
+#endif
@@ -1514,7 +1514,10 @@ void vtkPVRenderView::UpdateLOD()
 
   // Update LOD geometry.
 
-  this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+  // coarser levels scale the resolution down linearly, to 0 for the last one.
+  const double lodResolution = this->LODResolution *
+    (NUMBER_OF_LOD_LEVELS - 1 - this->LODLevel) / (NUMBER_OF_LOD_LEVELS - 1);
+  this->RequestInformation->Set(LOD_RESOLUTION(), lodResolution);
   if (this->UseOutlineForLODRendering)
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
@@ -1546,6 +1549,45 @@ void vtkPVRenderView::UpdateLOD()
   vtkTimerLog::MarkEndEvent("RenderView::UpdateLOD");
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetLODLevel(int level)
+{
+  level = vtkMath::ClampValue<int>(level, 0, NUMBER_OF_LOD_LEVELS - 1);
+  if (this->LODLevel != level)
+  {
+    this->LODLevel = level;
+    this->LastLODRenderTime = 0.0;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVRenderView::GetAdaptiveLODLevel() const
+{
+  if (this->LODTargetFrameRate <= 0.0)
+  {
+    return 0;
+  }
+  if (this->LastLODRenderTime <= 0.0)
+  {
+    // no measure for the current level yet.
+    return this->LODLevel;
+  }
+
+  const double targetTime = 1.0 / this->LODTargetFrameRate;
+  if (this->LastLODRenderTime > targetTime && this->LODLevel < NUMBER_OF_LOD_LEVELS - 1)
+  {
+    return this->LODLevel + 1;
+  }
+  // only go back to a finer level when well within the target, to avoid
+  // switching back and forth between two levels.
+  if (this->LastLODRenderTime < 0.5 * targetTime && this->LODLevel > 0)
+  {
+    return this->LODLevel - 1;
+  }
+  return this->LODLevel;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::StillRender()
 {
@@ -1782,8 +1824,16 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   {
     std::ostringstream stream;
     stream << "Mode: " << (interactive ? "interactive" : "still") << "\n"
-           << "Level-of-detail: " << (use_lod_rendering ? "yes" : "no") << "\n"
-           << "Remote/parallel rendering: " << (use_distributed_rendering ? "yes" : "no") << "\n";
+           << "Level-of-detail: ";
+    if (use_lod_rendering)
+    {
+      stream << "yes (level " << this->LODLevel << ")\n";
+    }
+    else
+    {
+      stream << "no\n";
+    }
+    stream << "Remote/parallel rendering: " << (use_distributed_rendering ? "yes" : "no") << "\n";
     this->Annotation->SetText(stream.str().c_str());
   }
 
@@ -1803,6 +1853,10 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (!this->MakingSelection)
   {
     this->Timer->StopTimer();
+    if (use_lod_rendering)
+    {
+      this->LastLODRenderTime = this->Timer->GetElapsedTime();
+    }
   }
 
   if (!this->MakingSelection)
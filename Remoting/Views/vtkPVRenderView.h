@@ -277,6 +277,42 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   ///@}
 
+  enum
+  {
+    NUMBER_OF_LOD_LEVELS = 5
+  };
+
+  ///@{
+  /**
+   * Get/Set the level of detail used for LOD rendering. Level 0 uses the
+   * LODResolution and each following level is coarser, down to the minimum
+   * resolution for level `NUMBER_OF_LOD_LEVELS - 1`. Representations cache
+   * the levels they build, so switching between levels is cheap.
+   * \note CallOnAllProcesses
+   */
+  void SetLODLevel(int level);
+  vtkGetMacro(LODLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the frame rate, in frames per second, targeted by interactive
+   * renders. When greater than 0, `GetAdaptiveLODLevel` picks coarser levels of
+   * detail while interactive renders are slower than the target, and finer
+   * ones when they are well within it. 0 (default) always uses level 0 i.e.
+   * the LODResolution.
+   */
+  vtkSetClampMacro(LODTargetFrameRate, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODTargetFrameRate, double);
+  ///@}
+
+  /**
+   * Returns the level of detail to use for the next interactive renders,
+   * based on the time the last interactive render using the current level
+   * took on this process and on LODTargetFrameRate.
+   */
+  int GetAdaptiveLODLevel() const;
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -1308,6 +1344,11 @@ protected:
   bool Blur;
 
   double LODResolution;
+  int LODLevel = 0;
+  double LODTargetFrameRate = 0.0;
+  // Duration, in seconds, of the last interactive render using LODLevel. 0 if
+  // none happened since the level changed.
+  double LastLODRenderTime = 0.0;
   bool UseLightKit;
 
   bool UsedLODForLastRender;
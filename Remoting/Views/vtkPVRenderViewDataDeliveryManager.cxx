@@ -577,6 +577,12 @@ int vtkPVRenderViewDataDeliveryManager::GetDeliveredDataKey(bool low_res) const
                                                    : this->GetViewDataDistributionMode(low_res);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVRenderViewDataDeliveryManager::GetRedistributedDataKey() const
+{
+  return REDISTRIBUTED_DATA_KEY;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVRenderViewDataDeliveryManager::GetMoveMode(vtkInformation* info, int viewMode) const
 {
@@ -180,6 +180,7 @@ protected:
   ~vtkPVRenderViewDataDeliveryManager() override;
 
   void MoveData(vtkPVDataRepresentation* repr, bool low_res, int port) override;
+  int GetRedistributedDataKey() const override;
 
   int GetViewDataDistributionMode(bool low_res) const;
   int GetMoveMode(vtkInformation* info, int viewMode) const;
@@ -413,6 +413,7 @@ void vtkPVView::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ViewTime: " << this->ViewTime << endl;
   os << indent << "CacheKey: " << this->CacheKey << endl;
   os << indent << "UseCache: " << this->UseCache << endl;
+  os << indent << "CacheSizeLimit: " << this->CacheSizeLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -463,9 +464,34 @@ void vtkPVView::Update()
     this->SynchronizeRepresentationTemporalPipelineStates();
   }
 
+  if (this->UseCache && this->CacheSizeLimit > 0)
+  {
+    this->EnforceCacheSizeLimit();
+  }
+
   this->UpdateTimeStamp.Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::EnforceCacheSizeLimit()
+{
+  vtkTypeUInt64 local = this->DeliveryManager
+    ? static_cast<vtkTypeUInt64>(
+        this->DeliveryManager->GetNumberOfCacheEntriesToEvict(this->CacheSizeLimit))
+    : 0;
+
+  // all processes must agree on what is cached, otherwise some would skip
+  // updating representations that others execute.
+  vtkTypeUInt64 global = local;
+  this->AllReduce(local, global, vtkCommunicator::MAX_OP);
+  if (global > 0 && this->DeliveryManager)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: evict %llu cache entries",
+      this->GetLogName().c_str(), static_cast<unsigned long long>(global));
+    this->DeliveryManager->EvictCacheEntries(static_cast<vtkIdType>(global));
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
@@ -963,6 +989,27 @@ vtkDataObject* vtkPVView::GetDeliveredPieceLOD(
   return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+void vtkPVView::SetPieceLODLevel(vtkInformation* info, vtkPVDataRepresentation* repr,
+  double resolution, vtkDataObject* data, int port)
+{
+  if (auto dm = vtkPVView::GetDeliveryManager(info))
+  {
+    dm->SetPieceLODLevel(repr, resolution, data, port);
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkDataObject* vtkPVView::GetPieceLODLevel(
+  vtkInformation* info, vtkPVDataRepresentation* repr, double resolution, int port)
+{
+  if (auto dm = vtkPVView::GetDeliveryManager(info))
+  {
+    return dm->GetPieceLODLevel(repr, resolution, port);
+  }
+  return nullptr;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::Deliver(int use_lod, unsigned int size, unsigned int* representation_ids)
 {
@@ -113,6 +113,18 @@ public:
   vtkGetMacro(UseCache, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the maximum memory, in kibibytes, that the data cached for the
+   * representations in this view may use on any process when UseCache is true.
+   * When exceeded, the least recently used cache entries are discarded at the
+   * end of Update(). 0 (default) means no limit.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(CacheSizeLimit, unsigned long);
+  vtkGetMacro(CacheSizeLimit, unsigned long);
+  ///@}
+
   ///@{
   /**
    * These methods are used to setup the view for capturing screen shots.
@@ -260,6 +272,11 @@ public:
   static vtkDataObject* GetDeliveredPieceLOD(
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
 
+  static void SetPieceLODLevel(vtkInformation* info, vtkPVDataRepresentation* repr,
+    double resolution, vtkDataObject* data, int port = 0);
+  static vtkDataObject* GetPieceLODLevel(
+    vtkInformation* info, vtkPVDataRepresentation* repr, double resolution, int port = 0);
+
   /**
    * Called on all processes to request data-delivery for the list of
    * representations. Note this method has to be called on all processes or it
@@ -355,6 +372,7 @@ protected:
   double ViewTime;
   double CacheKey;
   bool UseCache;
+  unsigned long CacheSizeLimit = 0;
 
   int Size[2];
   int Position[2];
@@ -373,6 +391,12 @@ protected:
    */
   void SynchronizeRepresentationTemporalPipelineStates();
 
+  /**
+   * Called in Update() to discard the least recently used cache entries when
+   * the cache exceeds CacheSizeLimit on any process.
+   */
+  void EnforceCacheSizeLimit();
+
 private:
   vtkPVView(const vtkPVView&) = delete;
   void operator=(const vtkPVView&) = delete;
@@ -204,9 +204,19 @@ void vtkSMRenderViewProxy::Update()
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::UpdateLOD()
 {
-  if (this->ObjectsCreated && this->NeedsUpdateLOD)
+  if (!this->ObjectsCreated)
+  {
+    return;
+  }
+
+  // pick the level of detail from the time recent interactive renders took.
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  const int lodLevel = rv->GetAdaptiveLODLevel();
+  if (this->NeedsUpdateLOD || lodLevel != rv->GetLODLevel())
   {
     vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetLODLevel" << lodLevel
+           << vtkClientServerStream::End;
     stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "UpdateLOD"
            << vtkClientServerStream::End;
     this->GetSession()->PrepareProgress();
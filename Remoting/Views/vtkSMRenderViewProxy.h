@@ -286,7 +286,8 @@ protected:
   void RenderForImageCapture() override;
 
   /**
-   * Calls UpdateLOD() on the vtkPVRenderView.
+   * Calls UpdateLOD() on the vtkPVRenderView, if needed, after picking the
+   * level of detail with vtkPVRenderView::GetAdaptiveLODLevel().
    */
   void UpdateLOD();
 
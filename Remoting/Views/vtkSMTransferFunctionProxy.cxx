@@ -20,6 +20,7 @@
 #include "vtkSMScalarBarWidgetRepresentationProxy.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettings.h"
+#include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
 #include "vtkSMTrace.h"
 #include "vtkSMTransferFunctionManager.h"
@@ -483,13 +484,20 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
     component = vtkSMPropertyHelper(this, "VectorComponent").GetAsInt();
   }
 
-  // Create a GroupDataSet filter
+  // Create the histogram pipeline once and keep it, so that the server side filters
+  // only execute again when their input or properties actually change.
   vtkSMSessionProxyManager* pxm =
     vtkSMProxyManager::GetProxyManager()->GetActiveSessionProxyManager();
-  vtkSmartPointer<vtkSMSourceProxy> group;
-  group.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
+  if (!this->HistogramMover || this->HistogramMover->GetSessionProxyManager() != pxm)
+  {
+    this->CreateHistogramPipeline(pxm);
+  }
+  vtkSMSourceProxy* group = this->HistogramGroup;
+  vtkSMSourceProxy* histo = this->HistogramFilter;
+  vtkSMSourceProxy* mover = this->HistogramMover;
 
   // Group all visible consumers using the transfer function proxy
+  std::vector<vtkSMProxy*> inputs;
   vtkPVArrayInformation* arrayInfo = nullptr;
   std::string arrayName;
   int arrayAsso = -1;
@@ -569,10 +577,7 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
       }
 
       // Add consumer to group filter
-      vtkSMSourceProxy* input =
-        vtkSMSourceProxy::SafeDownCast(vtkSMPropertyHelper(consumer, "Input").GetAsProxy());
-      vtkSMPropertyHelper(group, "Input").Add(input);
-      group->UpdateVTKObjects();
+      inputs.push_back(vtkSMPropertyHelper(consumer, "Input").GetAsProxy());
       hasData = true;
       usedProxy.insert(consumer);
     }
@@ -585,10 +590,10 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
     return this->HistogramTableCache;
   }
 
+  vtkSMPropertyHelper(group, "Input").Set(inputs.data(), static_cast<unsigned int>(inputs.size()));
+  group->UpdateVTKObjects();
+
   // Compute the histogram
-  vtkSmartPointer<vtkSMSourceProxy> histo;
-  histo.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractHistogram")));
-  vtkSMPropertyHelper(histo, "Input").Set(group);
   vtkSMPropertyHelper(histo, "SelectInputArray")
     .SetInputArrayToProcess(arrayAsso, arrayName.c_str());
   vtkSMPropertyHelper(histo, "Component").Set(component);
@@ -597,26 +602,18 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
   vtkSMPropertyHelper(histo, "CustomBinRanges").Set(this->LastRange, 2);
   histo->UpdateVTKObjects();
 
-  // Reduce it
-  vtkSmartPointer<vtkSMSourceProxy> reducer;
-  reducer.TakeReference(
-    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ReductionFilter")));
-  vtkSMPropertyHelper(reducer, "Input").Set(histo);
-  vtkSMPropertyHelper(reducer, "PostGatherHelperName").Set("vtkPVMergeTables");
-  reducer->UpdateVTKObjects();
-
-  // Move it from server to client and save it to the case
-  vtkSmartPointer<vtkSMSourceProxy> mover;
-  mover.TakeReference(
-    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ClientServerMoveData")));
-  vtkSMPropertyHelper(mover, "Input").Set(reducer);
-  vtkSMPropertyHelper(mover, "OutputDataType").Set(VTK_TABLE);
-  mover->UpdateVTKObjects();
+  // Move it from server to client and save it to the cache
   mover->UpdatePipeline();
   vtkTable* histoTable = vtkTable::SafeDownCast(
     vtkAlgorithm::SafeDownCast(mover->GetClientSideObject())->GetOutputDataObject(0));
   this->HistogramTableCache->ShallowCopy(histoTable);
 
+  // Do not keep the consumers' inputs alive through the cached pipeline. The
+  // histogram filter tracks the binned arrays, not its input, so its sketch is
+  // still reused next time if the data did not change.
+  vtkSMPropertyHelper(group, "Input").RemoveAllValues();
+  group->UpdateVTKObjects();
+
   // Sanity check of the histogram table
   if (this->HistogramTableCache->GetNumberOfColumns() < 2)
   {
@@ -646,6 +643,36 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
   return this->HistogramTableCache;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMTransferFunctionProxy::CreateHistogramPipeline(vtkSMSessionProxyManager* pxm)
+{
+  this->HistogramGroup.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
+
+  // The histogram sketch of the data is kept by the filter, so that rescaling the
+  // transfer function or changing the number of bins does not go through the data again.
+  // When the transfer function range is too narrow for the sketch to provide enough
+  // bins, the filter bins the data exactly instead.
+  this->HistogramFilter.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractHistogram")));
+  vtkSMPropertyHelper(this->HistogramFilter, "Input").Set(this->HistogramGroup);
+  vtkSMPropertyHelper(this->HistogramFilter, "UseHistogramSketch").Set(1);
+  this->HistogramFilter->UpdateVTKObjects();
+
+  this->HistogramReducer.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ReductionFilter")));
+  vtkSMPropertyHelper(this->HistogramReducer, "Input").Set(this->HistogramFilter);
+  vtkSMPropertyHelper(this->HistogramReducer, "PostGatherHelperName").Set("vtkPVMergeTables");
+  vtkSMPropertyHelper(this->HistogramReducer, "UseTreeReduction").Set(1);
+  this->HistogramReducer->UpdateVTKObjects();
+
+  this->HistogramMover.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ClientServerMoveData")));
+  vtkSMPropertyHelper(this->HistogramMover, "Input").Set(this->HistogramReducer);
+  vtkSMPropertyHelper(this->HistogramMover, "OutputDataType").Set(VTK_TABLE);
+  this->HistogramMover->UpdateVTKObjects();
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMTransferFunctionProxy::RescaleTransferFunctionToDataRange(bool extend)
 {
@@ -21,6 +21,8 @@
 
 // Forward declarations
 class vtkPVArrayInformation;
+class vtkSMSessionProxyManager;
+class vtkSMSourceProxy;
 
 class VTKREMOTINGVIEWS_EXPORT vtkSMTransferFunctionProxy : public vtkSMProxy
 {
@@ -268,6 +270,9 @@ public:
    * If successful, returns the histogram as a vtkTable containing two columns of double,
    * the first one being the indexes, the second one the number of values.
    * If not, returns nullptr.
+   * The server-side pipeline is kept between calls and bins a sketch of the data that is
+   * only recomputed when the data or the array change, so rescaling the transfer function
+   * or changing the number of bins is cheap. Counts are thus approximate near bin edges.
    */
   virtual vtkTable* ComputeDataHistogramTable(int numberOfBins);
   static vtkTable* ComputeDataHistogramTable(vtkSMProxy* proxy, int numberOfBins)
@@ -393,7 +398,17 @@ protected:
    */
   vtkSmartPointer<vtkTable> HistogramTableCache;
 
+  /**
+   * Server-side pipeline used by ComputeDataHistogramTable, kept between calls
+   */
+  vtkSmartPointer<vtkSMSourceProxy> HistogramGroup;
+  vtkSmartPointer<vtkSMSourceProxy> HistogramFilter;
+  vtkSmartPointer<vtkSMSourceProxy> HistogramReducer;
+  vtkSmartPointer<vtkSMSourceProxy> HistogramMover;
+
 private:
+  void CreateHistogramPipeline(vtkSMSessionProxyManager* pxm);
+
   vtkSMTransferFunctionProxy(const vtkSMTransferFunctionProxy&) = delete;
   void operator=(const vtkSMTransferFunctionProxy&) = delete;
 };
@@ -1,13 +1,21 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
+#include <vtkCellArray.h>
+#include <vtkCellType.h>
 #include <vtkConvertToMultiBlockDataSet.h>
 #include <vtkDataSet.h>
+#include <vtkFloatArray.h>
 #include <vtkLogger.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkPVDataUtilities.h>
 #include <vtkPartitionedDataSetCollection.h>
 #include <vtkPartitionedDataSetCollectionSource.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkUnstructuredGrid.h>
 
 int TestDataUtilities(int, char*[])
 {
@@ -38,5 +46,40 @@ int TestDataUtilities(int, char*[])
   vtkLogIfF(ERROR, vtkPVDataUtilities::GetAssignedNameForBlock(datasets[1]) != "Cross Cap",
     "Block name mismatch for (1, 0)");
 
+  // Test the mesh MTime ignores field data changes.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+  vtkNew<vtkPolyData> pd;
+  pd->DeepCopy(sphere->GetOutput());
+  const vtkMTimeType meshMTime = vtkPVDataUtilities::GetMeshMTime(pd);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(pd->GetNumberOfPoints());
+  scalars->FillValue(1.0f);
+  pd->GetPointData()->SetScalars(scalars);
+  pd->Modified();
+  vtkLogIfF(ERROR, vtkPVDataUtilities::GetMeshMTime(pd) != meshMTime,
+    "Mesh MTime changed when only point data was modified");
+  pd->GetPoints()->Modified();
+  vtkLogIfF(ERROR, vtkPVDataUtilities::GetMeshMTime(pd) <= meshMTime,
+    "Mesh MTime did not change when points were modified");
+  vtkLogIfF(ERROR, vtkPVDataUtilities::GetMeshMTime(nullptr) != 0, "Expected 0 for nullptr");
+
+  // Test the mesh MTime follows the faces of polyhedra.
+  vtkNew<vtkUnstructuredGrid> ug;
+  vtkNew<vtkPoints> tetraPoints;
+  tetraPoints->InsertNextPoint(0, 0, 0);
+  tetraPoints->InsertNextPoint(1, 0, 0);
+  tetraPoints->InsertNextPoint(0, 1, 0);
+  tetraPoints->InsertNextPoint(0, 0, 1);
+  ug->SetPoints(tetraPoints);
+  const vtkIdType tetraIds[4] = { 0, 1, 2, 3 };
+  const vtkIdType tetraFaces[16] = { 3, 0, 2, 1, 3, 0, 1, 3, 3, 0, 3, 2, 3, 1, 2, 3 };
+  ug->InsertNextCell(VTK_POLYHEDRON, 4, tetraIds, 4, tetraFaces);
+  const vtkMTimeType ugMeshMTime = vtkPVDataUtilities::GetMeshMTime(ug);
+  ug->GetPolyhedronFaces()->Modified();
+  vtkLogIfF(ERROR, vtkPVDataUtilities::GetMeshMTime(ug) <= ugMeshMTime,
+    "Mesh MTime did not change when polyhedron faces were modified");
+
   return EXIT_SUCCESS;
 }
@@ -46,6 +46,10 @@ int TestFileSequenceParser(int, char* argv[])
   check_group(seqParser.Get(), "prefix-021-suffix.ext", "prefix-..-suffix.ext");
   check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
   check_group(seqParser.Get(), "plt0001000", "plt..");
+  check_group(seqParser.Get(), "0001_foo.vtk", ".._foo.vtk");
+  check_group(seqParser.Get(), "12a.vtk", "..a.vtk");
+  check_group(seqParser.Get(), "dump-0000100.h5", "dump-..h5");
+  check_group(seqParser.Get(), "run.2.5.dat", "run.2...dat");
 
   check_no_group(seqParser.Get(), "foo.3dm");
   check_no_group(seqParser.Get(), "foo.2dm");
@@ -4,110 +4,198 @@
 
 #include "vtkObjectFactory.h"
 
-#include <set>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
 #include <string>
-#include <vtksys/RegularExpression.hxx>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
-vtkStandardNewMacro(vtkFileSequenceParser);
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::vtkFileSequenceParser()
-  : // sequence ending with numbers.
-  reg_ex(new vtksys::RegularExpression("^(.*)\\.([0-9.]+)$"))
-  ,
-  // sequence ending with extension.
-  reg_ex2(new vtksys::RegularExpression("^(.*)(\\.|_|-)([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, but with no ". or _" before
-  // the series number.
-  reg_ex3(new vtksys::RegularExpression("^(.*)([a-zA-Z])([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number
-  // followed by ". or _".
-  reg_ex4(new vtksys::RegularExpression("^([0-9.]+)(\\.|_|-)(.*)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number,
-  // but not followed by ". or _".
-  reg_ex5(new vtksys::RegularExpression("^([0-9.]+)([a-zA-Z])(.*)\\.(.*)$"))
-
-  ,
-  // fallback: any sequence with a number in the middle (taking the last number
-  // if multiple exist).
-  reg_ex_last(new vtksys::RegularExpression("^(.*[^0-9])([0-9]+)([^0-9]*)$"))
-  , SequenceIndex(-1)
-  , SequenceName(nullptr)
+namespace
 {
+inline bool IsIndexChar(char c)
+{
+  return (c >= '0' && c <= '9') || c == '.';
 }
 
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::~vtkFileSequenceParser()
+inline bool IsDigit(char c)
 {
-  delete this->reg_ex;
-  delete this->reg_ex2;
-  delete this->reg_ex3;
-  delete this->reg_ex4;
-  delete this->reg_ex5;
-  delete this->reg_ex_last;
+  return c >= '0' && c <= '9';
+}
 
-  this->SetSequenceName(nullptr);
+inline bool IsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
 }
 
-//-----------------------------------------------------------------------------
-bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+inline bool IsLetter(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// The file name is scanned once to build these tables, after which each of
+// the patterns below is matched in linear time. Each pattern reproduces the
+// greedy, left-to-right semantics of the regular expression quoted above it,
+// which is what this class used to rely on.
+struct vtkSequenceScanner
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
+  const std::string& Name;
+  std::ptrdiff_t Size;
+  // RunEnd[k]: end of the run of index characters starting at k (k if none).
+  std::vector<std::ptrdiff_t> RunEnd;
+  // LastDot[k]: position of the last '.' before k, -1 if none.
+  std::vector<std::ptrdiff_t> LastDot;
+
+  vtkSequenceScanner(const std::string& name)
+    : Name(name)
+    , Size(static_cast<std::ptrdiff_t>(name.size()))
+    , RunEnd(name.size() + 1)
+    , LastDot(name.size() + 1)
+  {
+    this->RunEnd[this->Size] = this->Size;
+    for (std::ptrdiff_t k = this->Size - 1; k >= 0; --k)
+    {
+      this->RunEnd[k] = IsIndexChar(name[k]) ? this->RunEnd[k + 1] : k;
+    }
+    this->LastDot[0] = -1;
+    for (std::ptrdiff_t k = 0; k < this->Size; ++k)
+    {
+      this->LastDot[k + 1] = name[k] == '.' ? k : this->LastDot[k];
+    }
+  }
+
+  std::string Sub(std::ptrdiff_t begin, std::ptrdiff_t end) const
+  {
+    return this->Name.substr(begin, end - begin);
+  }
+
+  // "^(.*)\.([0-9.]+)$"
+  bool MatchTrailingIndex(std::string& sequence, std::string& index) const
+  {
+    std::ptrdiff_t start = this->Size;
+    while (start > 0 && IsIndexChar(this->Name[start - 1]))
+    {
+      --start;
+    }
+    const std::ptrdiff_t dot = this->Size > 0 ? this->LastDot[this->Size - 1] : -1;
+    if (start == this->Size || dot < start)
+    {
+      return false;
+    }
+    sequence = this->Sub(0, dot);
+    index = this->Sub(dot + 1, this->Size);
+    return true;
+  }
+
+  // "^(.*)(\.|_|-)([0-9.]+)\.(.*)$" when `separator` is true,
+  // "^(.*)([a-zA-Z])([0-9.]+)\.(.*)$" otherwise.
+  bool MatchIndexBeforeExtension(bool separator, std::string& sequence, std::string& index) const
   {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndexString = this->reg_ex->match(2);
-    match = true;
+    for (std::ptrdiff_t cc = this->Size - 2; cc >= 0; --cc)
+    {
+      const char c = this->Name[cc];
+      if (!(separator ? IsSeparator(c) : IsLetter(c)) || !IsIndexChar(this->Name[cc + 1]))
+      {
+        continue;
+      }
+      const std::ptrdiff_t dot = this->LastDot[this->RunEnd[cc + 1]];
+      if (dot >= cc + 2)
+      {
+        sequence = this->Sub(0, cc + 1) + ".." + this->Sub(dot + 1, this->Size);
+        index = this->Sub(cc + 1, dot);
+        return true;
+      }
+    }
+    return false;
   }
-  else if (this->reg_ex2->find(file))
+
+  // "^([0-9.]+)(\.|_|-)(.*)\.(.*)$" when `separator` is true,
+  // "^([0-9.]+)([a-zA-Z])(.*)\.(.*)$" otherwise.
+  bool MatchLeadingIndex(bool separator, std::string& sequence, std::string& index) const
   {
-    this->SetSequenceName(std::string(
-      this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." + this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex2->match(3);
-    match = true;
+    const std::ptrdiff_t dot = this->LastDot[this->Size];
+    for (std::ptrdiff_t cc = std::min(this->RunEnd[0], this->Size - 1); cc >= 1; --cc)
+    {
+      const char c = this->Name[cc];
+      if ((separator ? IsSeparator(c) : IsLetter(c)) && dot >= cc + 1)
+      {
+        sequence = ".." + this->Sub(cc, dot) + "." + this->Sub(dot + 1, this->Size);
+        index = this->Sub(0, cc);
+        return true;
+      }
+    }
+    return false;
   }
-  else if (this->reg_ex3->find(file))
+};
+
+// "^(.*[^0-9])([0-9]+)([^0-9]*)$" i.e. the last number of `name`, provided it
+// does not start the name.
+bool MatchLastNumber(const std::string& name, std::string& prefix, std::string& index,
+  std::string& suffix)
+{
+  std::ptrdiff_t last = static_cast<std::ptrdiff_t>(name.size()) - 1;
+  while (last >= 0 && !IsDigit(name[last]))
   {
-    this->SetSequenceName(std::string(
-      this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." + this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex3->match(3);
-    match = true;
+    --last;
   }
-  else if (this->reg_ex4->find(file))
+  std::ptrdiff_t first = last;
+  while (first > 0 && IsDigit(name[first - 1]))
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) + "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex4->match(1);
-    match = true;
+    --first;
   }
-  else if (this->reg_ex5->find(file))
+  if (first <= 0)
   {
-    this->SetSequenceName(std::string(
-      ".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) + "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndexString = this->reg_ex5->match(1);
-    match = true;
+    return false;
   }
-  else
+  prefix = name.substr(0, first);
+  index = name.substr(first, last + 1 - first);
+  suffix = name.substr(last + 1);
+  return true;
+}
+}
+
+vtkStandardNewMacro(vtkFileSequenceParser);
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::vtkFileSequenceParser()
+  : SequenceIndex(-1)
+  , SequenceName(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::~vtkFileSequenceParser()
+{
+  this->SetSequenceName(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+{
+  const std::string fname = file ? file : "";
+  const vtkSequenceScanner scanner(fname);
+
+  std::string sequence;
+  bool match = scanner.MatchTrailingIndex(sequence, this->SequenceIndexString) ||
+    scanner.MatchIndexBeforeExtension(true, sequence, this->SequenceIndexString) ||
+    scanner.MatchIndexBeforeExtension(false, sequence, this->SequenceIndexString) ||
+    scanner.MatchLeadingIndex(true, sequence, this->SequenceIndexString) ||
+    scanner.MatchLeadingIndex(false, sequence, this->SequenceIndexString);
+  if (!match)
   {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
+    // fallback: any sequence with a number in the middle (taking the last number
+    // if multiple exist).
+    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(fname);
+    std::string ext = vtksys::SystemTools::GetFilenameExtension(fname);
+    std::string prefix, suffix;
+    if (MatchLastNumber(fname_wo_ext, prefix, this->SequenceIndexString, suffix))
     {
-      this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndexString = this->reg_ex_last->match(2);
+      sequence = prefix + ".." + suffix + ext;
       match = true;
     }
   }
   if (match)
   {
+    this->SetSequenceName(sequence.c_str());
     this->SequenceIndex = atoi(this->SequenceIndexString.c_str());
   }
   return match;
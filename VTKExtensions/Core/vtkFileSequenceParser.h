@@ -9,7 +9,13 @@
  * extract the base portion of the file name that is common to all the files
  * in the sequence. It will also provide the current sequence index of the
  * provided file name.
- * by several vtkPVUpdateSuppressor objects.
+ *
+ * The name is scanned once, in linear time, to locate the sequence index.
+ * The following patterns are recognized, in this order of precedence:
+ * `name.<index>`, `name[._-]<index>.ext`, `name<letter><index>.ext`,
+ * `<index>[._-]name.ext`, `<index><letter>name.ext` and, as a fallback, the
+ * last number of the name before its first extension. Indices are made of
+ * digits and dots.
  */
 
 #ifndef vtkFileSequenceParser_h
@@ -20,11 +26,6 @@
 
 #include <string> // for std::string
 
-namespace vtksys
-{
-class RegularExpression;
-}
-
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkFileSequenceParser : public vtkObject
 {
 public:
@@ -62,13 +63,6 @@ protected:
   vtkFileSequenceParser();
   ~vtkFileSequenceParser() override;
 
-  vtksys::RegularExpression* reg_ex;
-  vtksys::RegularExpression* reg_ex2;
-  vtksys::RegularExpression* reg_ex3;
-  vtksys::RegularExpression* reg_ex4;
-  vtksys::RegularExpression* reg_ex5;
-  vtksys::RegularExpression* reg_ex_last;
-
   // Used internal so char * allocations are done automatically.
   vtkSetStringMacro(SequenceName);
 
@@ -9,6 +9,106 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Tag used for the messages exchanged by vtkLogRecorder::SynchronizeClocks.
+constexpr int VTK_LOG_RECORDER_CLOCK_TAG = 35722;
+
+// Number of round trips used to estimate the clock offset of each rank; the
+// one with the shortest round trip gives the best estimate.
+constexpr int VTK_LOG_RECORDER_CLOCK_ROUNDS = 8;
+}
+
+class vtkLogRecorder::vtkInternals
+{
+public:
+  struct TraceEvent
+  {
+    double Time;
+    char Phase;
+    int Thread;
+    std::string Name;
+  };
+
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::map<std::thread::id, int> Threads;
+  std::string CallbackName;
+  vtkIdType MaximumNumberOfEvents = 1000000;
+  vtkIdType NumberOfDroppedEvents = 0;
+
+  // For each thread, whether the start of each of its open scopes was kept,
+  // innermost last.
+  std::map<int, std::vector<bool>> OpenScopes;
+
+  static double Now()
+  {
+    return std::chrono::duration<double, std::micro>(
+      std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+
+  void Record(const vtkLogger::Message& message)
+  {
+    TraceEvent event;
+    event.Time = vtkInternals::Now();
+    const char* text = message.message ? message.message : "";
+    if (message.prefix && message.prefix[0] == '{')
+    {
+      event.Phase = 'B';
+      event.Name = text;
+    }
+    else if (message.prefix && message.prefix[0] == '}')
+    {
+      // End of scope. The name is not needed since scopes nest on a thread.
+      event.Phase = 'E';
+    }
+    else
+    {
+      event.Phase = 'i';
+      event.Name = text;
+    }
+    std::replace(event.Name.begin(), event.Name.end(), '\n', ' ');
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Threads.emplace(
+      std::this_thread::get_id(), static_cast<int>(this->Threads.size()));
+    event.Thread = iter.first->second;
+
+    // Once the buffer is full, only the ends of the scopes whose start was
+    // kept are still recorded so that every kept scope remains matched.
+    bool keep = static_cast<vtkIdType>(this->Events.size()) < this->MaximumNumberOfEvents;
+    auto& scopes = this->OpenScopes[event.Thread];
+    if (event.Phase == 'B')
+    {
+      scopes.push_back(keep);
+    }
+    else if (event.Phase == 'E' && !scopes.empty())
+    {
+      keep = scopes.back();
+      scopes.pop_back();
+    }
+    if (keep)
+    {
+      this->Events.push_back(std::move(event));
+    }
+    else
+    {
+      ++this->NumberOfDroppedEvents;
+    }
+  }
+};
+
 vtkStandardNewMacro(vtkLogRecorder);
 
 //----------------------------------------------------------------------------
@@ -17,6 +117,7 @@ vtkLogRecorder::vtkLogRecorder()
   auto controller = vtkMultiProcessController::GetGlobalController();
   this->MyRank = controller->GetLocalProcessId();
   this->Verbosity = vtkLogger::VERBOSITY_INVALID;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
@@ -26,6 +127,8 @@ vtkLogRecorder::~vtkLogRecorder()
   {
     this->DisableLoggingCallback();
   }
+  this->SetTraceEnabled(false);
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -48,6 +151,11 @@ void vtkLogRecorder::SetVerbosity(int verbosity)
   {
     this->EnableLoggingCallback();
   }
+  if (this->TraceEnabled)
+  {
+    this->DisableTraceCallback();
+    this->EnableTraceCallback();
+  }
 
   this->Modified();
 }
@@ -125,6 +233,160 @@ void vtkLogRecorder::ClearLogs()
   this->Logs.clear();
 }
 
+//----------------------------------------------------------------------------
+void vtkLogRecorder::SetTraceEnabled(bool enabled)
+{
+  if (this->TraceEnabled == enabled)
+  {
+    return;
+  }
+  this->TraceEnabled = enabled;
+  if (enabled)
+  {
+    this->EnableTraceCallback();
+  }
+  else
+  {
+    this->DisableTraceCallback();
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkLogRecorder::EnableTraceCallback()
+{
+  // Messages more verbose than the recording verbosity are not traced so that
+  // recording does not make the logger format every message.
+  auto& internals = *this->Internals;
+  internals.CallbackName = "trace-grabber_" + std::to_string(this->MyRank) + "_" +
+    std::to_string(reinterpret_cast<std::uintptr_t>(this));
+  vtkLogger::AddCallback(
+    internals.CallbackName.c_str(),
+    [](void* user_data, const vtkLogger::Message& message) {
+      reinterpret_cast<vtkInternals*>(user_data)->Record(message);
+    },
+    &internals, static_cast<vtkLogger::Verbosity>(this->Verbosity));
+}
+
+//----------------------------------------------------------------------------
+void vtkLogRecorder::DisableTraceCallback()
+{
+  auto& internals = *this->Internals;
+  vtkLogger::RemoveCallback(internals.CallbackName.c_str());
+  internals.CallbackName.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkLogRecorder::SynchronizeClocks()
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+  if (numRanks <= 1)
+  {
+    this->ClockOffset = 0.0;
+    return;
+  }
+
+  // Cristian's algorithm: each rank asks rank 0 for its time a few times and
+  // assumes it was read halfway through the shortest round trip.
+  if (this->MyRank == 0)
+  {
+    for (int rank = 1; rank < numRanks; ++rank)
+    {
+      for (int round = 0; round < VTK_LOG_RECORDER_CLOCK_ROUNDS; ++round)
+      {
+        int ping;
+        controller->Receive(&ping, 1, rank, VTK_LOG_RECORDER_CLOCK_TAG);
+        double now = vtkInternals::Now();
+        controller->Send(&now, 1, rank, VTK_LOG_RECORDER_CLOCK_TAG);
+      }
+    }
+    this->ClockOffset = 0.0;
+  }
+  else
+  {
+    double bestRoundTrip = std::numeric_limits<double>::max();
+    for (int round = 0; round < VTK_LOG_RECORDER_CLOCK_ROUNDS; ++round)
+    {
+      int ping = round;
+      const double start = vtkInternals::Now();
+      controller->Send(&ping, 1, 0, VTK_LOG_RECORDER_CLOCK_TAG);
+      double reference;
+      controller->Receive(&reference, 1, 0, VTK_LOG_RECORDER_CLOCK_TAG);
+      const double end = vtkInternals::Now();
+      if (end - start < bestRoundTrip)
+      {
+        bestRoundTrip = end - start;
+        this->ClockOffset = reference - 0.5 * (start + end);
+      }
+    }
+  }
+  vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "trace clock offset: %f us", this->ClockOffset);
+}
+
+//----------------------------------------------------------------------------
+double vtkLogRecorder::GetTraceTime() const
+{
+  return vtkInternals::Now() + this->ClockOffset;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkLogRecorder::GetTraceEvents() const
+{
+  auto& internals = *this->Internals;
+  std::ostringstream stream;
+  stream.precision(std::numeric_limits<double>::max_digits10);
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  for (const auto& event : internals.Events)
+  {
+    stream << (event.Time + this->ClockOffset) << " " << event.Phase << " " << event.Thread << " "
+           << event.Name << "\n";
+  }
+  return stream.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkLogRecorder::ClearTraceEvents()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Events.clear();
+  internals.NumberOfDroppedEvents = 0;
+  // The starts of the scopes still open are gone: drop their ends too.
+  for (auto& scopes : internals.OpenScopes)
+  {
+    scopes.second.assign(scopes.second.size(), false);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkLogRecorder::SetMaximumNumberOfTraceEvents(vtkIdType count)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  if (internals.MaximumNumberOfEvents != count)
+  {
+    internals.MaximumNumberOfEvents = std::max<vtkIdType>(count, 0);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLogRecorder::GetMaximumNumberOfTraceEvents() const
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.MaximumNumberOfEvents;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLogRecorder::GetNumberOfDroppedTraceEvents() const
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.NumberOfDroppedEvents;
+}
+
 //----------------------------------------------------------------------------
 void vtkLogRecorder::SetCategoryVerbosity(int categoryIndex, int verbosity)
 {
@@ -173,4 +435,8 @@ void vtkLogRecorder::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Activation Count: " << this->RankEnabled << endl;
   os << indent << "Callback Name: " << this->CallbackName << endl;
   os << indent << "Log Buffer: " << this->Logs << endl;
+  os << indent << "TraceEnabled: " << this->TraceEnabled << endl;
+  os << indent << "ClockOffset: " << this->ClockOffset << endl;
+  os << indent << "MaximumNumberOfTraceEvents: " << this->GetMaximumNumberOfTraceEvents() << endl;
+  os << indent << "NumberOfDroppedTraceEvents: " << this->GetNumberOfDroppedTraceEvents() << endl;
 }
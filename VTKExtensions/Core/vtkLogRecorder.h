@@ -17,6 +17,12 @@
  * This class can be used to record log messages at or below a verbosity specified by
  * SetVerbosity(). If the process is run as an MPI job, the log messages from a
  * rank enabled via SetRankEnabled() will be recorded.
+ *
+ * Independently, vtkLogRecorder can record a timeline of trace events on every
+ * rank (see SetTraceEnabled()): the start and end of each vtkLogger scope and
+ * every other log message, time-stamped and tagged with the thread that
+ * emitted it. vtkPVLogInformation collects these events so that the timelines
+ * of all processes can be merged, e.g. with vtkPVLogTimelineWriter.
  */
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkLogRecorder : public vtkObject
 {
@@ -72,6 +78,66 @@ public:
    */
   void ClearLogs();
 
+  ///@{
+  /**
+   * Enable/disable recording of trace events on this process. Unlike log
+   * messages, trace events are recorded on all ranks while enabled. Only the
+   * messages and scopes at or below the verbosity set by SetVerbosity() are
+   * recorded. Default is false.
+   */
+  void SetTraceEnabled(bool enabled);
+  vtkGetMacro(TraceEnabled, bool);
+  vtkBooleanMacro(TraceEnabled, bool);
+  ///@}
+
+  /**
+   * Estimate the offset between the clock of this rank and the clock of rank
+   * 0 of the global controller, which is then used to correct the times of
+   * the trace events recorded on this rank. This must be called on all ranks.
+   */
+  void SynchronizeClocks();
+
+  /**
+   * Get the offset, in microseconds, added to the local clock to align it on
+   * the clock of rank 0. Computed by SynchronizeClocks().
+   */
+  vtkGetMacro(ClockOffset, double);
+
+  /**
+   * Get the current time, in microseconds, on the clock used for trace events.
+   */
+  double GetTraceTime() const;
+
+  /**
+   * Get the trace events recorded so far, one per line, formatted as
+   * `<time> <phase> <thread> <name>` where time is in microseconds on the
+   * clock of rank 0 and phase is `B` for the start of a scope, `E` for its end
+   * and `i` for any other log message.
+   */
+  std::string GetTraceEvents() const;
+
+  /**
+   * Clear any trace events recorded.
+   */
+  void ClearTraceEvents();
+
+  ///@{
+  /**
+   * Set/get the maximum number of trace events kept on this process. Once it
+   * is reached, new events are dropped, except for the ends of the scopes
+   * whose start was kept so that all recorded scopes remain matched. Default
+   * is 1000000.
+   */
+  void SetMaximumNumberOfTraceEvents(vtkIdType count);
+  vtkIdType GetMaximumNumberOfTraceEvents() const;
+  ///@}
+
+  /**
+   * Get the number of trace events dropped because the maximum number of
+   * trace events was reached, since the last ClearTraceEvents().
+   */
+  vtkIdType GetNumberOfDroppedTraceEvents() const;
+
   /**
    * Set the verbosity of a ParaView logging category.
    */
@@ -87,6 +153,11 @@ private:
   void operator=(const vtkLogRecorder&) = delete;
   void EnableLoggingCallback();
   void DisableLoggingCallback();
+  void EnableTraceCallback();
+  void DisableTraceCallback();
+
+  class vtkInternals;
+  vtkInternals* Internals;
 
   int Verbosity;
   std::string Logs;
@@ -94,6 +165,8 @@ private:
   std::string StartingLog;
   int MyRank;
   int RankEnabled = 0;
+  bool TraceEnabled = false;
+  double ClockOffset = 0.0;
 };
 
 #endif // vtkLogRecorder_h
@@ -2,15 +2,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVDataUtilities.h"
 
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
 #include "vtkInformation.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUniformGrid.h"
 #include "vtkUniformGridAMR.h"
 
+#include <algorithm>
 #include <cmath>
 
 // clang-format off
@@ -189,6 +197,60 @@ std::string vtkPVDataUtilities::GetAssignedNameForBlock(vtkDataObject* block)
   return {};
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPVDataUtilities::GetMeshMTime(vtkDataSet* ds)
+{
+  if (!ds)
+  {
+    return 0;
+  }
+
+  vtkMTimeType mtime = 0;
+  auto accumulate = [&mtime](vtkObject* obj) {
+    if (obj)
+    {
+      mtime = std::max(mtime, obj->GetMTime());
+    }
+  };
+
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    accumulate(ug->GetPoints());
+    accumulate(ug->GetCells());
+    accumulate(ug->GetCellTypesArray());
+    // polyhedra are described by their faces, stored apart from the cells.
+    accumulate(ug->GetPolyhedronFaces());
+    accumulate(ug->GetPolyhedronFaceLocations());
+  }
+  else if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    accumulate(pd->GetPoints());
+    accumulate(pd->GetVerts());
+    accumulate(pd->GetLines());
+    accumulate(pd->GetPolys());
+    accumulate(pd->GetStrips());
+  }
+  else if (auto ps = vtkPointSet::SafeDownCast(ds))
+  {
+    // structured grids: the topology is implicit in the dimensions.
+    accumulate(ps->GetPoints());
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    accumulate(rg->GetXCoordinates());
+    accumulate(rg->GetYCoordinates());
+    accumulate(rg->GetZCoordinates());
+  }
+  else
+  {
+    // implicit geometry (image data, hyper tree grids, ...) is described by
+    // the dataset's own ivars, only the dataset MTime tracks it.
+    mtime = ds->vtkObject::GetMTime();
+  }
+
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataUtilities::PrintSelf(ostream& os, vtkIndent indent)
 {
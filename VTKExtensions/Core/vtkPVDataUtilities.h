@@ -17,6 +17,7 @@
 #include <string> // for std::string
 
 class vtkDataObject;
+class vtkDataSet;
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVDataUtilities : public vtkObject
 {
 public:
@@ -40,6 +41,17 @@ public:
    */
   static std::string GetAssignedNameForBlock(vtkDataObject* block);
 
+  /**
+   * Returns a modification time that only changes when the mesh of `ds`
+   * changes, i.e. its points, cell connectivity, polyhedron faces or
+   * rectilinear coordinates. Field arrays and the dataset's own MTime are
+   * ignored so that filters can keep caches built from the geometry (locators,
+   * ghost exchanges, ...) when only point or cell data is modified. Datasets
+   * with implicit geometry, such as vtkImageData, fall back to the dataset
+   * MTime. Returns 0 for nullptr.
+   */
+  static vtkMTimeType GetMeshMTime(vtkDataSet* ds);
+
 protected:
   vtkPVDataUtilities();
   ~vtkPVDataUtilities() override;
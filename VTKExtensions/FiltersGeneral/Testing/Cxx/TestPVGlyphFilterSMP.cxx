@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTransform.h"
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Glyphs every other point, checking that points are tested in increasing order.
+class vtkEvenPointsGlyphFilter : public vtkPVGlyphFilter
+{
+public:
+  static vtkEvenPointsGlyphFilter* New();
+  vtkTypeMacro(vtkEvenPointsGlyphFilter, vtkPVGlyphFilter);
+
+  bool TestedInOrder = true;
+
+protected:
+  vtkEvenPointsGlyphFilter() = default;
+  ~vtkEvenPointsGlyphFilter() override = default;
+
+  int IsPointVisible(unsigned int, vtkDataSet*, vtkIdType ptId, bool) override
+  {
+    this->TestedInOrder = this->TestedInOrder && ptId > this->LastPointId;
+    this->LastPointId = ptId;
+    return ptId % 2 == 0 ? 1 : 0;
+  }
+
+private:
+  vtkIdType LastPointId = -1;
+};
+vtkStandardNewMacro(vtkEvenPointsGlyphFilter);
+
+vtkSmartPointer<vtkPolyData> MakeInput(vtkIdType numPts)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(42);
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numPts);
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    double x[3], v[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      random->Next();
+      x[i] = random->GetRangeValue(-10.0, 10.0);
+      random->Next();
+      v[i] = random->GetRangeValue(-1.0, 1.0);
+    }
+    points->SetPoint(cc, x);
+    vectors->SetTypedTuple(cc, v);
+    scalars->SetValue(cc, static_cast<double>(cc));
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(vectors);
+  input->GetPointData()->AddArray(scalars);
+  return input;
+}
+
+vtkSmartPointer<vtkPolyData> MakeSource()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(3);
+  normals->InsertNextTuple3(0, 0, 1);
+  normals->InsertNextTuple3(1, 0, 0);
+  normals->InsertNextTuple3(0, 1, 0);
+  normals->InsertNextTuple3(0.577, 0.577, 0.577);
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType tri0[3] = { 0, 1, 2 };
+  const vtkIdType tri1[3] = { 0, 1, 3 };
+  const vtkIdType quad[4] = { 0, 2, 3, 1 };
+  polys->InsertNextCell(3, tri0);
+  polys->InsertNextCell(3, tri1);
+  polys->InsertNextCell(4, quad);
+
+  auto source = vtkSmartPointer<vtkPolyData>::New();
+  source->SetPoints(points);
+  source->SetPolys(polys);
+  source->GetPointData()->SetNormals(normals);
+  return source;
+}
+
+bool ArraysEqual(vtkDataArray* a, vtkDataArray* b)
+{
+  vtk_assert(a != nullptr && b != nullptr);
+  vtk_assert(a->GetNumberOfTuples() == b->GetNumberOfTuples());
+  vtk_assert(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+    {
+      vtk_assert(a->GetComponent(cc, comp) == b->GetComponent(cc, comp));
+    }
+  }
+  return true;
+}
+
+bool CompareGlyphs(int glyphMode, bool useSourceTransform)
+{
+  auto input = MakeInput(2000);
+  auto source = MakeSource();
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateZ(30);
+  sourceTransform->Translate(-0.5, 0, 0);
+
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  for (int smp = 0; smp < 2; ++smp)
+  {
+    vtkNew<vtkPVGlyphFilter> glyph;
+    glyph->SetInputData(input);
+    glyph->SetInputData(1, source);
+    glyph->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "vectors");
+    glyph->SetInputArrayToProcess(1, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "vectors");
+    glyph->SetVectorScaleMode(vtkPVGlyphFilter::SCALE_BY_COMPONENTS);
+    glyph->SetScaleFactor(0.5);
+    glyph->SetGlyphMode(glyphMode);
+    glyph->SetStride(3);
+    glyph->SetMaximumNumberOfSamplePoints(500);
+    glyph->SetUseSMPTools(smp == 1);
+    if (useSourceTransform)
+    {
+      glyph->SetSourceTransform(sourceTransform);
+    }
+    glyph->Update();
+    outputs[smp] = vtkPolyData::SafeDownCast(glyph->GetOutputDataObject(0));
+    vtk_assert(outputs[smp] != nullptr);
+  }
+
+  vtkPolyData* serial = outputs[0];
+  vtkPolyData* parallel = outputs[1];
+  vtk_assert(serial->GetNumberOfPoints() > 0);
+  vtk_assert(serial->GetNumberOfCells() == parallel->GetNumberOfCells());
+  vtk_assert(ArraysEqual(serial->GetPoints()->GetData(), parallel->GetPoints()->GetData()));
+  vtk_assert(
+    ArraysEqual(serial->GetPolys()->GetOffsetsArray(), parallel->GetPolys()->GetOffsetsArray()));
+  vtk_assert(ArraysEqual(
+    serial->GetPolys()->GetConnectivityArray(), parallel->GetPolys()->GetConnectivityArray()));
+  vtk_assert(serial->GetPointData()->GetNumberOfArrays() ==
+    parallel->GetPointData()->GetNumberOfArrays());
+  for (int cc = 0; cc < serial->GetPointData()->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = serial->GetPointData()->GetArray(cc);
+    vtk_assert(ArraysEqual(array, parallel->GetPointData()->GetArray(array->GetName())));
+  }
+  return true;
+}
+
+bool TestOverriddenIsPointVisible()
+{
+  auto input = MakeInput(2000);
+  auto source = MakeSource();
+  vtkNew<vtkEvenPointsGlyphFilter> glyph;
+  glyph->SetInputData(input);
+  glyph->SetInputData(1, source);
+  glyph->SetUseSMPTools(true);
+  glyph->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(glyph->GetOutputDataObject(0));
+  vtk_assert(output != nullptr);
+  vtk_assert(glyph->TestedInOrder);
+  vtk_assert(output->GetNumberOfPoints() == 1000 * source->GetNumberOfPoints());
+  return true;
+}
+}
+
+int TestPVGlyphFilterSMP(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const int modes[3] = { vtkPVGlyphFilter::ALL_POINTS, vtkPVGlyphFilter::EVERY_NTH_POINT,
+    vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION };
+  for (int mode : modes)
+  {
+    if (!CompareGlyphs(mode, false) || !CompareGlyphs(mode, true))
+    {
+      cerr << "SMP and serial glyphs differ for glyph mode " << mode << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!TestOverriddenIsPointVisible())
+  {
+    cerr << "IsPointVisible overrides are ignored by the SMP path." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
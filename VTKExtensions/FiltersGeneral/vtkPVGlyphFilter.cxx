@@ -12,8 +12,10 @@
 #include "vtkDataSetTriangleFilter.h"
 #include "vtkFloatArray.h"
 #include "vtkGenerateIds.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -22,6 +24,8 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
@@ -44,6 +48,123 @@
 #include <vector>
 
 static const std::string IDS_ARRAY_NAME = "vtkPVGlyphFilter_Ids";
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Computes the (x, y, z) scale for the glyph placed at `ptId`. Shared between
+// the serial and SMP code paths so that both produce identical glyphs.
+void ComputeGlyphScale(vtkDataArray* scaleArray, vtkIdType ptId, int vectorScaleMode,
+  double scaleFactor, double scale[3])
+{
+  scale[0] = scale[1] = scale[2] = 1.0;
+  if (scaleArray)
+  {
+    const int numComps = scaleArray->GetNumberOfComponents();
+    if (numComps == 1)
+    {
+      scale[0] = scale[1] = scale[2] = scaleArray->GetComponent(ptId, 0);
+    }
+    else if (numComps == 2 || numComps == 3)
+    {
+      double vec[3] = { 0.0, 0.0, 0.0 };
+      scaleArray->GetTuple(ptId, vec);
+      if (vectorScaleMode == vtkPVGlyphFilter::SCALE_BY_MAGNITUDE)
+      {
+        scale[0] = scale[1] = scale[2] = numComps == 2 ? vtkMath::Norm2D(vec) : vtkMath::Norm(vec);
+      }
+      else
+      {
+        scale[0] = vec[0];
+        scale[1] = vec[1];
+        // leave scale[2] alone for 2D
+        if (numComps == 3)
+        {
+          scale[2] = vec[2];
+        }
+      }
+    }
+  }
+
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    scale[cc] *= scaleFactor;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Sets up `trans` to place a glyph at `x`, oriented along the `orientArray`
+// tuple for `ptId` and scaled by `scale`.
+void BuildGlyphTransform(
+  vtkTransform* trans, const double x[3], vtkDataArray* orientArray, vtkIdType ptId, double scale[3])
+{
+  trans->Identity();
+  trans->Translate(x[0], x[1], x[2]);
+
+  if (orientArray)
+  {
+    double v[3] = { 0.0 };
+    orientArray->GetTuple(ptId, v);
+    double vMag = vtkMath::Norm(v);
+    if (vMag > 0.0)
+    {
+      // if there is no y or z component
+      if (v[1] == 0.0 && v[2] == 0.0)
+      {
+        if (v[0] < 0) // just flip x if we need to
+        {
+          trans->RotateWXYZ(180.0, 0, 1, 0);
+        }
+      }
+      else
+      {
+        double vNew[3];
+        vNew[0] = (v[0] + vMag) / 2.0;
+        vNew[1] = v[1] / 2.0;
+        vNew[2] = v[2] / 2.0;
+        trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+      }
+    }
+  }
+
+  // scale data if appropriate
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    if (scale[cc] == 0.0)
+    {
+      scale[cc] = 1.0e-10;
+    }
+  }
+  trans->Scale(scale[0], scale[1], scale[2]);
+}
+
+//-----------------------------------------------------------------------------
+// The SMP path fills each cell array of the output independently. To keep the
+// cell ordering identical to the serial path (which calls InsertNextCell in
+// source order), it is only used when the glyph source has a single kind of
+// cells.
+vtkCellArray* GetSingleCellArray(vtkPolyData* source, int& kind)
+{
+  vtkCellArray* arrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+    source->GetStrips() };
+  vtkCellArray* result = nullptr;
+  kind = -1;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    if (arrays[cc] && arrays[cc]->GetNumberOfCells() > 0)
+    {
+      if (result)
+      {
+        return nullptr;
+      }
+      result = arrays[cc];
+      kind = cc;
+    }
+  }
+  return result;
+}
+}
+
 class vtkPVGlyphFilter::vtkInternals
 {
   vtkDataSet* LastDataSet = nullptr;
@@ -498,6 +619,7 @@ vtkPVGlyphFilter::vtkPVGlyphFilter()
   , Stride(1)
   , Controller(nullptr)
   , OutputPointsPrecision(vtkAlgorithm::DEFAULT_PRECISION)
+  , UseSMPTools(true)
   , Internals(new vtkPVGlyphFilter::vtkInternals())
 {
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -743,6 +865,27 @@ int vtkPVGlyphFilter::IsPointVisible(
   return this->Internals->IsPointVisible(index, ds, ptId, cellCenters, this);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPVGlyphFilter::IsPointGlyphed(unsigned int index, vtkDataSet* ds, vtkIdType ptId,
+  const unsigned char* ghosts, vtkUniformGrid* uniformGrid, bool cellCenters)
+{
+  // Check ghost points.
+  // If we are processing a piece, we do not want to duplicate
+  // glyphs on the borders.
+  if (ghosts && ghosts[ptId] & vtkDataSetAttributes::DUPLICATEPOINT)
+  {
+    return false;
+  }
+
+  // this is used to respect blanking specified on uniform grids.
+  if (uniformGrid && !uniformGrid->IsPointVisible(ptId))
+  {
+    return false;
+  }
+
+  return this->IsPointVisible(index, ds, ptId, cellCenters) != 0;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkPVGlyphFilter::IsInputArrayToProcessValid(vtkDataSet* input)
 {
@@ -879,6 +1022,12 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
 
+  int sourceCellKind;
+  if (this->UseSMPTools && ::GetSingleCellArray(source, sourceCellKind) != nullptr)
+  {
+    return this->ExecuteSMP(index, input, source, output, scaleArray, orientArray, cellCenters);
+  }
+
   // Allocate storage for output point data
   vtkPointData* outputPD = output->GetPointData();
   outputPD->CopyNormalsOff();
@@ -934,89 +1083,23 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   vtkNew<vtkIdList> pointIdList;
   vtkIdType ptIncr = 0;
   vtkIdType cellIncr = 0;
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
   for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
   {
-    double scalex(1.0), scaley(1.0), scalez(1.0);
     if (!(inPtId % 10000))
     {
       this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
+      if (this->CheckAbort())
       {
         break;
       }
     }
 
-    // Get the scalar and vector data
-    if (scaleArray)
+    if (!this->IsPointGlyphed(index, input, inPtId, inGhostLevels, inputUG, cellCenters))
     {
-      if (scaleArray->GetNumberOfComponents() == 1)
-      {
-        scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
-      }
-      else
-      {
-        // Consider the vector scaling mode
-        if (scaleArray->GetNumberOfComponents() == 2)
-        {
-          double* vec2 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm2D(vec2);
-          }
-          else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
-          {
-            scalex = vec2[0];
-            scaley = vec2[1];
-            // leave scalez alone for 2D
-          }
-        }
-        else if (scaleArray->GetNumberOfComponents() == 3)
-        {
-          double* vec3 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm(vec3);
-          }
-          else
-          {
-            scalex = vec3[0];
-            scaley = vec3[1];
-            scalez = vec3[2];
-          }
-        }
-      }
-    }
-
-    // Apply scale factor
-    scalex *= this->ScaleFactor;
-    scaley *= this->ScaleFactor;
-    scalez *= this->ScaleFactor;
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
-    {
-      continue;
-    }
-
-    // this is used to respect blanking specified on uniform grids.
-    vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
       continue;
     }
 
-    if (!this->IsPointVisible(index, input, inPtId, cellCenters))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
     // Copy all topology (transformation independent)
     for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
     {
@@ -1030,51 +1113,12 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
       output->InsertNextCell(source->GetCellType(cellId), pts);
     }
 
-    // translate Source to Input point
+    // translate, orient and scale Source to Input point
     double x[3];
+    double scale[3];
     input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (orientArray)
-    {
-      double v[3] = { 0.0 };
-      orientArray->GetTuple(inPtId, v);
-      double vMag = vtkMath::Norm(v);
-      if (vMag > 0.0)
-      {
-        // if there is no y or z component
-        if (v[1] == 0.0 && v[2] == 0.0)
-        {
-          if (v[0] < 0) // just flip x if we need to
-          {
-            trans->RotateWXYZ(180.0, 0, 1, 0);
-          }
-        }
-        else
-        {
-          double vNew[3];
-          vNew[0] = (v[0] + vMag) / 2.0;
-          vNew[1] = v[1] / 2.0;
-          vNew[2] = v[2] / 2.0;
-          trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-        }
-      }
-    }
-
-    // scale data if appropriate
-    if (scalex == 0.0)
-    {
-      scalex = 1.0e-10;
-    }
-    if (scaley == 0.0)
-    {
-      scaley = 1.0e-10;
-    }
-    if (scalez == 0.0)
-    {
-      scalez = 1.0e-10;
-    }
-    trans->Scale(scalex, scaley, scalez);
+    ::ComputeGlyphScale(scaleArray, inPtId, this->VectorScaleMode, this->ScaleFactor, scale);
+    ::BuildGlyphTransform(trans, x, orientArray, inPtId, scale);
 
     // multiply points and normals by resulting matrix
     if (this->SourceTransform)
@@ -1127,6 +1171,235 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVGlyphFilter::ExecuteSMP(unsigned int index, vtkDataSet* input, vtkPolyData* source,
+  vtkPolyData* output, vtkDataArray* scaleArray, vtkDataArray* orientArray, bool cellCenters)
+{
+  int sourceCellKind;
+  vtkCellArray* sourceCells = ::GetSingleCellArray(source, sourceCellKind);
+  assert(sourceCells != nullptr);
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* pd = input->GetPointData();
+
+  unsigned char* inGhostLevels = nullptr;
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    pd ? pd->GetArray(vtkDataSetAttributes::GhostArrayName()) : nullptr);
+  if (ghosts && ghosts->GetNumberOfComponents() == 1)
+  {
+    inGhostLevels = ghosts->GetPointer(0);
+  }
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+
+  // Pass 1: select points to glyph. This is done serially, in increasing point
+  // order, with the same test as Execute(): IsPointVisible() may be overridden
+  // and is neither required to be thread-safe nor to support points tested out
+  // of order. `glyphOffsets[ptId]` ends up being the index of the glyph
+  // generated for `ptId`, and `glyphOffsets[numPts]` the total number of glyphs.
+  std::vector<vtkIdType> glyphOffsets(numPts + 1, 0);
+  vtkIdType numGlyphs = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (!(ptId % 10000))
+    {
+      this->UpdateProgress(0.25 * ptId / numPts);
+      if (this->CheckAbort())
+      {
+        return true;
+      }
+    }
+    glyphOffsets[ptId] = numGlyphs;
+    if (this->IsPointGlyphed(index, input, ptId, inGhostLevels, inputUG, cellCenters))
+    {
+      ++numGlyphs;
+    }
+  }
+  glyphOffsets[numPts] = numGlyphs;
+  this->UpdateProgress(0.25);
+
+  // vtkDataSet::GetPoint() is only thread-safe once it has been called from a
+  // single thread.
+  double tmp[3];
+  input->GetPoint(0, tmp);
+
+  // Gather the source geometry once. The SourceTransform is independent of the
+  // glyphed point, so it is applied here rather than per glyph.
+  vtkPoints* sourcePts = source->GetPoints();
+  const vtkIdType numSourcePts = sourcePts->GetNumberOfPoints();
+  vtkNew<vtkPoints> glyphPts;
+  glyphPts->SetDataTypeToDouble();
+  if (this->SourceTransform)
+  {
+    glyphPts->Allocate(numSourcePts);
+    this->SourceTransform->TransformPoints(sourcePts, glyphPts);
+  }
+  else
+  {
+    glyphPts->DeepCopy(sourcePts);
+  }
+
+  std::vector<vtkIdType> sourceOffsets(1, 0);
+  std::vector<vtkIdType> sourceConnectivity;
+  vtkIdType npts;
+  const vtkIdType* cellPts;
+  for (sourceCells->InitTraversal(); sourceCells->GetNextCell(npts, cellPts);)
+  {
+    sourceConnectivity.insert(sourceConnectivity.end(), cellPts, cellPts + npts);
+    sourceOffsets.push_back(static_cast<vtkIdType>(sourceConnectivity.size()));
+  }
+  const vtkIdType numSourceCells = static_cast<vtkIdType>(sourceOffsets.size()) - 1;
+  const vtkIdType sourceConnectivitySize = static_cast<vtkIdType>(sourceConnectivity.size());
+
+  // Allocate all outputs up front so that pass 2 only writes at known offsets.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(
+    this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ? VTK_DOUBLE : VTK_FLOAT);
+  newPts->SetNumberOfPoints(numGlyphs * numSourcePts);
+
+  vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
+  vtkSmartPointer<vtkFloatArray> newNormals;
+  if (sourceNormals)
+  {
+    newNormals = vtkSmartPointer<vtkFloatArray>::New();
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetNumberOfTuples(numGlyphs * numSourcePts);
+    newNormals->SetName("Normals");
+  }
+
+  vtkPointData* outputPD = output->GetPointData();
+  outputPD->CopyNormalsOff();
+  outputPD->CopyAllocate(pd, numGlyphs * numSourcePts);
+  outputPD->SetNumberOfTuples(numGlyphs * numSourcePts);
+
+  vtkNew<vtkIdTypeArray> newOffsets;
+  newOffsets->SetNumberOfTuples(numGlyphs * numSourceCells + 1);
+  newOffsets->SetValue(numGlyphs * numSourceCells, numGlyphs * sourceConnectivitySize);
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  newConnectivity->SetNumberOfTuples(numGlyphs * sourceConnectivitySize);
+
+  // Pass 2: transform the source and emit geometry and attributes for every
+  // selected point.
+  vtkSMPThreadLocalObject<vtkTransform> tlTransform;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkTransform* trans = tlTransform.Local();
+    double matrix[4][4];
+    double normalMatrix[4][4];
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (!(ptId % 10000))
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
+      }
+
+      const vtkIdType glyphId = glyphOffsets[ptId];
+      if (glyphOffsets[ptId + 1] == glyphId)
+      {
+        continue;
+      }
+
+      double x[3];
+      double scale[3];
+      input->GetPoint(ptId, x);
+      ::ComputeGlyphScale(scaleArray, ptId, this->VectorScaleMode, this->ScaleFactor, scale);
+      ::BuildGlyphTransform(trans, x, orientArray, ptId, scale);
+      vtkMatrix4x4::DeepCopy(*matrix, trans->GetMatrix());
+
+      // Same arithmetic as vtkLinearTransform::TransformPoints().
+      const vtkIdType ptOffset = glyphId * numSourcePts;
+      for (vtkIdType cc = 0; cc < numSourcePts; ++cc)
+      {
+        double in[3], out[3];
+        glyphPts->GetPoint(cc, in);
+        for (int r = 0; r < 3; ++r)
+        {
+          out[r] = matrix[r][0] * in[0] + matrix[r][1] * in[1] + matrix[r][2] * in[2] + matrix[r][3];
+        }
+        newPts->SetPoint(ptOffset + cc, out);
+        if (pd)
+        {
+          outputPD->CopyData(pd, ptId, ptOffset + cc);
+        }
+      }
+
+      // Same arithmetic as vtkLinearTransform::TransformNormals().
+      if (newNormals)
+      {
+        vtkMatrix4x4::Invert(*matrix, *normalMatrix);
+        vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
+        for (vtkIdType cc = 0; cc < numSourcePts; ++cc)
+        {
+          double in[3];
+          float out[3];
+          sourceNormals->GetTuple(cc, in);
+          for (int r = 0; r < 3; ++r)
+          {
+            out[r] = static_cast<float>(
+              normalMatrix[r][0] * in[0] + normalMatrix[r][1] * in[1] + normalMatrix[r][2] * in[2]);
+          }
+          vtkMath::Normalize(out);
+          newNormals->SetTypedTuple(ptOffset + cc, out);
+        }
+      }
+
+      const vtkIdType cellOffset = glyphId * numSourceCells;
+      const vtkIdType connOffset = glyphId * sourceConnectivitySize;
+      for (vtkIdType cc = 0; cc < numSourceCells; ++cc)
+      {
+        newOffsets->SetValue(cellOffset + cc, connOffset + sourceOffsets[cc]);
+      }
+      for (vtkIdType cc = 0; cc < sourceConnectivitySize; ++cc)
+      {
+        newConnectivity->SetValue(connOffset + cc, sourceConnectivity[cc] + ptOffset);
+      }
+    }
+  });
+  if (this->GetAbortExecute())
+  {
+    return true;
+  }
+  this->UpdateProgress(0.9);
+
+  vtkNew<vtkCellArray> newCells;
+  newCells->SetData(newOffsets, newConnectivity);
+  switch (sourceCellKind)
+  {
+    case 0:
+      output->SetVerts(newCells);
+      break;
+    case 1:
+      output->SetLines(newCells);
+      break;
+    case 2:
+      output->SetPolys(newCells);
+      break;
+    default:
+      output->SetStrips(newCells);
+      break;
+  }
+
+  if (newNormals)
+  {
+    outputPD->SetNormals(newNormals);
+  }
+
+  // In certain cases, we can have a left over processing array, remove it.
+  outputPD->RemoveArray(IDS_ARRAY_NAME.c_str());
+
+  // Pass the field data
+  output->GetFieldData()->PassData(input->GetFieldData());
+  output->SetPoints(newPts);
+  output->Squeeze();
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1161,4 +1434,5 @@ void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Seed: " << this->Seed << endl;
   os << indent << "Stride: " << this->Stride << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "UseSMPTools: " << this->UseSMPTools << endl;
 }
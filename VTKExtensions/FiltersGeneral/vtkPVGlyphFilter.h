@@ -52,6 +52,7 @@
 
 class vtkMultiProcessController;
 class vtkTransform;
+class vtkUniformGrid;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVGlyphFilter : public vtkPolyDataAlgorithm
 {
@@ -174,6 +175,22 @@ public:
   vtkGetMacro(MaximumNumberOfSamplePoints, int);
   ///@}
 
+  ///@{
+  /**
+   * When set (default), glyphs are generated with vtkSMPTools in two passes:
+   * points to glyph are first selected and counted, then the transformed glyph
+   * geometry and point attributes are written at offsets computed with a
+   * prefix sum. The output is identical to the serial algorithm. Points are
+   * selected serially with IsPointVisible(), so subclasses overriding it are
+   * honored in both paths. The serial path is still used when the glyph source
+   * mixes several kinds of cells (verts, lines, polys, strips) or when this is
+   * turned off.
+   */
+  vtkSetMacro(UseSMPTools, bool);
+  vtkGetMacro(UseSMPTools, bool);
+  vtkBooleanMacro(UseSMPTools, bool);
+  ///@}
+
   /**
    * Overridden to create output data of appropriate type.
    */
@@ -245,11 +262,25 @@ protected:
   int Stride;
   vtkMultiProcessController* Controller;
   int OutputPointsPrecision;
+  bool UseSMPTools;
 
 private:
   vtkPVGlyphFilter(const vtkPVGlyphFilter&) = delete;
   void operator=(const vtkPVGlyphFilter&) = delete;
 
+  /**
+   * Returns true if the point \c ptId of \c ds is glyphed: it is not a
+   * duplicated ghost point, it is not blanked and IsPointVisible() accepts it.
+   */
+  bool IsPointGlyphed(unsigned int index, vtkDataSet* ds, vtkIdType ptId,
+    const unsigned char* ghosts, vtkUniformGrid* uniformGrid, bool cellCenters);
+
+  /**
+   * vtkSMPTools based implementation used by Execute() when UseSMPTools is set.
+   */
+  bool ExecuteSMP(unsigned int index, vtkDataSet* input, vtkPolyData* source, vtkPolyData* output,
+    vtkDataArray* scaleArray, vtkDataArray* orientArray, bool cellCenters);
+
   class vtkInternals;
   vtkInternals* Internals;
 };
@@ -0,0 +1,289 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVExtractArraysOverTime.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+
+#include <string>
+
+namespace
+{
+constexpr int NumberOfTimeSteps = 7;
+constexpr int NumberOfPoints = 20;
+
+// Temporal source of vertices with values depending on the time, split in pieces.
+// It counts its executions to check which timesteps are read again.
+class vtkTemporalVertexSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTemporalVertexSource* New();
+  vtkTypeMacro(vtkTemporalVertexSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  vtkTemporalVertexSource() { this->SetNumberOfInputPorts(0); }
+  ~vtkTemporalVertexSource() override = default;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[NumberOfTimeSteps];
+    for (int cc = 0; cc < NumberOfTimeSteps; ++cc)
+    {
+      timeSteps[cc] = 0.5 * cc;
+    }
+    const double range[2] = { timeSteps[0], timeSteps[NumberOfTimeSteps - 1] };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const int numPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    const int first = piece * NumberOfPoints / numPieces;
+    const int last = (piece + 1) * NumberOfPoints / numPieces;
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkDoubleArray> pointValues;
+    pointValues->SetName("PointValue");
+    vtkNew<vtkDoubleArray> cellValues;
+    cellValues->SetName("CellValue");
+    for (int id = first; id < last; ++id)
+    {
+      const vtkIdType ptId = points->InsertNextPoint(id, 0, 0);
+      verts->InsertNextCell(1, &ptId);
+      pointValues->InsertNextValue(100 * time + id);
+      cellValues->InsertNextValue(-10 * time * id);
+    }
+
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    output->GetPointData()->AddArray(pointValues);
+    output->GetCellData()->AddArray(cellValues);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  vtkTemporalVertexSource(const vtkTemporalVertexSource&) = delete;
+  void operator=(const vtkTemporalVertexSource&) = delete;
+};
+vtkStandardNewMacro(vtkTemporalVertexSource);
+
+// Compares the tables of two outputs of vtkPVExtractArraysOverTime, column by column.
+bool CompareOutputs(vtkMultiBlockDataSet* result, vtkMultiBlockDataSet* expected,
+  const std::string& label)
+{
+  if (result->GetNumberOfBlocks() != expected->GetNumberOfBlocks() ||
+    expected->GetNumberOfBlocks() == 0)
+  {
+    vtkLogF(ERROR, "%s: got %u blocks instead of %u.", label.c_str(),
+      result->GetNumberOfBlocks(), expected->GetNumberOfBlocks());
+    return false;
+  }
+  for (unsigned int block = 0; block < expected->GetNumberOfBlocks(); ++block)
+  {
+    auto resultTable = vtkTable::SafeDownCast(result->GetBlock(block));
+    auto expectedTable = vtkTable::SafeDownCast(expected->GetBlock(block));
+    if (!resultTable || !expectedTable ||
+      resultTable->GetNumberOfRows() != expectedTable->GetNumberOfRows() ||
+      resultTable->GetNumberOfColumns() != expectedTable->GetNumberOfColumns())
+    {
+      vtkLogF(ERROR, "%s: block %u differs in shape.", label.c_str(), block);
+      return false;
+    }
+    for (vtkIdType col = 0; col < expectedTable->GetNumberOfColumns(); ++col)
+    {
+      auto expectedColumn = vtkDataArray::SafeDownCast(expectedTable->GetColumn(col));
+      if (!expectedColumn)
+      {
+        continue;
+      }
+      auto resultColumn =
+        vtkDataArray::SafeDownCast(resultTable->GetColumnByName(expectedColumn->GetName()));
+      if (!resultColumn ||
+        resultColumn->GetNumberOfComponents() != expectedColumn->GetNumberOfComponents())
+      {
+        vtkLogF(ERROR, "%s: column '%s' is missing.", label.c_str(), expectedColumn->GetName());
+        return false;
+      }
+      for (vtkIdType row = 0; row < expectedTable->GetNumberOfRows(); ++row)
+      {
+        for (int comp = 0; comp < expectedColumn->GetNumberOfComponents(); ++comp)
+        {
+          if (resultColumn->GetComponent(row, comp) != expectedColumn->GetComponent(row, comp))
+          {
+            vtkLogF(ERROR, "%s: '%s'[%lld] is %g instead of %g.", label.c_str(),
+              expectedColumn->GetName(), static_cast<long long>(row),
+              resultColumn->GetComponent(row, comp), expectedColumn->GetComponent(row, comp));
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Checks the rows of the point statistics against the values of the source.
+bool CheckPointStatistics(vtkMultiBlockDataSet* output)
+{
+  auto table = vtkTable::SafeDownCast(output->GetBlock(0));
+  auto time = table ? vtkDataArray::SafeDownCast(table->GetColumnByName("Time")) : nullptr;
+  auto maximum =
+    table ? vtkDataArray::SafeDownCast(table->GetColumnByName("max(PointValue)")) : nullptr;
+  if (!time || !maximum || table->GetNumberOfRows() != NumberOfTimeSteps)
+  {
+    vtkLogF(ERROR, "Missing point statistics.");
+    return false;
+  }
+  for (vtkIdType row = 0; row < NumberOfTimeSteps; ++row)
+  {
+    if (time->GetTuple1(row) != 0.5 * row ||
+      maximum->GetTuple1(row) != 50.0 * row + NumberOfPoints - 1)
+    {
+      vtkLogF(ERROR, "Unexpected statistics for timestep %lld.", static_cast<long long>(row));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestTimeCompartments(vtkMultiProcessController* contr)
+{
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  vtkNew<vtkMultiBlockDataSet> reference;
+  bool success = true;
+  // 0 puts all ranks in one compartment, 1 gives each rank its own timesteps, and
+  // numRanks - 1 leaves a smaller last compartment when there are several ranks.
+  for (const int size : { 0, 1, numRanks - 1, numRanks })
+  {
+    vtkNew<vtkTemporalVertexSource> source;
+    vtkNew<vtkPVExtractArraysOverTime> filter;
+    filter->SetController(contr);
+    filter->SetTimeCompartmentSize(size);
+    filter->SetInputConnection(source->GetOutputPort());
+    filter->Update();
+
+    if (myRank == 0)
+    {
+      vtkMultiBlockDataSet* output = filter->GetOutput();
+      const std::string label = "TimeCompartmentSize " + std::to_string(size);
+      if (size == 0)
+      {
+        success = success && CheckPointStatistics(output);
+        reference->ShallowCopy(output);
+      }
+      else
+      {
+        success = success && CompareOutputs(output, reference, label);
+      }
+    }
+  }
+  return success;
+}
+
+bool TestCache(vtkMultiProcessController* contr)
+{
+  const int myRank = contr->GetLocalProcessId();
+  bool success = true;
+  for (const int size : { 0, 1 })
+  {
+    vtkNew<vtkTemporalVertexSource> source;
+    vtkNew<vtkPVExtractArraysOverTime> filter;
+    filter->SetController(contr);
+    filter->SetTimeCompartmentSize(size);
+    filter->SetCacheSize(16);
+    filter->SetInputConnection(source->GetOutputPort());
+    filter->Update();
+
+    // only a property of the filter changes: all timesteps come from the cache.
+    const int numberOfExecutions = source->NumberOfExecutions;
+    filter->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+    filter->Update();
+    if (source->NumberOfExecutions != numberOfExecutions)
+    {
+      vtkLogF(ERROR, "TimeCompartmentSize %d: %d timesteps executed again instead of cached.",
+        size, source->NumberOfExecutions - numberOfExecutions);
+      success = false;
+    }
+
+    vtkNew<vtkTemporalVertexSource> coldSource;
+    vtkNew<vtkPVExtractArraysOverTime> cold;
+    cold->SetController(contr);
+    cold->SetTimeCompartmentSize(size);
+    cold->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+    cold->SetInputConnection(coldSource->GetOutputPort());
+    cold->Update();
+
+    if (myRank == 0)
+    {
+      const std::string label = "Cached, TimeCompartmentSize " + std::to_string(size);
+      success = success && CompareOutputs(filter->GetOutput(), cold->GetOutput(), label);
+    }
+
+    // a change upstream invalidates the cache.
+    source->Modified();
+    filter->Update();
+    if (source->NumberOfExecutions == numberOfExecutions)
+    {
+      vtkLogF(ERROR, "TimeCompartmentSize %d: the cache was used after an upstream change.",
+        size);
+      success = false;
+    }
+  }
+  return success;
+}
+}
+
+// Checks that vtkPVExtractArraysOverTime produces the same rows whatever the
+// number of ranks in each time compartment, and that re-executing it from
+// cached input datasets gives the same rows as a cold run.
+int TestPVExtractArraysOverTime(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestTimeCompartments(contr) ? 1 : 0;
+  success = TestCache(contr) && success ? 1 : 0;
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,713 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVExtractArraysOverTime.h"
+
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDummyController.h"
+#include "vtkExtractSelection.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPExtractDataArraysOverTime.h"
+#include "vtkPExtractSelectedArraysOverTime.h"
+#include "vtkSelection.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Source producing a single dataset at a single timestep, used to feed one timestep
+ * at a time to the internal extraction filters.
+ */
+class vtkTimeSampleSource : public vtkAlgorithm
+{
+public:
+  static vtkTimeSampleSource* New();
+  vtkTypeMacro(vtkTimeSampleSource, vtkAlgorithm);
+
+  void SetSample(vtkDataObject* sample, double time)
+  {
+    this->Sample = sample;
+    this->Time = time;
+    this->Modified();
+  }
+
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+    {
+      vtkDataObject* output = vtkDataObject::GetData(outInfo);
+      if (!output || !output->IsA(this->Sample->GetClassName()))
+      {
+        auto newOutput = vtk::TakeSmartPointer(this->Sample->NewInstance());
+        outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+      }
+      return 1;
+    }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+    {
+      const double range[2] = { this->Time, this->Time };
+      outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), &this->Time, 1);
+      outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+      return 1;
+    }
+    if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+    {
+      vtkDataObject* output = vtkDataObject::GetData(outInfo);
+      output->ShallowCopy(this->Sample);
+      output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), this->Time);
+      return 1;
+    }
+    return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+  }
+
+protected:
+  vtkTimeSampleSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->SetNumberOfOutputPorts(1);
+  }
+  ~vtkTimeSampleSource() override = default;
+
+  int FillOutputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+    return 1;
+  }
+
+private:
+  vtkTimeSampleSource(const vtkTimeSampleSource&) = delete;
+  void operator=(const vtkTimeSampleSource&) = delete;
+
+  vtkSmartPointer<vtkDataObject> Sample;
+  double Time = 0.0;
+};
+vtkStandardNewMacro(vtkTimeSampleSource);
+
+// Column holding the timestep index of each row while rows are moved between ranks.
+const char* TimeStepIndexName = "vtkTimeStepIndex";
+
+//----------------------------------------------------------------------------
+vtkMTimeType GetUpstreamMTime(vtkAlgorithm* algorithm)
+{
+  vtkMTimeType mtime = algorithm->GetMTime();
+  for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+  {
+    for (int cc = 0; cc < algorithm->GetNumberOfInputConnections(port); ++cc)
+    {
+      if (auto input = algorithm->GetInputAlgorithm(port, cc))
+      {
+        mtime = std::max(mtime, ::GetUpstreamMTime(input));
+      }
+    }
+  }
+  return mtime;
+}
+
+//----------------------------------------------------------------------------
+// Creates an empty column with the same type, name and components as `array`.
+vtkSmartPointer<vtkAbstractArray> NewColumn(vtkAbstractArray* array)
+{
+  auto column = vtk::TakeSmartPointer(array->NewInstance());
+  column->SetName(array->GetName());
+  column->SetNumberOfComponents(array->GetNumberOfComponents());
+  return column;
+}
+
+//----------------------------------------------------------------------------
+// Appends `rows` to `partial`, which gets the same columns plus the timestep index.
+void AppendRows(vtkTable* rows, int index, vtkTable* partial)
+{
+  if (partial->GetNumberOfColumns() == 0)
+  {
+    for (vtkIdType col = 0; col < rows->GetNumberOfColumns(); ++col)
+    {
+      partial->AddColumn(::NewColumn(rows->GetColumn(col)));
+    }
+    vtkNew<vtkIntArray> indices;
+    indices->SetName(::TimeStepIndexName);
+    partial->AddColumn(indices);
+    partial->GetFieldData()->ShallowCopy(rows->GetFieldData());
+  }
+
+  auto indices = vtkIntArray::SafeDownCast(partial->GetColumnByName(::TimeStepIndexName));
+  for (vtkIdType row = 0; row < rows->GetNumberOfRows(); ++row)
+  {
+    const vtkIdType dest = indices->InsertNextValue(index);
+    for (vtkIdType col = 0; col < partial->GetNumberOfColumns(); ++col)
+    {
+      vtkAbstractArray* column = partial->GetColumn(col);
+      if (column == indices)
+      {
+        continue;
+      }
+      if (auto source = rows->GetColumnByName(column->GetName()))
+      {
+        column->InsertTuple(dest, row, source);
+      }
+      else
+      {
+        // column missing at this timestep, leave default values.
+        column->SetNumberOfTuples(dest + 1);
+        if (auto dataArray = vtkDataArray::SafeDownCast(column))
+        {
+          for (int comp = 0; comp < dataArray->GetNumberOfComponents(); ++comp)
+          {
+            dataArray->SetComponent(dest, comp, 0.0);
+          }
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void ForEachTable(vtkDataObject* dobj, const std::function<void(const std::string&, vtkTable*)>& f)
+{
+  auto tree = vtkDataObjectTree::SafeDownCast(dobj);
+  if (!tree)
+  {
+    return;
+  }
+  auto iter = vtk::TakeSmartPointer(tree->NewTreeIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    if (table && iter->HasCurrentMetaData() &&
+      iter->GetCurrentMetaData()->Has(vtkCompositeDataSet::NAME()))
+    {
+      f(iter->GetCurrentMetaData()->Get(vtkCompositeDataSet::NAME()), table);
+    }
+  }
+}
+}
+
+class vtkPVExtractArraysOverTime::vtkInternals
+{
+public:
+  std::vector<double> TimeSteps;
+
+  // Ranks of the time compartment of this rank.
+  vtkSmartPointer<vtkMultiProcessController> Compartment;
+  vtkMultiProcessController* CompartmentParent = nullptr;
+  int CompartmentSize = 0;
+  int CompartmentIndex = 0;
+  int NumberOfCompartments = 1;
+
+  // Range of timesteps assigned to the compartment of this rank.
+  int FirstTimeIndex = 0;
+  int LastTimeIndex = 0;
+
+  // Loop over the timesteps for which the upstream pipeline is executed.
+  bool Executing = false;
+  std::vector<int> Pending;
+  size_t Next = 0;
+  double LastRequestedTime = vtkMath::Nan();
+
+  // Extracted rows for each timestep index, for the current execution.
+  std::map<int, vtkSmartPointer<vtkDataObject>> Rows;
+
+  // Input datasets for each timestep index.
+  std::map<int, vtkSmartPointer<vtkDataObject>> Cache;
+  unsigned long CacheKiB = 0;
+  vtkMTimeType CacheMTime = 0;
+  std::vector<double> CacheTimeSteps;
+  int CacheCompartmentSize = -1;
+
+  void ClearCache()
+  {
+    this->Cache.clear();
+    this->CacheKiB = 0;
+  }
+
+  /**
+   * Returns the number of ranks in each compartment, for the given property value.
+   */
+  static int GetEffectiveSize(vtkMultiProcessController* controller, int size)
+  {
+    const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+    return (size <= 0 || size > numRanks) ? numRanks : size;
+  }
+
+  /**
+   * Splits the timesteps in contiguous ranges, one per compartment.
+   */
+  void ComputeTimeRange(vtkMultiProcessController* controller, int size)
+  {
+    const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+    const int rank = controller ? controller->GetLocalProcessId() : 0;
+    this->NumberOfCompartments = (numRanks + size - 1) / size;
+    this->CompartmentIndex = rank / size;
+
+    const int numTimeSteps = static_cast<int>(this->TimeSteps.size());
+    const int perCompartment = numTimeSteps / this->NumberOfCompartments;
+    const int remainder = numTimeSteps % this->NumberOfCompartments;
+    this->FirstTimeIndex =
+      this->CompartmentIndex * perCompartment + std::min(this->CompartmentIndex, remainder);
+    this->LastTimeIndex =
+      this->FirstTimeIndex + perCompartment + (this->CompartmentIndex < remainder ? 1 : 0);
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPVExtractArraysOverTime);
+
+//----------------------------------------------------------------------------
+vtkCxxSetObjectMacro(vtkPVExtractArraysOverTime, Controller, vtkMultiProcessController);
+
+//----------------------------------------------------------------------------
+vtkPVExtractArraysOverTime::vtkPVExtractArraysOverTime()
+  : Internals(new vtkPVExtractArraysOverTime::vtkInternals())
+{
+  this->SetNumberOfInputPorts(2);
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkPVExtractArraysOverTime::~vtkPVExtractArraysOverTime()
+{
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::SetSelectionExtractor(vtkExtractSelection* extractor)
+{
+  if (this->SelectionExtractor != extractor)
+  {
+    this->SelectionExtractor = extractor;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkExtractSelection* vtkPVExtractArraysOverTime::GetSelectionExtractor()
+{
+  return this->SelectionExtractor;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::ClearCache()
+{
+  this->Internals->ClearCache();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractArraysOverTime::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (port == 0)
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+    info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
+    info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
+  }
+  else
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkSelection");
+    info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractArraysOverTime::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto& internals = *this->Internals;
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  // an interrupted execution must not be resumed.
+  internals.Executing = false;
+  internals.TimeSteps.clear();
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    const double* timeSteps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    const int numTimeSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    internals.TimeSteps.assign(timeSteps, timeSteps + numTimeSteps);
+  }
+
+  // the output is not temporal.
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractArraysOverTime::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  auto& internals = *this->Internals;
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (internals.TimeSteps.empty())
+  {
+    return 1;
+  }
+
+  const int size = vtkInternals::GetEffectiveSize(this->Controller, this->TimeCompartmentSize);
+  double time;
+  if (internals.Executing)
+  {
+    time = internals.TimeSteps[internals.Pending[internals.Next]];
+  }
+  else if (!vtkMath::IsNan(internals.LastRequestedTime))
+  {
+    // the first pass only decides which timesteps need to be executed: request the
+    // timestep the upstream pipeline already has to avoid executing it again.
+    time = internals.LastRequestedTime;
+  }
+  else
+  {
+    internals.ComputeTimeRange(this->Controller, size);
+    const int last = static_cast<int>(internals.TimeSteps.size()) - 1;
+    time = internals.TimeSteps[std::min(internals.FirstTimeIndex, last)];
+  }
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+  internals.LastRequestedTime = time;
+
+  if (this->Controller)
+  {
+    // split the input among the ranks of the compartment only.
+    const int rank = this->Controller->GetLocalProcessId();
+    const int first = (rank / size) * size;
+    const int numPieces = std::min(size, this->Controller->GetNumberOfProcesses() - first);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), numPieces);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), rank - first);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractArraysOverTime::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto& internals = *this->Internals;
+  if (internals.TimeSteps.empty())
+  {
+    vtkErrorMacro("No time steps in input data!");
+    return 0;
+  }
+
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  vtkSelection* selection = vtkSelection::GetData(inputVector[1], 0);
+  auto output = vtkMultiBlockDataSet::GetData(outputVector, 0);
+  const double inputTime = input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP())
+    ? input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP())
+    : internals.LastRequestedTime;
+
+  if (!internals.Executing)
+  {
+    this->StartExecution();
+    internals.Executing = true;
+
+    // the dataset received for the first pass may be one of the pending timesteps.
+    const auto iter =
+      std::find(internals.TimeSteps.begin(), internals.TimeSteps.end(), inputTime);
+    const int index = static_cast<int>(std::distance(internals.TimeSteps.begin(), iter));
+    const auto pending = std::find(internals.Pending.begin(), internals.Pending.end(), index);
+    if (pending != internals.Pending.end())
+    {
+      internals.Pending.erase(pending);
+      this->AddSample(index, input, selection);
+    }
+  }
+  else
+  {
+    this->AddSample(internals.Pending[internals.Next], input, selection);
+    ++internals.Next;
+  }
+
+  if (internals.Next < internals.Pending.size())
+  {
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    this->UpdateProgress(
+      static_cast<double>(internals.Next) / static_cast<double>(internals.Pending.size()));
+    return 1;
+  }
+
+  request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+  internals.Executing = false;
+  this->FinishExecution(selection, output);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::StartExecution()
+{
+  auto& internals = *this->Internals;
+  const int size = vtkInternals::GetEffectiveSize(this->Controller, this->TimeCompartmentSize);
+
+  if (!this->Controller)
+  {
+    if (!internals.Compartment)
+    {
+      internals.Compartment = vtkSmartPointer<vtkDummyController>::New();
+    }
+  }
+  else if (internals.CompartmentParent != this->Controller || internals.CompartmentSize != size)
+  {
+    if (size == this->Controller->GetNumberOfProcesses())
+    {
+      internals.Compartment = this->Controller;
+    }
+    else
+    {
+      const int rank = this->Controller->GetLocalProcessId();
+      internals.Compartment =
+        vtk::TakeSmartPointer(this->Controller->PartitionController(rank / size, rank % size));
+    }
+    internals.CompartmentParent = this->Controller;
+    internals.CompartmentSize = size;
+  }
+  internals.ComputeTimeRange(this->Controller, size);
+
+  // cached datasets are only valid as long as nothing upstream changed. All ranks of a
+  // compartment must agree since the extraction is collective.
+  vtkMTimeType mtime = 0;
+  if (auto inputAlgorithm = this->GetInputAlgorithm(0, 0))
+  {
+    mtime = ::GetUpstreamMTime(inputAlgorithm);
+  }
+  int changed = (mtime != internals.CacheMTime || internals.TimeSteps != internals.CacheTimeSteps ||
+                  size != internals.CacheCompartmentSize)
+    ? 1
+    : 0;
+  int anyChanged = changed;
+  internals.Compartment->AllReduce(&changed, &anyChanged, 1, vtkCommunicator::MAX_OP);
+  if (anyChanged)
+  {
+    internals.ClearCache();
+    internals.CacheMTime = mtime;
+    internals.CacheTimeSteps = internals.TimeSteps;
+    internals.CacheCompartmentSize = size;
+  }
+
+  internals.Rows.clear();
+  internals.Pending.clear();
+  internals.Next = 0;
+  for (int index = internals.FirstTimeIndex; index < internals.LastTimeIndex; ++index)
+  {
+    if (internals.Cache.find(index) == internals.Cache.end())
+    {
+      internals.Pending.push_back(index);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::AddSample(int index, vtkDataObject* input, vtkSelection* selection)
+{
+  auto& internals = *this->Internals;
+  auto sample = vtk::TakeSmartPointer(input->NewInstance());
+  sample->ShallowCopy(input);
+  internals.Rows[index] = this->ExtractRows(sample, internals.TimeSteps[index], selection);
+  if (this->CacheSize == 0)
+  {
+    return;
+  }
+
+  const unsigned long sampleKiB = sample->GetActualMemorySize();
+  int fits = (internals.CacheKiB + sampleKiB <= static_cast<unsigned long>(this->CacheSize) * 1024)
+    ? 1
+    : 0;
+  int allFit = fits;
+  internals.Compartment->AllReduce(&fits, &allFit, 1, vtkCommunicator::MIN_OP);
+  if (allFit)
+  {
+    internals.Cache[index] = sample;
+    internals.CacheKiB += sampleKiB;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVExtractArraysOverTime::ExtractRows(
+  vtkDataObject* sample, double time, vtkSelection* selection)
+{
+  auto& internals = *this->Internals;
+  vtkNew<vtkTimeSampleSource> source;
+  source->SetSample(sample, time);
+
+  vtkSmartPointer<vtkAlgorithm> extractor;
+  if (selection)
+  {
+    vtkNew<vtkPExtractSelectedArraysOverTime> selectedArrays;
+    selectedArrays->SetController(internals.Compartment);
+    selectedArrays->SetReportStatisticsOnly(this->ReportStatisticsOnly);
+    if (this->SelectionExtractor)
+    {
+      selectedArrays->SetSelectionExtractor(this->SelectionExtractor);
+    }
+    selectedArrays->SetInputDataObject(1, selection);
+    extractor = selectedArrays;
+  }
+  else
+  {
+    vtkNew<vtkPExtractDataArraysOverTime> dataArrays;
+    dataArrays->SetController(internals.Compartment);
+    dataArrays->SetReportStatisticsOnly(this->ReportStatisticsOnly);
+    dataArrays->SetFieldAssociation(this->FieldAssociation);
+    extractor = dataArrays;
+  }
+  extractor->SetInputConnection(0, source->GetOutputPort());
+  extractor->Update();
+  return extractor->GetOutputDataObject(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::FinishExecution(
+  vtkSelection* selection, vtkMultiBlockDataSet* output)
+{
+  auto& internals = *this->Internals;
+  for (int index = internals.FirstTimeIndex; index < internals.LastTimeIndex; ++index)
+  {
+    if (internals.Rows.find(index) == internals.Rows.end())
+    {
+      internals.Rows[index] =
+        this->ExtractRows(internals.Cache[index], internals.TimeSteps[index], selection);
+    }
+  }
+
+  // rows are reduced on the root of each compartment, which sends them with their
+  // timestep index.
+  std::vector<std::string> names;
+  std::map<std::string, vtkSmartPointer<vtkTable>> partials;
+  if (internals.Compartment->GetLocalProcessId() == 0)
+  {
+    for (const auto& rows : internals.Rows)
+    {
+      ::ForEachTable(rows.second, [&](const std::string& name, vtkTable* table) {
+        auto& partial = partials[name];
+        if (!partial)
+        {
+          partial = vtkSmartPointer<vtkTable>::New();
+          names.push_back(name);
+        }
+        ::AppendRows(table, rows.first, partial);
+      });
+    }
+  }
+  internals.Rows.clear();
+
+  vtkNew<vtkMultiBlockDataSet> partial;
+  partial->SetNumberOfBlocks(static_cast<unsigned int>(names.size()));
+  for (unsigned int cc = 0; cc < names.size(); ++cc)
+  {
+    partial->SetBlock(cc, partials[names[cc]]);
+    partial->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), names[cc].c_str());
+  }
+
+  std::vector<vtkSmartPointer<vtkDataObject>> gathered;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    this->Controller->Gather(partial, gathered, 0);
+    if (this->Controller->GetLocalProcessId() != 0)
+    {
+      output->Initialize();
+      return;
+    }
+  }
+  else
+  {
+    gathered.emplace_back(partial);
+  }
+
+  // merge the rows of all compartments, ordered by timestep.
+  const vtkIdType numTimeSteps = static_cast<vtkIdType>(internals.TimeSteps.size());
+  std::vector<std::string> mergedNames;
+  std::map<std::string, vtkSmartPointer<vtkTable>> merged;
+  std::map<std::string, std::vector<bool>> filled;
+  for (const auto& dobj : gathered)
+  {
+    ::ForEachTable(dobj, [&](const std::string& name, vtkTable* table) {
+      auto& result = merged[name];
+      if (!result)
+      {
+        result = vtkSmartPointer<vtkTable>::New();
+        for (vtkIdType col = 0; col < table->GetNumberOfColumns(); ++col)
+        {
+          vtkAbstractArray* array = table->GetColumn(col);
+          if (strcmp(array->GetName(), ::TimeStepIndexName) != 0)
+          {
+            auto column = ::NewColumn(array);
+            column->SetNumberOfTuples(numTimeSteps);
+            if (auto dataArray = vtkDataArray::SafeDownCast(column))
+            {
+              dataArray->Fill(0.0);
+            }
+            result->AddColumn(column);
+          }
+        }
+        result->GetFieldData()->ShallowCopy(table->GetFieldData());
+        filled[name].resize(numTimeSteps, false);
+        mergedNames.push_back(name);
+      }
+
+      auto indices = vtkIntArray::SafeDownCast(table->GetColumnByName(::TimeStepIndexName));
+      auto& resultFilled = filled[name];
+      for (vtkIdType row = 0; row < table->GetNumberOfRows(); ++row)
+      {
+        const int index = indices->GetValue(row);
+        for (vtkIdType col = 0; col < result->GetNumberOfColumns(); ++col)
+        {
+          vtkAbstractArray* column = result->GetColumn(col);
+          if (auto source = table->GetColumnByName(column->GetName()))
+          {
+            column->SetTuple(index, row, source);
+          }
+        }
+        resultFilled[index] = true;
+      }
+    });
+  }
+
+  output->Initialize();
+  output->SetNumberOfBlocks(static_cast<unsigned int>(mergedNames.size()));
+  for (unsigned int cc = 0; cc < mergedNames.size(); ++cc)
+  {
+    vtkTable* result = merged[mergedNames[cc]];
+    // rows missing for some timesteps are left invalid, but still get their time.
+    if (auto timeArray = vtkDataArray::SafeDownCast(result->GetColumnByName("Time")))
+    {
+      const auto& resultFilled = filled[mergedNames[cc]];
+      for (vtkIdType index = 0; index < numTimeSteps; ++index)
+      {
+        if (!resultFilled[index])
+        {
+          timeArray->SetTuple1(index, internals.TimeSteps[index]);
+        }
+      }
+    }
+    output->SetBlock(cc, result);
+    output->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), mergedNames[cc].c_str());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractArraysOverTime::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "SelectionExtractor: " << this->SelectionExtractor << endl;
+  os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
+  os << indent << "ReportStatisticsOnly: " << this->ReportStatisticsOnly << endl;
+  os << indent << "TimeCompartmentSize: " << this->TimeCompartmentSize << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVExtractArraysOverTime
+ * @brief extracts array values or statistics over time, spreading timesteps across ranks
+ *
+ * vtkPVExtractArraysOverTime produces the tables of vtkPExtractDataArraysOverTime
+ * (Plot Data Over Time) or, when a selection is connected to its second input, of
+ * vtkPExtractSelectedArraysOverTime (Plot Selection Over Time).
+ *
+ * Ranks are grouped in time compartments of `TimeCompartmentSize` ranks. Each
+ * compartment executes the upstream pipeline for a contiguous range of timesteps only,
+ * with the input spatially partitioned among the ranks of the compartment, so
+ * compartments work on disjoint time ranges concurrently. The rows computed by each
+ * compartment are then merged on the root rank, which is the only rank producing output.
+ *
+ * Input datasets can also be cached, up to `CacheSize` MiB per rank, which is off by
+ * default. When only the selection or a property of this filter changes, rows are then
+ * extracted again from the cached datasets instead of executing the upstream pipeline
+ * for every timestep.
+ *
+ * @warning When using time compartments, upstream filters must not communicate across
+ * ranks (e.g. for redistribution or ghost cells generation) since compartments execute
+ * different timesteps at the same time.
+ *
+ * @sa vtkPExtractDataArraysOverTime vtkPExtractSelectedArraysOverTime
+ */
+
+#ifndef vtkPVExtractArraysOverTime_h
+#define vtkPVExtractArraysOverTime_h
+
+#include "vtkDataObject.h" // for vtkDataObject::FIELD_ASSOCIATION_POINTS
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkPVVTKExtensionsFiltersParallelModule.h" //needed for exports
+#include "vtkSmartPointer.h"                         // for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
+
+class vtkExtractSelection;
+class vtkMultiProcessController;
+class vtkSelection;
+
+class VTKPVVTKEXTENSIONSFILTERSPARALLEL_EXPORT vtkPVExtractArraysOverTime
+  : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkPVExtractArraysOverTime* New();
+  vtkTypeMacro(vtkPVExtractArraysOverTime, vtkMultiBlockDataSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the controller to use. By default,
+   * `vtkMultiProcessController::GetGlobalController` will be used.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the attribute data to extract when no selection is connected.
+   * Default is vtkDataObject::FIELD_ASSOCIATION_POINTS.
+   */
+  vtkSetClampMacro(FieldAssociation, int, 0, vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES - 1);
+  vtkGetMacro(FieldAssociation, int);
+  ///@}
+
+  ///@{
+  /**
+   * When true (default), only the statistics of the arrays are reported for each
+   * timestep, instead of one table per element.
+   */
+  vtkSetMacro(ReportStatisticsOnly, bool);
+  vtkGetMacro(ReportStatisticsOnly, bool);
+  vtkBooleanMacro(ReportStatisticsOnly, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the selection extractor used when a selection is connected.
+   * If not set, vtkExtractSelection is used.
+   */
+  void SetSelectionExtractor(vtkExtractSelection*);
+  vtkExtractSelection* GetSelectionExtractor();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of ranks in each time compartment. 0 (default) puts all ranks
+   * in a single compartment: every rank executes all timesteps on its spatial partition.
+   * 1 gives each rank its own range of timesteps, with the whole dataset as input.
+   */
+  vtkSetClampMacro(TimeCompartmentSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(TimeCompartmentSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum memory, in MiB per rank, used to cache input datasets.
+   * 0 (default) disables the cache.
+   */
+  vtkSetClampMacro(CacheSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
+  /**
+   * Clears cached input datasets.
+   */
+  void ClearCache();
+
+  /**
+   * Connect the selection to extract over time, if any. Equivalent to
+   * `SetInputConnection(1, algOutput)`.
+   */
+  void SetSelectionConnection(vtkAlgorithmOutput* algOutput)
+  {
+    this->SetInputConnection(1, algOutput);
+  }
+
+protected:
+  vtkPVExtractArraysOverTime();
+  ~vtkPVExtractArraysOverTime() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  vtkMultiProcessController* Controller = nullptr;
+  vtkSmartPointer<vtkExtractSelection> SelectionExtractor;
+  int FieldAssociation = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  bool ReportStatisticsOnly = true;
+  int TimeCompartmentSize = 0;
+  int CacheSize = 0;
+
+private:
+  vtkPVExtractArraysOverTime(const vtkPVExtractArraysOverTime&) = delete;
+  void operator=(const vtkPVExtractArraysOverTime&) = delete;
+
+  /**
+   * Collectively decides which timesteps this rank needs the upstream pipeline for.
+   */
+  void StartExecution();
+
+  /**
+   * Extracts the rows for timestep `index` from `sample` and caches it, if possible.
+   */
+  void AddSample(int index, vtkDataObject* sample, vtkSelection* selection);
+
+  /**
+   * Extracts the rows of cached timesteps and merges the rows of all ranks on the root.
+   */
+  void FinishExecution(vtkSelection* selection, vtkMultiBlockDataSet* output);
+
+  vtkSmartPointer<vtkDataObject> ExtractRows(
+    vtkDataObject* sample, double time, vtkSelection* selection);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
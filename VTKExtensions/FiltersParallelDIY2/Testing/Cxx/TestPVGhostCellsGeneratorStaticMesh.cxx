@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkDataArray.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkLogger.h>
+#include <vtkNew.h>
+#include <vtkPVGhostCellsGenerator.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkUnstructuredGrid.h>
+
+namespace
+{
+bool CheckExecution(vtkPVGhostCellsGenerator* generator, vtkUnstructuredGrid* input,
+  vtkIdType expectedHits, const char* step)
+{
+  generator->Update();
+  if (generator->GetNumberOfStaticMeshCacheHits() != expectedHits)
+  {
+    vtkLog(ERROR, << step << ": expected " << expectedHits << " cache hits, got "
+                  << generator->GetNumberOfStaticMeshCacheHits());
+    return false;
+  }
+
+  auto output = vtkUnstructuredGrid::SafeDownCast(generator->GetOutputDataObject(0));
+  vtkDataArray* outArray = output ? output->GetPointData()->GetArray("RTData") : nullptr;
+  if (!outArray)
+  {
+    vtkLog(ERROR, << step << ": missing RTData output array");
+    return false;
+  }
+  if (output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    vtkLog(ERROR, << step << ": expected " << input->GetNumberOfCells() << " cells, got "
+                  << output->GetNumberOfCells());
+    return false;
+  }
+
+  double inRange[2], outRange[2];
+  input->GetPointData()->GetArray("RTData")->GetRange(inRange);
+  outArray->GetRange(outRange);
+  if (inRange[0] != outRange[0] || inRange[1] != outRange[1])
+  {
+    vtkLog(ERROR, << step << ": output RTData range [" << outRange[0] << ", " << outRange[1]
+                  << "] does not match the input range [" << inRange[0] << ", " << inRange[1]
+                  << "]");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVGhostCellsGeneratorStaticMesh(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-5, 5, -5, 5, -5, 5);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->Update();
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(tetrahedralize->GetOutput());
+
+  vtkNew<vtkPVGhostCellsGenerator> generator;
+  generator->SetInputData(grid);
+  generator->UseStaticMeshCacheOn();
+  if (!CheckExecution(generator, grid, 0, "first execution"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Changing point data only must reuse the cached ghost geometry and carry
+  // the new values.
+  vtkDataArray* rtData = grid->GetPointData()->GetArray("RTData");
+  for (vtkIdType cc = 0; cc < rtData->GetNumberOfTuples(); ++cc)
+  {
+    rtData->SetTuple1(cc, 2.0 * rtData->GetTuple1(cc) + 1.0);
+  }
+  rtData->Modified();
+  grid->Modified();
+  if (!CheckExecution(generator, grid, 1, "point data change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Changing the points must regenerate the ghost geometry.
+  grid->GetPoints()->Modified();
+  grid->Modified();
+  if (!CheckExecution(generator, grid, 1, "points change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkIdTypeArray.h>
+#include <vtkLogger.h>
+#include <vtkMPIController.h>
+#include <vtkNew.h>
+#include <vtkPVGhostCellsGenerator.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <map>
+#include <string>
+
+namespace
+{
+constexpr int Extent = 6;
+
+// Returns the index of a point of the wavelet's lattice.
+vtkIdType GetLatticeIndex(vtkDataSet* ds, vtkIdType ptId)
+{
+  const vtkIdType dim = 2 * Extent + 1;
+  double x[3];
+  ds->GetPoint(ptId, x);
+  const vtkIdType ijk[3] = { static_cast<vtkIdType>(x[0] + Extent),
+    static_cast<vtkIdType>(x[1] + Extent), static_cast<vtkIdType>(x[2] + Extent) };
+  return ijk[0] + dim * (ijk[1] + dim * ijk[2]);
+}
+
+// Returns this rank's piece of a tetrahedralized wavelet, with global ids on
+// either its points or its cells.
+vtkSmartPointer<vtkUnstructuredGrid> MakePiece(vtkMultiProcessController* contr, bool pointIds)
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-Extent, Extent, -Extent, Extent, -Extent, Extent);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->UpdatePiece(contr->GetLocalProcessId(), contr->GetNumberOfProcesses(), 0);
+
+  auto piece = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  piece->DeepCopy(tetrahedralize->GetOutput());
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(pointIds ? "PointGlobalIds" : "CellGlobalIds");
+  if (pointIds)
+  {
+    // points shared by several pieces must have the same id: use the lattice index.
+    ids->SetNumberOfTuples(piece->GetNumberOfPoints());
+    for (vtkIdType cc = 0; cc < piece->GetNumberOfPoints(); ++cc)
+    {
+      ids->SetValue(cc, GetLatticeIndex(piece, cc));
+    }
+    piece->GetPointData()->SetGlobalIds(ids);
+  }
+  else
+  {
+    ids->SetNumberOfTuples(piece->GetNumberOfCells());
+    for (vtkIdType cc = 0; cc < piece->GetNumberOfCells(); ++cc)
+    {
+      ids->SetValue(cc, static_cast<vtkIdType>(contr->GetLocalProcessId()) * 10000000 + cc);
+    }
+    piece->GetCellData()->SetGlobalIds(ids);
+  }
+  return piece;
+}
+
+// Compares RTData at every point of `result` with the value at the same location
+// in `expected`, ghost points may not be in the same order.
+bool CompareValues(vtkDataSet* result, vtkDataSet* expected, const std::string& label)
+{
+  vtkDataArray* resultArray = result->GetPointData()->GetArray("RTData");
+  vtkDataArray* expectedArray = expected->GetPointData()->GetArray("RTData");
+  if (!resultArray || !expectedArray)
+  {
+    vtkLog(ERROR, << label << ": RTData is missing.");
+    return false;
+  }
+  std::map<vtkIdType, double> expectedValues;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPoints(); ++cc)
+  {
+    expectedValues[GetLatticeIndex(expected, cc)] = expectedArray->GetTuple1(cc);
+  }
+  for (vtkIdType cc = 0; cc < result->GetNumberOfPoints(); ++cc)
+  {
+    auto found = expectedValues.find(GetLatticeIndex(result, cc));
+    if (found == expectedValues.end() || found->second != resultArray->GetTuple1(cc))
+    {
+      vtkLog(ERROR, << label << ": unexpected RTData value " << resultArray->GetTuple1(cc)
+                    << " at point " << cc);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks the output of the cached generator against a generator without cache:
+// same ghosted mesh, same values including on ghosts received from other
+// ranks, and only the ids arrays that were in the input. Both generators are
+// updated before any check since their execution is collective.
+bool CheckOutput(vtkPVGhostCellsGenerator* cached, vtkUnstructuredGrid* input, bool pointIds,
+  const std::string& label)
+{
+  vtkNew<vtkPVGhostCellsGenerator> reference;
+  reference->SetInputData(input);
+  reference->Update();
+  cached->Update();
+
+  auto expected = vtkUnstructuredGrid::SafeDownCast(reference->GetOutputDataObject(0));
+  auto output = vtkUnstructuredGrid::SafeDownCast(cached->GetOutputDataObject(0));
+  if (!output || !expected || output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    vtkLog(ERROR, << label << ": the ghosted mesh differs from the one without cache.");
+    return false;
+  }
+  if (output->GetNumberOfCells() <= input->GetNumberOfCells() || !output->GetCellGhostArray())
+  {
+    vtkLog(ERROR, << label << ": no ghost cells were received.");
+    return false;
+  }
+  if (!CompareValues(output, expected, label))
+  {
+    return false;
+  }
+
+  if ((output->GetPointData()->GetGlobalIds() != nullptr) != pointIds ||
+    (output->GetCellData()->GetGlobalIds() != nullptr) == pointIds)
+  {
+    vtkLog(ERROR, << label << ": global ids are only expected on the "
+                  << (pointIds ? "points." : "cells."));
+    return false;
+  }
+  if (output->GetPointData()->GetProcessIds() || output->GetCellData()->GetProcessIds())
+  {
+    vtkLog(ERROR, << label << ": unexpected process ids.");
+    return false;
+  }
+  return true;
+}
+
+bool TestStaticMesh(vtkMultiProcessController* contr, bool pointIds)
+{
+  const std::string ids = pointIds ? "point ids" : "cell ids";
+  auto input = MakePiece(contr, pointIds);
+  // all ranks run the same collective updates, whatever their checks return.
+
+  vtkNew<vtkPVGhostCellsGenerator> generator;
+  generator->SetController(contr);
+  generator->SetInputData(input);
+  generator->UseStaticMeshCacheOn();
+  bool success = CheckOutput(generator, input, pointIds, "first execution with " + ids);
+
+  // new values are exchanged with the cached ghost mesh.
+  vtkDataArray* rtData = input->GetPointData()->GetArray("RTData");
+  for (vtkIdType cc = 0; cc < rtData->GetNumberOfTuples(); ++cc)
+  {
+    rtData->SetTuple1(cc, 2.0 * rtData->GetTuple1(cc) + contr->GetLocalProcessId());
+  }
+  rtData->Modified();
+  input->Modified();
+  success = CheckOutput(generator, input, pointIds, "point data change with " + ids) && success;
+  if (generator->GetNumberOfStaticMeshCacheHits() != 1)
+  {
+    vtkLog(ERROR, << "Expected 1 cache hit with " << ids << ", got "
+                  << generator->GetNumberOfStaticMeshCacheHits());
+    success = false;
+  }
+  return success;
+}
+}
+
+// Checks vtkPVGhostCellsGenerator's static mesh cache when ghosts are exchanged
+// between ranks.
+int TestPVGhostCellsGeneratorStaticMeshMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> contr;
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestStaticMesh(contr, true) ? 1 : 0;
+  success = TestStaticMesh(contr, false) && success ? 1 : 0;
+
+  int allSuccess = 0;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkDataArray.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkLogger.h>
+#include <vtkNew.h>
+#include <vtkPVProbeLineFilter.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkProbeLineFilter.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+
+namespace
+{
+bool CheckExecution(vtkPVProbeLineFilter* probe, vtkIdType expectedBuilds, const char* step)
+{
+  probe->Update();
+  const int resolution = probe->GetInteracting() && probe->GetInteractiveLineResolution() > 0
+    ? std::min(probe->GetInteractiveLineResolution(), probe->GetLineResolution())
+    : probe->GetLineResolution();
+  const vtkIdType expectedPoints = resolution + 1;
+  if (probe->GetOutput()->GetNumberOfPoints() != expectedPoints)
+  {
+    vtkLog(ERROR, << step << ": expected " << expectedPoints << " points, got "
+                  << probe->GetOutput()->GetNumberOfPoints());
+    return false;
+  }
+  if (probe->GetNumberOfLocatorBuilds() != expectedBuilds)
+  {
+    vtkLog(ERROR, << step << ": expected " << expectedBuilds << " locator builds, got "
+                  << probe->GetNumberOfLocatorBuilds());
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVProbeLineFilterLocatorCache(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->Update();
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(tetrahedralize->GetOutput());
+
+  vtkNew<vtkPVProbeLineFilter> probe;
+  probe->SetInputData(grid);
+  probe->SetSamplingPattern(vtkProbeLineFilter::SAMPLE_LINE_UNIFORMLY);
+  probe->SetLineResolution(100);
+  probe->SetPoint1(-8, -8, -8);
+  probe->SetPoint2(8, 8, 8);
+  if (!CheckExecution(probe, 1, "first execution"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  probe->SetLineResolution(50);
+  if (!CheckExecution(probe, 1, "resolution change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  probe->SetPoint2(8, -8, 8);
+  if (!CheckExecution(probe, 1, "line change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The coarse pre-pass samples fewer points while interacting, with the same locator.
+  probe->SetInteractiveLineResolution(10);
+  probe->InteractingOn();
+  if (!CheckExecution(probe, 1, "interaction"))
+  {
+    return EXIT_FAILURE;
+  }
+  probe->InteractingOff();
+  if (!CheckExecution(probe, 1, "end of interaction"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the attributes only must not rebuild the locator.
+  grid->GetPointData()->GetArray("RTData")->Modified();
+  grid->Modified();
+  if (!CheckExecution(probe, 1, "point data change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the mesh must.
+  grid->GetPoints()->Modified();
+  grid->Modified();
+  if (!CheckExecution(probe, 2, "points change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -2,46 +2,449 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVGhostCellsGenerator.h"
 
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataObjectTree.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGhostCellsGenerator.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataUtilities.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+#include <map>
+#include <numeric>
+
+namespace
+{
+const char* ORIGINAL_IDS_ARRAY_NAME = "vtkPVGhostCellsGenerator_OriginalIds";
+
+//----------------------------------------------------------------------------
+// Collect the vtkDataSet leaves of `dobj`, indexed by flat index (0 for a
+// non-composite dataset).
+std::map<unsigned int, vtkDataSet*> GetLeaves(vtkDataObject* dobj)
+{
+  std::map<unsigned int, vtkDataSet*> leaves;
+  if (auto ds = vtkDataSet::SafeDownCast(dobj))
+  {
+    leaves[0] = ds;
+  }
+  else if (auto dt = vtkDataObjectTree::SafeDownCast(dobj))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(dt->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (auto leaf = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        leaves[iter->GetCurrentFlatIndex()] = leaf;
+      }
+    }
+  }
+  return leaves;
+}
+
+//----------------------------------------------------------------------------
+void AddOriginalIds(vtkDataSetAttributes* attributes, vtkIdType size)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(ORIGINAL_IDS_ARRAY_NAME);
+  ids->SetNumberOfTuples(size);
+  std::iota(ids->GetPointer(0), ids->GetPointer(0) + size, 0);
+  attributes->AddArray(ids);
+}
+
+//----------------------------------------------------------------------------
+// Create a shallow copy of `dobj` with original ids arrays on the point and
+// cell data of every leaf.
+vtkSmartPointer<vtkDataObject> AddOriginalIds(vtkDataObject* dobj)
+{
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(dobj->NewInstance());
+  copy->ShallowCopy(dobj);
+  for (auto& leaf : ::GetLeaves(copy))
+  {
+    ::AddOriginalIds(leaf.second->GetPointData(), leaf.second->GetNumberOfPoints());
+    ::AddOriginalIds(leaf.second->GetCellData(), leaf.second->GetNumberOfCells());
+  }
+  return copy;
+}
+
+//----------------------------------------------------------------------------
+// Build the (source, destination) id pairs mapping non-ghost output entities
+// to input entities. Ghost entities are left out: their values are received
+// from the owning ranks.
+void BuildIdMap(vtkDataSetAttributes* outAttributes, vtkUnsignedCharArray* ghosts,
+  unsigned char ghostFlag, vtkIdList* srcIds, vtkIdList* dstIds)
+{
+  srcIds->Reset();
+  dstIds->Reset();
+  auto originalIds =
+    vtkIdTypeArray::SafeDownCast(outAttributes->GetArray(ORIGINAL_IDS_ARRAY_NAME));
+  if (!originalIds)
+  {
+    return;
+  }
+  for (vtkIdType cc = 0; cc < originalIds->GetNumberOfTuples(); ++cc)
+  {
+    if (!ghosts || !(ghosts->GetValue(cc) & ghostFlag))
+    {
+      srcIds->InsertNextId(originalIds->GetValue(cc));
+      dstIds->InsertNextId(cc);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Fill `outAttributes` with the arrays needed by the ghost synchronization,
+// taken from `cachedAttributes`, and the arrays of `inAttributes` remapped to
+// the cached output entities.
+void RemapAttributes(vtkDataSetAttributes* inAttributes, vtkDataSetAttributes* cachedAttributes,
+  vtkIdType numberOfTuples, vtkIdList* srcIds, vtkIdList* dstIds,
+  vtkDataSetAttributes* outAttributes)
+{
+  outAttributes->Initialize();
+  if (auto ghosts = cachedAttributes->GetArray(vtkDataSetAttributes::GhostArrayName()))
+  {
+    outAttributes->AddArray(ghosts);
+  }
+  if (auto gids = cachedAttributes->GetGlobalIds())
+  {
+    outAttributes->SetGlobalIds(gids);
+  }
+  if (auto pids = cachedAttributes->GetProcessIds())
+  {
+    outAttributes->SetProcessIds(pids);
+  }
+
+  for (int idx = 0; idx < inAttributes->GetNumberOfArrays(); ++idx)
+  {
+    vtkAbstractArray* inArray = inAttributes->GetAbstractArray(idx);
+    const int attributeType = inAttributes->IsArrayAnAttribute(idx);
+    if (!inArray || !inArray->GetName() ||
+      strcmp(inArray->GetName(), vtkDataSetAttributes::GhostArrayName()) == 0 ||
+      attributeType == vtkDataSetAttributes::GLOBALIDS ||
+      attributeType == vtkDataSetAttributes::PROCESSIDS)
+    {
+      continue;
+    }
+
+    vtkSmartPointer<vtkAbstractArray> outArray;
+    outArray.TakeReference(inArray->NewInstance());
+    outArray->SetName(inArray->GetName());
+    outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+    outArray->SetNumberOfTuples(numberOfTuples);
+    if (auto outDataArray = vtkDataArray::SafeDownCast(outArray))
+    {
+      outDataArray->Fill(0.0);
+    }
+    outArray->InsertTuples(dstIds, srcIds, inArray);
+
+    if (attributeType >= 0)
+    {
+      outAttributes->SetAttribute(outArray, attributeType);
+    }
+    else
+    {
+      outAttributes->AddArray(outArray);
+    }
+  }
+}
+}
+
+//----------------------------------------------------------------------------
+struct vtkPVGhostCellsGenerator::vtkInternals
+{
+  struct BlockCache
+  {
+    // Ghosted block produced by the last full generation.
+    vtkSmartPointer<vtkDataSet> Output;
+    vtkMTimeType MeshMTime = 0;
+    vtkIdType NumberOfPoints = 0;
+    vtkIdType NumberOfCells = 0;
+    // Whether the input block had global and process ids, for point data (0)
+    // and cell data (1).
+    bool HadGlobalIds[2] = { false, false };
+    bool HadProcessIds[2] = { false, false };
+    vtkNew<vtkIdList> PointSrcIds;
+    vtkNew<vtkIdList> PointDstIds;
+    vtkNew<vtkIdList> CellSrcIds;
+    vtkNew<vtkIdList> CellDstIds;
+  };
+
+  std::map<unsigned int, BlockCache> Blocks;
+  vtkSmartPointer<vtkDataObject> CachedOutput;
+  vtkMTimeType FilterMTime = 0;
+
+  //----------------------------------------------------------------------------
+  // Returns true if the cache is valid for `input` on this rank.
+  bool IsValid(vtkDataObject* input, vtkMTimeType filterMTime) const
+  {
+    if (!this->CachedOutput || this->FilterMTime != filterMTime ||
+      !this->CachedOutput->IsA(input->GetClassName()))
+    {
+      return false;
+    }
+
+    auto leaves = ::GetLeaves(input);
+    if (leaves.size() != this->Blocks.size())
+    {
+      return false;
+    }
+    for (const auto& leaf : leaves)
+    {
+      auto found = this->Blocks.find(leaf.first);
+      if (found == this->Blocks.end() ||
+        found->second.MeshMTime != vtkPVDataUtilities::GetMeshMTime(leaf.second) ||
+        found->second.NumberOfPoints != leaf.second->GetNumberOfPoints() ||
+        found->second.NumberOfCells != leaf.second->GetNumberOfCells())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Fill the cache from `input` and `output`, the result of a full ghost
+  // generation on `input` with original ids arrays added.
+  void Update(vtkDataObject* input, vtkDataObject* output, vtkMTimeType filterMTime)
+  {
+    this->Blocks.clear();
+    this->CachedOutput = output;
+    this->FilterMTime = filterMTime;
+
+    auto outLeaves = ::GetLeaves(output);
+    for (const auto& leaf : ::GetLeaves(input))
+    {
+      auto outLeaf = outLeaves.find(leaf.first);
+      if (outLeaf == outLeaves.end())
+      {
+        continue;
+      }
+      vtkDataSet* outDS = outLeaf->second;
+      auto& block = this->Blocks[leaf.first];
+      block.Output = outDS;
+      block.MeshMTime = vtkPVDataUtilities::GetMeshMTime(leaf.second);
+      block.NumberOfPoints = leaf.second->GetNumberOfPoints();
+      block.NumberOfCells = leaf.second->GetNumberOfCells();
+      vtkDataSetAttributes* inAttributes[2] = { leaf.second->GetPointData(),
+        leaf.second->GetCellData() };
+      for (int type = 0; type < 2; ++type)
+      {
+        block.HadGlobalIds[type] = inAttributes[type]->GetGlobalIds() != nullptr;
+        block.HadProcessIds[type] = inAttributes[type]->GetProcessIds() != nullptr;
+      }
+      ::BuildIdMap(outDS->GetPointData(), outDS->GetPointGhostArray(),
+        vtkDataSetAttributes::DUPLICATEPOINT, block.PointSrcIds, block.PointDstIds);
+      ::BuildIdMap(outDS->GetCellData(), outDS->GetCellGhostArray(),
+        vtkDataSetAttributes::DUPLICATECELL, block.CellSrcIds, block.CellDstIds);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Create a data object with the cached ghosted geometry and the attributes of
+  // `input`. Ghost entities are zero-filled, to be synchronized afterwards.
+  vtkSmartPointer<vtkDataObject> Compose(vtkDataObject* input)
+  {
+    auto inLeaves = ::GetLeaves(input);
+    auto composeBlock = [&](unsigned int index, vtkDataSet* cached) {
+      vtkSmartPointer<vtkDataSet> block;
+      block.TakeReference(cached->NewInstance());
+      block->CopyStructure(cached);
+      auto found = inLeaves.find(index);
+      if (found != inLeaves.end())
+      {
+        auto& cache = this->Blocks[index];
+        ::RemapAttributes(found->second->GetPointData(), cached->GetPointData(),
+          cached->GetNumberOfPoints(), cache.PointSrcIds, cache.PointDstIds,
+          block->GetPointData());
+        ::RemapAttributes(found->second->GetCellData(), cached->GetCellData(),
+          cached->GetNumberOfCells(), cache.CellSrcIds, cache.CellDstIds, block->GetCellData());
+        block->GetFieldData()->ShallowCopy(found->second->GetFieldData());
+      }
+      return block;
+    };
+
+    if (auto cachedDS = vtkDataSet::SafeDownCast(this->CachedOutput))
+    {
+      return composeBlock(0, cachedDS);
+    }
+
+    auto cachedDT = vtkDataObjectTree::SafeDownCast(this->CachedOutput);
+    vtkSmartPointer<vtkDataObjectTree> result;
+    result.TakeReference(cachedDT->NewInstance());
+    result->CopyStructure(cachedDT);
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cachedDT->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (auto cached = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        result->SetDataSet(iter, composeBlock(iter->GetCurrentFlatIndex(), cached));
+      }
+    }
+    result->GetFieldData()->ShallowCopy(input->GetFieldData());
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+  // Remove the arrays added for the cache that were not requested.
+  void CleanOutput(vtkDataObject* output, bool keepGlobalIds, bool keepProcessIds)
+  {
+    for (auto& leaf : ::GetLeaves(output))
+    {
+      auto found = this->Blocks.find(leaf.first);
+      vtkDataSetAttributes* outAttributes[2] = { leaf.second->GetPointData(),
+        leaf.second->GetCellData() };
+      for (int type = 0; type < 2; ++type)
+      {
+        vtkDataSetAttributes* attributes = outAttributes[type];
+        attributes->RemoveArray(ORIGINAL_IDS_ARRAY_NAME);
+        if (!keepGlobalIds && (found == this->Blocks.end() || !found->second.HadGlobalIds[type]))
+        {
+          attributes->SetGlobalIds(nullptr);
+        }
+        if (!keepProcessIds &&
+          (found == this->Blocks.end() || !found->second.HadProcessIds[type]))
+        {
+          attributes->SetProcessIds(nullptr);
+        }
+      }
+    }
+  }
+};
 
 vtkStandardNewMacro(vtkPVGhostCellsGenerator);
 
+//----------------------------------------------------------------------------
+vtkPVGhostCellsGenerator::vtkPVGhostCellsGenerator()
+  : Internals(new vtkPVGhostCellsGenerator::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVGhostCellsGenerator::~vtkPVGhostCellsGenerator()
+{
+  delete this->Internals;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGhostCellsGenerator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseStaticMeshCache: " << this->UseStaticMeshCache << endl;
+  os << indent << "NumberOfStaticMeshCacheHits: " << this->NumberOfStaticMeshCacheHits << endl;
 }
 
 //----------------------------------------------------------------------------
-int vtkPVGhostCellsGenerator::GhostCellsGeneratorUsingSuperclassInstance(
-  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+void vtkPVGhostCellsGenerator::ReleaseStaticMeshCache()
+{
+  this->Internals->Blocks.clear();
+  this->Internals->CachedOutput = nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVGhostCellsGenerator::RunSuperclassInstance(
+  vtkDataObject* input, bool synchronizeOnly)
 {
   vtkNew<Superclass> instance;
 
   instance->SetBuildIfRequired(this->GetBuildIfRequired());
   instance->SetController(this->GetController());
   instance->SetNumberOfGhostLayers(this->GetNumberOfGhostLayers());
+  instance->SetSynchronizeOnly(synchronizeOnly);
+  instance->SetGenerateGlobalIds(this->GetGenerateGlobalIds());
+  instance->SetGenerateProcessIds(this->GetGenerateProcessIds());
+  if (this->UseStaticMeshCache)
+  {
+    // Synchronization relies on global and process ids.
+    instance->SetGenerateGlobalIds(true);
+    instance->SetGenerateProcessIds(true);
+  }
 
+  instance->SetInputDataObject(input);
+  if (!instance->GetExecutive()->Update())
+  {
+    return nullptr;
+  }
+  return instance->GetOutputDataObject(0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGhostCellsGenerator::GhostCellsGeneratorUsingSuperclassInstance(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
   vtkDataObject* inputDO = vtkDataObject::GetData(inputVector[0], 0);
   vtkDataObject* outputDO = vtkDataObject::GetData(outputVector, 0);
 
-  instance->SetInputDataObject(inputDO);
-  if (instance->GetExecutive()->Update())
+  if (this->UseStaticMeshCache)
   {
-    outputDO->ShallowCopy(instance->GetOutput());
+    return this->StaticMeshRequestData(inputDO, outputDO);
+  }
+
+  auto result = this->RunSuperclassInstance(inputDO, this->GetSynchronizeOnly());
+  if (result)
+  {
+    outputDO->ShallowCopy(result);
     return 1;
   }
 
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkPVGhostCellsGenerator::StaticMeshRequestData(vtkDataObject* input, vtkDataObject* output)
+{
+  auto& internals = *this->Internals;
+
+  // All ranks must agree on reusing the cache since both code paths involve
+  // collective communication.
+  int canReuse = internals.IsValid(input, this->GetMTime()) ? 1 : 0;
+  vtkMultiProcessController* controller = this->GetController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int localCanReuse = canReuse;
+    controller->AllReduce(&localCanReuse, &canReuse, 1, vtkCommunicator::MIN_OP);
+  }
+
+  vtkSmartPointer<vtkDataObject> result;
+  if (canReuse)
+  {
+    ++this->NumberOfStaticMeshCacheHits;
+    result = this->RunSuperclassInstance(internals.Compose(input), true);
+  }
+  else
+  {
+    result = this->RunSuperclassInstance(::AddOriginalIds(input), false);
+    if (result)
+    {
+      internals.Update(input, result, this->GetMTime());
+    }
+  }
+
+  if (!result)
+  {
+    this->ReleaseStaticMeshCache();
+    return 0;
+  }
+
+  output->ShallowCopy(result);
+  internals.CleanOutput(output, this->GetGenerateGlobalIds(), this->GetGenerateProcessIds());
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVGhostCellsGenerator::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
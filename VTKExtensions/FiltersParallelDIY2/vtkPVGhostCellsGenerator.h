@@ -6,6 +6,14 @@
  *
  * This is a subclass of vtkGhostCellsGenerator that allows selection of
  * input vtkHyperTreeGrid
+ *
+ * It also provides a static mesh mode (see `UseStaticMeshCache`) for transient
+ * data where only point and cell attributes change over time. In that mode, the
+ * ghosted geometry produced by the first execution is cached along with the
+ * mapping from input to output points and cells. On later executions, if the
+ * mesh of every input block is unchanged on all ranks, the cached geometry is
+ * reused and only the attribute arrays are exchanged between ranks, using the
+ * superclass synchronization mode.
  */
 
 #ifndef vtkPVGhostCellsGenerator_h
@@ -13,6 +21,7 @@
 
 #include "vtkGhostCellsGenerator.h"
 #include "vtkPVVTKExtensionsFiltersParallelDIY2Module.h" //needed for exports
+#include "vtkSmartPointer.h"                             // for vtkSmartPointer
 
 class VTKPVVTKEXTENSIONSFILTERSPARALLELDIY2_EXPORT vtkPVGhostCellsGenerator
   : public vtkGhostCellsGenerator
@@ -22,9 +31,35 @@ public:
   vtkTypeMacro(vtkPVGhostCellsGenerator, vtkGhostCellsGenerator);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When on, cache the generated ghost geometry and reuse it on later
+   * executions as long as the input mesh (points and cells) does not change,
+   * exchanging only attribute arrays. The mesh is considered unchanged when the
+   * points and cells of each block have not been modified, which is the case
+   * with readers caching static geometry or after the Force Static Mesh
+   * filter. Off by default.
+   */
+  vtkSetMacro(UseStaticMeshCache, bool);
+  vtkGetMacro(UseStaticMeshCache, bool);
+  vtkBooleanMacro(UseStaticMeshCache, bool);
+  ///@}
+
+  /**
+   * Returns the number of executions that reused the cached ghost geometry and
+   * only exchanged attributes. Mostly useful to check that the static mesh
+   * cache is hit.
+   */
+  vtkGetMacro(NumberOfStaticMeshCacheHits, vtkIdType);
+
+  /**
+   * Release the cached ghost geometry, if any.
+   */
+  void ReleaseStaticMeshCache();
+
 protected:
-  vtkPVGhostCellsGenerator() = default;
-  ~vtkPVGhostCellsGenerator() override = default;
+  vtkPVGhostCellsGenerator();
+  ~vtkPVGhostCellsGenerator() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
@@ -32,9 +67,27 @@ protected:
   int GhostCellsGeneratorUsingSuperclassInstance(
     vtkInformation*, vtkInformationVector**, vtkInformationVector*);
 
+  /**
+   * Run an internal vtkGhostCellsGenerator configured like this filter on
+   * `input`. When `synchronizeOnly` is true, only ghost data is exchanged.
+   * Returns nullptr on failure.
+   */
+  vtkSmartPointer<vtkDataObject> RunSuperclassInstance(vtkDataObject* input, bool synchronizeOnly);
+
+  /**
+   * Implementation of RequestData() when UseStaticMeshCache is on.
+   */
+  int StaticMeshRequestData(vtkDataObject* input, vtkDataObject* output);
+
+  bool UseStaticMeshCache = false;
+  vtkIdType NumberOfStaticMeshCacheHits = 0;
+
 private:
   vtkPVGhostCellsGenerator(const vtkPVGhostCellsGenerator&) = delete;
   void operator=(const vtkPVGhostCellsGenerator&) = delete;
+
+  struct vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
@@ -3,23 +3,178 @@
 
 #include "vtkPVProbeLineFilter.h"
 
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectTree.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLineSource.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataUtilities.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
 #include "vtkProbeLineFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <map>
+
+struct vtkPVProbeLineFilter::vtkInternals
+{
+  struct LocatorItem
+  {
+    vtkMTimeType MeshMTime = 0;
+    vtkIdType NumberOfPoints = 0;
+    vtkIdType NumberOfCells = 0;
+    vtkSmartPointer<vtkStaticCellLocator> Locator;
+  };
+
+  // Cell locators of the point set blocks of the input, indexed by flat index.
+  std::map<unsigned int, LocatorItem> Locators;
+
+  // Shallow copy of the input handed to the prober. It is only replaced when
+  // the input changes so that the prober's input stays untouched when only the
+  // line is modified.
+  vtkSmartPointer<vtkDataObject> CachedInput;
+  vtkWeakPointer<vtkDataObject> LastInput;
+  vtkMTimeType LastInputMTime = 0;
+
+  //----------------------------------------------------------------------------
+  // Attach a cell locator to `copy`, a shallow copy of the `block` input block,
+  // reusing the previous one when the mesh of `block` did not change. Returns
+  // true if a new locator was built.
+  bool AttachLocator(unsigned int index, vtkDataSet* block, vtkDataSet* copy)
+  {
+    auto ps = vtkPointSet::SafeDownCast(copy);
+    if (!ps || ps->GetNumberOfCells() == 0)
+    {
+      this->Locators.erase(index);
+      return false;
+    }
+
+    const vtkMTimeType meshMTime = vtkPVDataUtilities::GetMeshMTime(block);
+    auto& item = this->Locators[index];
+    if (item.Locator == nullptr || item.MeshMTime != meshMTime ||
+      item.NumberOfPoints != block->GetNumberOfPoints() ||
+      item.NumberOfCells != block->GetNumberOfCells())
+    {
+      item.MeshMTime = meshMTime;
+      item.NumberOfPoints = block->GetNumberOfPoints();
+      item.NumberOfCells = block->GetNumberOfCells();
+      item.Locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      item.Locator->SetDataSet(ps);
+      item.Locator->BuildLocator();
+      // The search structure only depends on the mesh, which we track
+      // ourselves: do not let attribute changes trigger a rebuild.
+      item.Locator->UseExistingSearchStructureOn();
+      ps->SetCellLocator(item.Locator);
+      return true;
+    }
+
+    // `copy` shares its points and cells with the copy the locator was built
+    // for, the existing search structure is still valid.
+    item.Locator->SetDataSet(ps);
+    ps->SetCellLocator(item.Locator);
+    return false;
+  }
+};
 
 vtkStandardNewMacro(vtkPVProbeLineFilter);
 
 //----------------------------------------------------------------------------
 vtkPVProbeLineFilter::vtkPVProbeLineFilter()
+  : Internals(new vtkPVProbeLineFilter::vtkInternals())
 {
   this->LineSource->SetResolution(1);
   this->Prober->SetAggregateAsPolyData(true);
   this->Prober->SetSourceConnection(this->LineSource->GetOutputPort());
 }
 
+//----------------------------------------------------------------------------
+vtkPVProbeLineFilter::~vtkPVProbeLineFilter()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProbeLineFilter::ReleaseCache()
+{
+  this->Internals->Locators.clear();
+  this->Internals->CachedInput = nullptr;
+  this->Internals->LastInput = nullptr;
+  this->Internals->LastInputMTime = 0;
+  this->Prober->RemoveAllInputConnections(0);
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkPVProbeLineFilter::UpdateCachedInput(vtkDataObject* input)
+{
+  auto& internals = *this->Internals;
+  if (internals.CachedInput && internals.LastInput == input &&
+    internals.LastInputMTime == input->GetMTime())
+  {
+    return internals.CachedInput;
+  }
+
+  internals.LastInput = input;
+  internals.LastInputMTime = input->GetMTime();
+
+  if (auto ds = vtkDataSet::SafeDownCast(input))
+  {
+    vtkSmartPointer<vtkDataSet> copy;
+    copy.TakeReference(ds->NewInstance());
+    copy->ShallowCopy(ds);
+    this->NumberOfLocatorBuilds += internals.AttachLocator(0, ds, copy) ? 1 : 0;
+    internals.CachedInput = copy;
+  }
+  else if (auto dt = vtkDataObjectTree::SafeDownCast(input))
+  {
+    vtkSmartPointer<vtkDataObjectTree> copy;
+    copy.TakeReference(dt->NewInstance());
+    copy->CopyStructure(dt);
+
+    std::map<unsigned int, vtkInternals::LocatorItem> locators;
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(dt->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      auto block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (!block)
+      {
+        copy->SetDataSet(iter, iter->GetCurrentDataObject());
+        continue;
+      }
+      vtkSmartPointer<vtkDataSet> blockCopy;
+      blockCopy.TakeReference(block->NewInstance());
+      blockCopy->ShallowCopy(block);
+      copy->SetDataSet(iter, blockCopy);
+
+      const unsigned int index = iter->GetCurrentFlatIndex();
+      this->NumberOfLocatorBuilds += internals.AttachLocator(index, block, blockCopy) ? 1 : 0;
+      auto found = internals.Locators.find(index);
+      if (found != internals.Locators.end())
+      {
+        locators.insert(*found);
+      }
+    }
+    // Forget about locators of blocks that are gone.
+    internals.Locators.swap(locators);
+    internals.CachedInput = copy;
+  }
+  else
+  {
+    // e.g. vtkHyperTreeGrid: nothing to cache.
+    internals.Locators.clear();
+    internals.CachedInput = input;
+  }
+
+  this->Prober->SetInputData(internals.CachedInput);
+  return internals.CachedInput;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVProbeLineFilter::RequestData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -43,7 +198,9 @@ int vtkPVProbeLineFilter::RequestData(
 
   this->LineSource->SetPoint1(this->Point1);
   this->LineSource->SetPoint2(this->Point2);
-  this->Prober->SetLineResolution(this->LineResolution);
+  this->Prober->SetLineResolution(this->Interacting && this->InteractiveLineResolution > 0
+      ? std::min(this->InteractiveLineResolution, this->LineResolution)
+      : this->LineResolution);
   this->Prober->SetPassCellArrays(this->PassCellArrays);
   this->Prober->SetPassPointArrays(this->PassPointArrays);
   this->Prober->SetPassFieldArrays(this->PassFieldArrays);
@@ -52,7 +209,7 @@ int vtkPVProbeLineFilter::RequestData(
   this->Prober->SetComputeTolerance(this->ComputeTolerance);
   this->Prober->SetSamplingPattern(this->SamplingPattern);
 
-  this->Prober->SetInputData(input);
+  this->UpdateCachedInput(input);
   this->Prober->Update();
   output->ShallowCopy(this->Prober->GetOutputDataObject(0));
 
@@ -94,10 +251,14 @@ void vtkPVProbeLineFilter::PrintSelf(ostream& os, vtkIndent indent)
       break;
   }
   os << indent << "LineResolution: " << this->LineResolution << endl;
+  os << indent << "Interacting: " << this->Interacting << endl;
+  os << indent << "InteractiveLineResolution: " << this->InteractiveLineResolution << endl;
   os << indent << "PassPartialArrays: " << this->PassPartialArrays << endl;
   os << indent << "PassCellArrays: " << this->PassCellArrays << endl;
   os << indent << "PassPointArrays: " << this->PassPointArrays << endl;
   os << indent << "PassFieldArrays: " << this->PassFieldArrays << endl;
   os << indent << "ComputeTolerance: " << this->ComputeTolerance << endl;
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "NumberOfLocatorBuilds: " << this->NumberOfLocatorBuilds << endl;
+  os << indent << "Number of cached locators: " << this->Internals->Locators.size() << endl;
 }
@@ -7,6 +7,14 @@
  * Internal Paraview filters for API backward compatibilty and ease of use.
  * Internally build a line source as well as a vtkProbeLineFilter and exposes
  * their properties.
+ *
+ * To keep interactive line placement cheap on large unstructured inputs, the
+ * filter keeps a shallow copy of its input and a cell locator per point set
+ * block across executions. Locators are keyed on the mesh modification time of
+ * each block (points and cells, not attributes), so moving the line or changing
+ * the resolution only re-does the sampling. While `Interacting` is set, e.g. by
+ * the line widget while it is dragged, uniform sampling can use the coarser
+ * `InteractiveLineResolution`.
  */
 
 #ifndef vtkPVProbeLineFilter_h
@@ -115,6 +123,26 @@ public:
   vtkSetMacro(LineResolution, int);
   ///@}
 
+  ///@{
+  /**
+   * Set while the line is being interactively modified. When on and
+   * `InteractiveLineResolution` is strictly positive, uniform sampling uses
+   * `InteractiveLineResolution` instead of `LineResolution`. Off by default.
+   */
+  vtkSetMacro(Interacting, bool);
+  vtkBooleanMacro(Interacting, bool);
+  vtkGetMacro(Interacting, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of points of the sampling line used instead of `LineResolution`
+   * while `Interacting` is on. 0 (default) disables the coarse pre-pass.
+   */
+  vtkSetClampMacro(InteractiveLineResolution, int, 0, VTK_INT_MAX);
+  vtkGetMacro(InteractiveLineResolution, int);
+  ///@}
+
   ///@{
   /**
    * Get/Set the begin and end points for the line to probe against.
@@ -125,15 +153,28 @@ public:
   vtkSetVector3Macro(Point2, double);
   ///@}
 
+  /**
+   * Returns the number of cell locators built since the filter was created.
+   * Mostly useful to check that the locator cache is hit.
+   */
+  vtkGetMacro(NumberOfLocatorBuilds, vtkIdType);
+
+  /**
+   * Release the cached input copy and cell locators.
+   */
+  void ReleaseCache();
+
 protected:
   vtkPVProbeLineFilter();
-  ~vtkPVProbeLineFilter() override = default;
+  ~vtkPVProbeLineFilter() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
 
   int SamplingPattern = 0;
   int LineResolution = 1000;
+  bool Interacting = false;
+  int InteractiveLineResolution = 0;
   bool PassPartialArrays = false;
   bool PassCellArrays = false;
   bool PassPointArrays = false;
@@ -142,6 +183,7 @@ protected:
   double Tolerance = 1.0;
   double Point1[3] = { 0, 0, 0 };
   double Point2[3] = { 1, 1, 1 };
+  vtkIdType NumberOfLocatorBuilds = 0;
 
   vtkNew<vtkLineSource> LineSource;
   vtkNew<vtkProbeLineFilter> Prober;
@@ -149,6 +191,15 @@ protected:
 private:
   vtkPVProbeLineFilter(const vtkPVProbeLineFilter&) = delete;
   void operator=(const vtkPVProbeLineFilter&) = delete;
+
+  /**
+   * Returns the input handed to the internal prober, refreshing the cached
+   * copy and its cell locators if `input` changed since the last execution.
+   */
+  vtkDataObject* UpdateCachedInput(vtkDataObject* input);
+
+  struct vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif // vtkPVProbeLineFilter_h
@@ -0,0 +1,306 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+// Number of points along each side of the polydata.
+constexpr int Resolution = 64;
+
+// Exposes the marshalling done by vtkMPIMoveData before any communication.
+class TestMoveData : public vtkMPIMoveData
+{
+public:
+  static TestMoveData* New();
+  vtkTypeMacro(TestMoveData, vtkMPIMoveData);
+
+  std::string RoundTrip(vtkDataObject* input, vtkDataObject* output)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(input);
+    const std::string header(this->Buffers, 4);
+    this->ReconstructDataFromBuffer(output);
+    this->ClearBuffer();
+    return header;
+  }
+};
+vtkStandardNewMacro(TestMoveData);
+
+#define CHECK(condition)                                                                           \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(condition))                                                                              \
+    {                                                                                              \
+      vtkLog(ERROR, "Failed: " #condition);                                                        \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+void AddArrays(vtkDataSet* ds)
+{
+  const vtkIdType numberOfPoints = ds->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetComponentName(0, "X");
+  vectors->SetComponentName(2, "Z");
+  vectors->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType cc = 0; cc < numberOfPoints; ++cc)
+  {
+    scalars->SetValue(cc, 0.25 * cc);
+    const float vector[3] = { 1.f * cc, 2.f * cc, 3.f * cc };
+    vectors->SetTypedTuple(cc, vector);
+  }
+  ds->GetPointData()->SetScalars(scalars);
+  ds->GetPointData()->AddArray(vectors);
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(ds->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < ds->GetNumberOfCells(); ++cc)
+  {
+    ids->SetValue(cc, 1000 + cc);
+  }
+  ds->GetCellData()->SetGlobalIds(ids);
+
+  vtkNew<vtkStringArray> note;
+  note->SetName("note");
+  note->InsertNextValue("marshalled");
+  note->InsertNextValue("moved");
+  ds->GetFieldData()->AddArray(note);
+}
+
+bool CheckArrays(vtkDataSet* input, vtkDataSet* output)
+{
+  CHECK(output->GetNumberOfPoints() == input->GetNumberOfPoints());
+  CHECK(output->GetNumberOfCells() == input->GetNumberOfCells());
+
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  CHECK(scalars != nullptr && std::string(scalars->GetName()) == "scalars");
+  CHECK(scalars->GetDataType() == VTK_DOUBLE);
+  vtkFloatArray* vectors =
+    vtkFloatArray::SafeDownCast(output->GetPointData()->GetAbstractArray("vectors"));
+  CHECK(vectors != nullptr && vectors->GetNumberOfComponents() == 3);
+  CHECK(std::string(vectors->GetComponentName(0)) == "X");
+  CHECK(std::string(vectors->GetComponentName(2)) == "Z");
+  for (vtkIdType cc = 0; cc < output->GetNumberOfPoints(); ++cc)
+  {
+    CHECK(scalars->GetTuple1(cc) == 0.25 * cc);
+    CHECK(vectors->GetValue(3 * cc + 2) == 3.f * cc);
+  }
+
+  vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("ids"));
+  CHECK(ids != nullptr && ids->GetNumberOfValues() == output->GetNumberOfCells());
+  CHECK(output->GetNumberOfCells() == 0 || ids->GetValue(output->GetNumberOfCells() - 1) ==
+      1000 + output->GetNumberOfCells() - 1);
+
+  vtkStringArray* note =
+    vtkStringArray::SafeDownCast(output->GetFieldData()->GetAbstractArray("note"));
+  CHECK(note != nullptr && note->GetNumberOfValues() == 2);
+  CHECK(note->GetValue(0) == "marshalled" && note->GetValue(1) == "moved");
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> lines;
+  for (int j = 0; j < Resolution; ++j)
+  {
+    for (int i = 0; i < Resolution; ++i)
+    {
+      points->InsertNextPoint(i, j, std::sin(0.1 * i) * std::cos(0.1 * j));
+      if (i > 0 && j > 0)
+      {
+        const vtkIdType p = j * Resolution + i;
+        const vtkIdType quad[4] = { p - Resolution - 1, p - Resolution, p, p - 1 };
+        polys->InsertNextCell(4, quad);
+      }
+    }
+  }
+  const vtkIdType line[2] = { 0, Resolution - 1 };
+  lines->InsertNextCell(2, line);
+  input->SetPoints(points);
+  input->SetPolys(polys);
+  input->SetLines(lines);
+  AddArrays(input);
+  return input;
+}
+
+bool TestPolyData(TestMoveData* moveData, const std::string& format)
+{
+  vtkSmartPointer<vtkPolyData> input = MakePolyData();
+  vtkPoints* points = input->GetPoints();
+
+  vtkNew<vtkPolyData> output;
+  CHECK(moveData->RoundTrip(input, output) == format);
+  CHECK(output->GetNumberOfPolys() == input->GetNumberOfPolys());
+  CHECK(output->GetNumberOfLines() == 1);
+  CHECK(output->GetPoints()->GetData()->GetDataType() == points->GetData()->GetDataType());
+  double expected[3];
+  double received[3];
+  points->GetPoint(Resolution + 3, expected);
+  output->GetPoint(Resolution + 3, received);
+  CHECK(expected[0] == received[0] && expected[1] == received[1] && expected[2] == received[2]);
+  vtkNew<vtkIdList> cell;
+  output->GetCellPoints(output->GetNumberOfCells() - 1, cell);
+  CHECK(cell->GetNumberOfIds() == 4 && cell->GetId(2) == Resolution * Resolution - 1);
+  return CheckArrays(input, output);
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid()
+{
+  auto input = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+  points->InsertNextPoint(1, 1, 1);
+  input->SetPoints(points);
+  const vtkIdType tetra[4] = { 0, 1, 2, 3 };
+  const vtkIdType triangle[3] = { 1, 2, 4 };
+  const vtkIdType vertex[1] = { 4 };
+  input->InsertNextCell(VTK_TETRA, 4, tetra);
+  input->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  input->InsertNextCell(VTK_VERTEX, 1, vertex);
+  AddArrays(input);
+  return input;
+}
+
+bool TestUnstructuredGrid(TestMoveData* moveData, const std::string& format)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> input = MakeUnstructuredGrid();
+
+  vtkNew<vtkUnstructuredGrid> output;
+  CHECK(moveData->RoundTrip(input, output) == format);
+  CHECK(output->GetCellType(0) == VTK_TETRA);
+  CHECK(output->GetCellType(1) == VTK_TRIANGLE);
+  CHECK(output->GetCellType(2) == VTK_VERTEX);
+  vtkNew<vtkIdList> cell;
+  output->GetCellPoints(1, cell);
+  CHECK(cell->GetNumberOfIds() == 3 && cell->GetId(2) == 4);
+  return CheckArrays(input, output);
+}
+
+bool TestImageData(TestMoveData* moveData, const std::string& format, bool binary)
+{
+  vtkNew<vtkImageData> input;
+  input->SetExtent(-4, 11, 2, 9, 0, 3);
+  input->SetOrigin(0.5, -1, 2);
+  input->SetSpacing(0.25, 0.5, 1);
+  const double direction[9] = { 0, -1, 0, 1, 0, 0, 0, 0, 1 };
+  if (binary)
+  {
+    // The legacy format loses the orientation.
+    input->SetDirectionMatrix(direction);
+  }
+  AddArrays(input);
+
+  vtkNew<vtkImageData> output;
+  CHECK(moveData->RoundTrip(input, output) == format);
+  const int* extent = output->GetExtent();
+  CHECK(extent[0] == -4 && extent[1] == 11 && extent[2] == 2 && extent[5] == 3);
+  CHECK(output->GetOrigin()[0] == 0.5 && output->GetOrigin()[1] == -1);
+  CHECK(output->GetSpacing()[0] == 0.25 && output->GetSpacing()[1] == 0.5);
+  for (int cc = 0; cc < 9; ++cc)
+  {
+    CHECK(output->GetDirectionMatrix()->GetData()[cc] ==
+      input->GetDirectionMatrix()->GetData()[cc]);
+  }
+  return CheckArrays(input, output);
+}
+
+// Composite datasets are only marshalled in the binary format, along with the
+// names of their blocks and their empty blocks.
+bool TestMultiBlock(TestMoveData* moveData, const std::string& format)
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  vtkSmartPointer<vtkPolyData> polyData = MakePolyData();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeUnstructuredGrid();
+  vtkNew<vtkPartitionedDataSet> partitioned;
+  partitioned->SetNumberOfPartitions(2);
+  partitioned->SetPartition(1, grid);
+  input->SetNumberOfBlocks(3);
+  input->SetBlock(0, polyData);
+  input->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  input->SetBlock(2, partitioned);
+
+  vtkNew<vtkMultiBlockDataSet> output;
+  CHECK(moveData->RoundTrip(input, output) == format);
+  CHECK(output->GetNumberOfBlocks() == 3 && output->GetBlock(1) == nullptr);
+  vtkPolyData* outputPolyData = vtkPolyData::SafeDownCast(output->GetBlock(0));
+  CHECK(outputPolyData != nullptr);
+  CHECK(output->HasMetaData(0u) &&
+    std::string(output->GetMetaData(0u)->Get(vtkCompositeDataSet::NAME())) == "surface");
+  vtkPartitionedDataSet* outputPartitioned =
+    vtkPartitionedDataSet::SafeDownCast(output->GetBlock(2));
+  CHECK(outputPartitioned != nullptr && outputPartitioned->GetNumberOfPartitions() == 2);
+  vtkUnstructuredGrid* outputGrid =
+    vtkUnstructuredGrid::SafeDownCast(outputPartitioned->GetPartition(1));
+  CHECK(outputPartitioned->GetPartition(0) == nullptr && outputGrid != nullptr);
+  CHECK(outputGrid->GetCellType(0) == VTK_TETRA);
+  return CheckArrays(polyData, outputPolyData) && CheckArrays(grid, outputGrid);
+}
+}
+
+int TestMPIMoveDataMarshalling(int, char*[])
+{
+  vtkNew<TestMoveData> moveData;
+  const bool binary = vtkMPIMoveData::GetUseBinaryMarshalling();
+  const bool lz4 = vtkMPIMoveData::GetUseLZ4Compression();
+  const bool zlib = vtkMPIMoveData::GetUseZLibCompression();
+
+  bool success = true;
+  for (int mode = 0; mode < 4; ++mode)
+  {
+    // Legacy, binary, binary with LZ4 and binary with zlib.
+    vtkMPIMoveData::SetUseBinaryMarshalling(mode != 0);
+    vtkMPIMoveData::SetUseLZ4Compression(mode == 2);
+    vtkMPIMoveData::SetUseZLibCompression(mode == 3);
+    const std::string format = mode == 0 ? "# vt" : (mode == 3 ? "zlib" : "vtkb");
+    if (!TestPolyData(moveData, format) || !TestUnstructuredGrid(moveData, format) ||
+      !TestImageData(moveData, format, mode != 0) ||
+      (mode != 0 && !TestMultiBlock(moveData, format)))
+    {
+      vtkLog(ERROR, "Marshalling failed in mode " << mode << ".");
+      success = false;
+    }
+  }
+
+  vtkMPIMoveData::SetUseBinaryMarshalling(binary);
+  vtkMPIMoveData::SetUseLZ4Compression(lz4);
+  vtkMPIMoveData::SetUseZLibCompression(zlib);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,9 +4,13 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataAssembly.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
@@ -14,26 +18,40 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMPIMToNSocketConnection.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
 #include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseBinaryMarshalling = true;
+bool vtkMPIMoveData::UseLZ4Compression = false;
 
 namespace
 {
@@ -66,6 +84,987 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+//-----------------------------------------------------------------------------
+// Native binary marshalling.
+//
+// A piece marshalled in this format starts with the characters "vtkb" followed
+// by the format version, written in the byte order of the sender so that the
+// receiver can detect when values need to be swapped. Small values (names,
+// types, sizes) are accumulated in a header, while the memory of the arrays is
+// only referenced and copied once, directly into the message, optionally
+// compressed with LZ4. Composite datasets are written as their tree of
+// blocks, each leaf being written as a dataset.
+const char BinaryMagic[4] = { 'v', 't', 'k', 'b' };
+const vtkTypeUInt32 BinaryVersion = 2;
+
+// Written instead of the data object type for empty blocks.
+const vtkTypeInt32 NullDataObject = -1;
+
+// Composite datasets nested deeper than this are rejected when reading.
+const int MaximumTreeDepth = 64;
+
+// Arrays smaller than this are not worth compressing.
+const size_t MinimumCompressedBlockSize = 1024;
+
+enum BlockEncoding : vtkTypeUInt8
+{
+  RAW_BLOCK = 0,
+  LZ4_BLOCK = 1
+};
+
+enum ArrayKind : vtkTypeUInt8
+{
+  NO_ARRAY = 0,
+  DATA_ARRAY = 1,
+  STRING_ARRAY = 2
+};
+
+class vtkBinaryPacker
+{
+public:
+  vtkBinaryPacker(bool compress)
+    : Compress(compress)
+  {
+  }
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    this->WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteBytes(const void* data, size_t length)
+  {
+    if (this->Segments.empty() || this->Segments.back().IsBlock)
+    {
+      this->Segments.push_back(Segment{ false, nullptr, this->Header.size(), 0 });
+    }
+    const char* bytes = static_cast<const char*>(data);
+    this->Header.insert(this->Header.end(), bytes, bytes + length);
+    this->Segments.back().Length += length;
+  }
+
+  // Null strings are written with a length of 0, other strings with their
+  // length plus one.
+  void WriteString(const char* value)
+  {
+    const vtkTypeUInt32 length = value ? static_cast<vtkTypeUInt32>(strlen(value) + 1) : 0;
+    this->Write(length);
+    if (length > 1)
+    {
+      this->WriteBytes(value, length - 1);
+    }
+  }
+
+  // The memory is referenced until Pack() is called.
+  void WriteBlock(const void* data, size_t length)
+  {
+    this->Segments.push_back(Segment{ true, data, 0, data ? length : 0 });
+  }
+
+  void KeepAlive(vtkObjectBase* object) { this->Objects.emplace_back(object); }
+
+  char* Pack(vtkIdType& length) const
+  {
+    size_t bound = 0;
+    for (const Segment& segment : this->Segments)
+    {
+      bound += segment.IsBlock ? sizeof(vtkTypeUInt8) + sizeof(vtkTypeUInt64) : 0;
+      bound += this->CanCompress(segment)
+        ? std::max<size_t>(segment.Length, LZ4_compressBound(static_cast<int>(segment.Length)))
+        : segment.Length;
+    }
+
+    char* buffer = new char[bound];
+    char* out = buffer;
+    for (const Segment& segment : this->Segments)
+    {
+      if (!segment.IsBlock)
+      {
+        memcpy(out, this->Header.data() + segment.Offset, segment.Length);
+        out += segment.Length;
+        continue;
+      }
+
+      vtkTypeUInt8 encoding = RAW_BLOCK;
+      vtkTypeUInt64 stored = segment.Length;
+      char* payload = out + sizeof(encoding) + sizeof(stored);
+      if (this->CanCompress(segment))
+      {
+        const int inputSize = static_cast<int>(segment.Length);
+        const int compressed = LZ4_compress_default(static_cast<const char*>(segment.Data),
+          payload, inputSize, LZ4_compressBound(inputSize));
+        if (compressed > 0 && compressed < inputSize)
+        {
+          encoding = LZ4_BLOCK;
+          stored = static_cast<vtkTypeUInt64>(compressed);
+        }
+      }
+      if (encoding == RAW_BLOCK && segment.Length > 0)
+      {
+        memcpy(payload, segment.Data, segment.Length);
+      }
+      memcpy(out, &encoding, sizeof(encoding));
+      memcpy(out + sizeof(encoding), &stored, sizeof(stored));
+      out = payload + stored;
+    }
+    length = static_cast<vtkIdType>(out - buffer);
+    return buffer;
+  }
+
+private:
+  // A segment either covers a range of the header, or references a block of
+  // memory written by WriteBlock.
+  struct Segment
+  {
+    bool IsBlock;
+    const void* Data;
+    size_t Offset;
+    size_t Length;
+  };
+
+  bool CanCompress(const Segment& segment) const
+  {
+    return this->Compress && segment.IsBlock && segment.Length >= MinimumCompressedBlockSize &&
+      segment.Length <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE);
+  }
+
+  bool Compress;
+  std::vector<char> Header;
+  std::vector<Segment> Segments;
+  std::vector<vtkSmartPointer<vtkObjectBase>> Objects;
+};
+
+class vtkBinaryUnpacker
+{
+public:
+  vtkBinaryUnpacker(const char* data, size_t length)
+    : Cursor(data)
+    , End(data + length)
+  {
+  }
+
+  bool Begin()
+  {
+    vtkTypeUInt32 version = 0;
+    if (this->Remaining() < sizeof(BinaryMagic) ||
+      memcmp(this->Cursor, BinaryMagic, sizeof(BinaryMagic)) != 0)
+    {
+      return false;
+    }
+    this->Cursor += sizeof(BinaryMagic);
+    if (!this->Read(version))
+    {
+      return false;
+    }
+    if (version != BinaryVersion)
+    {
+      vtkByteSwap::SwapVoidRange(&version, 1, sizeof(version));
+      this->Swap = true;
+    }
+    return version == BinaryVersion;
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->Remaining() < sizeof(T))
+    {
+      return false;
+    }
+    memcpy(&value, this->Cursor, sizeof(T));
+    this->Cursor += sizeof(T);
+    if (this->Swap && sizeof(T) > 1)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    return true;
+  }
+
+  bool ReadString(std::string& value, bool& isNull)
+  {
+    vtkTypeUInt32 length = 0;
+    if (!this->Read(length) || (length > 0 && this->Remaining() < length - 1))
+    {
+      return false;
+    }
+    isNull = length == 0;
+    value.assign(this->Cursor, isNull ? 0 : length - 1);
+    this->Cursor += value.size();
+    return true;
+  }
+
+  // Reads a block written by vtkBinaryPacker::WriteBlock and swaps its values
+  // if needed.
+  bool ReadBlock(void* destination, size_t length, size_t wordSize)
+  {
+    vtkTypeUInt8 encoding = RAW_BLOCK;
+    vtkTypeUInt64 stored = 0;
+    if (!this->Read(encoding) || !this->Read(stored) || stored > this->Remaining())
+    {
+      return false;
+    }
+    if (encoding == RAW_BLOCK)
+    {
+      if (stored != length)
+      {
+        return false;
+      }
+      if (length > 0)
+      {
+        memcpy(destination, this->Cursor, length);
+      }
+    }
+    else if (encoding == LZ4_BLOCK)
+    {
+      if (length > static_cast<size_t>(LZ4_MAX_INPUT_SIZE) ||
+        LZ4_decompress_safe(this->Cursor, static_cast<char*>(destination),
+          static_cast<int>(stored), static_cast<int>(length)) != static_cast<int>(length))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+    this->Cursor += stored;
+    if (this->Swap && wordSize > 1)
+    {
+      vtkByteSwap::SwapVoidRange(destination, length / wordSize, wordSize);
+    }
+    return true;
+  }
+
+  size_t Remaining() const { return static_cast<size_t>(this->End - this->Cursor); }
+
+private:
+  const char* Cursor;
+  const char* End;
+  bool Swap = false;
+};
+
+bool CanMarshalArray(vtkAbstractArray* array)
+{
+  if (vtkDataArray::SafeDownCast(array))
+  {
+    return array->GetDataType() != VTK_BIT;
+  }
+  return vtkStringArray::SafeDownCast(array) != nullptr;
+}
+
+bool CanMarshalFieldData(vtkFieldData* fieldData)
+{
+  for (int cc = 0, max = fieldData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    if (!CanMarshalArray(fieldData->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsBinaryDataSetType(int type)
+{
+  return type == VTK_POLY_DATA || type == VTK_UNSTRUCTURED_GRID || type == VTK_IMAGE_DATA;
+}
+
+bool CanMarshalDataSet(vtkDataSet* ds)
+{
+  if (!CanMarshalFieldData(ds->GetFieldData()) || !CanMarshalFieldData(ds->GetPointData()) ||
+    !CanMarshalFieldData(ds->GetCellData()))
+  {
+    return false;
+  }
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(ds);
+  if (pointSet && pointSet->GetPoints() && !CanMarshalArray(pointSet->GetPoints()->GetData()))
+  {
+    return false;
+  }
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(ds);
+  vtkUnsignedCharArray* cellTypes = grid ? grid->GetCellTypesArray() : nullptr;
+  if (cellTypes)
+  {
+    const unsigned char* begin = cellTypes->GetPointer(0);
+    const unsigned char* end = begin + cellTypes->GetNumberOfValues();
+    if (std::find(begin, end, VTK_POLYHEDRON) != end)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the native binary format can represent `data`: polydata,
+// unstructured grids, image data, and multiblock and partitioned datasets of
+// these. Other data types, bit and variant arrays, and polyhedral cells are
+// left to the legacy writer.
+bool CanMarshalBinary(vtkDataObject* data)
+{
+  if (!data)
+  {
+    return true;
+  }
+  if (vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    for (unsigned int cc = 0; cc < multiBlock->GetNumberOfBlocks(); ++cc)
+    {
+      if (!CanMarshalBinary(multiBlock->GetBlock(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (vtkPartitionedDataSetCollection* collection =
+        vtkPartitionedDataSetCollection::SafeDownCast(data))
+  {
+    for (unsigned int cc = 0; cc < collection->GetNumberOfPartitionedDataSets(); ++cc)
+    {
+      if (!CanMarshalBinary(collection->GetPartitionedDataSet(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(data))
+  {
+    for (unsigned int cc = 0; cc < partitioned->GetNumberOfPartitions(); ++cc)
+    {
+      if (!CanMarshalBinary(partitioned->GetPartitionAsDataObject(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  return IsBinaryDataSetType(data->GetDataObjectType()) &&
+    CanMarshalDataSet(vtkDataSet::SafeDownCast(data));
+}
+
+void WriteArray(vtkBinaryPacker& packer, vtkAbstractArray* array)
+{
+  if (!array)
+  {
+    packer.Write(static_cast<vtkTypeUInt8>(NO_ARRAY));
+    return;
+  }
+  vtkStringArray* strings = vtkStringArray::SafeDownCast(array);
+  packer.Write(static_cast<vtkTypeUInt8>(strings ? STRING_ARRAY : DATA_ARRAY));
+  packer.WriteString(array->GetName());
+  packer.Write(static_cast<vtkTypeInt32>(array->GetDataType()));
+  packer.Write(static_cast<vtkTypeInt32>(array->GetNumberOfComponents()));
+  packer.Write(static_cast<vtkTypeInt64>(array->GetNumberOfTuples()));
+  const int numberOfNames = array->HasAComponentName() ? array->GetNumberOfComponents() : 0;
+  packer.Write(static_cast<vtkTypeInt32>(numberOfNames));
+  for (int cc = 0; cc < numberOfNames; ++cc)
+  {
+    packer.WriteString(array->GetComponentName(cc));
+  }
+
+  const vtkIdType numberOfValues = array->GetNumberOfTuples() * array->GetNumberOfComponents();
+  if (strings)
+  {
+    for (vtkIdType cc = 0; cc < numberOfValues; ++cc)
+    {
+      packer.WriteString(strings->GetValue(cc).c_str());
+    }
+    return;
+  }
+
+  packer.Write(static_cast<vtkTypeInt32>(array->GetDataTypeSize()));
+  if (!array->HasStandardMemoryLayout())
+  {
+    // Implicit and struct-of-arrays arrays are copied in the usual layout first.
+    vtkDataArray* copy = vtkDataArray::CreateDataArray(array->GetDataType());
+    copy->DeepCopy(array);
+    packer.KeepAlive(copy);
+    copy->Delete();
+    array = copy;
+  }
+  packer.WriteBlock(numberOfValues > 0 ? array->GetVoidPointer(0) : nullptr,
+    static_cast<size_t>(numberOfValues) * array->GetDataTypeSize());
+}
+
+// Converts `count` integers of `wordSize` bytes, signed or not, to `values`.
+template <typename T>
+void ConvertIntegers(const unsigned char* data, int wordSize, bool isSigned, T* values,
+  vtkIdType count)
+{
+  for (vtkIdType cc = 0; cc < count; ++cc, data += wordSize)
+  {
+    switch (wordSize)
+    {
+      case 1:
+        values[cc] = isSigned ? static_cast<T>(*reinterpret_cast<const vtkTypeInt8*>(data))
+                              : static_cast<T>(*data);
+        break;
+      case 2:
+      {
+        vtkTypeInt16 value;
+        memcpy(&value, data, sizeof(value));
+        values[cc] = isSigned ? static_cast<T>(value) : static_cast<T>(vtkTypeUInt16(value));
+        break;
+      }
+      case 4:
+      {
+        vtkTypeInt32 value;
+        memcpy(&value, data, sizeof(value));
+        values[cc] = isSigned ? static_cast<T>(value) : static_cast<T>(vtkTypeUInt32(value));
+        break;
+      }
+      default:
+      {
+        vtkTypeInt64 value;
+        memcpy(&value, data, sizeof(value));
+        values[cc] = isSigned ? static_cast<T>(value) : static_cast<T>(vtkTypeUInt64(value));
+        break;
+      }
+    }
+  }
+}
+
+// Reads a block of integers written with a different size than the one of
+// the values of `array` on this process, and converts them.
+bool ReadConvertedBlock(vtkBinaryUnpacker& unpacker, vtkAbstractArray* array,
+  vtkIdType numberOfValues, vtkTypeInt32 wordSize)
+{
+  bool isSigned = true;
+  switch (array->GetDataType())
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_INT:
+    case VTK_LONG:
+    case VTK_LONG_LONG:
+    case VTK_ID_TYPE:
+      break;
+    case VTK_UNSIGNED_CHAR:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_UNSIGNED_INT:
+    case VTK_UNSIGNED_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+      isSigned = false;
+      break;
+    default:
+      return false;
+  }
+  if (wordSize != 1 && wordSize != 2 && wordSize != 4 && wordSize != 8)
+  {
+    return false;
+  }
+
+  const size_t length = static_cast<size_t>(numberOfValues) * wordSize;
+  std::vector<unsigned char> data(length);
+  if (!unpacker.ReadBlock(data.data(), length, wordSize))
+  {
+    return false;
+  }
+  void* values = numberOfValues > 0 ? array->GetVoidPointer(0) : nullptr;
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(ConvertIntegers(
+      data.data(), wordSize, isSigned, static_cast<VTK_TT*>(values), numberOfValues));
+  }
+  return true;
+}
+
+bool ReadArray(vtkBinaryUnpacker& unpacker, vtkSmartPointer<vtkAbstractArray>& array)
+{
+  vtkTypeUInt8 kind = NO_ARRAY;
+  std::string name;
+  bool nullName = true;
+  vtkTypeInt32 dataType = 0;
+  vtkTypeInt32 numberOfComponents = 0;
+  vtkTypeInt64 numberOfTuples = 0;
+  vtkTypeInt32 numberOfNames = 0;
+  array = nullptr;
+  if (!unpacker.Read(kind))
+  {
+    return false;
+  }
+  if (kind == NO_ARRAY)
+  {
+    return true;
+  }
+  if (!unpacker.ReadString(name, nullName) || !unpacker.Read(dataType) ||
+    !unpacker.Read(numberOfComponents) || !unpacker.Read(numberOfTuples) ||
+    !unpacker.Read(numberOfNames) || numberOfComponents < 1 || numberOfTuples < 0 ||
+    (numberOfNames != 0 && numberOfNames != numberOfComponents))
+  {
+    return false;
+  }
+
+  if (kind == STRING_ARRAY)
+  {
+    array = vtkSmartPointer<vtkStringArray>::New();
+  }
+  else if (kind == DATA_ARRAY && dataType != VTK_BIT)
+  {
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  }
+  if (!array)
+  {
+    return false;
+  }
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numberOfTuples));
+  if (!nullName)
+  {
+    array->SetName(name.c_str());
+  }
+  for (int cc = 0; cc < numberOfNames; ++cc)
+  {
+    std::string componentName;
+    bool nullComponentName = true;
+    if (!unpacker.ReadString(componentName, nullComponentName))
+    {
+      return false;
+    }
+    if (!nullComponentName)
+    {
+      array->SetComponentName(cc, componentName.c_str());
+    }
+  }
+
+  const vtkIdType numberOfValues = array->GetNumberOfTuples() * numberOfComponents;
+  if (vtkStringArray* strings = vtkStringArray::SafeDownCast(array))
+  {
+    std::string value;
+    bool nullValue = true;
+    for (vtkIdType cc = 0; cc < numberOfValues; ++cc)
+    {
+      if (!unpacker.ReadString(value, nullValue))
+      {
+        return false;
+      }
+      strings->SetValue(cc, value);
+    }
+    return true;
+  }
+
+  vtkTypeInt32 wordSize = 0;
+  if (!unpacker.Read(wordSize))
+  {
+    return false;
+  }
+  if (wordSize != array->GetDataTypeSize())
+  {
+    // vtkIdType and long may have a different size on the sender.
+    return ReadConvertedBlock(unpacker, array, numberOfValues, wordSize);
+  }
+  return unpacker.ReadBlock(numberOfValues > 0 ? array->GetVoidPointer(0) : nullptr,
+    static_cast<size_t>(numberOfValues) * wordSize, wordSize);
+}
+
+void WriteFieldData(vtkBinaryPacker& packer, vtkFieldData* fieldData)
+{
+  packer.Write(static_cast<vtkTypeInt32>(fieldData->GetNumberOfArrays()));
+  for (int cc = 0, max = fieldData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    WriteArray(packer, fieldData->GetAbstractArray(cc));
+  }
+  if (vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData))
+  {
+    int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    attributes->GetAttributeIndices(indices);
+    for (int index : indices)
+    {
+      packer.Write(static_cast<vtkTypeInt32>(index));
+    }
+  }
+}
+
+bool ReadFieldData(vtkBinaryUnpacker& unpacker, vtkFieldData* fieldData)
+{
+  vtkTypeInt32 numberOfArrays = 0;
+  if (!unpacker.Read(numberOfArrays) || numberOfArrays < 0)
+  {
+    return false;
+  }
+  for (vtkTypeInt32 cc = 0; cc < numberOfArrays; ++cc)
+  {
+    vtkSmartPointer<vtkAbstractArray> array;
+    if (!ReadArray(unpacker, array) || !array)
+    {
+      return false;
+    }
+    fieldData->AddArray(array);
+  }
+  if (vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData))
+  {
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+    {
+      vtkTypeInt32 index = -1;
+      if (!unpacker.Read(index) || index >= numberOfArrays)
+      {
+        return false;
+      }
+      if (index >= 0)
+      {
+        attributes->SetActiveAttribute(index, attribute);
+      }
+    }
+  }
+  return true;
+}
+
+void WriteCellArray(vtkBinaryPacker& packer, vtkCellArray* cells)
+{
+  WriteArray(packer, cells ? cells->GetOffsetsArray() : nullptr);
+  WriteArray(packer, cells ? cells->GetConnectivityArray() : nullptr);
+}
+
+bool ReadCellArray(vtkBinaryUnpacker& unpacker, vtkSmartPointer<vtkCellArray>& cells)
+{
+  vtkSmartPointer<vtkAbstractArray> offsets;
+  vtkSmartPointer<vtkAbstractArray> connectivity;
+  cells = nullptr;
+  if (!ReadArray(unpacker, offsets) || !ReadArray(unpacker, connectivity))
+  {
+    return false;
+  }
+  if (!offsets && !connectivity)
+  {
+    return true;
+  }
+  cells = vtkSmartPointer<vtkCellArray>::New();
+  return cells->SetData(
+    vtkDataArray::SafeDownCast(offsets), vtkDataArray::SafeDownCast(connectivity));
+}
+
+// Name of a block of a composite dataset, if any.
+const char* GetBlockName(vtkDataObjectTree* tree, unsigned int index)
+{
+  vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(tree);
+  vtkPartitionedDataSetCollection* collection = vtkPartitionedDataSetCollection::SafeDownCast(tree);
+  vtkInformation* metaData = nullptr;
+  if (multiBlock && multiBlock->HasMetaData(index))
+  {
+    metaData = multiBlock->GetMetaData(index);
+  }
+  else if (collection && collection->HasMetaData(index))
+  {
+    metaData = collection->GetMetaData(index);
+  }
+  return metaData && metaData->Has(vtkCompositeDataSet::NAME())
+    ? metaData->Get(vtkCompositeDataSet::NAME())
+    : nullptr;
+}
+
+void WriteDataSet(vtkBinaryPacker& packer, vtkDataSet* ds)
+{
+  WriteFieldData(packer, ds->GetFieldData());
+
+  if (vtkImageData* image = vtkImageData::SafeDownCast(ds))
+  {
+    // Unlike the legacy format, the extent and orientation are kept as is.
+    const int* extent = image->GetExtent();
+    for (int cc = 0; cc < 6; ++cc)
+    {
+      packer.Write(static_cast<vtkTypeInt32>(extent[cc]));
+    }
+    packer.WriteBytes(image->GetOrigin(), 3 * sizeof(double));
+    packer.WriteBytes(image->GetSpacing(), 3 * sizeof(double));
+    packer.WriteBytes(image->GetDirectionMatrix()->GetData(), 9 * sizeof(double));
+  }
+  if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(ds))
+  {
+    vtkPoints* points = pointSet->GetPoints();
+    WriteArray(packer, points ? points->GetData() : nullptr);
+  }
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(ds))
+  {
+    WriteCellArray(packer, polyData->GetVerts());
+    WriteCellArray(packer, polyData->GetLines());
+    WriteCellArray(packer, polyData->GetPolys());
+    WriteCellArray(packer, polyData->GetStrips());
+  }
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    WriteArray(packer, grid->GetCellTypesArray());
+    WriteCellArray(packer, grid->GetCells());
+  }
+  WriteFieldData(packer, ds->GetPointData());
+  WriteFieldData(packer, ds->GetCellData());
+}
+
+// Writes the type of `data`, followed by its blocks for composite datasets, or
+// by its arrays for datasets.
+void WriteDataObject(vtkBinaryPacker& packer, vtkDataObject* data)
+{
+  packer.Write(static_cast<vtkTypeInt32>(data ? data->GetDataObjectType() : NullDataObject));
+  if (!data)
+  {
+    return;
+  }
+  if (vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    packer.Write(static_cast<vtkTypeUInt32>(multiBlock->GetNumberOfBlocks()));
+    for (unsigned int cc = 0; cc < multiBlock->GetNumberOfBlocks(); ++cc)
+    {
+      packer.WriteString(GetBlockName(multiBlock, cc));
+      WriteDataObject(packer, multiBlock->GetBlock(cc));
+    }
+  }
+  else if (vtkPartitionedDataSetCollection* collection =
+             vtkPartitionedDataSetCollection::SafeDownCast(data))
+  {
+    packer.Write(static_cast<vtkTypeUInt32>(collection->GetNumberOfPartitionedDataSets()));
+    for (unsigned int cc = 0; cc < collection->GetNumberOfPartitionedDataSets(); ++cc)
+    {
+      packer.WriteString(GetBlockName(collection, cc));
+      WriteDataObject(packer, collection->GetPartitionedDataSet(cc));
+    }
+    vtkDataAssembly* assembly = collection->GetDataAssembly();
+    packer.WriteString(assembly ? assembly->SerializeToXML(vtkIndent()).c_str() : nullptr);
+  }
+  else if (vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(data))
+  {
+    packer.Write(static_cast<vtkTypeUInt32>(partitioned->GetNumberOfPartitions()));
+    for (unsigned int cc = 0; cc < partitioned->GetNumberOfPartitions(); ++cc)
+    {
+      WriteDataObject(packer, partitioned->GetPartitionAsDataObject(cc));
+    }
+  }
+  else
+  {
+    WriteDataSet(packer, vtkDataSet::SafeDownCast(data));
+  }
+}
+
+char* MarshalBinary(vtkDataObject* data, bool compress, vtkIdType& length)
+{
+  vtkBinaryPacker packer(compress);
+  packer.WriteBytes(BinaryMagic, sizeof(BinaryMagic));
+  packer.Write(BinaryVersion);
+  WriteDataObject(packer, data);
+  return packer.Pack(length);
+}
+
+bool IsBinaryBuffer(const char* buffer, vtkIdType length)
+{
+  return length >= static_cast<vtkIdType>(sizeof(BinaryMagic)) &&
+    memcmp(buffer, BinaryMagic, sizeof(BinaryMagic)) == 0;
+}
+
+vtkSmartPointer<vtkDataSet> ReadDataSet(vtkBinaryUnpacker& unpacker, vtkTypeInt32 type)
+{
+  vtkSmartPointer<vtkDataSet> ds;
+  ds.TakeReference(vtkDataSet::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+  if (!ds || !ReadFieldData(unpacker, ds->GetFieldData()))
+  {
+    return nullptr;
+  }
+
+  if (vtkImageData* image = vtkImageData::SafeDownCast(ds))
+  {
+    vtkTypeInt32 extent[6];
+    double origin[3];
+    double spacing[3];
+    double direction[9];
+    for (vtkTypeInt32& value : extent)
+    {
+      if (!unpacker.Read(value))
+      {
+        return nullptr;
+      }
+    }
+    for (double* values : { origin, spacing })
+    {
+      if (!unpacker.Read(values[0]) || !unpacker.Read(values[1]) || !unpacker.Read(values[2]))
+      {
+        return nullptr;
+      }
+    }
+    for (double& value : direction)
+    {
+      if (!unpacker.Read(value))
+      {
+        return nullptr;
+      }
+    }
+    image->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+    image->SetOrigin(origin);
+    image->SetSpacing(spacing);
+    image->SetDirectionMatrix(direction);
+  }
+  if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(ds))
+  {
+    vtkSmartPointer<vtkAbstractArray> coordinates;
+    if (!ReadArray(unpacker, coordinates) ||
+      (coordinates && !vtkDataArray::SafeDownCast(coordinates)))
+    {
+      return nullptr;
+    }
+    if (coordinates)
+    {
+      vtkNew<vtkPoints> points;
+      points->SetData(vtkDataArray::SafeDownCast(coordinates));
+      pointSet->SetPoints(points);
+    }
+  }
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(ds))
+  {
+    vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+    if (!ReadCellArray(unpacker, verts) || !ReadCellArray(unpacker, lines) ||
+      !ReadCellArray(unpacker, polys) || !ReadCellArray(unpacker, strips))
+    {
+      return nullptr;
+    }
+    polyData->SetVerts(verts);
+    polyData->SetLines(lines);
+    polyData->SetPolys(polys);
+    polyData->SetStrips(strips);
+  }
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    vtkSmartPointer<vtkAbstractArray> cellTypes;
+    vtkSmartPointer<vtkCellArray> cells;
+    if (!ReadArray(unpacker, cellTypes) || !ReadCellArray(unpacker, cells))
+    {
+      return nullptr;
+    }
+    if (cells)
+    {
+      vtkUnsignedCharArray* types = vtkUnsignedCharArray::SafeDownCast(cellTypes);
+      if (!types || types->GetNumberOfValues() != cells->GetNumberOfCells())
+      {
+        return nullptr;
+      }
+      grid->SetCells(types, cells);
+    }
+  }
+  if (!ReadFieldData(unpacker, ds->GetPointData()) ||
+    !ReadFieldData(unpacker, ds->GetCellData()))
+  {
+    return nullptr;
+  }
+  return ds;
+}
+
+// Reads a data object written by WriteDataObject. Returns false on invalid
+// data, `data` being null for empty blocks.
+bool ReadDataObject(vtkBinaryUnpacker& unpacker, vtkSmartPointer<vtkDataObject>& data, int depth)
+{
+  vtkTypeInt32 type = NullDataObject;
+  data = nullptr;
+  if (!unpacker.Read(type))
+  {
+    return false;
+  }
+  if (type == NullDataObject)
+  {
+    return true;
+  }
+  if (IsBinaryDataSetType(type))
+  {
+    data = ReadDataSet(unpacker, type);
+    return data != nullptr;
+  }
+
+  vtkTypeUInt32 numberOfBlocks = 0;
+  if (depth >= MaximumTreeDepth || !unpacker.Read(numberOfBlocks) ||
+    numberOfBlocks > unpacker.Remaining() / sizeof(vtkTypeInt32))
+  {
+    return false;
+  }
+  std::vector<vtkSmartPointer<vtkDataObject>> blocks(numberOfBlocks);
+  std::vector<std::string> names(numberOfBlocks);
+  std::vector<bool> hasName(numberOfBlocks, false);
+  const bool named = type == VTK_MULTIBLOCK_DATA_SET || type == VTK_PARTITIONED_DATA_SET_COLLECTION;
+  for (vtkTypeUInt32 cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    bool nullName = true;
+    if ((named && !unpacker.ReadString(names[cc], nullName)) ||
+      !ReadDataObject(unpacker, blocks[cc], depth + 1))
+    {
+      return false;
+    }
+    hasName[cc] = !nullName;
+  }
+
+  if (type == VTK_MULTIBLOCK_DATA_SET)
+  {
+    auto multiBlock = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    multiBlock->SetNumberOfBlocks(numberOfBlocks);
+    for (vtkTypeUInt32 cc = 0; cc < numberOfBlocks; ++cc)
+    {
+      multiBlock->SetBlock(cc, blocks[cc]);
+      if (hasName[cc])
+      {
+        multiBlock->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), names[cc].c_str());
+      }
+    }
+    data = multiBlock;
+  }
+  else if (type == VTK_PARTITIONED_DATA_SET_COLLECTION)
+  {
+    auto collection = vtkSmartPointer<vtkPartitionedDataSetCollection>::New();
+    collection->SetNumberOfPartitionedDataSets(numberOfBlocks);
+    for (vtkTypeUInt32 cc = 0; cc < numberOfBlocks; ++cc)
+    {
+      vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(blocks[cc]);
+      if (blocks[cc] && !partitioned)
+      {
+        return false;
+      }
+      collection->SetPartitionedDataSet(cc, partitioned);
+      if (hasName[cc])
+      {
+        collection->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), names[cc].c_str());
+      }
+    }
+    std::string assemblyXML;
+    bool nullAssembly = true;
+    if (!unpacker.ReadString(assemblyXML, nullAssembly))
+    {
+      return false;
+    }
+    if (!nullAssembly)
+    {
+      vtkNew<vtkDataAssembly> assembly;
+      if (!assembly->InitializeFromXML(assemblyXML.c_str()))
+      {
+        return false;
+      }
+      collection->SetDataAssembly(assembly);
+    }
+    data = collection;
+  }
+  else if (type == VTK_PARTITIONED_DATA_SET || type == VTK_MULTIPIECE_DATA_SET)
+  {
+    vtkSmartPointer<vtkPartitionedDataSet> partitioned;
+    partitioned.TakeReference(
+      vtkPartitionedDataSet::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+    partitioned->SetNumberOfPartitions(numberOfBlocks);
+    for (vtkTypeUInt32 cc = 0; cc < numberOfBlocks; ++cc)
+    {
+      partitioned->SetPartition(cc, blocks[cc]);
+    }
+    data = partitioned;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDataObject> UnmarshalBinary(const char* buffer, vtkIdType length)
+{
+  vtkBinaryUnpacker unpacker(buffer, static_cast<size_t>(length));
+  vtkSmartPointer<vtkDataObject> data;
+  if (!unpacker.Begin() || !ReadDataObject(unpacker, data, 0))
+  {
+    return nullptr;
+  }
+  return data;
+}
 };
 
 vtkStandardNewMacro(vtkMPIMoveData);
@@ -164,6 +1163,30 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseBinaryMarshalling(bool b)
+{
+  vtkMPIMoveData::UseBinaryMarshalling = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseBinaryMarshalling()
+{
+  return vtkMPIMoveData::UseBinaryMarshalling;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseLZ4Compression(bool b)
+{
+  vtkMPIMoveData::UseLZ4Compression = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseLZ4Compression()
+{
+  return vtkMPIMoveData::UseLZ4Compression;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -943,25 +1966,41 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  char* binary = nullptr;
+  vtkDataWriter* writer = nullptr;
+  const char* marshalled = nullptr;
+  vtkIdType marshalled_length = 0;
+  if (vtkMPIMoveData::UseBinaryMarshalling && ::CanMarshalBinary(data))
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    vtkTimerLog::MarkStartEvent("Binary marshal");
+    binary = ::MarshalBinary(data, vtkMPIMoveData::UseLZ4Compression, marshalled_length);
+    marshalled = binary;
+    vtkTimerLog::MarkEndEvent("Binary marshal");
   }
+  else
+  {
+    // Copy input to isolate reader from the pipeline.
+    writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    marshalled = writer->GetOutputString();
+    marshalled_length = writer->GetOutputStringLength();
+  }
 
   char* buffer = nullptr;
   vtkIdType buffer_length = 0;
@@ -970,15 +2009,15 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
     // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
+    uLongf out_size = compressBound(marshalled_length);
     buffer = new char[out_size + 8];
     memcpy(buffer, "zlib0000", 8);
 
     compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
+      reinterpret_cast<const Bytef*>(marshalled), marshalled_length,
       /* compression_level */ Z_DEFAULT_COMPRESSION);
     vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+    int in_size = static_cast<int>(marshalled_length);
     for (int cc = 0; cc < 4; cc++)
     {
       // the first 4 bytes in the header are "zlib" which helps the receiver
@@ -989,6 +2028,12 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
       in_size = in_size >> 8;
     }
     buffer_length = out_size + 8;
+    delete[] binary;
+  }
+  else if (binary)
+  {
+    buffer_length = marshalled_length;
+    buffer = binary;
   }
   else
   {
@@ -1005,8 +2050,11 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
 
-  writer->Delete();
-  writer = nullptr;
+  if (writer)
+  {
+    writer->Delete();
+    writer = nullptr;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -1049,6 +2097,25 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (::IsBinaryBuffer(bufferArray, bufferLength))
+    {
+      vtkTimerLog::MarkStartEvent("Binary unmarshal");
+      vtkSmartPointer<vtkDataObject> piece = ::UnmarshalBinary(bufferArray, bufferLength);
+      vtkTimerLog::MarkEndEvent("Binary unmarshal");
+      if (piece)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(piece);
+        pieces.push_back(piece);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to unmarshal received piece " << idx << ".");
+      }
+      delete[] realBuffer;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
@@ -102,6 +102,32 @@ public:
   static bool GetUseZLibCompression();
   ///@}
 
+  ///@{
+  /**
+   * When set to true, polydata, unstructured grids and image data, as well as
+   * multiblock and partitioned datasets of these, are marshalled in a native
+   * binary format: the array memory is copied as is in the message, instead of
+   * going through the legacy VTK file writer and reader. Other data types, and
+   * datasets with bit arrays, variant arrays or polyhedral cells, are always
+   * sent in the legacy format. Integer arrays whose type has a different size
+   * on the sender, such as vtkIdType, are converted. True by default.
+   * Like the zlib compression, this only has an effect on the data-sender
+   * processes.
+   */
+  static void SetUseBinaryMarshalling(bool b);
+  static bool GetUseBinaryMarshalling();
+  ///@}
+
+  ///@{
+  /**
+   * When set to true, each array marshalled in the native binary format is
+   * compressed with LZ4, which is much faster than the zlib compression of the
+   * whole message. False by default.
+   */
+  static void SetUseLZ4Compression(bool b);
+  static bool GetUseLZ4Compression();
+  ///@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -186,6 +212,8 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static bool UseBinaryMarshalling;
+  static bool UseLZ4Compression;
 };
 
 #endif
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkCSVWriter.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkLogger.h>
+#include <vtkMPIController.h>
+#include <vtkNew.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+#include <vtkTestUtilities.h>
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Number of rows of each rank, spanning several formatting blocks. The second
+// of the three ranks has none, to check that it does not leave a gap between
+// the rows of its neighbours.
+vtkIdType GetNumberOfRows(int rank)
+{
+  return rank == 1 ? 0 : 3000 + 7 * rank;
+}
+
+vtkIdType GetFirstRow(int rank)
+{
+  vtkIdType first = 0;
+  for (int cc = 0; cc < rank; ++cc)
+  {
+    first += GetNumberOfRows(cc);
+  }
+  return first;
+}
+
+void FillTable(vtkTable* table, vtkIdType first, vtkIdType count)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Id");
+  ids->SetNumberOfTuples(count);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Value");
+  values->SetNumberOfComponents(2);
+  values->SetNumberOfTuples(count);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Name");
+  names->SetNumberOfTuples(count);
+  for (vtkIdType cc = 0; cc < count; ++cc)
+  {
+    const vtkIdType row = first + cc;
+    ids->SetValue(cc, row);
+    values->SetTypedComponent(cc, 0, row / 3.0);
+    values->SetTypedComponent(cc, 1, -1e10 * row);
+    names->SetValue(cc, "row " + std::to_string(row));
+  }
+  table->AddColumn(ids);
+  table->AddColumn(values);
+  table->AddColumn(names);
+}
+
+std::string ReadFile(const std::string& fname)
+{
+  vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+}
+
+// Checks that the file written by vtkCSVWriter on several ranks is identical,
+// byte for byte, to the file written by a single process from the same rows.
+int TestCSVWriterParallelOutput(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string parallelName = std::string(tempDir) + "/TestCSVWriterParallelOutput.csv";
+  const std::string serialName = std::string(tempDir) + "/TestCSVWriterSerialOutput.csv";
+  delete[] tempDir;
+
+  vtkNew<vtkTable> table;
+  FillTable(table, GetFirstRow(myRank), GetNumberOfRows(myRank));
+  vtkNew<vtkCSVWriter> writer;
+  writer->SetFileName(parallelName.c_str());
+  writer->SetInputDataObject(table);
+  writer->Write();
+
+  int success = writer->GetErrorCode() == 0 ? 1 : 0;
+  if (myRank == 0)
+  {
+    vtkNew<vtkTable> allRows;
+    FillTable(allRows, 0, GetFirstRow(numRanks));
+    vtkNew<vtkCSVWriter> serialWriter;
+    serialWriter->SetController(nullptr);
+    serialWriter->SetFileName(serialName.c_str());
+    serialWriter->SetInputDataObject(allRows);
+    serialWriter->Write();
+
+    const std::string parallel = ReadFile(parallelName);
+    const std::string serial = ReadFile(serialName);
+    if (serial.empty() || parallel != serial)
+    {
+      vtkLogF(ERROR, "Parallel output (%d bytes) differs from the serial one (%d bytes).",
+        static_cast<int>(parallel.size()), static_cast<int>(serial.size()));
+      success = 0;
+    }
+    if (vtksys::SystemTools::FileExists(parallelName + ".probe"))
+    {
+      vtkLogF(ERROR, "The shared filesystem probe file was not removed.");
+      success = 0;
+    }
+  }
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkFileSeriesReader.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Internal reader producing an empty polydata: the file series reader only
+// needs it to go through the pipeline passes.
+class vtkEmptyPolyDataReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkEmptyPolyDataReader* New();
+  vtkTypeMacro(vtkEmptyPolyDataReader, vtkPolyDataAlgorithm);
+
+protected:
+  vtkEmptyPolyDataReader() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outVector) override
+  {
+    vtkPolyData::GetData(outVector, 0)->Initialize();
+    return 1;
+  }
+};
+vtkStandardNewMacro(vtkEmptyPolyDataReader);
+
+bool CheckCounters(vtkFileSeriesReader* reader, vtkIdType hits, vtkIdType misses, int line)
+{
+  if (reader->GetNumberOfPrefetchHits() != hits || reader->GetNumberOfPrefetchMisses() != misses)
+  {
+    vtkLogF(ERROR, "line %d: expected %lld hits and %lld misses, got %lld and %lld", line,
+      static_cast<long long>(hits), static_cast<long long>(misses),
+      static_cast<long long>(reader->GetNumberOfPrefetchHits()),
+      static_cast<long long>(reader->GetNumberOfPrefetchMisses()));
+    return false;
+  }
+  return true;
+}
+}
+
+#define CHECK_COUNTERS(hits, misses)                                                               \
+  if (!CheckCounters(reader, hits, misses, __LINE__))                                              \
+  {                                                                                                \
+    vtkFileSeriesReader::SetGlobalPrefetch(false);                                                 \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestFileSeriesReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestFileSeriesReaderPrefetch_";
+  delete[] tempDir;
+
+  vtkNew<vtkEmptyPolyDataReader> internalReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(internalReader);
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    const std::string fname = prefix + std::to_string(cc) + ".txt";
+    std::ofstream file(fname.c_str());
+    file << "file " << cc << "\n";
+    reader->AddFileName(fname.c_str());
+  }
+
+  // Off by default: nothing is counted.
+  reader->UpdateTimeStep(1);
+  reader->UpdateTimeStep(0);
+  CHECK_COUNTERS(0, 0);
+
+  vtkFileSeriesReader::SetGlobalPrefetch(true);
+
+  // Nothing was prefetched for the first file read with prefetch on, then each
+  // file was prefetched while reading the previous one.
+  reader->UpdateTimeStep(1);
+  CHECK_COUNTERS(0, 1);
+  reader->UpdateTimeStep(2);
+  reader->UpdateTimeStep(3);
+  CHECK_COUNTERS(2, 1);
+
+  // Re-reading the same file is not counted.
+  reader->Modified();
+  reader->UpdateTimeStep(3);
+  CHECK_COUNTERS(2, 1);
+
+  // Jumping backward misses, then the previous file is prefetched.
+  reader->UpdateTimeStep(1);
+  CHECK_COUNTERS(2, 2);
+  reader->UpdateTimeStep(0);
+  CHECK_COUNTERS(3, 2);
+
+  vtkFileSeriesReader::SetGlobalPrefetch(false);
+  reader->UpdateTimeStep(2);
+  CHECK_COUNTERS(3, 2);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkLogger.h>
+#include <vtkMPIController.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkParallelSerialWriter.h>
+
+#include <algorithm>
+
+namespace
+{
+// Exposes the number of IO ranks computed by vtkParallelSerialWriter.
+class TestWriter : public vtkParallelSerialWriter
+{
+public:
+  static TestWriter* New();
+  vtkTypeMacro(TestWriter, vtkParallelSerialWriter);
+  using vtkParallelSerialWriter::ComputeNumberOfIORanks;
+};
+vtkStandardNewMacro(TestWriter);
+
+// Size of the local data of each rank, in KiB.
+vtkIdType GetLocalSize(int rank)
+{
+  return 512 * (rank + 1);
+}
+}
+
+// Checks that the number of IO ranks chosen from TargetDataSizePerIORank
+// splits the total data size across ranks, within [1, number of ranks].
+int TestParallelSerialWriterIORanks(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+  vtkIdType totalSize = 0;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    totalSize += GetLocalSize(rank);
+  }
+
+  vtkNew<TestWriter> writer;
+  writer->SetController(contr);
+  int success = 1;
+
+  // without a target, NumberOfIORanks is used.
+  writer->SetNumberOfIORanks(1);
+  if (writer->ComputeNumberOfIORanks(GetLocalSize(myRank)) != 1)
+  {
+    vtkLogF(ERROR, "Expected NumberOfIORanks to be used without a target size.");
+    success = 0;
+  }
+
+  for (const int target : { 1, 2, 3, 1000 })
+  {
+    writer->SetTargetDataSizePerIORank(target);
+    const vtkIdType targetSize = static_cast<vtkIdType>(target) * 1024;
+    const int expected = static_cast<int>(std::max<vtkIdType>(
+      1, std::min<vtkIdType>(numRanks, (totalSize + targetSize - 1) / targetSize)));
+    const int count = writer->ComputeNumberOfIORanks(GetLocalSize(myRank));
+    if (count != expected)
+    {
+      vtkLogF(ERROR, "Expected %d IO ranks for a target of %d MiB, got %d.", expected, target,
+        count);
+      success = 0;
+    }
+  }
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -8,7 +8,6 @@
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkAttributeDataToTableFilter.h"
 #include "vtkCellData.h"
-#include "vtkCharArray.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
@@ -16,21 +15,26 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
-#include "vtkUnsignedCharArray.h"
 
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstdio>
+#include <random>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 //-----------------------------------------------------------------------------
@@ -192,9 +196,84 @@ int vtkCSVWriter::ProcessRequest(
 
 namespace
 {
+/**
+ * Appends values as text, producing the same characters as an `ostream` configured
+ * with the writer's precision and notation but without the stream overhead so that
+ * rows can be formatted concurrently.
+ */
+struct ValueFormatter
+{
+  int Precision = 5;
+  bool Scientific = true;
+
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type operator()(
+    std::string& text, T value) const
+  {
+    const char* format = this->Scientific ? "%.*e" : "%.*g";
+    char buffer[64];
+    const int length =
+      snprintf(buffer, sizeof(buffer), format, this->Precision, static_cast<double>(value));
+    if (length < 0)
+    {
+      return;
+    }
+    if (static_cast<size_t>(length) < sizeof(buffer))
+    {
+      text.append(buffer, length);
+      return;
+    }
+    // very large precision, fall back to an exactly sized buffer.
+    std::vector<char> large(length + 1);
+    snprintf(large.data(), large.size(), format, this->Precision, static_cast<double>(value));
+    text.append(large.data(), length);
+  }
+
+  // char types are written as numbers, not as characters.
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type operator()(
+    std::string& text, T value) const
+  {
+    using UnsignedT = typename std::make_unsigned<T>::type;
+    const bool negative = ValueFormatter::IsNegative(value, std::is_signed<T>());
+    UnsignedT magnitude = static_cast<UnsignedT>(value);
+    if (negative)
+    {
+      magnitude = static_cast<UnsignedT>(0 - magnitude);
+    }
+
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* cursor = end;
+    do
+    {
+      *--cursor = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative)
+    {
+      *--cursor = '-';
+    }
+    text.append(cursor, end - cursor);
+  }
+
+private:
+  template <typename T>
+  static bool IsNegative(T value, std::true_type)
+  {
+    return value < 0;
+  }
+  template <typename T>
+  static bool IsNegative(T, std::false_type)
+  {
+    return false;
+  }
+};
+
 /**
  * Worker interface, so we can store pointers of concrete subclasses in a generic container.
- * The operator() should write the array value at given index into the stream.
+ * The operator() should append the array value at given index to the text. It is called
+ * concurrently for different rows.
  */
 struct AbstractStreamWorker
 {
@@ -202,8 +281,10 @@ struct AbstractStreamWorker
     : NumberOfComponents(arr->GetNumberOfComponents())
   {
   }
+  virtual ~AbstractStreamWorker() = default;
 
-  virtual void operator()(ostream& stream, vtkCSVWriter* writer, vtkIdType index) = 0;
+  virtual void operator()(std::string& text, const ValueFormatter& formatter,
+    vtkCSVWriter* writer, vtkIdType index) = 0;
   vtkIdType NumberOfComponents;
 };
 
@@ -219,9 +300,10 @@ struct DataToStreamWorker : public AbstractStreamWorker
     this->Range = vtk::DataArrayValueRange(array);
   }
 
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
+  void operator()(std::string& text, const ValueFormatter& formatter,
+    vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
   {
-    stream << this->Range[index];
+    formatter(text, this->Range[index]);
   }
 
 private:
@@ -242,60 +324,15 @@ struct DataToStreamWorker<vtkStringArray> : public AbstractStreamWorker
   {
   }
 
-  void operator()(ostream& stream, vtkCSVWriter* writer, vtkIdType index) override
+  void operator()(std::string& text, const ValueFormatter& vtkNotUsed(formatter),
+    vtkCSVWriter* writer, vtkIdType index) override
   {
-    stream << writer->GetString(this->Array->GetValue(index));
+    text += writer->GetString(this->Array->GetValue(index));
   }
 
   vtkStringArray* Array;
 };
 
-/**
- * vtkCharArray specialization to enforce numeric values.
- */
-template <>
-struct DataToStreamWorker<vtkCharArray> : public AbstractStreamWorker
-{
-  DataToStreamWorker(vtkCharArray* array)
-    : AbstractStreamWorker(array)
-  {
-    this->Range = vtk::DataArrayValueRange(array);
-  }
-
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
-  {
-    stream << static_cast<int>(this->Range[index]);
-  }
-
-private:
-  using RangeType =
-    typename vtk::detail::SelectValueRange<vtkCharArray, vtk::detail::DynamicTupleSize>::type;
-  RangeType Range;
-};
-
-/**
- * vtkUnsignedCharArray specialization to enforce numeric values.
- */
-template <>
-struct DataToStreamWorker<vtkUnsignedCharArray> : public AbstractStreamWorker
-{
-  DataToStreamWorker(vtkUnsignedCharArray* array)
-    : AbstractStreamWorker(array)
-  {
-    this->Range = vtk::DataArrayValueRange(array);
-  }
-
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
-  {
-    stream << static_cast<int>(this->Range[index]);
-  }
-
-private:
-  using RangeType = typename vtk::detail::SelectValueRange<vtkUnsignedCharArray,
-    vtk::detail::DynamicTupleSize>::type;
-  RangeType Range;
-};
-
 /**
  * Worker dedicated to construct the correct type of workers. Instead
  * of dispatching every row, this pattern enables us to dispatch
@@ -312,6 +349,11 @@ struct WorkerCreator
   }
 };
 
+// Rows are formatted in blocks of this many rows, one block per task.
+constexpr vtkIdType RowsPerBlock = 1024;
+// At most this many rows are held as text at a time.
+constexpr vtkIdType RowsPerBatch = 256 * RowsPerBlock;
+
 } // end anonymous namespace
 
 class vtkCSVWriter::CSVFile
@@ -321,6 +363,8 @@ class vtkCSVWriter::CSVFile
   int TimeStep = -1;
   double Time = vtkMath::Nan();
   std::vector<std::shared_ptr<::AbstractStreamWorker>> ColumnsWorkers;
+  ::ValueFormatter Formatter;
+  std::string FieldDelimiter;
 
 public:
   CSVFile(int timeStep, double time)
@@ -341,13 +385,14 @@ public:
     {
       return vtkErrorCode::NoFileNameError;
     }
+    // binary, so that the byte offsets computed for parallel writes match the file.
     if (OpenMode::Write == mode)
     {
-      this->Stream.open(filename, ios::out);
+      this->Stream.open(filename, ios::out | ios::binary);
     }
     else // (OpenMode::Append == mode)
     {
-      this->Stream.open(filename, ios::app);
+      this->Stream.open(filename, ios::app | ios::binary);
     }
     if (this->Stream.fail())
     {
@@ -356,6 +401,12 @@ public:
     return vtkErrorCode::NoError;
   }
 
+  int Close()
+  {
+    this->Stream.close();
+    return this->Stream.fail() ? vtkErrorCode::OutOfDiskSpaceError : vtkErrorCode::NoError;
+  }
+
   void WriteHeader(vtkTable* table, vtkCSVWriter* self, OpenMode mode)
   {
     this->WriteHeader(table->GetRowData(), self, mode);
@@ -421,17 +472,41 @@ public:
         this->ColumnInfo.push_back(std::make_pair(std::string(array->GetName()), num_comps));
       }
     }
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
+  }
+
+  /**
+   * Sends the columns chosen by the root when writing the header to all other ranks.
+   */
+  void BroadcastColumnInfo(vtkMultiProcessController* controller)
+  {
+    vtkMultiProcessStream stream;
+    if (controller->GetLocalProcessId() == 0)
     {
-      this->Stream << std::scientific;
+      stream << static_cast<int>(this->ColumnInfo.size());
+      for (const auto& cinfo : this->ColumnInfo)
+      {
+        stream << cinfo.first << cinfo.second;
+      }
+    }
+    controller->Broadcast(stream, 0);
+    if (controller->GetLocalProcessId() != 0)
+    {
+      int count = 0;
+      stream >> count;
+      this->ColumnInfo.resize(count);
+      for (auto& cinfo : this->ColumnInfo)
+      {
+        stream >> cinfo.first >> cinfo.second;
+      }
     }
-    this->Stream << std::setprecision(self->GetPrecision());
   }
 
   void InitializeStreamWorkers(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
     this->ColumnsWorkers.clear();
+    this->Formatter.Precision = self->GetPrecision();
+    this->Formatter.Scientific = self->GetUseScientificNotation();
+    this->FieldDelimiter = self->GetFieldDelimiter() ? self->GetFieldDelimiter() : "";
 
     using SupportedArrays = vtkArrayDispatch::AllArrays;
     using Dispatcher = vtkArrayDispatch::DispatchByArray<SupportedArrays>;
@@ -475,49 +550,98 @@ public:
   }
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    this->FormatBatches(dsa, self, [this](const std::vector<std::string>& blocks) {
+      for (const auto& block : blocks)
+      {
+        this->Stream.write(block.data(), block.size());
+      }
+    });
+  }
+
+  void Write(const std::string& text) { this->Stream.write(text.data(), text.size()); }
+
+  /**
+   * Formats the rows of `dsa` in batches of `RowsPerBatch` rows, as they would
+   * be written by `WriteData`, and calls `consumer` with the blocks of each
+   * batch, in order. At most one batch is held as text at a time.
+   */
+  template <typename Consumer>
+  void FormatBatches(vtkDataSetAttributes* dsa, vtkCSVWriter* self, Consumer&& consumer)
   {
     const auto numTuples = dsa->GetNumberOfTuples();
-    for (vtkIdType tupleIndex = 0; tupleIndex < numTuples; ++tupleIndex)
+    std::vector<std::string> blocks;
+    for (vtkIdType begin = 0; begin < numTuples; begin += ::RowsPerBatch)
     {
-      bool firstColumn = true;
-      if (this->TimeStep >= 0)
+      this->FormatRows(begin, std::min(begin + ::RowsPerBatch, numTuples), numTuples, self, blocks);
+      consumer(blocks);
+    }
+  }
+
+private:
+  /**
+   * Formats rows [begin, end) in blocks of `RowsPerBlock` rows. Blocks are formatted
+   * concurrently and must be written in order.
+   */
+  void FormatRows(vtkIdType begin, vtkIdType end, vtkIdType numTuples, vtkCSVWriter* self,
+    std::vector<std::string>& blocks)
+  {
+    const vtkIdType numBlocks = (end - begin + ::RowsPerBlock - 1) / ::RowsPerBlock;
+    blocks.clear();
+    blocks.resize(numBlocks);
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType block = first; block < last; ++block)
       {
-        this->Stream << this->TimeStep;
-        firstColumn = false;
+        const vtkIdType rowBegin = begin + block * ::RowsPerBlock;
+        const vtkIdType rowEnd = std::min(rowBegin + ::RowsPerBlock, end);
+        std::string& text = blocks[block];
+        for (vtkIdType tupleIndex = rowBegin; tupleIndex < rowEnd; ++tupleIndex)
+        {
+          this->FormatRow(tupleIndex, numTuples, self, text);
+        }
       }
-      if (!vtkMath::IsNan(this->Time))
+    });
+  }
+
+  void FormatRow(vtkIdType tupleIndex, vtkIdType numTuples, vtkCSVWriter* self, std::string& text)
+  {
+    bool firstColumn = true;
+    if (this->TimeStep >= 0)
+    {
+      this->Formatter(text, this->TimeStep);
+      firstColumn = false;
+    }
+    if (!vtkMath::IsNan(this->Time))
+    {
+      if (!firstColumn)
+      {
+        text += this->FieldDelimiter;
+      }
+      // add a time column.
+      this->Formatter(text, this->Time);
+      firstColumn = false;
+    }
+
+    for (auto& columnWorker : this->ColumnsWorkers)
+    {
+      int numComps = columnWorker->NumberOfComponents;
+      vtkIdType index = tupleIndex * numComps;
+      for (int component = 0; component < numComps; component++)
       {
         if (!firstColumn)
         {
-          this->Stream << self->GetFieldDelimiter();
+          text += this->FieldDelimiter;
         }
-        // add a time column.
-        this->Stream << this->Time;
         firstColumn = false;
-      }
-
-      for (auto& columnWorker : this->ColumnsWorkers)
-      {
-        int numComps = columnWorker->NumberOfComponents;
-        vtkIdType index = tupleIndex * numComps;
-        for (int component = 0; component < numComps; component++)
+        if ((index + component) < numComps * numTuples)
         {
-          if (!firstColumn)
-          {
-            this->Stream << self->GetFieldDelimiter();
-          }
-          firstColumn = false;
-          if ((index + component) < numComps * numTuples)
-          {
-            (*columnWorker)(this->Stream, self, index + component);
-          }
+          (*columnWorker)(text, this->Formatter, self, index + component);
         }
       }
-      this->Stream << "\n";
     }
+    text += '\n';
   }
 
-private:
   CSVFile(const CSVFile&) = delete;
   void operator=(const CSVFile&) = delete;
 };
@@ -672,18 +796,29 @@ void vtkCSVWriter::WriteData()
 
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
-  if (myRank > 0)
+  const std::string fname = filename.str();
+  vtkCSVWriter::CSVFile file(timeStep, time);
+  CSVFile::OpenMode openMode =
+    this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0
+    ? CSVFile::OpenMode::Append
+    : CSVFile::OpenMode::Write;
+  int error_code{ vtkErrorCode::NoError };
+  if (myRank == 0)
   {
-    int error_code{ vtkErrorCode::NoError };
-    controller->Broadcast(&error_code, 1, 0);
-    if (error_code != vtkErrorCode::NoError)
-    {
-      this->SetErrorCode(error_code);
-      return;
-    }
+    error_code = file.Open(fname.c_str(), openMode);
+  }
+  controller->Broadcast(&error_code, 1, 0);
+  if (error_code != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(error_code);
+    return;
+  }
 
-    vtkIdType row_count = table->GetNumberOfRows();
-    controller->Gather(&row_count, nullptr, 1, 0);
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, global_row_counts.data(), 1);
+  if (myRank > 0)
+  {
     if (row_count > 0)
     {
       vtkNew<vtkTable> clone;
@@ -696,36 +831,9 @@ void vtkCSVWriter::WriteData()
       // output file consistently.
       controller->Send(clone, 0, 88020);
     }
-
-    // BARRIER
-    controller->Barrier();
-
-    if (row_count > 0)
-    {
-      controller->Send(table, 0, 88021);
-    }
-    controller->Broadcast(&error_code, 1, 0);
-    this->SetErrorCode(error_code);
   }
   else
   {
-    vtkCSVWriter::CSVFile file(timeStep, time);
-    CSVFile::OpenMode openMode =
-      this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0
-      ? CSVFile::OpenMode::Append
-      : CSVFile::OpenMode::Write;
-    int error_code = file.Open(filename.str().c_str(), openMode);
-    controller->Broadcast(&error_code, 1, 0);
-    if (error_code != vtkErrorCode::NoError)
-    {
-      this->SetErrorCode(error_code);
-      return;
-    }
-
-    const vtkIdType row_count = table->GetNumberOfRows();
-    std::vector<vtkIdType> global_row_counts(numRanks, 0);
-    controller->Gather(&row_count, global_row_counts.data(), 1, 0);
-
     // build field list to determine which columns to write.
     vtkDataSetAttributes::FieldList columns;
     for (int rank = 0; rank < numRanks; ++rank)
@@ -745,36 +853,159 @@ void vtkCSVWriter::WriteData()
       }
     }
 
-    // BARRIER
-    controller->Barrier();
-
-    // now write the real data.
     vtkNew<vtkDataSetAttributes> tmp;
     tmp->CopyAllOn();
     columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
 
     // first write headers.
     file.WriteHeader(tmp, this, openMode);
+  }
+  file.BroadcastColumnInfo(controller);
 
-    for (int rank = 0; rank < numRanks; ++rank)
+  if (row_count > 0)
+  {
+    file.InitializeStreamWorkers(table->GetRowData(), this);
+  }
+
+  // Each rank writes its rows directly into the file when all ranks share a
+  // filesystem. To find out, the root writes a random token in a probe file
+  // next to the output, which every other rank must then read back.
+  const std::string probeName = fname + ".probe";
+  vtkIdType status[3] = { vtkErrorCode::NoError, 0, 0 };
+  if (myRank == 0)
+  {
+    status[0] = file.Close();
+    status[1] = static_cast<vtkIdType>(vtksys::SystemTools::FileLength(fname));
+    std::random_device device;
+    std::mt19937 generator(device());
+    status[2] = std::uniform_int_distribution<vtkIdType>(1, VTK_ID_MAX)(generator);
+    vtksys::ofstream probe(probeName.c_str());
+    probe << status[2];
+    probe.close();
+    if (probe.fail())
     {
-      if (global_row_counts[rank] > 0)
-      {
-        if (rank == 0)
+      status[2] = 0;
+    }
+  }
+  controller->Broadcast(status, 3, 0);
+  if (status[0] != vtkErrorCode::NoError)
+  {
+    if (myRank == 0)
+    {
+      vtksys::SystemTools::RemoveFile(probeName);
+    }
+    this->SetErrorCode(static_cast<unsigned long>(status[0]));
+    return;
+  }
+
+  int shared = status[2] != 0 ? 1 : 0;
+  if (shared && myRank > 0)
+  {
+    vtksys::ifstream probe(probeName.c_str());
+    vtkIdType token = 0;
+    shared = (probe >> token) && token == status[2] ? 1 : 0;
+  }
+  vtksys::ofstream slice;
+  if (shared && row_count > 0)
+  {
+    slice.open(fname.c_str(), ios::in | ios::out | ios::binary);
+    shared = slice.fail() ? 0 : 1;
+  }
+  int all_shared = 0;
+  controller->AllReduce(&shared, &all_shared, 1, vtkCommunicator::MIN_OP);
+  if (myRank == 0)
+  {
+    // every rank is done with the probe past the reduction.
+    vtksys::SystemTools::RemoveFile(probeName);
+  }
+
+  if (all_shared)
+  {
+    // the rows are formatted once to measure them: an exclusive prefix sum of
+    // the sizes gives each rank's offset past what the root has already
+    // written. They are formatted again to be written, one batch at a time.
+    vtkIdType text_size = 0;
+    if (row_count > 0)
+    {
+      file.FormatBatches(table->GetRowData(), this, [&](const std::vector<std::string>& blocks) {
+        for (const auto& block : blocks)
         {
-          file.WriteData(table, this);
+          text_size += static_cast<vtkIdType>(block.size());
         }
-        else
+      });
+    }
+    std::vector<vtkIdType> text_sizes(numRanks, 0);
+    controller->AllGather(&text_size, text_sizes.data(), 1);
+    vtkIdType offset = status[1];
+    for (int rank = 0; rank < myRank; ++rank)
+    {
+      offset += text_sizes[rank];
+    }
+
+    error_code = vtkErrorCode::NoError;
+    if (row_count > 0)
+    {
+      slice.seekp(offset);
+      file.FormatBatches(table->GetRowData(), this, [&](const std::vector<std::string>& blocks) {
+        for (const auto& block : blocks)
         {
-          vtkNew<vtkTable> remote_table;
-          controller->Receive(remote_table.Get(), rank, 88021);
-          assert(remote_table->GetNumberOfRows() > 0);
-          file.WriteData(remote_table, this);
+          slice.write(block.data(), block.size());
         }
+      });
+      slice.close();
+      if (slice.fail())
+      {
+        error_code = vtkErrorCode::OutOfDiskSpaceError;
+      }
+    }
+    int global_error_code{ vtkErrorCode::NoError };
+    controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+    this->SetErrorCode(global_error_code);
+  }
+  else
+  {
+    // fallback: the root appends the rows of every rank in order, as they are
+    // formatted and sent block by block, each block preceded by its size.
+    slice.close();
+    if (myRank > 0)
+    {
+      if (row_count > 0)
+      {
+        file.FormatBatches(table->GetRowData(), this, [&](const std::vector<std::string>& blocks) {
+          for (const auto& block : blocks)
+          {
+            const vtkIdType size = static_cast<vtkIdType>(block.size());
+            controller->Send(&size, 1, 0, 88021);
+            controller->Send(block.data(), size, 0, 88022);
+          }
+        });
+      }
+    }
+    else
+    {
+      error_code = file.Open(fname.c_str(), CSVFile::OpenMode::Append);
+      if (row_count > 0)
+      {
+        file.WriteData(table->GetRowData(), this);
+      }
+      std::string block;
+      for (int rank = 1; rank < numRanks; ++rank)
+      {
+        const vtkIdType numBlocks = (global_row_counts[rank] + ::RowsPerBlock - 1) / ::RowsPerBlock;
+        for (vtkIdType cc = 0; cc < numBlocks; ++cc)
+        {
+          vtkIdType size = 0;
+          controller->Receive(&size, 1, rank, 88021);
+          block.resize(size);
+          controller->Receive(&block[0], size, rank, 88022);
+          file.Write(block);
+        }
+      }
+      if (error_code == vtkErrorCode::NoError)
+      {
+        error_code = file.Close();
       }
     }
-
-    error_code = vtkErrorCode::NoError;
     controller->Broadcast(&error_code, 1, 0);
     this->SetErrorCode(error_code);
   }
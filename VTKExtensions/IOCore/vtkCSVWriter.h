@@ -4,6 +4,14 @@
  * @class   vtkCSVWriter
  * @brief   CSV writer for vtkTable/vtkDataSet/vtkCompositeDataSet
  * Writes a vtkTable/vtkDataSet/vtkCompositeDataSet as a delimited text file (such as CSV).
+ *
+ * Rows are formatted concurrently using vtkSMPTools. In parallel, the root rank
+ * picks the columns common to all ranks and writes the header, then each rank
+ * formats its own rows and writes them at its offset in the file. Whether the
+ * ranks share a filesystem is checked with a probe file holding a random token,
+ * written by the root next to the output and read back by the other ranks. If
+ * some rank cannot read it, the formatted rows are sent to the root which
+ * writes them instead.
  */
 
 #ifndef vtkCSVWriter_h
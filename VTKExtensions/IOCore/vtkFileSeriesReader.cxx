@@ -15,6 +15,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -26,10 +27,12 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <cctype> // for isprint().
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -360,6 +363,57 @@ private:
 };
 }
 
+//=============================================================================
+// Reads a file in a background thread, discarding its content, so that it is
+// in the operating system file cache when the reader opens it.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  ~vtkFileSeriesReaderPrefetcher() { this->Cancel(); }
+
+  // Index of the file last prefetched, -1 if none.
+  int GetIndex() const { return this->Index; }
+
+  void Start(const std::string& fname, int index, vtkTypeInt64 maxBytes)
+  {
+    this->Cancel();
+    this->Index = index;
+    this->Abort = false;
+    this->Worker = std::thread(
+      [this, fname, maxBytes]()
+      {
+        vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+        std::vector<char> buffer(1 << 20);
+        vtkTypeInt64 total = 0;
+        while (file && total < maxBytes && !this->Abort)
+        {
+          file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+          total += static_cast<vtkTypeInt64>(file.gcount());
+        }
+      });
+  }
+
+  void Cancel()
+  {
+    if (this->Worker.joinable())
+    {
+      this->Abort = true;
+      this->Worker.join();
+    }
+  }
+
+  void Reset()
+  {
+    this->Cancel();
+    this->Index = -1;
+  }
+
+private:
+  std::thread Worker;
+  std::atomic<bool> Abort{ false };
+  int Index = -1;
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -368,8 +422,20 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  vtkFileSeriesReaderPrefetcher Prefetcher;
+  int LastReadIndex = -1;
+  int Direction = 1;
+  vtkIdType PrefetchHits = 0;
+  vtkIdType PrefetchMisses = 0;
+
+  static bool GlobalPrefetch;
+  static int GlobalPrefetchSizeLimit;
 };
 
+bool vtkFileSeriesReaderInternals::GlobalPrefetch = false;
+int vtkFileSeriesReaderInternals::GlobalPrefetchSizeLimit = 256;
+
 //=============================================================================
 vtkFileSeriesReader::vtkFileSeriesReader()
 {
@@ -393,6 +459,42 @@ vtkFileSeriesReader::~vtkFileSeriesReader()
   delete this->Internal;
 }
 
+//----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetGlobalPrefetch(bool val)
+{
+  vtkFileSeriesReaderInternals::GlobalPrefetch = val;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFileSeriesReader::GetGlobalPrefetch()
+{
+  return vtkFileSeriesReaderInternals::GlobalPrefetch;
+}
+
+//----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetGlobalPrefetchSizeLimit(int val)
+{
+  vtkFileSeriesReaderInternals::GlobalPrefetchSizeLimit = std::max(val, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkFileSeriesReader::GetGlobalPrefetchSizeLimit()
+{
+  return vtkFileSeriesReaderInternals::GlobalPrefetchSizeLimit;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkFileSeriesReader::GetNumberOfPrefetchHits()
+{
+  return this->Internal->PrefetchHits;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkFileSeriesReader::GetNumberOfPrefetchMisses()
+{
+  return this->Internal->PrefetchMisses;
+}
+
 //----------------------------------------------------------------------------
 void vtkFileSeriesReader::AddFileName(const char* name)
 {
@@ -712,6 +814,31 @@ int vtkFileSeriesReader::RequestData(
   vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
+  const int index = static_cast<int>(this->_FileIndex);
+  // In parallel, ranks usually read a piece of each file only: having all of
+  // them read the whole next file would multiply the I/O instead of hiding it.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool prefetch = vtkFileSeriesReaderInternals::GlobalPrefetch &&
+    this->GetNumberOfFileNames() > 1 && (!controller || controller->GetNumberOfProcesses() == 1);
+  auto& internal = *this->Internal;
+  if (prefetch && index != internal.LastReadIndex)
+  {
+    if (internal.Prefetcher.GetIndex() == index)
+    {
+      ++internal.PrefetchHits;
+    }
+    else
+    {
+      // don't compete with the reader for the disk.
+      internal.Prefetcher.Cancel();
+      ++internal.PrefetchMisses;
+    }
+    vtkLogF(TRACE, "%s: prefetch %s for file %d (%lld hits, %lld misses)",
+      vtkLogIdentifier(this), internal.Prefetcher.GetIndex() == index ? "hit" : "miss", index,
+      static_cast<long long>(internal.PrefetchHits),
+      static_cast<long long>(internal.PrefetchMisses));
+  }
+
   int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
 
   if (this->GetNumberOfFileNames() > 0)
@@ -720,9 +847,53 @@ int vtkFileSeriesReader::RequestData(
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
   }
 
+  if (prefetch)
+  {
+    this->PrefetchNextFile(index);
+  }
+  else
+  {
+    internal.Prefetcher.Reset();
+  }
+  internal.LastReadIndex = index;
+
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchNextFile(int index)
+{
+  auto& internal = *this->Internal;
+  if (internal.LastReadIndex >= 0 && index != internal.LastReadIndex)
+  {
+    internal.Direction = index > internal.LastReadIndex ? 1 : -1;
+  }
+
+  const int next = index + internal.Direction;
+  if (next < 0 || next >= static_cast<int>(this->GetNumberOfFileNames()))
+  {
+    internal.Prefetcher.Reset();
+    return;
+  }
+  if (next == internal.Prefetcher.GetIndex())
+  {
+    // already prefetched or in progress.
+    return;
+  }
+
+  const std::string fname = this->GetFileName(static_cast<unsigned int>(next));
+  if (vtksys::SystemTools::FileIsDirectory(fname))
+  {
+    internal.Prefetcher.Reset();
+    return;
+  }
+
+  vtkLogF(TRACE, "%s: prefetch '%s'", vtkLogIdentifier(this), fname.c_str());
+  const vtkTypeInt64 maxBytes =
+    static_cast<vtkTypeInt64>(vtkFileSeriesReaderInternals::GlobalPrefetchSizeLimit) << 20;
+  internal.Prefetcher.Start(fname, next, maxBytes);
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestInformationForInput(
   int index, vtkInformation* request, vtkInformationVector* outputVector)
@@ -975,6 +1146,8 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "NumberOfPrefetchHits: " << this->Internal->PrefetchHits << endl;
+  os << indent << "NumberOfPrefetchMisses: " << this->Internal->PrefetchMisses << endl;
 }
 
 //-----------------------------------------------------------------------------
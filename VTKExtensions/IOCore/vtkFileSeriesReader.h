@@ -55,6 +55,14 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When prefetching is enabled (see SetGlobalPrefetch()), after the file for a
+ * timestep has been read, the file the next timestep is expected to need is
+ * read in a background thread so that it is in the operating system file cache
+ * when requested. The next file is the one following the current file in the
+ * direction of the last change of file, i.e. backward when playing an
+ * animation in reverse. Prefetching is disabled when running with more than
+ * one process, since each process usually reads only part of each file.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -133,6 +141,33 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * Turn prefetching of the next file on/off for all file series readers. Off
+   * by default, and ignored when the global controller has more than one
+   * process. Only the first `PrefetchSizeLimit` mebibytes of each file are
+   * prefetched, which bounds the memory the operating system may have to
+   * devote to the file cache for each reader (256 MiB by default).
+   * Typically, one uses vtkPVGeneralSettings to change these rather than using
+   * this API directly.
+   */
+  static void SetGlobalPrefetch(bool);
+  static bool GetGlobalPrefetch();
+  static void SetGlobalPrefetchSizeLimit(int);
+  static int GetGlobalPrefetchSizeLimit();
+  ///@}
+
+  ///@{
+  /**
+   * Number of times a file was requested while it had been prefetched (hits)
+   * or not (misses), since this reader was created. Only changes of file are
+   * counted and only while prefetching is on. Each hit or miss is also logged
+   * at the TRACE verbosity.
+   */
+  vtkIdType GetNumberOfPrefetchHits();
+  vtkIdType GetNumberOfPrefetchMisses();
+  ///@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -215,6 +250,12 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Start prefetching the file expected to be requested after the file with
+   * the given index. Called in RequestData() once that file has been read.
+   */
+  void PrefetchNextFile(int index);
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
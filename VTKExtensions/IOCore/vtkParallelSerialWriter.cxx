@@ -5,6 +5,7 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
@@ -21,10 +22,16 @@
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include "vtk_jsoncpp.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+#include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
 // clang-format off
@@ -56,6 +63,8 @@ vtkCxxSetObjectMacro(vtkParallelSerialWriter, Controller, vtkMultiProcessControl
 vtkParallelSerialWriter::vtkParallelSerialWriter()
   : NumberOfIORanks(1)
   , RankAssignmentMode(vtkParallelSerialWriter::ASSIGNMENT_MODE_CONTIGUOUS)
+  , TargetDataSizePerIORank(0)
+  , WritePartitionIndexFile(false)
   , Controller(nullptr)
   , SubController(nullptr)
 {
@@ -187,9 +196,11 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     this->CurrentTimeIndex = 0;
   }
 
+  auto inputDO = vtkDataObject::GetData(inputVector[0], 0);
+  const vtkIdType localSize = inputDO ? static_cast<vtkIdType>(inputDO->GetActualMemorySize()) : 0;
+
   const int num_ranks = this->Controller->GetNumberOfProcesses();
-  int num_io_ranks = std::min(this->NumberOfIORanks, num_ranks);
-  num_io_ranks = num_io_ranks <= 0 ? num_ranks : num_io_ranks;
+  const int num_io_ranks = this->ComputeNumberOfIORanks(localSize);
   if (num_io_ranks == 1)
   {
     this->SubController = nullptr;
@@ -221,7 +232,7 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
       this->Controller->PartitionController(this->SubControllerColor, myid));
   }
 
-  auto inputDO = vtkDataObject::GetData(inputVector[0], 0);
+  const bool write_index = this->SubController != nullptr && this->WritePartitionIndexFile;
 
   // PartitionedDataSet (PD)/PartitionedDataSetCollection (PDC) make it much easier
   // to deal with blocks and partitions esp. in distributed environments.
@@ -245,7 +256,12 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     {
       // Create filename for the block.
       auto fname = fmt::format("{0}/{1}{2:{3}}{4}", path, fnameNoExt, cc, precision, ext);
-      this->WriteATimestep(fname, pdc->GetPartitionedDataSet(cc));
+      const bool written = this->WriteATimestep(fname, pdc->GetPartitionedDataSet(cc));
+      if (write_index)
+      {
+        this->WriteIndexFile(fname, written,
+          static_cast<vtkIdType>(pdc->GetPartitionedDataSet(cc)->GetActualMemorySize()));
+      }
     }
   }
   else
@@ -255,7 +271,11 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     converter->Update();
     auto pdc = converter->GetOutput();
     assert(pdc->GetNumberOfPartitionedDataSets() == 1);
-    this->WriteATimestep(this->FileName, pdc->GetPartitionedDataSet(0));
+    const bool written = this->WriteATimestep(this->FileName, pdc->GetPartitionedDataSet(0));
+    if (write_index)
+    {
+      this->WriteIndexFile(this->FileName, written, localSize);
+    }
   }
 
   if (write_all)
@@ -278,7 +298,7 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
 }
 
 //----------------------------------------------------------------------------
-void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input)
+bool vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input)
 {
   assert(input != nullptr);
 
@@ -299,7 +319,7 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
   if (controller->GetLocalProcessId() != 0)
   {
     // done.
-    return;
+    return false;
   }
   assert(!gatheredDataSets.empty());
 
@@ -318,7 +338,7 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
     allDataSets.end());
   if (allDataSets.empty())
   {
-    return;
+    return false;
   }
 
   if (this->PostGatherHelper)
@@ -345,34 +365,100 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
   // release memory.
   allDataSets.clear();
   this->WriteAFile(fname, inputDO);
+  return true;
 }
 
 //----------------------------------------------------------------------------
 void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDataObject* input)
 {
-  std::string filename = this->GetPartitionFileName(filename_arg);
-  if (this->WriteAllTimeSteps)
+  const std::string filename =
+    this->GetTimeStepFileName(this->GetPartitionFileName(filename_arg, this->SubControllerColor));
+  this->Writer->SetInputDataObject(input);
+  this->SetWriterFileName(filename.c_str());
+  this->WriteInternal();
+  this->Writer->RemoveAllInputConnections(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteIndexFile(
+  const std::string& fname, bool written, vtkIdType localSize)
+{
+  // Gather the group of each rank, whether it wrote a file and the size of
+  // the data it contributed, in KiB.
+  const int num_ranks = this->Controller->GetNumberOfProcesses();
+  const vtkIdType local[3] = { this->SubControllerColor, written ? 1 : 0, localSize };
+  std::vector<vtkIdType> all(3 * num_ranks);
+  this->Controller->Gather(local, all.data(), 3, 0);
+  if (this->Controller->GetLocalProcessId() != 0)
   {
-    std::string path = vtksys::SystemTools::GetFilenamePath(filename);
-    std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
-    std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
-    if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
-    {
-      // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
-      char suffix[100];
-      snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
-      filename = fmt::format("{0}/{1}{2}{3}", path, fnamenoext, suffix, ext);
-    }
-    else
+    return;
+  }
+
+  struct Partition
+  {
+    Json::Value Ranks{ Json::arrayValue };
+    vtkIdType Size = 0;
+    bool Written = false;
+  };
+  std::map<int, Partition> partitions;
+  for (int rank = 0; rank < num_ranks; ++rank)
+  {
+    auto& partition = partitions[static_cast<int>(all[3 * rank])];
+    partition.Ranks.append(rank);
+    partition.Written |= all[3 * rank + 1] != 0;
+    partition.Size += all[3 * rank + 2];
+  }
+
+  Json::Value files(Json::arrayValue);
+  for (const auto& item : partitions)
+  {
+    if (!item.second.Written)
     {
-      filename = fmt::format("{0}/{1}.{2}{3}", path, fnamenoext, this->CurrentTimeIndex, ext);
+      // all ranks of this group had empty data.
+      continue;
     }
+    const std::string partitionName =
+      this->GetTimeStepFileName(this->GetPartitionFileName(fname, item.first));
+    Json::Value file;
+    file["name"] = vtksys::SystemTools::GetFilenameName(partitionName);
+    file["ranks"] = item.second.Ranks;
+    file["data-size"] = static_cast<Json::Int64>(item.second.Size) * 1024;
+    files.append(file);
   }
 
-  this->Writer->SetInputDataObject(input);
-  this->SetWriterFileName(filename.c_str());
-  this->WriteInternal();
-  this->Writer->RemoveAllInputConnections(0);
+  Json::Value root;
+  root["file-partitions-version"] = "1.0";
+  root["partitions"] = files;
+
+  const std::string indexFilename = this->GetTimeStepFileName(fname) + ".partitions";
+  vtksys::ofstream indexFile(indexFilename.c_str(), ios::out);
+  if (!indexFile)
+  {
+    vtkErrorMacro("Failed to open partition index file '" << indexFilename << "'.");
+    return;
+  }
+  Json::StreamWriterBuilder builder;
+  builder["commentStyle"] = "None";
+  builder["indentation"] = "   ";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(root, &indexFile);
+}
+
+//----------------------------------------------------------------------------
+int vtkParallelSerialWriter::ComputeNumberOfIORanks(vtkIdType localSize)
+{
+  const int num_ranks = this->Controller->GetNumberOfProcesses();
+  if (this->TargetDataSizePerIORank > 0)
+  {
+    // sizes are in KiB, as returned by vtkDataObject::GetActualMemorySize.
+    vtkIdType totalSize = 0;
+    this->Controller->AllReduce(&localSize, &totalSize, 1, vtkCommunicator::SUM_OP);
+    const vtkIdType target = static_cast<vtkIdType>(this->TargetDataSizePerIORank) * 1024;
+    const vtkIdType count = (totalSize + target - 1) / target;
+    return static_cast<int>(std::max<vtkIdType>(1, std::min<vtkIdType>(count, num_ranks)));
+  }
+  const int num_io_ranks = std::min(this->NumberOfIORanks, num_ranks);
+  return num_io_ranks <= 0 ? num_ranks : num_io_ranks;
 }
 
 //----------------------------------------------------------------------------
@@ -406,18 +492,38 @@ void vtkParallelSerialWriter::WriteInternal()
 }
 
 //-----------------------------------------------------------------------------
-std::string vtkParallelSerialWriter::GetPartitionFileName(const std::string& fname)
+std::string vtkParallelSerialWriter::GetPartitionFileName(const std::string& fname, int color)
 {
-  if (this->SubController != nullptr && this->SubControllerColor >= 0)
+  if (this->SubController != nullptr && color >= 0)
   {
     std::string path = vtksys::SystemTools::GetFilenamePath(fname);
     std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
     std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fname);
-    return path + "/" + fnamenoext + "-" + std::to_string(this->SubControllerColor) + ext;
+    return path + "/" + fnamenoext + "-" + std::to_string(color) + ext;
   }
   return fname;
 }
 
+//-----------------------------------------------------------------------------
+std::string vtkParallelSerialWriter::GetTimeStepFileName(const std::string& fname)
+{
+  if (!this->WriteAllTimeSteps)
+  {
+    return fname;
+  }
+  std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fname);
+  if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
+  {
+    // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
+    char suffix[100];
+    snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
+    return fmt::format("{0}/{1}{2}{3}", path, fnamenoext, suffix, ext);
+  }
+  return fmt::format("{0}/{1}.{2}{3}", path, fnamenoext, this->CurrentTimeIndex, ext);
+}
+
 //-----------------------------------------------------------------------------
 void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 {
@@ -435,4 +541,8 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfIORanks: " << this->NumberOfIORanks << endl;
+  os << indent << "RankAssignmentMode: " << this->RankAssignmentMode << endl;
+  os << indent << "TargetDataSizePerIORank: " << this->TargetDataSizePerIORank << endl;
+  os << indent << "WritePartitionIndexFile: " << this->WritePartitionIndexFile << endl;
 }
@@ -9,7 +9,9 @@
  * and invokes the internal writer. The reduction is controlled by the
  * PreGatherHelper and PostGatherHelper. Instead of collecting all the data to
  * the root node the filter supports reducing down to a target number of ranks
- * which ranks chosen in either round-robin or contiguous fashion.
+ * which ranks chosen in either round-robin or contiguous fashion. The number of
+ * these IO ranks can also be derived from the size of the data, and each of them
+ * writes a partition file that is listed in a JSON index file.
  *
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
@@ -153,6 +155,29 @@ public:
   vtkGetMacro(NumberOfIORanks, int);
   ///@}
 
+  ///@{
+  /**
+   * When greater than 0, the number of IO ranks is chosen so that each of them
+   * writes about this amount of data, in MiB, instead of using
+   * `NumberOfIORanks`. The data size is measured on every write, so the number
+   * of partition files can change between timesteps. Default is 0.
+   */
+  vtkSetClampMacro(TargetDataSizePerIORank, int, 0, VTK_INT_MAX);
+  vtkGetMacro(TargetDataSizePerIORank, int);
+  ///@}
+
+  ///@{
+  /**
+   * When data is written by more than one IO rank, write an index next to the
+   * partition files, named after the output file with a `.partitions`
+   * extension. It is a JSON file that lists the partition files along with the
+   * ranks whose data each contains. Default is false.
+   */
+  vtkGetMacro(WritePartitionIndexFile, bool);
+  vtkSetMacro(WritePartitionIndexFile, bool);
+  vtkBooleanMacro(WritePartitionIndexFile, bool);
+  ///@}
+
   enum
   {
     ASSIGNMENT_MODE_CONTIGUOUS,
@@ -200,17 +225,26 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Returns the number of ranks that write to disk, given the size of the
+   * local data in KiB. This is a collective operation when
+   * `TargetDataSizePerIORank` is set.
+   */
+  int ComputeNumberOfIORanks(vtkIdType localSize);
+
 private:
   vtkParallelSerialWriter(const vtkParallelSerialWriter&) = delete;
   void operator=(const vtkParallelSerialWriter&) = delete;
 
-  void WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input);
+  bool WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input);
   void WriteAFile(const std::string& fname, vtkDataObject* input);
+  void WriteIndexFile(const std::string& fname, bool written, vtkIdType localSize);
 
   void SetWriterFileName(const char* fname);
   void WriteInternal();
 
-  std::string GetPartitionFileName(const std::string& fname);
+  std::string GetPartitionFileName(const std::string& fname, int color);
+  std::string GetTimeStepFileName(const std::string& fname);
 
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
@@ -233,6 +267,8 @@ private:
 
   int NumberOfIORanks;
   int RankAssignmentMode;
+  int TargetDataSizePerIORank;
+  bool WritePartitionIndexFile;
 
   vtkMultiProcessController* Controller;
   vtkSmartPointer<vtkMultiProcessController> SubController;
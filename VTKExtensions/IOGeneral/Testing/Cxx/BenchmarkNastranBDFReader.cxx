@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Micro-benchmark of vtkNastranBDFReader on generated bulk data decks of
+// increasing size. The mean time of a read is reported as a CTest measurement,
+// so that it is tracked on CDash. `--benchmark_min_time=<seconds>` sets how
+// long each read is repeated (0.1s by default).
+
+#include "vtkLogger.h"
+#include "vtkNastranBDFReader.h"
+#include "vtkNew.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Writes a deck of `resolution`^2 points, triangulated, with a pressure value
+// per triangle.
+bool WriteNastranDeck(const std::string& fileName, int resolution)
+{
+  vtksys::ofstream file(fileName.c_str());
+  file << "TITLE=BenchmarkNastranBDFReader\nBEGIN BULK\n";
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      file << "GRID," << j * resolution + i + 1 << ",," << 0.01 * i << "," << 0.01 * j << ",0.\n";
+    }
+  }
+  int element = 0;
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      const int pt = j * resolution + i + 1;
+      file << "CTRIA3," << ++element << ",1," << pt << "," << pt + 1 << "," << pt + resolution
+           << "\n";
+      file << "CTRIA3," << ++element << ",1," << pt + 1 << "," << pt + resolution + 1 << ","
+           << pt + resolution << "\n";
+    }
+  }
+  for (int cc = 1; cc <= element; ++cc)
+  {
+    file << "PLOAD2,1," << 0.5 * cc << "," << cc << "\n";
+  }
+  file << "ENDDATA\n";
+  return static_cast<bool>(file);
+}
+}
+
+//----------------------------------------------------------------------------
+int BenchmarkNastranBDFReader(int argc, char* argv[])
+{
+  double minTime = 0.1;
+  for (int cc = 1; cc < argc; ++cc)
+  {
+    const std::string arg = argv[cc];
+    if (arg.compare(0, 21, "--benchmark_min_time=") == 0)
+    {
+      minTime = std::atof(arg.substr(21).c_str());
+    }
+  }
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  vtksys::SystemTools::MakeDirectory(tempDir);
+  const std::string fileName = std::string(tempDir) + "/BenchmarkNastranBDFReader.bdf";
+  delete[] tempDir;
+
+  for (const int resolution : { 128, 512 })
+  {
+    if (!WriteNastranDeck(fileName, resolution))
+    {
+      vtkLogF(ERROR, "Failed to write '%s'.", fileName.c_str());
+      return EXIT_FAILURE;
+    }
+    const double bytes = static_cast<double>(vtksys::SystemTools::FileLength(fileName));
+
+    vtkNew<vtkNastranBDFReader> reader;
+    reader->SetFileName(fileName);
+    reader->Update(); // warm-up
+    if (reader->GetOutput()->GetNumberOfPoints() != resolution * resolution)
+    {
+      vtkLogF(ERROR, "Unexpected number of points.");
+      return EXIT_FAILURE;
+    }
+
+    using clock = std::chrono::steady_clock;
+    long iterations = 0;
+    const auto start = clock::now();
+    double elapsed = 0.0;
+    do
+    {
+      reader->Modified();
+      reader->Update();
+      ++iterations;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < minTime);
+
+    const double seconds = elapsed / iterations;
+    const std::string name = "NastranBDFReader/Read/" + std::to_string(resolution) + "^2";
+    cout << name << ": " << seconds * 1e3 << " ms (" << bytes / seconds / (1 << 20)
+         << " MiB/s, " << iterations << " iterations)" << endl;
+    cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">" << seconds * 1e3
+         << "</DartMeasurement>" << endl;
+  }
+  vtksys::SystemTools::RemoveFile(fileName);
+
+  return EXIT_SUCCESS;
+}
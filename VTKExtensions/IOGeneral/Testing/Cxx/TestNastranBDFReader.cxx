@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkExecutive.h"
+#include "vtkLogger.h"
+#include "vtkNastranBDFReader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <string>
+
+namespace
+{
+bool WriteFile(const std::string& fileName, const char* content)
+{
+  vtksys::ofstream file(fileName.c_str());
+  file << content;
+  return static_cast<bool>(file);
+}
+}
+
+// Checks the parsing of small Nastran bulk data decks: comments, cells
+// referring to points defined later in the file, and PLOAD2 entries referring
+// to an unknown element.
+int TestNastranBDFReader(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestNastranBDFReader.bdf";
+  delete[] tempDir;
+
+  // The triangles are defined before their points, and `$` starts a comment,
+  // either on its own line or at the end of an entry.
+  if (!WriteFile(fileName,
+        "$ Generated by TestNastranBDFReader\n"
+        "BEGIN BULK\n"
+        "CTRIA3,10,1,3,1,2 $ first triangle\n"
+        "CTRIA3,20,1,2,4,3$second triangle\n"
+        "PLOAD2,1,2.5,20\n"
+        "$GRID,5,,9.,9.,9.\n"
+        "GRID,1,,0.,0.,0.\n"
+        "GRID,2,,1.,0.,0. $ comment\n"
+        "GRID,3,,0.,1.,0.\n"
+        "GRID,4,,1.,1.,0.$\n"
+        "ENDDATA\n"))
+  {
+    vtkLogF(ERROR, "Failed to write '%s'.", fileName.c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkNastranBDFReader> reader;
+  reader->SetFileName(fileName);
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != 4 || output->GetNumberOfCells() != 2)
+  {
+    vtkLogF(ERROR, "Expected 4 points and 2 cells, got %lld and %lld.",
+      static_cast<long long>(output->GetNumberOfPoints()),
+      static_cast<long long>(output->GetNumberOfCells()));
+    return EXIT_FAILURE;
+  }
+
+  // The first point of the second triangle is GRID 2, i.e. (1, 0, 0).
+  double point[3];
+  output->GetPoint(output->GetCell(1)->GetPointId(0), point);
+  if (point[0] != 1. || point[1] != 0. || point[2] != 0.)
+  {
+    vtkLogF(ERROR, "Unexpected point (%g, %g, %g).", point[0], point[1], point[2]);
+    return EXIT_FAILURE;
+  }
+
+  vtkDataArray* pload2 = output->GetCellData()->GetArray("PLOAD2");
+  if (!pload2 || pload2->GetTuple1(0) != 0. || pload2->GetTuple1(1) != 2.5)
+  {
+    vtkLogF(ERROR, "Unexpected PLOAD2 values.");
+    return EXIT_FAILURE;
+  }
+
+  // A PLOAD2 on an unknown element is an error.
+  if (!WriteFile(fileName,
+        "BEGIN BULK\n"
+        "GRID,1,,0.,0.,0.\n"
+        "GRID,2,,1.,0.,0.\n"
+        "GRID,3,,0.,1.,0.\n"
+        "CTRIA3,10,1,1,2,3\n"
+        "PLOAD2,1,2.5,11\n"
+        "ENDDATA\n"))
+  {
+    vtkLogF(ERROR, "Failed to write '%s'.", fileName.c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  reader->AddObserver(vtkCommand::ErrorEvent, observer);
+  reader->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, observer);
+  reader->Modified();
+  reader->Update();
+  if (!observer->GetError() ||
+    observer->GetErrorMessage().find("Undefined element in PLOAD2 (11)") == std::string::npos)
+  {
+    vtkLogF(ERROR, "Expected an error for the PLOAD2 on an unknown element.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPhastaReader.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Writes binary PHASTA files, optionally in the opposite byte order.
+class vtkPhastaFileWriter
+{
+public:
+  vtkPhastaFileWriter(const std::string& fname, bool swap)
+    : File(fname.c_str(), std::ios::out | std::ios::binary)
+    , Swap(swap)
+  {
+    this->File << "# PHASTA Input File Version 2.0\n";
+    this->File << "# written by TestPhastaReader\n";
+    this->File << "byteorder magic number : < 5 > 1\n";
+    this->WriteValues(std::vector<int>{ 362436 });
+    this->File << "\n";
+  }
+
+  void WriteHeader(const std::string& key, const std::vector<int>& params)
+  {
+    this->WriteBlockHeader(key, 0, params);
+  }
+
+  template <typename T>
+  void WriteBlock(
+    const std::string& key, const std::vector<int>& params, const std::vector<T>& data)
+  {
+    this->WriteBlockHeader(key, data.size() * sizeof(T) + 1, params);
+    this->WriteValues(data);
+    this->File << "\n";
+  }
+
+private:
+  void WriteBlockHeader(const std::string& key, std::size_t size, const std::vector<int>& params)
+  {
+    this->File << key << " : < " << size << " >";
+    for (const int param : params)
+    {
+      this->File << " " << param;
+    }
+    this->File << "\n";
+  }
+
+  template <typename T>
+  void WriteValues(const std::vector<T>& values)
+  {
+    for (const T& value : values)
+    {
+      char bytes[sizeof(T)];
+      std::memcpy(bytes, &value, sizeof(T));
+      if (this->Swap)
+      {
+        std::reverse(bytes, bytes + sizeof(T));
+      }
+      this->File.write(bytes, sizeof(T));
+    }
+  }
+
+  std::ofstream File;
+  bool Swap;
+};
+
+// A single hexahedron.
+void WriteGeometry(const std::string& fname, bool swap)
+{
+  vtkPhastaFileWriter writer(fname, swap);
+  writer.WriteHeader("number of nodes", { 8 });
+  writer.WriteHeader("number of interior elements", { 1 });
+  writer.WriteHeader("number of interior tpblocks", { 1 });
+  // coordinates are stored one component after the other.
+  const std::vector<double> coordinates = { 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+    0, 0, 1, 1, 1, 1 };
+  writer.WriteBlock("co-ordinates", { 8, 3 }, coordinates);
+  const std::vector<int> connectivity = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  writer.WriteBlock(
+    "connectivity interior linear hexahedron", { 1, 8, 1, 8, 1, 1, 1 }, connectivity);
+}
+
+// Restart file where variable v of node n is `offset + 10 * v + n`, preceded by
+// unrelated blocks that must be skipped.
+void WriteRestart(const std::string& fname, bool swap, double offset, int numberOfExtraBlocks)
+{
+  vtkPhastaFileWriter writer(fname, swap);
+  for (int cc = 0; cc < numberOfExtraBlocks; ++cc)
+  {
+    writer.WriteBlock("time derivative of solution", { 8, 5, 1 }, std::vector<double>(40, -1.0));
+  }
+  std::vector<double> solution(40);
+  for (int v = 0; v < 5; ++v)
+  {
+    for (int n = 0; n < 8; ++n)
+    {
+      solution[v * 8 + n] = offset + 10 * v + n;
+    }
+  }
+  writer.WriteBlock("solution", { 8, 5, 1 }, solution);
+}
+
+bool CheckArray(vtkUnstructuredGrid* grid, const char* name, int variable, double offset)
+{
+  vtkDataArray* array = grid->GetPointData()->GetArray(name);
+  if (!array || array->GetNumberOfTuples() != 8)
+  {
+    vtkLogF(ERROR, "Missing or wrong size array '%s'.", name);
+    return false;
+  }
+  for (int n = 0; n < 8; ++n)
+  {
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+    {
+      const double expected = offset + 10 * (variable + c) + n;
+      if (array->GetComponent(n, c) != expected)
+      {
+        vtkLogF(ERROR, "'%s'[%d][%d] is %g instead of %g.", name, n, c, array->GetComponent(n, c),
+          expected);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckOutput(vtkPhastaReader* reader, double offset, const char* label)
+{
+  reader->Modified();
+  reader->Update();
+  vtkUnstructuredGrid* grid = reader->GetOutput();
+  if (grid->GetNumberOfPoints() != 8 || grid->GetNumberOfCells() != 1 ||
+    grid->GetCellType(0) != VTK_HEXAHEDRON)
+  {
+    vtkLogF(ERROR, "%s: unexpected geometry.", label);
+    return false;
+  }
+  double point[3];
+  grid->GetPoint(6, point);
+  if (point[0] != 1 || point[1] != 1 || point[2] != 1)
+  {
+    vtkLogF(ERROR, "%s: unexpected point (%g, %g, %g).", label, point[0], point[1], point[2]);
+    return false;
+  }
+  // The 3 fields come from the same block, read once.
+  if (!CheckArray(grid, "pressure", 0, offset) || !CheckArray(grid, "velocity", 1, offset) ||
+    !CheckArray(grid, "temperature", 4, offset))
+  {
+    vtkLogF(ERROR, "%s: unexpected fields.", label);
+    return false;
+  }
+  return true;
+}
+}
+
+// Reads small PHASTA files in both byte orders, through the header index and
+// the shared field blocks, and checks that rewriting a file invalidates its
+// cached header index.
+int TestPhastaReader(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestPhastaReader";
+  delete[] tempDir;
+
+  for (const bool swap : { false, true })
+  {
+    const std::string geometry = prefix + (swap ? "_swapped" : "") + "_geom.dat";
+    const std::string restart = prefix + (swap ? "_swapped" : "") + "_restart.dat";
+    WriteGeometry(geometry, swap);
+    WriteRestart(restart, swap, 0.5, 2);
+
+    vtkNew<vtkPhastaReader> reader;
+    reader->SetGeometryFileName(geometry.c_str());
+    reader->SetFieldFileName(restart.c_str());
+    reader->SetFieldInfo("pressure", "solution", 0, 1, 0, "double");
+    reader->SetFieldInfo("velocity", "solution", 1, 3, 0, "double");
+    reader->SetFieldInfo("temperature", "solution", 4, 1, 0, "double");
+
+    const char* label = swap ? "swapped" : "native";
+    if (!CheckOutput(reader, 0.5, label) || !CheckOutput(reader, 0.5, label))
+    {
+      return EXIT_FAILURE;
+    }
+
+    // A file with a different layout is indexed again.
+    WriteRestart(restart, swap, 100.0, 1);
+    if (!CheckOutput(reader, 100.0, label))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,321 +3,681 @@
 #include "vtkNastranBDFReader.h"
 
 #include "vtksys/FStream.hxx"
-#include "vtksys/SystemTools.hxx"
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
-#include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 vtkStandardNewMacro(vtkNastranBDFReader);
 
-static const std::string COMMENT_KEY = "$";
-static const std::vector<std::string> IGNORED_KEYS = { COMMENT_KEY, "BEGIN BULK", "ENDDATA",
-  "PSHELL", "MAT1" };
+namespace
+{
+const char* const IGNORED_KEYS[] = { "$", "BEGIN BULK", "ENDDATA", "PSHELL", "MAT1" };
 
-static const std::string CTRIA3_KEY = "CTRIA3";
-static const std::string GRID_KEY = "GRID";
-static const std::string PLOAD2_KEY = "PLOAD2";
-static const std::string TIME_KEY = "TIME";
-static const std::string TITLE_KEY = "TITLE";
+const char* const CTRIA3_KEY = "CTRIA3";
+const char* const GRID_KEY = "GRID";
+const char* const PLOAD2_KEY = "PLOAD2";
+const char* const TIME_KEY = "TIME";
+const char* const TITLE_KEY = "TITLE";
 
-namespace utils
-{
-// Returns if `line` starts with the string `keyword`
-bool StartsWith(const std::string& line, const std::string& keyword)
-{
-  return line.rfind(keyword, 0) == 0;
-}
+// Files smaller than this are parsed as a single chunk.
+constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
 
-// Returns if `line` matches a keyword that should be silently ignored
-bool IsIgnored(const std::string& line)
+// Longest field that can be converted to a number.
+constexpr size_t MAX_NUMBER_LENGTH = 64;
+
+//------------------------------------------------------------------------------
+// Read only view of the file content. The file is memory mapped when possible,
+// and read in a single call otherwise.
+class vtkBDFFileBuffer
 {
-  for (const auto& ignoring : IGNORED_KEYS)
+public:
+  vtkBDFFileBuffer() = default;
+  ~vtkBDFFileBuffer()
   {
-    if (StartsWith(line, ignoring))
+#if !defined(_WIN32)
+    if (this->Mapped)
     {
-      return true;
+      ::munmap(this->Mapped, this->Size);
     }
+#endif
   }
-  return false;
-}
 
-// In-place removal of trailing comment
-void TrimTrailingComment(std::string& line)
-{
-  if (auto pos = line.find(COMMENT_KEY) != std::string::npos)
+  bool Open(const std::string& fileName)
   {
-    line.erase(pos);
+#if !defined(_WIN32)
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void* mapped =
+        ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED)
+      {
+        ::posix_madvise(mapped, static_cast<size_t>(st.st_size), POSIX_MADV_WILLNEED);
+        this->Mapped = mapped;
+        this->Data = static_cast<const char*>(mapped);
+        this->Size = static_cast<size_t>(st.st_size);
+        ::close(fd);
+        return true;
+      }
+    }
+    ::close(fd);
+#endif
+    // fallback: read the whole file at once.
+    vtksys::ifstream file(fileName.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+      return false;
+    }
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size < 0)
+    {
+      return false;
+    }
+    this->Buffer.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(this->Buffer.data(), size))
+    {
+      return false;
+    }
+    this->Data = this->Buffer.data();
+    this->Size = this->Buffer.size();
+    return true;
   }
-}
 
-// Parses a whole `line`, depending on its starting `keyword`.
-// Returns a vector of values as string.
-// Typically, it splits the line around each delimiter `,`.
-std::vector<std::string> ParseArgs(const std::string& line, const std::string& keyword)
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  vtkBDFFileBuffer(const vtkBDFFileBuffer&) = delete;
+  void operator=(const vtkBDFFileBuffer&) = delete;
+
+#if !defined(_WIN32)
+  void* Mapped = nullptr;
+#endif
+  std::vector<char> Buffer;
+  const char* Data = nullptr;
+  size_t Size = 0;
+};
+
+//------------------------------------------------------------------------------
+// Non owning range of characters, used to tokenize lines without allocation.
+struct vtkBDFToken
 {
-  std::vector<std::string> arguments;
-  if (keyword == TITLE_KEY)
+  vtkBDFToken() = default;
+  vtkBDFToken(const char* begin, const char* end)
+    : Begin(begin)
+    , End(end)
   {
-    // remove `TITLE` keyword and the `=` char
-    arguments.push_back(line.substr(line.find(keyword) + keyword.size() + 1));
   }
-  else if (keyword == TIME_KEY)
+
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+
+  size_t Size() const { return static_cast<size_t>(this->End - this->Begin); }
+  bool Empty() const { return this->Begin == this->End; }
+  std::string ToString() const { return std::string(this->Begin, this->End); }
+
+  // Returns if the token starts with the string `keyword`
+  bool StartsWith(const char* keyword) const
   {
-    arguments.push_back(line.substr(line.find(keyword) + keyword.size()));
+    const size_t length = std::strlen(keyword);
+    return this->Size() >= length && std::strncmp(this->Begin, keyword, length) == 0;
   }
-  else
+
+  // Returns the position of `c`, or End.
+  const char* Find(char c) const
   {
-    std::stringstream linestream(line);
-    std::string arg;
-    // first element is the keyword, do not store it as arg.
-    std::getline(linestream, arg, ',');
-    while (std::getline(linestream, arg, ','))
-    {
-      arguments.push_back(arg);
-    }
+    const void* found = std::memchr(this->Begin, c, this->Size());
+    return found ? static_cast<const char*>(found) : this->End;
   }
-
-  return arguments;
-}
 };
 
 //------------------------------------------------------------------------------
-vtkNastranBDFReader::vtkNastranBDFReader()
+// Returns if `line` matches a keyword that should be silently ignored
+bool IsIgnored(const vtkBDFToken& line)
 {
-  this->SetNumberOfInputPorts(0);
-  this->OriginalPointIds->SetName("Ids");
+  for (const char* ignoring : IGNORED_KEYS)
+  {
+    if (line.StartsWith(ignoring))
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 //------------------------------------------------------------------------------
-vtkIdType vtkNastranBDFReader::GetVTKPointId(const std::string& arg)
+// Splits `line` around each delimiter `,`. The first field is the keyword and
+// is not stored. Only the first `maxArgs` arguments are stored in `args`,
+// the returned value is the total number of arguments.
+int ParseArgs(const vtkBDFToken& line, vtkBDFToken* args, int maxArgs)
 {
-  vtkIdType elt = std::stol(arg);
-  return this->PointsIds.find(elt) != this->PointsIds.end() ? this->PointsIds.find(elt)->second
-                                                            : -1;
+  const char* cursor = line.Find(',');
+  int count = 0;
+  while (cursor != line.End)
+  {
+    vtkBDFToken arg;
+    arg.Begin = cursor + 1;
+    arg.End = vtkBDFToken{ arg.Begin, line.End }.Find(',');
+    cursor = arg.End;
+    // a trailing delimiter does not introduce an empty argument
+    if (arg.Empty() && arg.End == line.End)
+    {
+      break;
+    }
+    if (count < maxArgs)
+    {
+      args[count] = arg;
+    }
+    ++count;
+  }
+  return count;
 }
 
 //------------------------------------------------------------------------------
-bool vtkNastranBDFReader::AddTitle(const std::vector<std::string>& args)
+// Numbers are parsed with the same rules as std::stod and std::stol: leading
+// white spaces are skipped and trailing characters are ignored.
+bool ParseNumber(const vtkBDFToken& token, double& value, std::string& error)
 {
-  vtkNew<vtkStringArray> data;
-  data->SetName(TITLE_KEY.c_str());
-  data->InsertNextValue(args[0]);
-  this->GetOutput()->GetFieldData()->AddArray(data);
+  char buffer[MAX_NUMBER_LENGTH];
+  const size_t length = std::min(token.Size(), MAX_NUMBER_LENGTH - 1);
+  std::copy(token.Begin, token.Begin + length, buffer);
+  buffer[length] = '\0';
+  char* end = nullptr;
+  errno = 0;
+  value = std::strtod(buffer, &end);
+  if (end == buffer)
+  {
+    error = "Error while parsing number, wrong type: " + token.ToString();
+    return false;
+  }
+  if (errno == ERANGE)
+  {
+    error = "Error while parsing number, out of range: " + token.ToString();
+    return false;
+  }
   return true;
 }
 
 //------------------------------------------------------------------------------
-bool vtkNastranBDFReader::AddTimeInfo(const std::vector<std::string>& args)
+bool ParseNumber(const vtkBDFToken& token, vtkIdType& value, std::string& error)
 {
-  vtkNew<vtkDoubleArray> data;
-  data->SetName(TIME_KEY.c_str());
-  data->InsertNextValue(std::stod(args[0]));
-  this->GetOutput()->GetFieldData()->AddArray(data);
+  char buffer[MAX_NUMBER_LENGTH];
+  const size_t length = std::min(token.Size(), MAX_NUMBER_LENGTH - 1);
+  std::copy(token.Begin, token.Begin + length, buffer);
+  buffer[length] = '\0';
+  char* end = nullptr;
+  errno = 0;
+  const long long parsed = std::strtoll(buffer, &end, 10);
+  if (end == buffer)
+  {
+    error = "Error while parsing number, wrong type: " + token.ToString();
+    return false;
+  }
+  if (errno == ERANGE || parsed < VTK_ID_MIN || parsed > VTK_ID_MAX)
+  {
+    error = "Error while parsing number, out of range: " + token.ToString();
+    return false;
+  }
+  value = static_cast<vtkIdType>(parsed);
   return true;
 }
 
 //------------------------------------------------------------------------------
-bool vtkNastranBDFReader::AddPoint(const std::vector<std::string>& args)
+// Entries parsed from a range of lines, in file order.
+struct vtkBDFChunk
 {
-  // Expected args: ID CP X1 X2 X3.
-  // Where:
-  // ID is the id of the point,
-  // CP is unused,
-  // X1, X2, X3 are coordinates
-  // extra args are silently ignored
-  if (args.size() < 5)
-  {
-    vtkErrorMacro("Wrong size for GRID element, should be at least 5");
-    return false;
-  }
+  vtkBDFToken Range;
+
+  // GRID: original id and coordinates
+  std::vector<vtkIdType> PointIds;
+  std::vector<double> Coordinates;
+  // CTRIA3: original element id and original point ids
+  std::vector<vtkIdType> CellIds;
+  std::vector<vtkIdType> CellPoints;
+  // PLOAD2: original element id and pressure value
+  std::vector<vtkIdType> Pload2CellIds;
+  std::vector<double> Pload2Values;
+
+  // Last TITLE and TIME entries of the chunk
+  bool HasTitle = false;
+  vtkBDFToken Title;
+  bool HasTime = false;
+  double Time = 0.0;
+
+  // Store parsing errors as <Keyword, numberOfOccurence>
+  std::map<std::string, vtkIdType> UnsupportedElements;
+
+  // First error of the chunk, parsing stops there.
+  std::string Error;
+  vtkBDFToken ErrorLine;
+
+  bool ParseLine(const vtkBDFToken& line);
+  void Parse();
+};
 
-  vtkIdType originalId = std::stod(args[0]);
-  vtkIdType id =
-    this->Points->InsertNextPoint(std::stod(args[2]), std::stod(args[3]), std::stod(args[4]));
-  this->OriginalPointIds->InsertNextValue(originalId);
-  this->PointsIds[originalId] = id;
+//------------------------------------------------------------------------------
+bool vtkBDFChunk::ParseLine(const vtkBDFToken& rawLine)
+{
+  vtkBDFToken line = rawLine;
+  // skip blank and comments
+  if (line.Empty() || IsIgnored(line))
+  {
+    return true;
+  }
+  // remove trailing comment
+  line.End = line.Find('$');
 
+  vtkBDFToken args[5];
+  if (line.StartsWith(TITLE_KEY))
+  {
+    // remove `TITLE` keyword and the `=` char
+    const size_t skip = std::strlen(TITLE_KEY) + 1;
+    this->HasTitle = true;
+    this->Title.Begin = line.Size() > skip ? line.Begin + skip : line.End;
+    this->Title.End = line.End;
+  }
+  else if (line.StartsWith(TIME_KEY))
+  {
+    // remove `TIME` keyword and its separator
+    const size_t skip = std::strlen(TIME_KEY) + 1;
+    vtkBDFToken value{ line.Size() > skip ? line.Begin + skip : line.End, line.End };
+    if (!ParseNumber(value, this->Time, this->Error))
+    {
+      return false;
+    }
+    this->HasTime = true;
+  }
+  else if (line.StartsWith(GRID_KEY))
+  {
+    // Expected args: ID CP X1 X2 X3.
+    // Where:
+    // ID is the id of the point,
+    // CP is unused,
+    // X1, X2, X3 are coordinates
+    // extra args are silently ignored
+    if (ParseArgs(line, args, 5) < 5)
+    {
+      this->Error = "Wrong size for GRID element, should be at least 5";
+      return false;
+    }
+    vtkIdType id;
+    double coords[3];
+    if (!ParseNumber(args[0], id, this->Error) || !ParseNumber(args[2], coords[0], this->Error) ||
+      !ParseNumber(args[3], coords[1], this->Error) ||
+      !ParseNumber(args[4], coords[2], this->Error))
+    {
+      return false;
+    }
+    this->PointIds.push_back(id);
+    this->Coordinates.insert(this->Coordinates.end(), coords, coords + 3);
+  }
+  else if (line.StartsWith(CTRIA3_KEY))
+  {
+    // Expected args: EID PID G1 G2 G3
+    // Where:
+    // EID is the corresponding cell id,
+    // PID is unused,
+    // G1 G2 G3 are points ids defining a triangle.
+    // extra args are silently ignored
+    if (ParseArgs(line, args, 5) < 5)
+    {
+      this->Error = "Wrong size for CTRIA3 element, should be at least 5";
+      return false;
+    }
+    vtkIdType ids[4];
+    if (!ParseNumber(args[0], ids[0], this->Error) || !ParseNumber(args[2], ids[1], this->Error) ||
+      !ParseNumber(args[3], ids[2], this->Error) || !ParseNumber(args[4], ids[3], this->Error))
+    {
+      return false;
+    }
+    this->CellIds.push_back(ids[0]);
+    this->CellPoints.insert(this->CellPoints.end(), ids + 1, ids + 4);
+  }
+  else if (line.StartsWith(PLOAD2_KEY))
+  {
+    // Expected args: SID P EID
+    // SID: Load set identification number (unused).
+    // P: Pressure value
+    // EID: Element identification number.
+    // extra args are silently ignored
+    if (ParseArgs(line, args, 3) < 3)
+    {
+      this->Error = "Wrong size for PLOAD2 element, should be at least 3";
+      return false;
+    }
+    vtkIdType id;
+    double value;
+    if (!ParseNumber(args[1], value, this->Error) || !ParseNumber(args[2], id, this->Error))
+    {
+      return false;
+    }
+    this->Pload2CellIds.push_back(id);
+    this->Pload2Values.push_back(value);
+  }
+  // store unsupported keyword for summary reporting.
+  else
+  {
+    this->UnsupportedElements[std::string(line.Begin, line.Find(','))]++;
+  }
   return true;
 }
 
 //------------------------------------------------------------------------------
-bool vtkNastranBDFReader::AddTriangle(const std::vector<std::string>& args)
+void vtkBDFChunk::Parse()
 {
-  // Expected args: EID PID G1 G2 G3
-  // Where:
-  // EID is the corresponding cell id,
-  // PID is unused,
-  // G1 G2 G3 are points ids defining a triangle.
-  // extra args are silently ignored
-  if (args.size() < 5)
-  {
-    vtkErrorMacro("Wrong size for CTRIA3 element, should be at least 5");
-    return false;
+  vtkBDFToken remaining = this->Range;
+  while (remaining.Begin < remaining.End)
+  {
+    vtkBDFToken line{ remaining.Begin, remaining.Find('\n') };
+    remaining.Begin = line.End == remaining.End ? line.End : line.End + 1;
+    if (!line.Empty() && line.End[-1] == '\r')
+    {
+      --line.End;
+    }
+    if (!this->ParseLine(line))
+    {
+      this->ErrorLine = line;
+      return;
+    }
   }
+}
 
-  vtkNew<vtkTriangle> tri;
-  vtkIdType pt1Id = this->GetVTKPointId(args[2]);
-  vtkIdType pt2Id = this->GetVTKPointId(args[3]);
-  vtkIdType pt3Id = this->GetVTKPointId(args[4]);
+//------------------------------------------------------------------------------
+// Splits the file in chunks of complete lines.
+std::vector<vtkBDFChunk> SplitInChunks(const char* data, size_t size)
+{
+  const size_t threads = static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  // a few chunks per thread to balance the load between them.
+  const size_t chunkSize = std::max(MIN_CHUNK_SIZE, size / (4 * std::max<size_t>(threads, 1)) + 1);
+
+  std::vector<vtkBDFChunk> chunks;
+  const char* end = data + size;
+  const char* begin = data;
+  while (begin < end)
+  {
+    const char* chunkEnd = begin + std::min(chunkSize, static_cast<size_t>(end - begin));
+    chunkEnd = vtkBDFToken{ chunkEnd, end }.Find('\n');
+    chunkEnd = chunkEnd == end ? end : chunkEnd + 1;
+    chunks.emplace_back();
+    chunks.back().Range = vtkBDFToken{ begin, chunkEnd };
+    begin = chunkEnd;
+  }
+  return chunks;
+}
 
-  if (pt1Id == -1 || pt2Id == -1 || pt3Id == -1)
+//------------------------------------------------------------------------------
+// Concatenates GRID entries in file order. When a point id is defined more
+// than once, the last definition is used by the cells.
+void MergePoints(const std::vector<vtkBDFChunk>& chunks, vtkPoints* points,
+  vtkIdTypeArray* originalIds, std::unordered_map<vtkIdType, vtkIdType>& pointsIds)
+{
+  std::vector<vtkIdType> offsets(chunks.size() + 1, 0);
+  for (size_t cc = 0; cc < chunks.size(); ++cc)
   {
-    vtkErrorMacro(<< "Undefined point in triangle (" << args[2] << ", " << args[3] << ", "
-                  << args[4] << ")");
-    return false;
+    offsets[cc + 1] = offsets[cc] + static_cast<vtkIdType>(chunks[cc].PointIds.size());
   }
+  const vtkIdType numberOfPoints = offsets.back();
+
+  vtkNew<vtkFloatArray> coordinates;
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(numberOfPoints);
+  originalIds->SetNumberOfValues(numberOfPoints);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkBDFChunk& chunk = chunks[cc];
+      std::copy(chunk.Coordinates.begin(), chunk.Coordinates.end(),
+        coordinates->GetPointer(3 * offsets[cc]));
+      std::copy(
+        chunk.PointIds.begin(), chunk.PointIds.end(), originalIds->GetPointer(offsets[cc]));
+    }
+  });
+  points->SetData(coordinates);
 
-  tri->GetPointIds()->SetId(0, pt1Id);
-  tri->GetPointIds()->SetId(1, pt2Id);
-  tri->GetPointIds()->SetId(2, pt3Id);
+  pointsIds.reserve(static_cast<size_t>(numberOfPoints));
+  for (vtkIdType id = 0; id < numberOfPoints; ++id)
+  {
+    pointsIds[originalIds->GetValue(id)] = id;
+  }
+}
 
-  if (this->Cells->GetNumberOfCells() == 0)
+//------------------------------------------------------------------------------
+// Concatenates CTRIA3 entries in file order, converting their point ids to
+// output point ids. Returns false if a triangle uses an undefined point.
+bool MergeTriangles(const std::vector<vtkBDFChunk>& chunks,
+  const std::unordered_map<vtkIdType, vtkIdType>& pointsIds, vtkCellArray* cells,
+  std::unordered_map<vtkIdType, vtkIdType>& cellsIds, std::string& error)
+{
+  std::vector<vtkIdType> offsets(chunks.size() + 1, 0);
+  for (size_t cc = 0; cc < chunks.size(); ++cc)
   {
-    this->Cells->AllocateEstimate(this->Points->GetNumberOfPoints(), 3);
+    offsets[cc + 1] = offsets[cc] + static_cast<vtkIdType>(chunks[cc].CellIds.size());
   }
+  const vtkIdType numberOfCells = offsets.back();
+
+  vtkNew<vtkIdTypeArray> cellOffsets;
+  cellOffsets->SetNumberOfValues(numberOfCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numberOfCells);
+  // index in the chunk of the first triangle using an undefined point
+  std::vector<vtkIdType> undefined(chunks.size(), -1);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkBDFChunk& chunk = chunks[cc];
+      vtkIdType* cellPoints = connectivity->GetPointer(3 * offsets[cc]);
+      for (size_t pt = 0; pt < chunk.CellPoints.size(); ++pt)
+      {
+        auto found = pointsIds.find(chunk.CellPoints[pt]);
+        if (found == pointsIds.end())
+        {
+          undefined[cc] = static_cast<vtkIdType>(pt / 3);
+          break;
+        }
+        cellPoints[pt] = found->second;
+      }
+      for (vtkIdType cell = offsets[cc]; cell < offsets[cc + 1]; ++cell)
+      {
+        cellOffsets->SetValue(cell, 3 * cell);
+      }
+    }
+  });
+  cellOffsets->SetValue(numberOfCells, 3 * numberOfCells);
 
-  vtkIdType id = this->Cells->InsertNextCell(tri);
-  this->CellsIds[std::stol(args[0])] = id;
+  for (size_t cc = 0; cc < chunks.size(); ++cc)
+  {
+    if (undefined[cc] != -1)
+    {
+      const vtkIdType* ids = &chunks[cc].CellPoints[3 * undefined[cc]];
+      std::ostringstream message;
+      message << "Undefined point in triangle (" << ids[0] << ", " << ids[1] << ", " << ids[2]
+              << ")";
+      error = message.str();
+      return false;
+    }
+  }
+  cells->SetData(cellOffsets, connectivity);
 
+  cellsIds.reserve(static_cast<size_t>(numberOfCells));
+  vtkIdType cellId = 0;
+  for (const auto& chunk : chunks)
+  {
+    for (const vtkIdType id : chunk.CellIds)
+    {
+      cellsIds[id] = cellId++;
+    }
+  }
   return true;
 }
 
 //------------------------------------------------------------------------------
-bool vtkNastranBDFReader::AddPload2Data(const std::vector<std::string>& args)
+// Creates the PLOAD2 cell array, if any PLOAD2 entry was read. Cells without
+// pressure are set to 0. Returns false if an entry refers to an undefined cell.
+bool MergePload2(const std::vector<vtkBDFChunk>& chunks,
+  const std::unordered_map<vtkIdType, vtkIdType>& cellsIds, vtkIdType numberOfCells,
+  vtkSmartPointer<vtkDoubleArray>& pload2, std::string& error)
 {
-  // Expected args: SID P EID
-  // SID: Load set identification number (unused).
-  // P: Pressure value
-  // EID: Element identification number.
-  // extra args are silently ignored
-  if (args.size() < 3)
-  {
-    vtkErrorMacro("Wrong size for PLOAD2 element, should be at least 3");
-    return false;
+  bool hasPload2 = false;
+  for (const auto& chunk : chunks)
+  {
+    hasPload2 |= !chunk.Pload2CellIds.empty();
   }
-
-  if (this->CellsIds.empty())
+  if (!hasPload2)
+  {
+    return true;
+  }
+  if (numberOfCells == 0)
   {
-    vtkErrorMacro("Trying to add PLOAD2 data without any cell defined. Skipping.");
+    error = "Trying to add PLOAD2 data without any cell defined.";
     return false;
   }
 
-  if (!this->Pload2)
+  pload2 = vtkSmartPointer<vtkDoubleArray>::New();
+  pload2->SetName(PLOAD2_KEY);
+  pload2->SetNumberOfTuples(numberOfCells);
+  pload2->Fill(0.0);
+  for (const auto& chunk : chunks)
   {
-    this->Pload2 = vtkSmartPointer<vtkDoubleArray>::New();
-    this->Pload2->SetNumberOfTuples(this->Cells->GetNumberOfCells());
-    this->Pload2->SetName(PLOAD2_KEY.c_str());
+    for (size_t cc = 0; cc < chunk.Pload2CellIds.size(); ++cc)
+    {
+      auto found = cellsIds.find(chunk.Pload2CellIds[cc]);
+      if (found == cellsIds.end())
+      {
+        error = "Undefined element in PLOAD2 (" + std::to_string(chunk.Pload2CellIds[cc]) + ")";
+        return false;
+      }
+      pload2->SetValue(found->second, chunk.Pload2Values[cc]);
+    }
   }
-
-  this->Pload2->InsertValue(this->CellsIds[std::stol(args[2])], std::stod(args[1]));
   return true;
 }
+}
+
+//------------------------------------------------------------------------------
+vtkNastranBDFReader::vtkNastranBDFReader()
+{
+  this->SetNumberOfInputPorts(0);
+  this->OriginalPointIds->SetName("Ids");
+}
+
+//------------------------------------------------------------------------------
+void vtkNastranBDFReader::Initialize()
+{
+  this->Points->Initialize();
+  this->Cells->Initialize();
+  this->OriginalPointIds->Initialize();
+  this->Pload2 = nullptr;
+  this->CellsIds.clear();
+  this->PointsIds.clear();
+  this->UnsupportedElements.clear();
+}
 
 //------------------------------------------------------------------------------
 int vtkNastranBDFReader::RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*)
 {
-  // Create stream
-  vtksys::ifstream filestream;
-  vtksys::SystemTools::Stat_t fs;
-  if (!vtksys::SystemTools::Stat(this->FileName, &fs))
-  {
-    filestream.open(this->FileName.c_str(), ios::in);
-  }
-  if (filestream.fail())
+  this->Initialize();
+
+  vtkBDFFileBuffer file;
+  if (!file.Open(this->FileName))
   {
     vtkErrorMacro("Could not open file : " << this->FileName);
-    return false;
+    return 0;
   }
 
-  // read lines, and call appropriate method depending on keyword
-  std::string line;
-  bool success = true;
-  while (vtksys::SystemTools::GetLineFromStream(filestream, line) && success)
+  // parse chunks of lines concurrently
+  std::vector<vtkBDFChunk> chunks = ::SplitInChunks(file.GetData(), file.GetSize());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      chunks[cc].Parse();
+    }
+  });
+
+  // report the first error in file order
+  for (const auto& chunk : chunks)
   {
-    // skip blank and comments
-    if (line.empty() || utils::IsIgnored(line))
+    if (!chunk.Error.empty())
     {
-      continue;
+      vtkErrorMacro(<< chunk.Error << "\n"
+                    << "Fail to read file."
+                    << "\n"
+                    << "Error with line: \n"
+                    << chunk.ErrorLine.ToString());
+      return 0;
     }
+  }
 
-    utils::TrimTrailingComment(line);
+  ::MergePoints(chunks, this->Points, this->OriginalPointIds, this->PointsIds);
+  std::string error;
+  if (!::MergeTriangles(chunks, this->PointsIds, this->Cells, this->CellsIds, error) ||
+    !::MergePload2(
+      chunks, this->CellsIds, this->Cells->GetNumberOfCells(), this->Pload2, error))
+  {
+    vtkErrorMacro(<< error << "\n"
+                  << "Fail to read file.");
+    return 0;
+  }
 
-    // we parse values with std::sto[ild] that may raise exception. Catch them.
-    try
+  auto output = this->GetOutput();
+  for (const auto& chunk : chunks)
+  {
+    for (const auto& unsupported : chunk.UnsupportedElements)
     {
-      // parse line depending on keyword
-      if (utils::StartsWith(line, TITLE_KEY))
-      {
-        success = this->AddTitle(utils::ParseArgs(line, TITLE_KEY));
-      }
-      else if (utils::StartsWith(line, TIME_KEY))
-      {
-        success = this->AddTimeInfo(utils::ParseArgs(line, TITLE_KEY));
-      }
-      else if (utils::StartsWith(line, GRID_KEY))
-      {
-        success = this->AddPoint(utils::ParseArgs(line, GRID_KEY));
-      }
-      else if (utils::StartsWith(line, CTRIA3_KEY))
-      {
-        success = this->AddTriangle(utils::ParseArgs(line, CTRIA3_KEY));
-      }
-      else if (utils::StartsWith(line, PLOAD2_KEY))
-      {
-        success = this->AddPload2Data(utils::ParseArgs(line, PLOAD2_KEY));
-      }
-      // store unsupported keyword for summary reporting.
-      else
-      {
-        std::string keyword = line.substr(0, line.find(','));
-        if (this->UnsupportedElements.find(keyword) != this->UnsupportedElements.end())
-        {
-          this->UnsupportedElements[keyword]++;
-        }
-        else
-        {
-          this->UnsupportedElements[keyword] = 1;
-        }
-      }
+      this->UnsupportedElements[unsupported.first] += unsupported.second;
     }
-    catch (std::invalid_argument const& ex)
+    if (chunk.HasTitle)
     {
-      vtkErrorMacro(<< "Error while parsing number, wrong type: " << ex.what());
-      success = false;
+      vtkNew<vtkStringArray> data;
+      data->SetName(TITLE_KEY);
+      data->InsertNextValue(chunk.Title.ToString());
+      output->GetFieldData()->AddArray(data);
     }
-    catch (std::out_of_range const& ex)
+    if (chunk.HasTime)
     {
-      vtkErrorMacro(<< "Error while parsing number, out of range: " << ex.what());
-      success = false;
+      vtkNew<vtkDoubleArray> data;
+      data->SetName(TIME_KEY);
+      data->InsertNextValue(chunk.Time);
+      output->GetFieldData()->AddArray(data);
     }
   }
 
-  if (!success)
-  {
-    vtkErrorMacro(<< "Fail to read file."
-                  << "\n"
-                  << "Error with line: \n"
-                  << line);
-    return 0;
-  }
-
   for (const auto& unsupported : this->UnsupportedElements)
   {
     vtkWarningMacro("Skip unsupported entry `" << unsupported.first << "` (" << unsupported.second
                                                << " occurences)");
   }
 
-  auto output = this->GetOutput();
   output->SetPoints(this->Points);
   output->GetPointData()->AddArray(this->OriginalPointIds);
   output->SetCells(VTK_TRIANGLE, this->Cells);
@@ -334,5 +694,5 @@ void vtkNastranBDFReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 
-  os << indent << "FileName: " << (this->FileName.empty() ? this->FileName : "(none)") << endl;
+  os << indent << "FileName: " << (this->FileName.empty() ? "(none)" : this->FileName) << endl;
 }
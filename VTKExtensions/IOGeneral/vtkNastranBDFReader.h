@@ -5,6 +5,10 @@
  * @class   vtkNastranBDFReader
  * @brief   Reader for Bulk Data Format from Nastran
  *
+ * The file is memory mapped and split in chunks of lines that are parsed
+ * concurrently with vtkSMPTools. Entries of each chunk are then merged in file
+ * order, so the output does not depend on the number of threads. As bulk data
+ * entries are not ordered, cells may refer to points defined later in the file.
  */
 #ifndef vtkNastranBDFReader_h
 #define vtkNastranBDFReader_h
@@ -17,7 +21,7 @@
 
 #include <map>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 class vtkCellArray;
 class vtkDoubleArray;
@@ -45,24 +49,8 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
-  ///@{
-  /**
-   * Inner methods to parse Bulk Data Entries and fill output vtkDataObject.
-   */
-  // Add title as field data
-  bool AddTitle(const std::vector<std::string>& args);
-  // Add time as field data
-  bool AddTimeInfo(const std::vector<std::string>& args);
-  // Add output point
-  bool AddPoint(const std::vector<std::string>& args);
-  // Add triangle cell. Points should be parsed first.
-  bool AddTriangle(const std::vector<std::string>& args);
-  // Add Pload2 as cell data. Cells should be parsed first.
-  bool AddPload2Data(const std::vector<std::string>& args);
-  ///@}
-
-  // Return the id in `Points` of the element id `arg`
-  vtkIdType GetVTKPointId(const std::string& arg);
+  // Reset the parsed data before reading a file
+  void Initialize();
 
   std::string FileName;
 
@@ -72,8 +60,8 @@ protected:
   vtkSmartPointer<vtkDoubleArray> Pload2;
 
   // Utilities map to store <inputId, VTKId>
-  std::map<vtkIdType, vtkIdType> CellsIds;
-  std::map<vtkIdType, vtkIdType> PointsIds;
+  std::unordered_map<vtkIdType, vtkIdType> CellsIds;
+  std::unordered_map<vtkIdType, vtkIdType> PointsIds;
 
   // Store parsing errors as <Keyword, numberOfOccurence>
   std::map<std::string, vtkIdType> UnsupportedElements;
@@ -22,7 +22,12 @@ vtkStandardNewMacro(vtkPhastaReader);
 
 vtkCxxSetObjectMacro(vtkPhastaReader, CachedGrid, vtkUnstructuredGrid);
 
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -48,14 +53,162 @@ struct vtkPhastaReaderInternal
 
   typedef std::map<std::string, FieldInfo> FieldInfoMapType;
   FieldInfoMapType FieldInfoMap;
+
+  // Last data block read from the field file.
+  std::string BlockTag;
+  std::string BlockType;
+  std::vector<char> Block;
 };
 
+namespace
+{
+// Location of the blocks of a binary PHASTA file. It is built by a single scan
+// of the headers the first time a block of the file is looked up, so that
+// reading a block does not rescan (and rewind) the file, and is shared by all
+// readers of the process until the file changes.
+struct vtkPhastaHeaderIndex
+{
+  struct Entry
+  {
+    std::string Key;         // the keyphrase, as written in the file
+    long Offset;             // offset of the data block following the header
+    std::vector<int> Params; // values following the block size
+  };
+  std::vector<Entry> Entries;
+  int WrongEndian = 0;
+};
+
+std::shared_ptr<const vtkPhastaHeaderIndex> vtkBuildHeaderIndex(FILE* fileObject)
+{
+  auto index = std::make_shared<vtkPhastaHeaderIndex>();
+  char Line[1024];
+  rewind(fileObject);
+  while (fgets(Line, 1024, fileObject))
+  {
+    const size_t real_length = strcspn(Line, "#");
+    if (Line[0] == '\n' || real_length == 0)
+    {
+      continue;
+    }
+    std::string text(Line, real_length);
+    const size_t colon = text.find(':');
+    if (colon == std::string::npos)
+    {
+      continue;
+    }
+
+    vtkPhastaHeaderIndex::Entry entry;
+    entry.Key = text.substr(0, colon);
+    std::vector<int> values;
+    char* token = strtok(&text[colon + 1], " ,;<>\r\n");
+    for (; token; token = strtok(nullptr, " ,;<>\r\n"))
+    {
+      values.push_back(atoi(token));
+    }
+    if (values.empty())
+    {
+      continue;
+    }
+    entry.Params.assign(values.begin() + 1, values.end());
+    entry.Offset = ftell(fileObject);
+    const long next = entry.Offset + values[0]; // the size includes the trailing newline.
+
+    std::string phrase;
+    for (char c : entry.Key)
+    {
+      if (c != ' ')
+      {
+        phrase += static_cast<char>(tolower(c));
+      }
+    }
+    if (phrase == "byteordermagicnumber")
+    {
+      int integer_value = 0;
+      if (fread(&integer_value, sizeof(int), 1, fileObject) == 1 && integer_value != 362436)
+      {
+        index->WrongEndian = 1;
+      }
+    }
+    else
+    {
+      index->Entries.push_back(std::move(entry));
+    }
+    if (fseek(fileObject, next, SEEK_SET) != 0)
+    {
+      break;
+    }
+  }
+  clearerr(fileObject);
+  return index;
+}
+
+// Indexes of the files read by this process, keyed by file name and checked
+// against the modification time and size of the file.
+struct vtkPhastaHeaderIndexCache
+{
+  struct Item
+  {
+    long ModifiedTime;
+    unsigned long Length;
+    std::shared_ptr<const vtkPhastaHeaderIndex> Index;
+  };
+  std::mutex Mutex;
+  std::map<std::string, Item> Items;
+};
+
+std::shared_ptr<const vtkPhastaHeaderIndex> vtkGetHeaderIndex(
+  const std::string& filename, FILE* fileObject)
+{
+  // Restart files are typically read for a few hundred timesteps and pieces.
+  const size_t maximumNumberOfIndexes = 1024;
+  static vtkPhastaHeaderIndexCache cache;
+
+  const long modifiedTime = vtksys::SystemTools::ModifiedTime(filename);
+  const unsigned long length = vtksys::SystemTools::FileLength(filename);
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  auto iter = cache.Items.find(filename);
+  if (iter != cache.Items.end() && iter->second.ModifiedTime == modifiedTime &&
+    iter->second.Length == length)
+  {
+    return iter->second.Index;
+  }
+  if (cache.Items.size() >= maximumNumberOfIndexes)
+  {
+    cache.Items.clear();
+  }
+  auto index = vtkBuildHeaderIndex(fileObject);
+  cache.Items[filename] = vtkPhastaHeaderIndexCache::Item{ modifiedTime, length, index };
+  return index;
+}
+
+template <typename WordT>
+void vtkSwapWords(unsigned char* bytes, int nItems)
+{
+  // Byte swapping whole words with shifts lets compilers use vector shuffles.
+  for (int i = 0; i < nItems; i++)
+  {
+    WordT word;
+    memcpy(&word, bytes + i * sizeof(WordT), sizeof(WordT));
+    WordT swapped = 0;
+    for (size_t j = 0; j < sizeof(WordT); j++)
+    {
+      swapped |= ((word >> (8 * j)) & 0xff) << (8 * (sizeof(WordT) - 1 - j));
+    }
+    memcpy(bytes + i * sizeof(WordT), &swapped, sizeof(WordT));
+  }
+}
+}
+
 // Begin of copy from phastaIO
 
 std::map<int, char*> LastHeaderKey;
 std::vector<FILE*> fileArray;
 std::vector<int> byte_order;
 std::vector<int> header_type;
+std::vector<std::string> file_names;
+std::vector<std::shared_ptr<const vtkPhastaHeaderIndex>> header_index;
+std::vector<size_t> next_header;
+std::vector<const vtkPhastaHeaderIndex::Entry*> last_header;
 int DataSize = 0;
 int LastHeaderNotFound = 0;
 int Wrong_Endian = 0;
@@ -288,6 +441,17 @@ void vtkPhastaReader::SwapArrayByteOrder(void* array, int nbytes, int nItems)
   int i, j;
   unsigned char* ucDst = (unsigned char*)array;
 
+  if (nbytes == 4)
+  {
+    vtkSwapWords<std::uint32_t>(ucDst, nItems);
+    return;
+  }
+  if (nbytes == 8)
+  {
+    vtkSwapWords<std::uint64_t>(ucDst, nItems);
+    return;
+  }
+
   for (i = 0; i < nItems; i++)
   {
     for (j = 0; j < (nbytes / 2); j++)
@@ -330,6 +494,10 @@ void vtkPhastaReader::openfile(const char filename[], const char mode[], int* fi
     fileArray.push_back(file);
     byte_order.push_back(0);
     header_type.push_back(sizeof(int));
+    file_names.emplace_back(fname);
+    header_index.emplace_back();
+    next_header.push_back(0);
+    last_header.push_back(nullptr);
     *fileDescriptor = static_cast<int>(fileArray.size());
   }
   delete[] imode;
@@ -345,6 +513,8 @@ void vtkPhastaReader::closefile(int* fileDescriptor, const char mode[])
   }
 
   fclose(fileArray[*fileDescriptor - 1]);
+  header_index[*fileDescriptor - 1] = nullptr;
+  last_header[*fileDescriptor - 1] = nullptr;
   delete[] imode;
 }
 
@@ -377,6 +547,45 @@ void vtkPhastaReader::readheader(int* fileDescriptor, const char keyphrase[], vo
   // on the header line.
 
   valueListInt = static_cast<int*>(valueArray);
+  if (binary_format)
+  {
+    // look the block up in the index of the file, starting after the last
+    // block found, like the sequential scan of readHeader does.
+    if (!header_index[filePtr])
+    {
+      header_index[filePtr] = vtkGetHeaderIndex(file_names[filePtr], fileObject);
+    }
+    const vtkPhastaHeaderIndex& index = *header_index[filePtr];
+    const size_t count = index.Entries.size();
+    const vtkPhastaHeaderIndex::Entry* found = nullptr;
+    for (size_t cc = 0; cc < count && !found; ++cc)
+    {
+      const size_t pos = (next_header[filePtr] + cc) % count;
+      if (cscompare(keyphrase, index.Entries[pos].Key.c_str()))
+      {
+        found = &index.Entries[pos];
+        next_header[filePtr] = pos + 1;
+      }
+    }
+    last_header[filePtr] = found;
+    byte_order[filePtr] = index.WrongEndian;
+    if (!found)
+    {
+      vtkGenericWarningMacro(<< "Could not find: " << keyphrase << endl);
+      LastHeaderNotFound = 1;
+      return;
+    }
+    if (static_cast<int>(found->Params.size()) < *nItems)
+    {
+      vtkGenericWarningMacro(<< "Expected # of ints not found for: " << keyphrase << endl);
+    }
+    for (int i = 0; i < *nItems && i < static_cast<int>(found->Params.size()); i++)
+    {
+      valueListInt[i] = found->Params[i];
+    }
+    return;
+  }
+
   int ierr = readHeader(fileObject, keyphrase, valueListInt, *nItems);
 
   byte_order[filePtr] = Wrong_Endian;
@@ -432,7 +641,21 @@ void vtkPhastaReader::readdatablock(int* fileDescriptor, const char keyphrase[],
   int nUnits = *nItems;
   isBinary(iotype);
 
-  if (binary_format)
+  if (binary_format && last_header[filePtr])
+  {
+    // a single read of the whole block, at the offset found in the index.
+    if (fseek(fileObject, last_header[filePtr]->Offset, SEEK_SET) != 0)
+    {
+      vtkGenericWarningMacro(<< "Could not seek to the block of: " << keyphrase << endl);
+      return;
+    }
+    xfread(valueArray, type_size, nUnits, fileObject);
+    if (Wrong_Endian)
+    {
+      SwapArrayByteOrder(valueArray, static_cast<int>(type_size), nUnits);
+    }
+  }
+  else if (binary_format)
   {
     xfread(valueArray, type_size, nUnits, fileObject);
     xfread(&junk, sizeof(char), 1, fileObject);
@@ -960,18 +1183,8 @@ void vtkPhastaReader::ReadFieldFile(
     if (dtype == 0)
     { // data is type double
 
-      double* data;
-      data = new double[item];
-
-      if (data == nullptr)
-      {
-        vtkErrorMacro(<< "Unable to allocate memory for field info");
-
-        dataArray->Delete();
-        continue;
-      }
-
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
+      const double* data = static_cast<const double*>(
+        this->ReadFieldBlock(&fieldfile, phastaFieldTag, item, dataType, sizeof(double)));
 
       switch (numOfComps)
       {
@@ -1027,28 +1240,14 @@ void vtkPhastaReader::ReadFieldFile(
           vtkErrorMacro("number of components [" << numOfComps << "] NOT supported");
 
           dataArray->Delete();
-          delete[] data;
           continue;
       }
-
-      // clean up
-      delete[] data;
     }
     else if (dtype == 1)
     { // data is type float
 
-      float* data;
-      data = new float[item];
-
-      if (data == nullptr)
-      {
-        vtkErrorMacro(<< "Unable to allocate memory for field info");
-
-        dataArray->Delete();
-        continue;
-      }
-
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
+      const float* data = static_cast<const float*>(
+        this->ReadFieldBlock(&fieldfile, phastaFieldTag, item, dataType, sizeof(float)));
 
       switch (numOfComps)
       {
@@ -1124,12 +1323,8 @@ void vtkPhastaReader::ReadFieldFile(
           vtkErrorMacro("number of components [" << numOfComps << "] NOT supported");
 
           dataArray->Delete();
-          delete[] data;
           continue;
       }
-
-      // clean up
-      delete[] data;
     }
     else
     {
@@ -1146,9 +1341,29 @@ void vtkPhastaReader::ReadFieldFile(
 
   // close up
   closefile(&fieldfile, "read");
+  this->Internal->BlockTag.clear();
+  std::vector<char>().swap(this->Internal->Block);
 
 } // closes ReadFieldFile
 
+const void* vtkPhastaReader::ReadFieldBlock(
+  int* fieldfile, const char* phastaFieldTag, int item, const char* dataType, size_t typeSize)
+{
+  // Several fields are usually taken from the same block (e.g. "solution"),
+  // so the last block read is kept instead of reading it again for each one.
+  vtkPhastaReaderInternal* internal = this->Internal;
+  const size_t size = static_cast<size_t>(item) * typeSize;
+  if (internal->BlockTag != phastaFieldTag || internal->BlockType != dataType ||
+    internal->Block.size() != size)
+  {
+    internal->Block.resize(size);
+    readdatablock(fieldfile, phastaFieldTag, internal->Block.data(), &item, dataType, "binary");
+    internal->BlockTag = LastHeaderNotFound ? "" : phastaFieldTag;
+    internal->BlockType = dataType;
+  }
+  return internal->Block.data();
+}
+
 void vtkPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
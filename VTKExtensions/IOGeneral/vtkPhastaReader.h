@@ -80,6 +80,11 @@ private:
 
   int NumberOfVariables; // number of variable in the field file
 
+  // Reads a data block of the field file, reusing the previous one when it is
+  // the same block.
+  const void* ReadFieldBlock(
+    int* fieldfile, const char* phastaFieldTag, int item, const char* dataType, size_t typeSize);
+
   static char* StringStripper(const char istring[]);
   static int cscompare(const char teststring[], const char targetstring[]);
   static void isBinary(const char iotype[]);
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+// Returns the bin values of the histogram of `image`'s "values" array over `range`.
+vtkSmartPointer<vtkDataArray> ComputeBins(
+  vtkImageData* image, bool useSketch, int binCount, const double* range)
+{
+  vtkNew<vtkPExtractHistogram> histogram;
+  histogram->SetInputData(image);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "values");
+  histogram->SetUseHistogramSketch(useSketch);
+  histogram->SetBinCount(binCount);
+  if (range)
+  {
+    histogram->SetUseCustomBinRanges(true);
+    histogram->SetCustomBinRanges(range[0], range[1]);
+  }
+  histogram->Update();
+  return vtkDataArray::SafeDownCast(histogram->GetOutput()->GetColumn(1));
+}
+
+bool Compare(vtkImageData* image, int binCount, const double* range, double tolerance,
+  const std::string& label)
+{
+  auto exact = ComputeBins(image, false, binCount, range);
+  auto approx = ComputeBins(image, true, binCount, range);
+  if (!exact || !approx || exact->GetNumberOfTuples() != binCount ||
+    approx->GetNumberOfTuples() != binCount)
+  {
+    vtkLog(ERROR, << label << ": missing bins.");
+    return false;
+  }
+  for (vtkIdType bin = 0; bin < binCount; ++bin)
+  {
+    const double expected = exact->GetTuple1(bin);
+    if (std::abs(approx->GetTuple1(bin) - expected) > tolerance * expected)
+    {
+      vtkLog(ERROR, << label << ": bin " << bin << " has " << approx->GetTuple1(bin)
+                    << " values, expected " << expected);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+// Checks that the single pass mode of vtkPExtractHistogram matches the default
+// one, including for custom bin ranges much narrower than the data range.
+int TestPExtractHistogramSketch(int, char*[])
+{
+  const vtkIdType numValues = 100000;
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(static_cast<int>(numValues), 1, 1);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(numValues);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  for (vtkIdType cc = 0; cc < numValues; ++cc)
+  {
+    random->Next();
+    values->SetValue(cc, random->GetRangeValue(0.0, 1000.0));
+  }
+  image->GetPointData()->AddArray(values);
+
+  // the sketch is fine enough for the whole range, even with misaligned bins.
+  bool success = Compare(image, 10, nullptr, 0.02, "data range");
+  success = Compare(image, 7, nullptr, 0.02, "data range, misaligned bins") && success;
+  const double wide[2] = { 100.0, 700.0 };
+  success = Compare(image, 13, wide, 0.02, "wide custom range") && success;
+
+  // a custom range covering fewer sketch bins than bins falls back to the exact binning.
+  const double narrow[2] = { 100.0, 101.0 };
+  success = Compare(image, 10, narrow, 0.0, "narrow custom range") && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
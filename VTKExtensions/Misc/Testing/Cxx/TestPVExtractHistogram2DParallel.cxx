@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkExecutive.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVExtractHistogram2D.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+
+// Runs the single-pass histogram with one rank missing the input array. All
+// ranks must go through the collective sketch reduction without hanging: the
+// ranks with data get the histogram of all the samples, the other one fails.
+int TestPVExtractHistogram2DParallel(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+  const bool missingArray = numRanks > 1 && myRank == numRanks - 1;
+  const int numRanksWithArray = numRanks > 1 ? numRanks - 1 : 1;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(20);
+  sphere->SetPhiResolution(20);
+  sphere->SetCenter(myRank, 0, 0);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0, 0, -1);
+  elevation->SetHighPoint(0, 0, 1);
+  elevation->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(elevation->GetOutput());
+  const vtkIdType numberOfPoints = input->GetNumberOfPoints();
+  if (missingArray)
+  {
+    input->GetPointData()->RemoveArray("Elevation");
+  }
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  vtkNew<vtkPVExtractHistogram2D> histogram;
+  histogram->AddObserver(vtkCommand::ErrorEvent, observer);
+  histogram->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, observer);
+  histogram->SetController(contr);
+  histogram->SetInputData(input);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Elevation");
+  histogram->SetNumberOfBins(10, 10);
+  histogram->UseHistogramSketchOn();
+  histogram->Update();
+
+  int success = 1;
+  if (missingArray)
+  {
+    if (!observer->GetError())
+    {
+      vtkLog(ERROR, "Expected an error on the rank missing the input array.");
+      success = 0;
+    }
+  }
+  else
+  {
+    vtkDataArray* counts = histogram->GetOutput()->GetPointData()->GetScalars();
+    double total = 0.0;
+    for (vtkIdType cc = 0; counts && cc < counts->GetNumberOfTuples(); ++cc)
+    {
+      total += counts->GetTuple1(cc);
+    }
+    const double expected = static_cast<double>(numRanksWithArray * numberOfPoints);
+    if (total != expected)
+    {
+      vtkLog(ERROR, "Expected " << expected << " samples in the histogram, got " << total);
+      success = 0;
+    }
+  }
+
+  int allSuccess;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPVHistogramSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestPVHistogramSketch(int, char*[])
+{
+  const int numValues = 100000;
+  std::vector<double> values(numValues);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  for (int cc = 0; cc < numValues; ++cc)
+  {
+    random->Next();
+    values[cc] = random->GetRangeValue(-50.0, 250.0);
+  }
+  values[10] = std::numeric_limits<double>::quiet_NaN();
+
+  // Bin all values at once using vtkSMPTools, and in three separate sketches
+  // filled in a different order then merged.
+  vtkPVHistogramSketch all(1, 1024);
+  all.AddSamples(numValues,
+    [&](vtkIdType id, double* sample)
+    {
+      sample[0] = values[id];
+      return true;
+    });
+  vtkPVHistogramSketch parts[3] = { vtkPVHistogramSketch(1, 1024), vtkPVHistogramSketch(1, 1024),
+    vtkPVHistogramSketch(1, 1024) };
+  for (int cc = numValues - 1; cc >= 0; --cc)
+  {
+    parts[cc % 3].Add(&values[cc]);
+  }
+  std::vector<double> buffer;
+  parts[2].Serialize(buffer);
+  vtkPVHistogramSketch received(1, 1024);
+  vtk_assert(received.Deserialize(buffer.data(), static_cast<vtkIdType>(buffer.size())));
+  parts[0].Merge(parts[1]);
+  parts[0].Merge(received);
+
+  double range[2], mergedRange[2];
+  vtk_assert(all.GetRange(0, range) && parts[0].GetRange(0, mergedRange));
+  vtk_assert(all.GetTotalCount() == numValues - 1);
+  vtk_assert(parts[0].GetTotalCount() == numValues - 1);
+  vtk_assert(range[0] == mergedRange[0] && range[1] == mergedRange[1]);
+
+  // Compare a 10 bins histogram with the exact one.
+  const int numBins = 10;
+  const double delta = (range[1] - range[0]) / numBins;
+  std::vector<double> exact(numBins, 0.0), approx(numBins, 0.0);
+  for (double value : values)
+  {
+    if (std::isfinite(value))
+    {
+      const int bin = std::min(static_cast<int>((value - range[0]) / delta), numBins - 1);
+      exact[bin]++;
+    }
+  }
+  parts[0].ForEachBin(
+    [&](const double* center, double count)
+    {
+      const int bin = std::min(static_cast<int>((center[0] - range[0]) / delta), numBins - 1);
+      approx[bin] += count;
+    });
+  for (int bin = 0; bin < numBins; ++bin)
+  {
+    vtk_assert(std::abs(exact[bin] - approx[bin]) <= 0.02 * exact[bin]);
+  }
+
+  // With bins that are not aligned with the coarse bins of a low resolution
+  // sketch, counts must be split across bins rather than aliased, including
+  // when the sketch is clipped to a narrower range.
+  vtkPVHistogramSketch coarse(1, 64);
+  for (double value : values)
+  {
+    coarse.Add(&value);
+  }
+  const double clips[2][2] = { { range[0], range[1] }, { 0.0, 100.0 } };
+  for (const auto& clip : clips)
+  {
+    const int numMisalignedBins = 7;
+    const vtkPVHistogramSketch::RegularBins bins = { clip[0],
+      (clip[1] - clip[0]) / numMisalignedBins, numMisalignedBins };
+    std::vector<double> exactMisaligned(numMisalignedBins, 0.0);
+    std::vector<double> rebinned(numMisalignedBins, 0.0);
+    for (double value : values)
+    {
+      if (std::isfinite(value) && value >= clip[0] && value <= clip[1])
+      {
+        const int bin = std::min(
+          static_cast<int>((value - bins.Origin) / bins.Width), numMisalignedBins - 1);
+        exactMisaligned[bin]++;
+      }
+    }
+    coarse.Rebin(
+      &bins, &clip, [&](const vtkIdType* bin, double count) { rebinned[bin[0]] += count; });
+    for (int bin = 0; bin < numMisalignedBins; ++bin)
+    {
+      vtk_assert(std::abs(exactMisaligned[bin] - rebinned[bin]) <= 0.02 * exactMisaligned[bin]);
+    }
+  }
+
+  // 2D sketches keep the exact range of each axis.
+  vtkPVHistogramSketch sketch2D(2, 64);
+  for (int cc = 0; cc < 1000; ++cc)
+  {
+    const double sample[2] = { -static_cast<double>(cc), 1e-3 * cc };
+    sketch2D.Add(sample);
+  }
+  double total = 0.0;
+  sketch2D.ForEachBin([&](const double*, double count) { total += count; });
+  vtk_assert(total == 1000);
+  vtk_assert(sketch2D.GetRange(0, range) && range[0] == -999 && range[1] == 0);
+  vtk_assert(sketch2D.GetRange(1, range) && range[0] == 0 && std::abs(range[1] - 0.999) < 1e-12);
+
+  // Re-binning a 2D sketch keeps the total count.
+  const vtkPVHistogramSketch::RegularBins bins2D[2] = { { -999.0, 999.0 / 6, 7 },
+    { 0.0, 0.999 / 4, 5 } };
+  total = 0.0;
+  sketch2D.Rebin(bins2D, nullptr,
+    [&](const vtkIdType* bin, double count)
+    {
+      if (bin[0] >= 0 && bin[0] < 7 && bin[1] >= 0 && bin[1] < 5)
+      {
+        total += count;
+      }
+    });
+  vtk_assert(std::abs(total - 1000) < 1e-9);
+
+  return EXIT_SUCCESS;
+}
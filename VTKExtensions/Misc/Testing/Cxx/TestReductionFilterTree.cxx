@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAttributeDataReductionFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVMergeTables.h"
+#include "vtkReductionFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+namespace
+{
+// Table produced by process `rank`: a few rows of values unique to the rank.
+vtkSmartPointer<vtkTable> MakeTable(int rank)
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  vtkNew<vtkDoubleArray> counts;
+  counts->SetName("counts");
+  for (int cc = 0; cc < 5; ++cc)
+  {
+    values->InsertNextValue(rank * 100 + cc);
+    counts->InsertNextValue(rank + cc);
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  table->AddColumn(values);
+  table->AddColumn(counts);
+  return table;
+}
+
+vtkSmartPointer<vtkAlgorithm> MakeHelper(bool append)
+{
+  if (append)
+  {
+    return vtkSmartPointer<vtkPVMergeTables>::New();
+  }
+  auto sum = vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+  sum->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+  sum->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+  return sum;
+}
+
+bool SameTables(vtkTable* result, vtkTable* expected)
+{
+  if (!result || result->GetNumberOfRows() != expected->GetNumberOfRows() ||
+    result->GetNumberOfColumns() != expected->GetNumberOfColumns())
+  {
+    return false;
+  }
+  for (vtkIdType col = 0; col < expected->GetNumberOfColumns(); ++col)
+  {
+    const char* name = expected->GetColumnName(col);
+    auto resultColumn = vtkDoubleArray::SafeDownCast(result->GetColumnByName(name));
+    auto expectedColumn = vtkDoubleArray::SafeDownCast(expected->GetColumn(col));
+    if (!resultColumn)
+    {
+      return false;
+    }
+    for (vtkIdType row = 0; row < expected->GetNumberOfRows(); ++row)
+    {
+      if (resultColumn->GetValue(row) != expectedColumn->GetValue(row))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Reduce the tables of all processes along the tree and compare the result
+// with the helper run serially on the tables of all processes.
+bool TestHelper(vtkMultiProcessController* controller, bool append, int mode)
+{
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(MakeHelper(append));
+  reduction->SetUseTreeReduction(true);
+  reduction->SetReductionMode(mode);
+  reduction->SetInputDataObject(MakeTable(myRank));
+  reduction->Update();
+
+  if (mode != vtkReductionFilter::REDUCE_ALL_TO_ALL && myRank != 0)
+  {
+    return true;
+  }
+
+  auto serial = MakeHelper(append);
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    serial->AddInputDataObject(MakeTable(rank));
+  }
+  serial->Update();
+
+  if (!SameTables(vtkTable::SafeDownCast(reduction->GetOutputDataObject(0)),
+        vtkTable::SafeDownCast(serial->GetOutputDataObject(0))))
+  {
+    vtkLog(ERROR, "Tree reduction of " << (append ? "merged" : "summed")
+                                       << " tables does not match the serial result.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestReductionFilterTree(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int modes[] = { vtkReductionFilter::REDUCE_ALL_TO_ONE,
+    vtkReductionFilter::REDUCE_ALL_TO_ALL };
+  int success = 1;
+  for (bool append : { true, false })
+  {
+    for (int mode : modes)
+    {
+      success = TestHelper(contr, append, mode) && success;
+    }
+  }
+
+  int allSuccess;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -11,6 +11,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
@@ -24,6 +25,7 @@ vtkAttributeDataReductionFilter::vtkAttributeDataReductionFilter()
   this->ReductionType = vtkAttributeDataReductionFilter::ADD;
   this->AttributeType = vtkAttributeDataReductionFilter::POINT_DATA |
     vtkAttributeDataReductionFilter::CELL_DATA | vtkAttributeDataReductionFilter::ROW_DATA;
+  this->GetInformation()->Set(vtkReductionFilter::ASSOCIATIVE_HELPER(), 1);
 }
 
 //-----------------------------------------------------------------------------
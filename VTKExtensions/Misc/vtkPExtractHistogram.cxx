@@ -6,21 +6,75 @@
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVHistogramSketch.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+//-----------------------------------------------------------------------------
+std::vector<vtkDataObject*> GetLeaves(vtkDataObject* input)
+{
+  std::vector<vtkDataObject*> leaves;
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(input))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      leaves.push_back(iter->GetCurrentDataObject());
+    }
+  }
+  else if (input)
+  {
+    leaves.push_back(input);
+  }
+  return leaves;
+}
+}
+
+struct vtkPExtractHistogram::vtkInternals
+{
+  struct SketchArray
+  {
+    vtkWeakPointer<vtkAbstractArray> Array;
+    vtkMTimeType MTime;
+  };
+
+  // Reduced sketch of the last input (only meaningful on the root node), and
+  // what it was computed from. The sketch only depends on the values of the
+  // binned and ghost arrays, so these are tracked rather than the input itself:
+  // the sketch survives upstream re-executions that shallow copy the same
+  // arrays into a new dataset.
+  vtkPVHistogramSketch Sketch;
+  std::vector<SketchArray> SketchArrays;
+  bool HasSketch = false;
+  std::string SketchArrayName;
+  int SketchArrayAssociation = -1;
+  int SketchComponent = -1;
+};
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -28,12 +82,14 @@ vtkPExtractHistogram::vtkPExtractHistogram()
 {
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Internals = new vtkInternals();
 }
 
 //-----------------------------------------------------------------------------
 vtkPExtractHistogram::~vtkPExtractHistogram()
 {
   this->SetController(nullptr);
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
@@ -64,6 +120,16 @@ bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector
 int vtkPExtractHistogram::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  if (this->UseHistogramSketch && !this->CalculateAverages)
+  {
+    bool tooCoarse = false;
+    const int result = this->RequestDataWithSketch(inputVector, outputVector, tooCoarse);
+    if (!tooCoarse)
+    {
+      return result;
+    }
+  }
+
   // All processes generate the histogram.
   // However we want to avoid the super class to normalize/accumulate the results, hence temporarily
   // disable these functionalities.
@@ -96,18 +162,17 @@ int vtkPExtractHistogram::RequestData(
       return 1;
     }
     // Now we need to collect and reduce data from all nodes on the root.
+    // Bins are summed along a reduction tree, so the PostGatherHelper is needed
+    // on all nodes.
     vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
     reduceFilter->SetController(this->Controller);
+    reduceFilter->SetUseTreeReduction(true);
 
-    if (isRoot)
-    {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
-    }
+    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+    reduceFilter->SetPostGatherHelper(rf);
 
     vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
     copy->ShallowCopy(output);
@@ -170,9 +235,214 @@ int vtkPExtractHistogram::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkPExtractHistogram::RequestDataWithSketch(
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector, bool& tooCoarse)
+{
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  vtkTable* output = vtkTable::GetData(outputVector, 0);
+
+  const bool useCustomRange = this->GetUseCustomBinRanges();
+  double customRange[2] = { 0.0, 0.0 };
+  if (useCustomRange)
+  {
+    this->GetCustomBinRanges(customRange);
+    if (customRange[1] < customRange[0])
+    {
+      std::swap(customRange[0], customRange[1]);
+    }
+  }
+
+  // The sketch covers all the data, whatever the bins. It is kept to only
+  // re-bin it when the bins change but not the data, array or component.
+  vtkInformation* arrayInfo = this->GetInputArrayInformation(0);
+  const char* arrayName =
+    arrayInfo->Has(vtkDataObject::FIELD_NAME()) ? arrayInfo->Get(vtkDataObject::FIELD_NAME()) : "";
+  const int arrayAssociation = arrayInfo->Has(vtkDataObject::FIELD_ASSOCIATION())
+    ? arrayInfo->Get(vtkDataObject::FIELD_ASSOCIATION())
+    : -1;
+  std::vector<vtkInternals::SketchArray> sketchArrays;
+  for (vtkDataObject* leaf : ::GetLeaves(input))
+  {
+    int association;
+    vtkDataArray* array = this->GetInputArrayToProcess(0, leaf, association);
+    vtkFieldData* fd = array ? leaf->GetAttributesAsFieldData(association) : nullptr;
+    vtkUnsignedCharArray* ghosts = fd ? fd->GetGhostArray() : nullptr;
+    sketchArrays.push_back({ array, array ? array->GetMTime() : 0 });
+    sketchArrays.push_back({ ghosts, ghosts ? ghosts->GetMTime() : 0 });
+  }
+  vtkInternals& internals = *this->Internals;
+  const bool sameArrays = internals.SketchArrays.size() == sketchArrays.size() &&
+    std::equal(sketchArrays.begin(), sketchArrays.end(), internals.SketchArrays.begin(),
+      [](const vtkInternals::SketchArray& a, const vtkInternals::SketchArray& b)
+      { return a.Array == b.Array && a.MTime == b.MTime; });
+  int reuseSketch = internals.HasSketch && input && sameArrays &&
+      internals.SketchArrayName == arrayName &&
+      internals.SketchArrayAssociation == arrayAssociation &&
+      internals.SketchComponent == this->GetComponent() &&
+      internals.Sketch.GetResolution() == this->SketchResolution
+    ? 1
+    : 0;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    // all ranks must take part in the reduction if any of them changed.
+    int reuseAll = 0;
+    this->Controller->AllReduce(&reuseSketch, &reuseAll, 1, vtkCommunicator::MIN_OP);
+    reuseSketch = reuseAll;
+  }
+
+  if (!reuseSketch)
+  {
+    internals.HasSketch = true;
+    internals.SketchArrays = sketchArrays;
+    internals.SketchArrayName = arrayName;
+    internals.SketchArrayAssociation = arrayAssociation;
+    internals.SketchComponent = this->GetComponent();
+    internals.Sketch = vtkPVHistogramSketch(1, this->SketchResolution);
+    if (!this->ComputeSketch(input, internals.Sketch))
+    {
+      internals.HasSketch = false;
+      return 0;
+    }
+  }
+  const vtkPVHistogramSketch& sketch = internals.Sketch;
+  const int binCount = std::max(this->BinCount, 1);
+  bool isRoot = !this->Controller || (this->Controller->GetLocalProcessId() == 0);
+
+  // Each bin must cover at least one sketch bin, otherwise the histogram of a
+  // narrow custom range would be interpolated from a handful of sketch bins.
+  // Only the root has the reduced sketch to decide.
+  int coarse = isRoot && useCustomRange && !sketch.IsEmpty() &&
+      customRange[1] - customRange[0] < binCount * sketch.GetBinWidth(0)
+    ? 1
+    : 0;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    this->Controller->Broadcast(&coarse, 1, 0);
+  }
+  tooCoarse = coarse != 0;
+  if (tooCoarse)
+  {
+    return 1;
+  }
+
+  output->Initialize();
+  if (!isRoot)
+  {
+    return 1;
+  }
+
+  double range[2] = { customRange[0], customRange[1] };
+  if (!useCustomRange)
+  {
+    if (!sketch.GetRange(0, range))
+    {
+      // Nothing to do if there is no data
+      return 1;
+    }
+    if (this->GetCenterBinsAroundMinAndMax() && this->BinCount > 1)
+    {
+      const double halfDelta = 0.5 * (range[1] - range[0]) / (this->BinCount - 1);
+      range[0] -= halfDelta;
+      range[1] += halfDelta;
+    }
+  }
+
+  const double binDelta = (range[1] - range[0]) / binCount;
+
+  // Sketch bins straddling several bins are split across them.
+  std::vector<double> counts(binCount, 0.0);
+  const vtkPVHistogramSketch::RegularBins bins = { range[0], binDelta, binCount };
+  const double clip[1][2] = { { customRange[0], customRange[1] } };
+  sketch.Rebin(&bins, useCustomRange ? clip : nullptr,
+    [&](const vtkIdType* bin, double count) { counts[bin[0]] += count; });
+
+  vtkNew<vtkDoubleArray> binExtents;
+  binExtents->SetName(this->BinExtentsArrayName);
+  binExtents->SetNumberOfTuples(binCount);
+  vtkNew<vtkIntArray> binValues;
+  binValues->SetName(this->BinValuesArrayName);
+  binValues->SetNumberOfTuples(binCount);
+  for (int i = 0; i < binCount; ++i)
+  {
+    binExtents->SetValue(i, range[0] + (i + 0.5) * binDelta);
+    binValues->SetValue(i, static_cast<int>(std::round(counts[i])));
+  }
+
+  output->GetRowData()->AddArray(binExtents);
+  output->GetRowData()->AddArray(binValues);
+
+  if (this->Normalize)
+  {
+    this->Superclass::NormalizeBins(output);
+  }
+  if (this->Accumulation)
+  {
+    this->Superclass::AccumulateBins(output);
+  }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ComputeSketch(vtkDataObject* input, vtkPVHistogramSketch& sketch)
+{
+  // Bin all the local values in a single pass, without knowing the global range.
+  const int component = this->GetComponent();
+  for (vtkDataObject* leaf : ::GetLeaves(input))
+  {
+    int association;
+    vtkDataArray* array = this->GetInputArrayToProcess(0, leaf, association);
+    if (!array)
+    {
+      continue;
+    }
+    vtkFieldData* fd = leaf->GetAttributesAsFieldData(association);
+    vtkUnsignedCharArray* ghosts = fd ? fd->GetGhostArray() : nullptr;
+    const unsigned char ghostsToSkip = fd ? fd->GetGhostsToSkip() : 0;
+    const int numComps = array->GetNumberOfComponents();
+    const bool useMagnitude = numComps > 1 && (component < 0 || component >= numComps);
+    const int comp = (component >= 0 && component < numComps) ? component : 0;
+
+    sketch.AddSamples(array->GetNumberOfTuples(),
+      [&](vtkIdType tupleId, double* sample) -> bool
+      {
+        if (ghosts && (ghosts->GetValue(tupleId) & ghostsToSkip))
+        {
+          return false;
+        }
+        double value = 0.0;
+        if (useMagnitude)
+        {
+          for (int cc = 0; cc < numComps; ++cc)
+          {
+            const double val = array->GetComponent(tupleId, cc);
+            value += val * val;
+          }
+          value = std::sqrt(value);
+        }
+        else
+        {
+          value = array->GetComponent(tupleId, comp);
+        }
+        sample[0] = value;
+        return true;
+      });
+  }
+
+  // Merge the sketches on the root node.
+  if (!sketch.Reduce(this->Controller))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce histograms.");
+    return false;
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "UseHistogramSketch: " << this->UseHistogramSketch << endl;
+  os << indent << "SketchResolution: " << this->SketchResolution << endl;
 }
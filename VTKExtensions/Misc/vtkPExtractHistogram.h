@@ -7,6 +7,19 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * By default, the range of the input array is first reduced across all
+ * processes, then each process bins its data and the resulting tables are
+ * gathered and summed on the root node. When UseHistogramSketch is enabled,
+ * the data is instead binned in a single pass, using multiple threads, into a
+ * vtkPVHistogramSketch that does not need to know the range beforehand. The
+ * sketches are then merged with a reduction tree and the histogram is
+ * extracted from the global sketch on the root node. This mode does not support
+ * CalculateAverages and is approximate: the count of a sketch bin straddling
+ * several bins is split among them. When custom bin ranges cover fewer sketch
+ * bins than BinCount, e.g. when zooming on a part of the data range, the bins
+ * would be fed by too few sketch bins and the default mode is used instead.
+ * See vtkPVHistogramSketch.
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -16,6 +29,7 @@
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
 class vtkMultiProcessController;
+class vtkPVHistogramSketch;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -33,6 +47,27 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, compute the histogram in a single pass using mergeable
+   * histogram sketches instead of reducing the range first. Ignored when
+   * CalculateAverages is on. Default is false.
+   */
+  vtkSetMacro(UseHistogramSketch, bool);
+  vtkGetMacro(UseHistogramSketch, bool);
+  vtkBooleanMacro(UseHistogramSketch, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of bins of the sketch used when UseHistogramSketch is enabled. The
+   * higher the resolution, the more accurate the histogram. It should be much
+   * larger than BinCount. Default is 4096.
+   */
+  vtkSetClampMacro(SketchResolution, int, 8, VTK_INT_MAX);
+  vtkGetMacro(SketchResolution, int);
+  ///@}
+
 protected:
   vtkPExtractHistogram();
   ~vtkPExtractHistogram() override;
@@ -46,11 +81,31 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Single-pass implementation of RequestData used when UseHistogramSketch is on.
+   * The reduced sketch is kept between executions, so that only changing the bins
+   * (BinCount, CustomBinRanges...) does not go through the data again.
+   * `tooCoarse` is set on all processes if the sketch is too coarse for the custom
+   * bin ranges, in which case nothing is done and the default mode must be used.
+   */
+  int RequestDataWithSketch(
+    vtkInformationVector** inputVector, vtkInformationVector* outputVector, bool& tooCoarse);
+
+  /**
+   * Bin the input array of `input` into `sketch` and reduce it on the root node.
+   */
+  bool ComputeSketch(vtkDataObject* input, vtkPVHistogramSketch& sketch);
+
   vtkMultiProcessController* Controller;
+  bool UseHistogramSketch = false;
+  int SketchResolution = 4096;
 
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&) = delete;
   void operator=(const vtkPExtractHistogram&) = delete;
+
+  struct vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
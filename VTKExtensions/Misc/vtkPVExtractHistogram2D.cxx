@@ -5,6 +5,7 @@
 
 // VTK includes
 #include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataObject.h"
@@ -18,11 +19,14 @@
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVHistogramSketch.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkPVExtractHistogram2D);
 vtkCxxSetObjectMacro(vtkPVExtractHistogram2D, Controller, vtkMultiProcessController);
 
@@ -67,6 +71,8 @@ void vtkPVExtractHistogram2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseCustomBinRanges1 = " << this->UseCustomBinRanges1 << endl;
   os << indent << "CustomBinRanges1 = [" << this->CustomBinRanges1[0] << ", "
      << this->CustomBinRanges1[1] << "]" << endl;
+  os << indent << "UseHistogramSketch = " << this->UseHistogramSketch << endl;
+  os << indent << "SketchResolution = " << this->SketchResolution << endl;
 }
 
 //------------------------------------------------------------------------------------------------
@@ -86,6 +92,7 @@ int vtkPVExtractHistogram2D::RequestInformation(vtkInformation* vtkNotUsed(reque
   this->InitializeCache();
   this->GetInputArrays(inputVector);
   this->ComputeComponentRange();
+  this->ReduceComponentRange();
 
   int ext[6] = { 0, this->NumberOfBins[0] - 1, 0, this->NumberOfBins[1] - 1, 0, 0 };
   outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext, 6);
@@ -129,6 +136,15 @@ int vtkPVExtractHistogram2D::RequestData(vtkInformation* vtkNotUsed(request),
 {
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+
+  // In single-pass mode, the output bounds are the global ranges, as in RequestInformation.
+  // The reductions are collective, so they must run even on ranks missing the input arrays.
+  vtkPVHistogramSketch sketch(2, this->SketchResolution);
+  this->ReduceComponentRange();
+  if (this->UseHistogramSketch && !this->ComputeSketch(sketch))
+  {
+    return 0;
+  }
   if (!input || !this->ComponentArrayCache[0])
   {
     return 0;
@@ -151,7 +167,14 @@ int vtkPVExtractHistogram2D::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetOrigin(o);
   output->SetSpacing(sp);
   output->AllocateScalars(VTK_DOUBLE, 1);
-  this->ComputeHistogram2D(output);
+  if (this->UseHistogramSketch)
+  {
+    this->ComputeHistogram2DFromSketch(sketch, output);
+  }
+  else
+  {
+    this->ComputeHistogram2D(output);
+  }
 
   return 1;
 }
@@ -399,6 +422,126 @@ void vtkPVExtractHistogram2D::ComputeHistogram2D(vtkImageData* histogram)
   }
 }
 
+//------------------------------------------------------------------------------------------------
+bool vtkPVExtractHistogram2D::ComputeSketch(vtkPVHistogramSketch& sketch)
+{
+  vtkDataArray* array0 = this->ComponentArrayCache[0];
+  vtkDataArray* array1 = this->ComponentArrayCache[1];
+
+  // Ranks with invalid inputs contribute an empty sketch: all ranks must take part in the
+  // reduction below. Errors are reported once it is done.
+  const char* error = nullptr;
+  if (!array0 || !array1)
+  {
+    error = "Missing input arrays to process.";
+  }
+  else if (array0->GetNumberOfTuples() != array1->GetNumberOfTuples())
+  {
+    error = "Both arrays should be the same size";
+  }
+
+  // Custom ranges are known beforehand, values outside of them are not binned.
+  const bool useCustomRange[2] = { this->UseCustomBinRanges0,
+    this->UseCustomBinRanges1 && !this->UseGradientForYAxis };
+  if (!error)
+  {
+    const int comps[2] = {
+      std::min(this->ComponentIndexCache[0], array0->GetNumberOfComponents() - 1),
+      std::min(this->ComponentIndexCache[1], array1->GetNumberOfComponents() - 1)
+    };
+    const double(&ranges)[2][2] = this->ComponentRangeCache;
+    vtkUnsignedCharArray* ghosts = this->GhostArray;
+    const unsigned char ghostsToSkip = this->GhostsToSkip;
+
+    sketch.AddSamples(array0->GetNumberOfTuples(),
+      [&](vtkIdType tupleId, double* sample) -> bool
+      {
+        if (ghosts && (ghosts->GetValue(tupleId) & ghostsToSkip))
+        {
+          return false;
+        }
+        sample[0] = array0->GetComponent(tupleId, comps[0]);
+        sample[1] = array1->GetComponent(tupleId, comps[1]);
+        for (int axis = 0; axis < 2; ++axis)
+        {
+          if (useCustomRange[axis] &&
+            (sample[axis] < ranges[axis][0] || sample[axis] > ranges[axis][1]))
+          {
+            return false;
+          }
+        }
+        return true;
+      });
+  }
+
+  // Every process gets the global histogram.
+  const bool reduced = sketch.Reduce(this->Controller);
+  if (!sketch.Broadcast(this->Controller) || !reduced)
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce histograms.");
+    return false;
+  }
+  if (error)
+  {
+    vtkErrorMacro(<< error);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------------------------
+void vtkPVExtractHistogram2D::ComputeHistogram2DFromSketch(
+  const vtkPVHistogramSketch& sketch, vtkImageData* histogram)
+{
+  auto histArray = histogram->GetPointData()->GetScalars();
+  histArray->FillComponent(0, 0);
+  auto histRange = vtk::DataArrayValueRange(histArray);
+
+  // Same bins as ComputeHistogram2D, sketch bins straddling several of them are split.
+  vtkPVHistogramSketch::RegularBins bins[2];
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    const double delta = this->ComponentRangeCache[axis][1] - this->ComponentRangeCache[axis][0];
+    bins[axis].Origin = this->ComponentRangeCache[axis][0];
+    bins[axis].Width = this->NumberOfBins[axis] > 1 ? delta / (this->NumberOfBins[axis] - 1) : 0.0;
+    bins[axis].NumberOfBins = this->NumberOfBins[axis];
+  }
+  sketch.Rebin(bins, nullptr,
+    [&](const vtkIdType* bin, double count)
+    { histRange[bin[1] * this->NumberOfBins[0] + bin[0]] += count; });
+}
+
+//------------------------------------------------------------------------------------------------
+void vtkPVExtractHistogram2D::ReduceComponentRange()
+{
+  if (!this->UseHistogramSketch || !this->Controller ||
+    this->Controller->GetNumberOfProcesses() <= 1)
+  {
+    return;
+  }
+
+  // Ranks without input arrays do not contribute to the global ranges.
+  const bool hasArrays = this->ComponentArrayCache[0] && this->ComponentArrayCache[1];
+  const bool useCustomRange[2] = { this->UseCustomBinRanges0,
+    this->UseCustomBinRanges1 && !this->UseGradientForYAxis };
+  double localMin[2], localMax[2], globalMin[2], globalMax[2];
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    localMin[axis] = hasArrays ? this->ComponentRangeCache[axis][0] : VTK_DOUBLE_MAX;
+    localMax[axis] = hasArrays ? this->ComponentRangeCache[axis][1] : VTK_DOUBLE_MIN;
+  }
+  this->Controller->AllReduce(localMin, globalMin, 2, vtkCommunicator::MIN_OP);
+  this->Controller->AllReduce(localMax, globalMax, 2, vtkCommunicator::MAX_OP);
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    if (!useCustomRange[axis] && globalMin[axis] <= globalMax[axis])
+    {
+      this->ComponentRangeCache[axis][0] = globalMin[axis];
+      this->ComponentRangeCache[axis][1] = globalMax[axis];
+    }
+  }
+}
+
 //------------------------------------------------------------------------------------------------
 void vtkPVExtractHistogram2D::ComputeGradient(vtkDataObject* input)
 {
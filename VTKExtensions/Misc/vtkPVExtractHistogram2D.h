@@ -7,6 +7,12 @@
  * vtkPVExtractHistogram2D is a vtkImageAlgorithm subclass for parallel datasets, to extract the 2D
  * histogram. It uses vtkExtractHistogram2D internally and gathers the histogram data on the root
  * node.
+ *
+ * When UseHistogramSketch is enabled, the pairs of values are binned in a single pass, using
+ * multiple threads, into a vtkPVHistogramSketch. The sketches of all processes are merged with a
+ * reduction tree so that the histogram is global and available on all processes, and its bounds
+ * are the global ranges of the values. This mode is approximate: the count of a sketch bin
+ * straddling several bins of the histogram is split among them.
  */
 
 #ifndef vtkPVExtractHistogram2D_h
@@ -19,6 +25,7 @@
 // Forward declarations
 class vtkDataArray;
 class vtkMultiProcessController;
+class vtkPVHistogramSketch;
 class vtkUnsignedCharArray;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPVExtractHistogram2D : public vtkImageAlgorithm
@@ -118,6 +125,26 @@ public:
   vtkGetVector2Macro(OutputSpacing, double);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, compute the histogram in a single pass using mergeable histogram sketches,
+   * reduced across all processes. Default is false.
+   */
+  vtkSetMacro(UseHistogramSketch, bool);
+  vtkGetMacro(UseHistogramSketch, bool);
+  vtkBooleanMacro(UseHistogramSketch, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of bins per axis of the sketch used when UseHistogramSketch is enabled. It should be
+   * larger than NumberOfBins. Each thread bins its values into its own sketch of
+   * SketchResolution^2 bins, hence the maximum of 1024. Default is 512.
+   */
+  vtkSetClampMacro(SketchResolution, int, 8, 1024);
+  vtkGetMacro(SketchResolution, int);
+  ///@}
+
 protected:
   vtkPVExtractHistogram2D();
   ~vtkPVExtractHistogram2D() override;
@@ -133,6 +160,8 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
   void ComputeHistogram2D(vtkImageData* histogram);
+  bool ComputeSketch(vtkPVHistogramSketch& sketch);
+  void ComputeHistogram2DFromSketch(const vtkPVHistogramSketch& sketch, vtkImageData* histogram);
   void ComputeGradient(vtkDataObject* input);
 
   int Component0 = 0;
@@ -148,6 +177,8 @@ protected:
   bool UseInputRangesForOutputBounds = true;
   double OutputOrigin[2] = { 0.0, 0.0 };
   double OutputSpacing[2] = { 1.0, 1.0 };
+  bool UseHistogramSketch = false;
+  int SketchResolution = 512;
 
   // Cache of internal array and range
   int ComponentIndexCache[2];
@@ -160,6 +191,7 @@ protected:
   void GetInputArrays(vtkInformationVector**);
   void ComputeVectorMagnitude(vtkDataArray*, vtkDataArray*&);
   void ComputeComponentRange();
+  void ReduceComponentRange();
 
 private:
   vtkPVExtractHistogram2D(const vtkPVExtractHistogram2D&) = delete;
@@ -0,0 +1,499 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVHistogramSketch.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Exponents are clamped so that bin widths are representable, non-zero doubles.
+const int MinimumExponent = -1074;
+const int MaximumExponent = 1023;
+
+//-----------------------------------------------------------------------------
+long long BinIndex(double value, double width)
+{
+  return static_cast<long long>(std::floor(value / width));
+}
+
+//-----------------------------------------------------------------------------
+// floor(value / 2^shift), for bin indices that are all below 2^53 in magnitude.
+long long FloorShift(long long value, int shift)
+{
+  if (shift <= 0)
+  {
+    return value;
+  }
+  if (shift >= 62)
+  {
+    return value < 0 ? -1 : 0;
+  }
+  return value >= 0 ? (value >> shift) : -((-value - 1) >> shift) - 1;
+}
+
+//-----------------------------------------------------------------------------
+// The smallest exponent keeping `value / width` below 2^52 for the given range,
+// so that bin indices are computed exactly.
+int SmallestExponent(double low, double high)
+{
+  const double maxAbs = std::max(std::abs(low), std::abs(high));
+  return maxAbs > 0.0 ? std::max(std::ilogb(maxAbs) - 50, MinimumExponent) : MinimumExponent;
+}
+
+//-----------------------------------------------------------------------------
+bool IsFinite(const double* sample, int dims)
+{
+  for (int dim = 0; dim < dims; ++dim)
+  {
+    if (!std::isfinite(sample[dim]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//-----------------------------------------------------------------------------
+vtkPVHistogramSketch::vtkPVHistogramSketch(int numberOfDimensions, int resolution)
+  : NumberOfDimensions(std::min(std::max(numberOfDimensions, 1), 3))
+  , Resolution(std::max(resolution, 8))
+{
+  this->Initialize();
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Initialize()
+{
+  this->Counts.clear();
+  this->TotalCount = 0.0;
+  for (int dim = 0; dim < MaxNumberOfDimensions; ++dim)
+  {
+    this->Exponent[dim] = 0;
+    this->Origin[dim] = 0;
+    this->Width[dim] = 1.0;
+    this->Range[dim][0] = std::numeric_limits<double>::infinity();
+    this->Range[dim][1] = -std::numeric_limits<double>::infinity();
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVHistogramSketch::GetRange(int dimension, double range[2]) const
+{
+  if (this->IsEmpty() || dimension < 0 || dimension >= this->NumberOfDimensions)
+  {
+    return false;
+  }
+  range[0] = this->Range[dimension][0];
+  range[1] = this->Range[dimension][1];
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// A grid is chosen so that the range only spans half the bins: this leaves
+// room on both sides and avoids regridding every time the range grows a bit.
+bool vtkPVHistogramSketch::Fits(int exponent, double low, double high) const
+{
+  const double width = std::ldexp(1.0, exponent);
+  return BinIndex(high, width) - BinIndex(low, width) + 1 <= this->Resolution / 2;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::ChooseGrid(
+  double low, double high, int minExponent, int& exponent, long long& origin) const
+{
+  int candidate = std::max(minExponent, SmallestExponent(low, high));
+  const double halfSpan = 0.5 * high - 0.5 * low;
+  if (halfSpan > 0.0)
+  {
+    // lower bound of the smallest exponent for which the span fits, so that
+    // only a couple of iterations are needed below.
+    candidate =
+      std::max(candidate, std::ilogb(halfSpan) - std::ilogb(static_cast<double>(this->Resolution)));
+  }
+  candidate = std::min(candidate, MaximumExponent);
+  while (candidate < MaximumExponent && !this->Fits(candidate, low, high))
+  {
+    ++candidate;
+  }
+
+  exponent = candidate;
+  const double width = std::ldexp(1.0, candidate);
+  const long long lowIndex = BinIndex(low, width);
+  const long long used = BinIndex(high, width) - lowIndex + 1;
+  origin = lowIndex - (this->Resolution - used) / 2;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Cover(
+  const double* lows, const double* highs, const int* minExponents)
+{
+  const int dims = this->NumberOfDimensions;
+  if (this->Counts.empty())
+  {
+    vtkIdType numberOfBins = 1;
+    for (int dim = 0; dim < dims; ++dim)
+    {
+      this->ChooseGrid(lows[dim], highs[dim],
+        minExponents ? minExponents[dim] : MinimumExponent, this->Exponent[dim],
+        this->Origin[dim]);
+      this->Width[dim] = std::ldexp(1.0, this->Exponent[dim]);
+      numberOfBins *= this->Resolution;
+    }
+    this->Counts.assign(static_cast<size_t>(numberOfBins), 0.0);
+    return;
+  }
+
+  int exponents[MaxNumberOfDimensions];
+  long long origins[MaxNumberOfDimensions];
+  bool regrid = false;
+  for (int dim = 0; dim < dims; ++dim)
+  {
+    exponents[dim] = this->Exponent[dim];
+    origins[dim] = this->Origin[dim];
+    const int minExponent =
+      minExponents ? std::max(minExponents[dim], this->Exponent[dim]) : this->Exponent[dim];
+    if (minExponent == this->Exponent[dim] &&
+      BinIndex(lows[dim], this->Width[dim]) >= this->Origin[dim] &&
+      BinIndex(highs[dim], this->Width[dim]) < this->Origin[dim] + this->Resolution)
+    {
+      continue;
+    }
+
+    // the new grid must also hold the samples already binned.
+    const double low = std::min(lows[dim], this->Range[dim][0]);
+    const double high = std::max(highs[dim], this->Range[dim][1]);
+    this->ChooseGrid(low, high, minExponent, exponents[dim], origins[dim]);
+    regrid = true;
+  }
+
+  if (regrid)
+  {
+    this->Regrid(exponents, origins);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Regrid(const int* exponents, const long long* origins)
+{
+  const vtkPVHistogramSketch previous(*this);
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    this->Exponent[dim] = exponents[dim];
+    this->Origin[dim] = origins[dim];
+    this->Width[dim] = std::ldexp(1.0, exponents[dim]);
+  }
+  std::fill(this->Counts.begin(), this->Counts.end(), 0.0);
+  this->Accumulate(previous);
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Accumulate(const vtkPVHistogramSketch& source)
+{
+  // Bins of `source` are never wider than ours, and both grids are aligned on
+  // multiples of their widths: each source bin falls entirely in one of our bins.
+  const vtkIdType resolution = this->Resolution;
+  const vtkIdType numberOfBins = static_cast<vtkIdType>(source.Counts.size());
+  for (vtkIdType flatIndex = 0; flatIndex < numberOfBins; ++flatIndex)
+  {
+    const double count = source.Counts[flatIndex];
+    if (count == 0.0)
+    {
+      continue;
+    }
+    vtkIdType remainder = flatIndex;
+    vtkIdType target = 0;
+    vtkIdType stride = 1;
+    for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+    {
+      const long long index = source.Origin[dim] + remainder % resolution;
+      remainder /= resolution;
+      long long mapped =
+        FloorShift(index, this->Exponent[dim] - source.Exponent[dim]) - this->Origin[dim];
+      mapped = std::min(std::max(mapped, 0LL), static_cast<long long>(resolution - 1));
+      target += static_cast<vtkIdType>(mapped) * stride;
+      stride *= resolution;
+    }
+    this->Counts[target] += count;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Insert(const double* sample, double weight)
+{
+  const long long resolution = this->Resolution;
+  vtkIdType target = 0;
+  vtkIdType stride = 1;
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    long long index = BinIndex(sample[dim], this->Width[dim]) - this->Origin[dim];
+    index = std::min(std::max(index, 0LL), resolution - 1);
+    target += static_cast<vtkIdType>(index) * stride;
+    stride *= this->Resolution;
+
+    this->Range[dim][0] = std::min(this->Range[dim][0], sample[dim]);
+    this->Range[dim][1] = std::max(this->Range[dim][1], sample[dim]);
+  }
+  this->Counts[target] += weight;
+  this->TotalCount += weight;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Add(const double* sample, double weight)
+{
+  if (!IsFinite(sample, this->NumberOfDimensions))
+  {
+    return;
+  }
+  this->Cover(sample, sample, nullptr);
+  this->Insert(sample, weight);
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::AddBatch(const double* samples, vtkIdType numberOfSamples)
+{
+  const int dims = this->NumberOfDimensions;
+  double lows[MaxNumberOfDimensions];
+  double highs[MaxNumberOfDimensions];
+  for (int dim = 0; dim < dims; ++dim)
+  {
+    lows[dim] = std::numeric_limits<double>::infinity();
+    highs[dim] = -std::numeric_limits<double>::infinity();
+  }
+
+  bool hasSamples = false;
+  for (vtkIdType cc = 0; cc < numberOfSamples; ++cc)
+  {
+    const double* sample = samples + cc * dims;
+    if (IsFinite(sample, dims))
+    {
+      hasSamples = true;
+      for (int dim = 0; dim < dims; ++dim)
+      {
+        lows[dim] = std::min(lows[dim], sample[dim]);
+        highs[dim] = std::max(highs[dim], sample[dim]);
+      }
+    }
+  }
+  if (!hasSamples)
+  {
+    return;
+  }
+
+  this->Cover(lows, highs, nullptr);
+  for (vtkIdType cc = 0; cc < numberOfSamples; ++cc)
+  {
+    const double* sample = samples + cc * dims;
+    if (IsFinite(sample, dims))
+    {
+      this->Insert(sample, 1.0);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Merge(const vtkPVHistogramSketch& other)
+{
+  if (other.IsEmpty() || other.NumberOfDimensions != this->NumberOfDimensions ||
+    other.Resolution != this->Resolution)
+  {
+    return;
+  }
+  if (this->IsEmpty())
+  {
+    *this = other;
+    return;
+  }
+
+  double lows[MaxNumberOfDimensions];
+  double highs[MaxNumberOfDimensions];
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    lows[dim] = other.Range[dim][0];
+    highs[dim] = other.Range[dim][1];
+  }
+  this->Cover(lows, highs, other.Exponent);
+  this->Accumulate(other);
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    this->Range[dim][0] = std::min(this->Range[dim][0], other.Range[dim][0]);
+    this->Range[dim][1] = std::max(this->Range[dim][1], other.Range[dim][1]);
+  }
+  this->TotalCount += other.TotalCount;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::Serialize(std::vector<double>& buffer) const
+{
+  buffer.clear();
+  buffer.reserve(3 + 4 * this->NumberOfDimensions + this->Counts.size());
+  buffer.push_back(this->NumberOfDimensions);
+  buffer.push_back(this->Resolution);
+  buffer.push_back(this->TotalCount);
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    buffer.push_back(this->Exponent[dim]);
+    buffer.push_back(static_cast<double>(this->Origin[dim]));
+    buffer.push_back(this->Range[dim][0]);
+    buffer.push_back(this->Range[dim][1]);
+  }
+  buffer.insert(buffer.end(), this->Counts.begin(), this->Counts.end());
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVHistogramSketch::Deserialize(const double* buffer, vtkIdType size)
+{
+  const vtkIdType headerSize = 3 + 4 * this->NumberOfDimensions;
+  if (!buffer || size < headerSize ||
+    static_cast<int>(buffer[0]) != this->NumberOfDimensions ||
+    static_cast<int>(buffer[1]) != this->Resolution)
+  {
+    return false;
+  }
+
+  vtkIdType numberOfBins = 1;
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    numberOfBins *= this->Resolution;
+  }
+  if (size != headerSize && size != headerSize + numberOfBins)
+  {
+    return false;
+  }
+
+  this->Initialize();
+  if (size == headerSize)
+  {
+    // empty sketch
+    return true;
+  }
+  this->TotalCount = buffer[2];
+  for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+  {
+    const double* header = buffer + 3 + 4 * dim;
+    this->Exponent[dim] = static_cast<int>(header[0]);
+    this->Origin[dim] = static_cast<long long>(header[1]);
+    this->Width[dim] = std::ldexp(1.0, this->Exponent[dim]);
+    this->Range[dim][0] = header[2];
+    this->Range[dim][1] = header[3];
+  }
+  this->Counts.assign(buffer + headerSize, buffer + size);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVHistogramSketch::Reduce(vtkMultiProcessController* controller)
+{
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return true;
+  }
+
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  std::vector<double> buffer;
+  bool success = true;
+  for (int step = 1; step < numProcs; step *= 2)
+  {
+    if (rank % (2 * step) != 0)
+    {
+      // hand over our partial sketch to our parent, we're done.
+      this->Serialize(buffer);
+      vtkNew<vtkDoubleArray> array;
+      array->SetArray(buffer.data(), static_cast<vtkIdType>(buffer.size()), /*save=*/1);
+      return controller->Send(array, rank - step, ReduceTag) != 0 && success;
+    }
+    if (rank + step < numProcs)
+    {
+      // on failure, keep going without the child's samples so that the
+      // processes waiting on us do not hang.
+      vtkNew<vtkDoubleArray> array;
+      vtkPVHistogramSketch child(this->NumberOfDimensions, this->Resolution);
+      if (controller->Receive(array, rank + step, ReduceTag) &&
+        child.Deserialize(array->GetPointer(0), array->GetNumberOfValues()))
+      {
+        this->Merge(child);
+      }
+      else
+      {
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVHistogramSketch::SplitInterval(double low, double high, const double* clip,
+  const RegularBins& bins, std::vector<std::pair<vtkIdType, double>>& parts)
+{
+  parts.clear();
+  const double length = high - low;
+  if (clip)
+  {
+    low = std::max(low, clip[0]);
+    high = std::min(high, clip[1]);
+  }
+  if (high < low || (high == low && length > 0.0))
+  {
+    return;
+  }
+
+  const vtkIdType numberOfBins = std::max<vtkIdType>(bins.NumberOfBins, 1);
+  auto binOf = [&](double value)
+  {
+    if (bins.Width <= 0.0)
+    {
+      return vtkIdType(0);
+    }
+    const double bin = std::floor((value - bins.Origin) / bins.Width);
+    return static_cast<vtkIdType>(
+      std::min(std::max(bin, 0.0), static_cast<double>(numberOfBins - 1)));
+  };
+  if (length <= 0.0 || bins.Width <= 0.0)
+  {
+    parts.emplace_back(binOf(low), length > 0.0 ? (high - low) / length : 1.0);
+    return;
+  }
+
+  const vtkIdType last = binOf(high);
+  for (vtkIdType bin = binOf(low); bin <= last; ++bin)
+  {
+    // the first and last bins extend to infinity, like in binOf().
+    const double binLow = bin == 0 ? low : bins.Origin + bin * bins.Width;
+    const double binHigh = bin == numberOfBins - 1 ? high : bins.Origin + (bin + 1) * bins.Width;
+    const double overlap = std::min(high, binHigh) - std::max(low, binLow);
+    if (overlap > 0.0)
+    {
+      parts.emplace_back(bin, overlap / length);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVHistogramSketch::Broadcast(vtkMultiProcessController* controller)
+{
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return true;
+  }
+
+  const bool isRoot = controller->GetLocalProcessId() == 0;
+  std::vector<double> buffer;
+  vtkNew<vtkDoubleArray> array;
+  if (isRoot)
+  {
+    this->Serialize(buffer);
+    array->SetArray(buffer.data(), static_cast<vtkIdType>(buffer.size()), /*save=*/1);
+  }
+  if (!controller->Broadcast(array, 0))
+  {
+    return false;
+  }
+  return isRoot || this->Deserialize(array->GetPointer(0), array->GetNumberOfValues());
+}
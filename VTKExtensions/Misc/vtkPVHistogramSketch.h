@@ -0,0 +1,321 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVHistogramSketch
+ * @brief   mergeable fixed-size histogram used to bin data in a single pass.
+ *
+ * vtkPVHistogramSketch counts samples of 1, 2 or 3 dimensions into a dense grid
+ * of `Resolution` bins per dimension. The bin width along each dimension is a
+ * power of two and bins are aligned on multiples of that width, so the grid
+ * does not need to know the data range in advance: when a sample falls outside
+ * the covered region, neighbouring bins are merged (the width doubles) until it
+ * fits. Two sketches can thus always be merged exactly by coarsening the finer
+ * one, no matter in which order samples were added, which makes it possible to
+ * bin data on each thread and each rank independently and combine the results
+ * with a reduction tree.
+ *
+ * The exact range of the samples is tracked alongside the bins. A histogram
+ * with arbitrary regular bins is obtained from the sketch with Rebin(), which
+ * splits the count of each sketch bin across the output bins it overlaps,
+ * assuming samples are uniformly distributed inside a sketch bin. The result is
+ * thus only approximate for sketch bins straddling an output bin boundary, but
+ * free of the aliasing that assigning whole sketch bins would cause when output
+ * bins are not a multiple of the sketch bins. The higher the resolution, the
+ * smaller the error.
+ *
+ * This is the engine behind the single-pass modes of vtkPExtractHistogram and
+ * vtkPVExtractHistogram2D.
+ */
+
+#ifndef vtkPVHistogramSketch_h
+#define vtkPVHistogramSketch_h
+
+#include "vtkPVVTKExtensionsMiscModule.h" // needed for exports
+#include "vtkSMPThreadLocal.h"            // for vtkSMPThreadLocal
+#include "vtkSMPTools.h"                  // for vtkSMPTools
+#include "vtkType.h"                      // for vtkIdType
+
+#include <algorithm> // for std::min
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPVHistogramSketch
+{
+public:
+  enum
+  {
+    MaxNumberOfDimensions = 3,
+    BatchSize = 1024,
+    ReduceTag = 21877
+  };
+
+  /**
+   * Create an empty sketch. The number of dimensions is clamped to
+   * [1, MaxNumberOfDimensions] and the resolution to at least 8 bins.
+   */
+  vtkPVHistogramSketch(int numberOfDimensions = 1, int resolution = 1024);
+
+  /**
+   * Remove all samples.
+   */
+  void Initialize();
+
+  int GetNumberOfDimensions() const { return this->NumberOfDimensions; }
+  int GetResolution() const { return this->Resolution; }
+
+  /**
+   * Returns the width of the bins along `dimension`. Only meaningful if the
+   * sketch is not empty.
+   */
+  double GetBinWidth(int dimension) const { return this->Width[dimension]; }
+
+  /**
+   * Returns true if no sample has been added.
+   */
+  bool IsEmpty() const { return this->Counts.empty(); }
+
+  /**
+   * Returns the sum of the weights of all samples added so far.
+   */
+  double GetTotalCount() const { return this->TotalCount; }
+
+  /**
+   * Get the exact range of the samples along the given dimension.
+   * Returns false if the sketch is empty.
+   */
+  bool GetRange(int dimension, double range[2]) const;
+
+  /**
+   * Add a single sample of `GetNumberOfDimensions()` coordinates.
+   * Samples with non-finite coordinates are ignored.
+   */
+  void Add(const double* sample, double weight = 1.0);
+
+  /**
+   * Add `numberOfSamples` samples stored contiguously in `samples`. This only
+   * checks once that the grid covers the batch, hence is much faster than
+   * calling Add() for each sample. Samples with non-finite coordinates are
+   * ignored.
+   */
+  void AddBatch(const double* samples, vtkIdType numberOfSamples);
+
+  /**
+   * Add samples `[0, numberOfSamples)` using vtkSMPTools. `getter(id, sample)`
+   * is called concurrently; it must fill `sample` with the coordinates of the
+   * sample `id` and return false if this sample should be skipped (ghosts,
+   * values outside of a custom range...).
+   */
+  template <typename Getter>
+  void AddSamples(vtkIdType numberOfSamples, Getter getter);
+
+  /**
+   * Add all the samples of `other` into this sketch. Both sketches must have
+   * the same number of dimensions and resolution.
+   */
+  void Merge(const vtkPVHistogramSketch& other);
+
+  /**
+   * Merge the sketches of all processes using a binomial tree. On return, the
+   * sketch on process 0 holds the samples of all processes while the sketches
+   * of the other processes are left partially merged. This is a collective
+   * operation: every process completes its part of the communication even
+   * when a message from another process could not be received, and only then
+   * returns false.
+   */
+  bool Reduce(vtkMultiProcessController* controller);
+
+  /**
+   * Send the sketch of process 0 to all the other processes.
+   * This is a collective operation. Returns false on communication errors.
+   */
+  bool Broadcast(vtkMultiProcessController* controller);
+
+  ///@{
+  /**
+   * Serialize the sketch into a flat buffer, and restore it.
+   * Deserialize returns false if the buffer does not match the number of
+   * dimensions and resolution of this sketch.
+   */
+  void Serialize(std::vector<double>& buffer) const;
+  bool Deserialize(const double* buffer, vtkIdType size);
+  ///@}
+
+  /**
+   * Call `functor(center, count)` for each non-empty bin. `center` holds the
+   * coordinates of the center of the bin, clamped to the range of the samples
+   * so that the bins containing the extreme values map to them.
+   */
+  template <typename Functor>
+  void ForEachBin(Functor functor) const;
+
+  /**
+   * Regular output bins `[Origin + i * Width, Origin + (i + 1) * Width)` for
+   * `i` in `[0, NumberOfBins)`. Values before the first bin or after the last
+   * one are counted in them. With a null width, everything goes to bin 0.
+   */
+  struct RegularBins
+  {
+    double Origin;
+    double Width;
+    vtkIdType NumberOfBins;
+  };
+
+  /**
+   * Re-bin the sketch into the regular bins `bins[dim]` along each dimension.
+   * Each non-empty sketch bin, clamped to the range of the samples, is split
+   * across the output bins it overlaps proportionally to the overlap, and
+   * `functor(indices, count)` is called for each part with the index of the
+   * output bin along each dimension. If `clip` is not null, the parts of the
+   * sketch bins outside of `[clip[dim][0], clip[dim][1]]` are dropped.
+   */
+  template <typename Functor>
+  void Rebin(const RegularBins* bins, const double (*clip)[2], Functor functor) const;
+
+private:
+  static void SplitInterval(double low, double high, const double* clip,
+    const RegularBins& bins, std::vector<std::pair<vtkIdType, double>>& parts);
+
+  bool Fits(int exponent, double low, double high) const;
+  void ChooseGrid(double low, double high, int minExponent, int& exponent, long long& origin) const;
+  void Cover(const double* lows, const double* highs, const int* minExponents);
+  void Regrid(const int* exponents, const long long* origins);
+  void Accumulate(const vtkPVHistogramSketch& source);
+  void Insert(const double* sample, double weight);
+
+  int NumberOfDimensions;
+  int Resolution;
+  double TotalCount = 0.0;
+
+  // bin `i` along dimension `d` covers
+  // [(Origin[d] + i) * 2^Exponent[d], (Origin[d] + i + 1) * 2^Exponent[d])
+  int Exponent[MaxNumberOfDimensions];
+  long long Origin[MaxNumberOfDimensions];
+  double Width[MaxNumberOfDimensions];
+  double Range[MaxNumberOfDimensions][2];
+
+  // dense bins, first dimension varying fastest. Empty when no sample was added.
+  std::vector<double> Counts;
+};
+
+//-----------------------------------------------------------------------------
+template <typename Getter>
+void vtkPVHistogramSketch::AddSamples(vtkIdType numberOfSamples, Getter getter)
+{
+  const int dims = this->NumberOfDimensions;
+  vtkSMPThreadLocal<vtkPVHistogramSketch> locals(
+    vtkPVHistogramSketch(this->NumberOfDimensions, this->Resolution));
+  vtkSMPTools::For(0, numberOfSamples,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkPVHistogramSketch& local = locals.Local();
+      double batch[BatchSize * MaxNumberOfDimensions];
+      for (vtkIdType start = begin; start < end; start += BatchSize)
+      {
+        const vtkIdType stop = std::min<vtkIdType>(end, start + BatchSize);
+        vtkIdType count = 0;
+        for (vtkIdType id = start; id < stop; ++id)
+        {
+          if (getter(id, batch + count * dims))
+          {
+            ++count;
+          }
+        }
+        local.AddBatch(batch, count);
+      }
+    });
+
+  for (auto iter = locals.begin(); iter != locals.end(); ++iter)
+  {
+    this->Merge(*iter);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <typename Functor>
+void vtkPVHistogramSketch::ForEachBin(Functor functor) const
+{
+  const vtkIdType numberOfBins = static_cast<vtkIdType>(this->Counts.size());
+  double center[MaxNumberOfDimensions];
+  for (vtkIdType flatIndex = 0; flatIndex < numberOfBins; ++flatIndex)
+  {
+    const double count = this->Counts[flatIndex];
+    if (count == 0.0)
+    {
+      continue;
+    }
+    vtkIdType remainder = flatIndex;
+    for (int dim = 0; dim < this->NumberOfDimensions; ++dim)
+    {
+      const vtkIdType index = remainder % this->Resolution;
+      remainder /= this->Resolution;
+      const double value =
+        (static_cast<double>(this->Origin[dim] + index) + 0.5) * this->Width[dim];
+      center[dim] = std::min(std::max(value, this->Range[dim][0]), this->Range[dim][1]);
+    }
+    functor(static_cast<const double*>(center), count);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <typename Functor>
+void vtkPVHistogramSketch::Rebin(
+  const RegularBins* bins, const double (*clip)[2], Functor functor) const
+{
+  const int dims = this->NumberOfDimensions;
+  const vtkIdType numberOfBins = static_cast<vtkIdType>(this->Counts.size());
+  std::vector<std::pair<vtkIdType, double>> parts[MaxNumberOfDimensions];
+  vtkIdType indices[MaxNumberOfDimensions];
+  std::size_t cursor[MaxNumberOfDimensions];
+  for (vtkIdType flatIndex = 0; flatIndex < numberOfBins; ++flatIndex)
+  {
+    const double count = this->Counts[flatIndex];
+    if (count == 0.0)
+    {
+      continue;
+    }
+    bool empty = false;
+    vtkIdType remainder = flatIndex;
+    for (int dim = 0; dim < dims; ++dim)
+    {
+      const vtkIdType index = remainder % this->Resolution;
+      remainder /= this->Resolution;
+      const double low = static_cast<double>(this->Origin[dim] + index) * this->Width[dim];
+      const double high = low + this->Width[dim];
+      vtkPVHistogramSketch::SplitInterval(std::max(low, this->Range[dim][0]),
+        std::min(high, this->Range[dim][1]), clip ? clip[dim] : nullptr, bins[dim], parts[dim]);
+      empty = empty || parts[dim].empty();
+      cursor[dim] = 0;
+    }
+    if (empty)
+    {
+      continue;
+    }
+
+    // visit every combination of the parts along each dimension.
+    int dim = 0;
+    while (dim < dims)
+    {
+      double partCount = count;
+      for (int cc = 0; cc < dims; ++cc)
+      {
+        indices[cc] = parts[cc][cursor[cc]].first;
+        partCount *= parts[cc][cursor[cc]].second;
+      }
+      functor(static_cast<const vtkIdType*>(indices), partCount);
+      for (dim = 0; dim < dims; ++dim)
+      {
+        if (++cursor[dim] < parts[dim].size())
+        {
+          break;
+        }
+        cursor[dim] = 0;
+      }
+    }
+  }
+}
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkPVHistogramSketch.h
@@ -9,12 +9,16 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
 vtkStandardNewMacro(vtkPVMergeTables);
 //----------------------------------------------------------------------------
-vtkPVMergeTables::vtkPVMergeTables() = default;
+vtkPVMergeTables::vtkPVMergeTables()
+{
+  this->GetInformation()->Set(vtkReductionFilter::ASSOCIATIVE_HELPER(), 1);
+}
 
 //----------------------------------------------------------------------------
 vtkPVMergeTables::~vtkPVMergeTables() = default;
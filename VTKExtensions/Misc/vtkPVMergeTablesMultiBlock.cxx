@@ -8,6 +8,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
@@ -20,6 +21,7 @@ vtkPVMergeTablesMultiBlock::vtkPVMergeTablesMultiBlock()
 {
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
+  this->GetInformation()->Set(vtkReductionFilter::ASSOCIATIVE_HELPER(), 1);
 }
 
 //----------------------------------------------------------------------------
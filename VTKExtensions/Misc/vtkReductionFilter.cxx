@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkClientServerStreamInstantiator.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkGenericDataObjectReader.h"
@@ -14,7 +15,9 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -35,6 +38,7 @@ vtkStandardNewMacro(vtkReductionFilter);
 vtkCxxSetObjectMacro(vtkReductionFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkReductionFilter, PreGatherHelper, vtkAlgorithm);
 vtkCxxSetObjectMacro(vtkReductionFilter, PostGatherHelper, vtkAlgorithm);
+vtkInformationKeyMacro(vtkReductionFilter, ASSOCIATIVE_HELPER, Integer);
 
 //-----------------------------------------------------------------------------
 vtkReductionFilter::vtkReductionFilter()
@@ -354,6 +358,12 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
   }
 
+  if (this->UseTreeReduction && this->PassThrough < 0 && this->CanUseTreeReduction(preOutput))
+  {
+    this->TreeReduce(preOutput, output);
+    return;
+  }
+
   std::vector<vtkSmartPointer<vtkDataObject>> data_sets;
   std::vector<vtkSmartPointer<vtkDataObject>> receiveData(numProcs);
 
@@ -423,6 +433,135 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
   }
 }
+
+//-----------------------------------------------------------------------------
+bool vtkReductionFilter::CanUseTreeReduction(vtkDataObject* preOutput)
+{
+  // Helpers declare themselves associative with ASSOCIATIVE_HELPER(): summing
+  // attributes (vtkAttributeDataReductionFilter) or appending rows
+  // (vtkPVMergeTables, vtkPVMergeTablesMultiBlock) gives the same result
+  // whether the inputs are merged at once or by consecutive subsets.
+  // The PostGatherHelper may be set on the reduction process only and
+  // selections are gathered differently, so all processes must agree.
+  int canUseTree = 0;
+  if (this->PostGatherHelper && !vtkSelection::SafeDownCast(preOutput))
+  {
+    canUseTree =
+      this->PostGatherHelper->GetInformation()->Get(vtkReductionFilter::ASSOCIATIVE_HELPER());
+  }
+  int allCanUseTree = 0;
+  if (!this->Controller->AllReduce(&canUseTree, &allCanUseTree, 1, vtkCommunicator::MIN_OP))
+  {
+    return false;
+  }
+  return allCanUseTree != 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::TreeReduce(vtkDataObject* preOutput, vtkDataObject* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // At step `s`, processes that are a multiple of 2*s receive the partial result
+  // of processes [myId + s, myId + 2*s) from process myId + s. Merging our own
+  // data first then our children's in increasing order keeps the data ordered
+  // by process id, as with a gather.
+  std::vector<vtkSmartPointer<vtkDataObject>> pieces;
+  if (preOutput)
+  {
+    pieces.push_back(preOutput);
+  }
+  int step = 1;
+  for (; step < numProcs && myId % (2 * step) == 0; step *= 2)
+  {
+    if (myId + step < numProcs)
+    {
+      int hasData = 0;
+      controller->Receive(&hasData, 1, myId + step, TRANSMIT_DATA_OBJECT);
+      if (hasData)
+      {
+        vtkSmartPointer<vtkDataObject> piece;
+        piece.TakeReference(controller->ReceiveDataObject(myId + step, TRANSMIT_DATA_OBJECT));
+        if (piece)
+        {
+          pieces.push_back(piece);
+        }
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkDataObject> merged;
+  if (pieces.size() == 1)
+  {
+    merged = pieces[0];
+  }
+  else if (pieces.size() > 1)
+  {
+    merged.TakeReference(output->NewInstance());
+    this->PostProcess(merged, pieces.data(), static_cast<unsigned int>(pieces.size()));
+  }
+  pieces.clear();
+
+  if (myId != 0)
+  {
+    // forward our partial result to our parent.
+    int hasData = merged ? 1 : 0;
+    controller->Send(&hasData, 1, myId - step, TRANSMIT_DATA_OBJECT);
+    if (hasData)
+    {
+      controller->Send(merged.GetPointer(), myId - step, TRANSMIT_DATA_OBJECT);
+    }
+    merged = nullptr;
+  }
+
+  // Process 0 now holds the reduced result, move it where it is expected.
+  if (this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+  {
+    int hasData = merged ? 1 : 0;
+    controller->Broadcast(&hasData, 1, 0);
+    if (hasData)
+    {
+      controller->Broadcast(myId == 0 ? merged.GetPointer() : output, 0);
+    }
+  }
+  else if (this->ReductionProcessId != 0)
+  {
+    if (myId == 0)
+    {
+      int hasData = merged ? 1 : 0;
+      controller->Send(&hasData, 1, this->ReductionProcessId, TRANSMIT_DATA_OBJECT);
+      if (hasData)
+      {
+        controller->Send(merged.GetPointer(), this->ReductionProcessId, TRANSMIT_DATA_OBJECT);
+      }
+      merged = nullptr;
+    }
+    else if (myId == this->ReductionProcessId)
+    {
+      int hasData = 0;
+      controller->Receive(&hasData, 1, 0, TRANSMIT_DATA_OBJECT);
+      if (hasData)
+      {
+        merged.TakeReference(controller->ReceiveDataObject(0, TRANSMIT_DATA_OBJECT));
+      }
+    }
+  }
+
+  if (merged)
+  {
+    vtkSmartPointer<vtkDataObject> inputs[1] = { merged };
+    this->PostProcess(output, inputs, 1);
+  }
+  else if (myId != this->ReductionProcessId && preOutput &&
+    this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+  {
+    vtkSmartPointer<vtkDataObject> inputs[1] = { preOutput };
+    this->PostProcess(output, inputs, 1);
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
   std::vector<vtkSmartPointer<vtkDataObject>>& receiveData, int destProcessId)
@@ -473,4 +612,5 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "UseTreeReduction: " << this->UseTreeReduction << endl;
 }
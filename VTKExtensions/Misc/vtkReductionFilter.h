@@ -17,6 +17,13 @@
  * In addition to doing reduction the PassThrough variable lets you choose
  * to pass through the results of any one node instead of aggregating all of
  * them together.
+ *
+ * When UseTreeReduction is set and the PostGatherHelper declares itself
+ * associative (see ASSOCIATIVE_HELPER()), the intermediate results are not all
+ * gathered on the root node. Instead they are merged along a binomial tree:
+ * each node runs the PostGatherHelper on its own result and the partial
+ * results of its children before forwarding it to its parent, so that no node
+ * holds more than O(log(N)) results at once.
  */
 
 #ifndef vtkReductionFilter_h
@@ -27,6 +34,7 @@
 #include "vtkSmartPointer.h"              // needed for vtkSmartPointer.
 #include <vector>                         //  needed for std::vector
 
+class vtkInformationIntegerKey;
 class vtkMultiProcessController;
 class vtkSelection;
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkReductionFilter : public vtkDataObjectAlgorithm
@@ -114,6 +122,28 @@ public:
   vtkGetMacro(GenerateProcessIds, int);
   ///@}
 
+  ///@{
+  /**
+   * When set, reduce the data using a binomial tree instead of gathering it
+   * on a single node, provided that the PostGatherHelper is associative on all
+   * nodes. The PostGatherHelper then also runs on intermediate nodes. The
+   * result is the same as with a gather since the data is merged in process
+   * order. Selections and PassThrough always use a gather. Default is false.
+   */
+  vtkSetMacro(UseTreeReduction, bool);
+  vtkGetMacro(UseTreeReduction, bool);
+  vtkBooleanMacro(UseTreeReduction, bool);
+  ///@}
+
+  /**
+   * Key to set to 1 in the information of a PostGatherHelper (see
+   * vtkAlgorithm::GetInformation()) to declare that it is associative:
+   * reducing the outputs of the helper on consecutive subsets of the inputs
+   * gives the same result as reducing all the inputs at once. Its output must
+   * also be an acceptable input. Required by UseTreeReduction.
+   */
+  static vtkInformationIntegerKey* ASSOCIATIVE_HELPER();
+
   enum Tags
   {
     TRANSMIT_DATA_OBJECT = 23484
@@ -137,6 +167,18 @@ protected:
   void PostProcess(
     vtkDataObject* output, vtkSmartPointer<vtkDataObject> inputs[], unsigned int num_inputs);
 
+  /**
+   * Returns true if all the processes can reduce `preOutput` with a tree.
+   * This is a collective operation.
+   */
+  bool CanUseTreeReduction(vtkDataObject* preOutput);
+
+  /**
+   * Reduce using a binomial tree rooted at process 0. Used instead of the gather
+   * in Reduce() when CanUseTreeReduction() is true.
+   */
+  void TreeReduce(vtkDataObject* preOutput, vtkDataObject* output);
+
   /**
    * Gather for vtkSelection
    * sendData is a vtkSelection while receiveData is a vector of NumberOfProcesses
@@ -152,6 +194,7 @@ protected:
   int GenerateProcessIds;
   int ReductionMode;
   int ReductionProcessId;
+  bool UseTreeReduction = false;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&) = delete;